@@ -0,0 +1,70 @@
+#include "cancellation_token.hpp"
+
+#include <algorithm>
+
+namespace duckdb {
+
+namespace {
+thread_local CancellationToken *current_cancellation_token = nullptr;
+} // namespace
+
+void CancellationToken::Cancel() {
+	vector<std::pair<CallbackId, std::function<void()>>> to_invoke;
+	{
+		const concurrency::lock_guard<concurrency::mutex> lock(mu);
+		if (cancelled.load(std::memory_order_relaxed)) {
+			return;
+		}
+		cancelled.store(true, std::memory_order_release);
+		to_invoke = std::move(callbacks);
+		callbacks.clear();
+		cv.notify_all();
+	}
+	// Invoke callbacks without holding the lock, so they're free to call back into the token.
+	for (auto &cur_callback : to_invoke) {
+		cur_callback.second();
+	}
+}
+
+CancellationToken::CallbackId CancellationToken::AddCallback(std::function<void()> callback) {
+	CallbackId id;
+	{
+		const concurrency::lock_guard<concurrency::mutex> lock(mu);
+		id = next_callback_id++;
+		if (!cancelled.load(std::memory_order_relaxed)) {
+			callbacks.emplace_back(id, std::move(callback));
+			return id;
+		}
+	}
+	callback();
+	return id;
+}
+
+void CancellationToken::RemoveCallback(CallbackId id) {
+	const concurrency::lock_guard<concurrency::mutex> lock(mu);
+	callbacks.erase(std::remove_if(callbacks.begin(), callbacks.end(),
+	                               [id](const std::pair<CallbackId, std::function<void()>> &cur_callback) {
+		                               return cur_callback.first == id;
+	                               }),
+	                callbacks.end());
+}
+
+bool CancellationToken::WaitFor(std::chrono::microseconds timeout) {
+	concurrency::unique_lock<concurrency::mutex> lock(mu);
+	return cv.wait_for(lock, timeout, [this]() { return cancelled.load(std::memory_order_relaxed); });
+}
+
+optional_ptr<CancellationToken> CancellationToken::GetCurrent() {
+	return current_cancellation_token;
+}
+
+ScopedCancellationToken::ScopedCancellationToken(optional_ptr<CancellationToken> token)
+    : previous(current_cancellation_token) {
+	current_cancellation_token = token.get();
+}
+
+ScopedCancellationToken::~ScopedCancellationToken() {
+	current_cancellation_token = previous.get();
+}
+
+} // namespace duckdb
@@ -0,0 +1,158 @@
+#include "file_handle_pool.hpp"
+
+#include "duckdb/common/string_util.hpp"
+#include "hedged_request_config.hpp"
+
+#include <algorithm>
+
+namespace duckdb {
+
+shared_ptr<FileHandle> MakeSharedFileHandle(unique_ptr<FileHandle> handle) {
+	return shared_ptr<FileHandle>(handle.release(), [](FileHandle *handle) {
+		if (handle) {
+			// Released from destructors, which have no way to report the failure.
+			try {
+				handle->Close();
+			} catch (...) {
+			}
+			delete handle;
+		}
+	});
+}
+
+FileHandlePool::FileHandlePool()
+    : ttl_ms(DEFAULT_HANDLE_POOL_TTL_MS), max_handles(DEFAULT_HANDLE_POOL_MAX_HANDLES) {
+}
+
+void FileHandlePool::SetTtl(std::chrono::milliseconds ttl_p) {
+	ttl_ms.store(ttl_p.count(), std::memory_order_relaxed);
+}
+
+void FileHandlePool::SetMaxHandles(idx_t max_handles_p) {
+	max_handles.store(max_handles_p, std::memory_order_relaxed);
+	vector<shared_ptr<FileHandle>> evicted;
+	{
+		const concurrency::lock_guard<concurrency::mutex> lock(mu);
+		EvictToLimit(max_handles_p, evicted);
+	}
+	// Handles are closed on release, which happens without lock.
+}
+
+void FileHandlePool::Put(const string &key, idx_t flags, shared_ptr<FileHandle> handle, PooledHandleVersion version) {
+	const auto cur_max_handles = max_handles.load(std::memory_order_relaxed);
+	if (cur_max_handles == 0 || handle == nullptr) {
+		return;
+	}
+	vector<shared_ptr<FileHandle>> evicted;
+	{
+		const concurrency::lock_guard<concurrency::mutex> lock(mu);
+		const auto now = std::chrono::steady_clock::now();
+		EvictExpired(now, evicted);
+		EvictToLimit(cur_max_handles - 1, evicted);
+		const auto ttl = std::chrono::milliseconds(ttl_ms.load(std::memory_order_relaxed));
+		handles.emplace_back(PooledHandle {key, flags, std::move(handle), std::move(version), now + ttl});
+		index[key].emplace_back(std::prev(handles.end()));
+		handle_count.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+shared_ptr<FileHandle> FileHandlePool::TryTake(const string &key, idx_t flags,
+                                               const std::function<bool(const PooledHandleVersion &)> &is_current) {
+	if (handle_count.load(std::memory_order_relaxed) == 0) {
+		return nullptr;
+	}
+	vector<shared_ptr<FileHandle>> evicted;
+	shared_ptr<FileHandle> result;
+	{
+		const concurrency::lock_guard<concurrency::mutex> lock(mu);
+		EvictExpired(std::chrono::steady_clock::now(), evicted);
+		while (result == nullptr) {
+			auto index_iter = index.find(key);
+			if (index_iter == index.end()) {
+				break;
+			}
+			auto &key_handles = index_iter->second;
+			auto iter = std::find_if(key_handles.rbegin(), key_handles.rend(),
+			                         [flags](const HandleList::iterator &cur) { return cur->flags == flags; });
+			if (iter == key_handles.rend()) {
+				break;
+			}
+			auto handle_iter = *iter;
+			// Stale handles are closed, and the next older one is tried.
+			if (is_current(handle_iter->version)) {
+				result = std::move(handle_iter->handle);
+			}
+			EraseHandle(handle_iter, evicted);
+		}
+	}
+	return result;
+}
+
+void FileHandlePool::Erase(const string &key) {
+	if (handle_count.load(std::memory_order_relaxed) == 0) {
+		return;
+	}
+	vector<shared_ptr<FileHandle>> evicted;
+	{
+		const concurrency::lock_guard<concurrency::mutex> lock(mu);
+		auto index_iter = index.find(key);
+		if (index_iter == index.end()) {
+			return;
+		}
+		// Erasing the last handle of a key drops its index entry, copy iterators first.
+		const auto key_handles = index_iter->second;
+		for (auto &cur_handle_iter : key_handles) {
+			EraseHandle(cur_handle_iter, evicted);
+		}
+	}
+}
+
+void FileHandlePool::ErasePrefix(const string &prefix) {
+	if (handle_count.load(std::memory_order_relaxed) == 0) {
+		return;
+	}
+	vector<shared_ptr<FileHandle>> evicted;
+	{
+		const concurrency::lock_guard<concurrency::mutex> lock(mu);
+		for (auto iter = handles.begin(); iter != handles.end();) {
+			auto cur_iter = iter++;
+			if (StringUtil::StartsWith(cur_iter->key, prefix)) {
+				EraseHandle(cur_iter, evicted);
+			}
+		}
+	}
+}
+
+idx_t FileHandlePool::GetHandleCount() const {
+	const concurrency::lock_guard<concurrency::mutex> lock(mu);
+	return handles.size();
+}
+
+void FileHandlePool::EvictExpired(std::chrono::steady_clock::time_point now, vector<shared_ptr<FileHandle>> &evicted) {
+	while (!handles.empty() && handles.front().expire_at <= now) {
+		EraseHandle(handles.begin(), evicted);
+	}
+}
+
+void FileHandlePool::EvictToLimit(idx_t limit, vector<shared_ptr<FileHandle>> &evicted) {
+	while (handles.size() > limit) {
+		EraseHandle(handles.begin(), evicted);
+	}
+}
+
+void FileHandlePool::EraseHandle(HandleList::iterator iter, vector<shared_ptr<FileHandle>> &evicted) {
+	if (iter->handle != nullptr) {
+		evicted.emplace_back(std::move(iter->handle));
+	}
+	auto index_iter = index.find(iter->key);
+	D_ASSERT(index_iter != index.end());
+	auto &key_handles = index_iter->second;
+	key_handles.erase(std::find(key_handles.begin(), key_handles.end(), iter));
+	if (key_handles.empty()) {
+		index.erase(index_iter);
+	}
+	handles.erase(iter);
+	handle_count.fetch_sub(1, std::memory_order_relaxed);
+}
+
+} // namespace duckdb
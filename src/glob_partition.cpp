@@ -0,0 +1,100 @@
+#include "glob_partition.hpp"
+
+#include "duckdb/common/string_util.hpp"
+
+namespace duckdb {
+
+namespace {
+constexpr const char *GLOB_WILDCARDS = "*?[";
+// Filesystems whose ListFiles lists one directory level, including subdirectories.
+constexpr const char *DIRECTORY_LEVEL_FILESYSTEMS[] = {"LocalFileSystem", "MockFileSystem"};
+} // namespace
+
+bool SplitGlobPattern(const string &pattern, GlobPartitioning &partitioning) {
+	const auto first_wildcard = pattern.find_first_of(GLOB_WILDCARDS);
+	if (first_wildcard == string::npos) {
+		return false;
+	}
+	const auto segment_begin = pattern.rfind('/', first_wildcard);
+	const auto segment_end = pattern.find('/', first_wildcard);
+	if (segment_begin == string::npos || segment_end == string::npos) {
+		return false;
+	}
+
+	auto base = pattern.substr(0, segment_begin + 1);
+	// Wildcard in the scheme or bucket part, e.g. "s3://bucket-*/file".
+	if (StringUtil::EndsWith(base, "://") || StringUtil::EndsWith(base, ":///")) {
+		return false;
+	}
+	auto segment = pattern.substr(segment_begin + 1, segment_end - segment_begin - 1);
+	// Recursive glob matches any number of levels, which cannot be expressed as one partition per directory.
+	if (segment.find("**") != string::npos) {
+		return false;
+	}
+
+	partitioning.base = std::move(base);
+	partitioning.segment = std::move(segment);
+	partitioning.suffix = pattern.substr(segment_end);
+	return true;
+}
+
+bool HasGlobWildcard(const string &segment) {
+	return segment.find_first_of(GLOB_WILDCARDS) != string::npos;
+}
+
+bool SplitGlobLevels(const string &pattern, GlobLevels &levels) {
+	const auto first_wildcard = pattern.find_first_of(GLOB_WILDCARDS);
+	if (first_wildcard == string::npos || pattern.find("**") != string::npos) {
+		return false;
+	}
+	const auto base_end = pattern.rfind('/', first_wildcard);
+	if (base_end == string::npos) {
+		return false;
+	}
+	auto base = pattern.substr(0, base_end + 1);
+	if (StringUtil::EndsWith(base, "://") || StringUtil::EndsWith(base, ":///")) {
+		return false;
+	}
+	vector<string> segments;
+	idx_t segment_begin = base.size();
+	while (segment_begin <= pattern.size()) {
+		auto segment_end = pattern.find('/', segment_begin);
+		if (segment_end == string::npos) {
+			segment_end = pattern.size();
+		}
+		if (segment_end == segment_begin) {
+			return false;
+		}
+		segments.emplace_back(pattern.substr(segment_begin, segment_end - segment_begin));
+		segment_begin = segment_end + 1;
+	}
+
+	levels.base = std::move(base);
+	levels.segments = std::move(segments);
+	return true;
+}
+
+string GetPartitionDirectoryName(const string &base, const string &listed_name) {
+	string name = listed_name;
+	if (StringUtil::StartsWith(name, base)) {
+		name = name.substr(base.size());
+	}
+	while (!name.empty() && name.back() == '/') {
+		name.pop_back();
+	}
+	if (name.find('/') != string::npos) {
+		return "";
+	}
+	return name;
+}
+
+bool ListsDirectoryLevels(const string &filesystem_name) {
+	for (const auto *cur_name : DIRECTORY_LEVEL_FILESYSTEMS) {
+		if (filesystem_name == cur_name) {
+			return true;
+		}
+	}
+	return false;
+}
+
+} // namespace duckdb
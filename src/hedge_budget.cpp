@@ -0,0 +1,59 @@
+#include "hedge_budget.hpp"
+
+#include "hedged_request_config.hpp"
+
+#include <algorithm>
+
+namespace duckdb {
+
+namespace {
+int64_t ToFixedPoint(double value, int64_t scale) {
+	return static_cast<int64_t>(std::max(value, 0.0) * static_cast<double>(scale));
+}
+} // namespace
+
+HedgeBudget::HedgeBudget()
+    : tokens(ToFixedPoint(static_cast<double>(DEFAULT_HEDGE_BUDGET_BURST), TOKEN_SCALE)),
+      deposit(ToFixedPoint(DEFAULT_HEDGE_BUDGET_PERCENT / 100.0, TOKEN_SCALE)),
+      capacity(ToFixedPoint(static_cast<double>(DEFAULT_HEDGE_BUDGET_BURST), TOKEN_SCALE)) {
+}
+
+void HedgeBudget::Configure(double ratio, double burst) {
+	deposit.store(ToFixedPoint(ratio, TOKEN_SCALE), std::memory_order_relaxed);
+	const auto new_capacity = ToFixedPoint(burst, TOKEN_SCALE);
+	capacity.store(new_capacity, std::memory_order_relaxed);
+
+	// Clamp existing tokens into the new capacity.
+	auto current = tokens.load(std::memory_order_relaxed);
+	while (current > new_capacity &&
+	       !tokens.compare_exchange_weak(current, new_capacity, std::memory_order_relaxed)) {
+	}
+}
+
+void HedgeBudget::OnPrimaryRequest() {
+	const auto current_deposit = deposit.load(std::memory_order_relaxed);
+	const auto current_capacity = capacity.load(std::memory_order_relaxed);
+	auto current = tokens.load(std::memory_order_relaxed);
+	while (current < current_capacity) {
+		const auto updated = std::min(current + current_deposit, current_capacity);
+		if (tokens.compare_exchange_weak(current, updated, std::memory_order_relaxed)) {
+			return;
+		}
+	}
+}
+
+bool HedgeBudget::TryAcquire() {
+	auto current = tokens.load(std::memory_order_relaxed);
+	while (current >= TOKEN_SCALE) {
+		if (tokens.compare_exchange_weak(current, current - TOKEN_SCALE, std::memory_order_relaxed)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+double HedgeBudget::GetAvailableTokens() const {
+	return static_cast<double>(tokens.load(std::memory_order_relaxed)) / static_cast<double>(TOKEN_SCALE);
+}
+
+} // namespace duckdb
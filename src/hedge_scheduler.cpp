@@ -0,0 +1,140 @@
+#include "hedge_scheduler.hpp"
+
+#include "duckdb/common/vector.hpp"
+
+namespace duckdb {
+
+constexpr std::chrono::milliseconds HedgeScheduler::DEFAULT_TICK;
+
+HedgeScheduler::HedgeScheduler(std::chrono::milliseconds tick_p)
+    : tick(tick_p.count() > 0 ? tick_p : DEFAULT_TICK), start_time(Clock::now()) {
+	thread = std::thread([this]() { Run(); });
+}
+
+HedgeScheduler::~HedgeScheduler() {
+	{
+		const concurrency::lock_guard<concurrency::mutex> lock(mu);
+		stopped = true;
+		wakeup_cv.notify_all();
+	}
+	thread.join();
+}
+
+uint64_t HedgeScheduler::GetTick(Clock::time_point time_point) const {
+	if (time_point <= start_time) {
+		return 0;
+	}
+	return static_cast<uint64_t>((time_point - start_time) / tick);
+}
+
+uint64_t HedgeScheduler::GetDeadlineTick(Clock::time_point deadline) const {
+	if (deadline <= start_time) {
+		return 0;
+	}
+	const auto elapsed = deadline - start_time;
+	auto deadline_tick = static_cast<uint64_t>(elapsed / tick);
+	if (elapsed % tick != Clock::duration::zero()) {
+		++deadline_tick;
+	}
+	return deadline_tick;
+}
+
+HedgeScheduler::Clock::time_point HedgeScheduler::GetTickTime(uint64_t tick_p) const {
+	return start_time + tick * tick_p;
+}
+
+uint64_t HedgeScheduler::Schedule(Clock::time_point deadline, Callback callback) {
+	const concurrency::lock_guard<concurrency::mutex> lock(mu);
+	// An idle wheel could lag far behind, catch up before placing the timer relative to the current tick.
+	if (wheel.IsEmpty()) {
+		vector<uint64_t> expired;
+		wheel.Advance(GetTick(Clock::now()), expired);
+	}
+
+	const auto timer_id = next_timer_id++;
+	const auto deadline_tick = GetDeadlineTick(deadline);
+	timers[timer_id].callback = std::move(callback);
+	wheel.Add(timer_id, deadline_tick);
+	if (deadline_tick < planned_wakeup_tick) {
+		wakeup_cv.notify_one();
+	}
+	return timer_id;
+}
+
+bool HedgeScheduler::Cancel(uint64_t timer_id) {
+	concurrency::unique_lock<concurrency::mutex> lock(mu);
+	auto iter = timers.find(timer_id);
+	if (iter == timers.end()) {
+		return false;
+	}
+	if (running_timer_id != timer_id) {
+		wheel.Remove(timer_id);
+		timers.erase(iter);
+		return true;
+	}
+
+	// Callback is running, which drops the timer once it completes.
+	iter->second.cancelled = true;
+	if (std::this_thread::get_id() != thread.get_id()) {
+		callback_completion_cv.wait(lock, [this, timer_id]() DUCKDB_REQUIRES(mu) {
+			return running_timer_id != timer_id;
+		});
+	}
+	return true;
+}
+
+idx_t HedgeScheduler::GetPendingTimerCount() const {
+	const concurrency::lock_guard<concurrency::mutex> lock(mu);
+	return wheel.GetTimerCount();
+}
+
+void HedgeScheduler::Run() {
+	vector<uint64_t> expired;
+	concurrency::unique_lock<concurrency::mutex> lock(mu);
+	while (!stopped) {
+		wheel.Advance(GetTick(Clock::now()), expired);
+		for (const auto timer_id : expired) {
+			auto iter = timers.find(timer_id);
+			if (iter == timers.end()) {
+				continue;
+			}
+
+			// Invoke callback without lock, so it could schedule or cancel other timers.
+			running_timer_id = timer_id;
+			auto callback = std::move(iter->second.callback);
+			lock.unlock();
+			Clock::time_point next_deadline;
+			bool rearm = false;
+			try {
+				rearm = callback(next_deadline);
+			} catch (...) {
+				// Exception cannot be propagated to anyone, drop the timer.
+				rearm = false;
+			}
+			lock.lock();
+			running_timer_id = 0;
+
+			iter = timers.find(timer_id);
+			if (rearm && !iter->second.cancelled) {
+				iter->second.callback = std::move(callback);
+				wheel.Add(timer_id, GetDeadlineTick(next_deadline));
+			} else {
+				timers.erase(iter);
+			}
+			callback_completion_cv.notify_all();
+		}
+		expired.clear();
+
+		// Sleep until the next expiry or cascade point, or untimed if there's no timer.
+		if (wheel.IsEmpty()) {
+			planned_wakeup_tick = UINT64_MAX;
+			wakeup_cv.wait(lock);
+		} else {
+			planned_wakeup_tick = wheel.GetNextWakeupTick();
+			wakeup_cv.wait_until(lock, GetTickTime(planned_wakeup_tick));
+		}
+		wakeup_count.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+} // namespace duckdb
@@ -1,20 +1,33 @@
 #include "hedged_file_system.hpp"
 
 #include "duckdb/common/enums/file_glob_options.hpp"
+#include "duckdb/common/error_data.hpp"
 #include "duckdb/common/exception.hpp"
 #include "duckdb/common/multi_file/multi_file_list.hpp"
 #include "duckdb/common/helper.hpp"
 #include "duckdb/common/numeric_utils.hpp"
 #include "duckdb/common/unique_ptr.hpp"
+#include "duckdb/function/scalar/string_common.hpp"
 #include "duckdb/main/client_context_file_opener.hpp"
 #include "duckdb/main/database.hpp"
 #include "duckdb/main/database_file_opener.hpp"
 #include "duckdb/storage/object_cache.hpp"
+#include "cancellation_token.hpp"
 #include "future_utils.hpp"
+#include "glob_partition.hpp"
 #include "hedged_request_config.hpp"
+#include "hedged_request_stats.hpp"
+#include "hedging_policy.hpp"
+#include "listing_stream.hpp"
+#include "read_ahead_window.hpp"
+#include "read_buffer_pool.hpp"
+#include "request_trace.hpp"
 #include "thread_annotation.hpp"
 
-#include <future>
+#include <algorithm>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
 #include <type_traits>
 
 namespace duckdb {
@@ -38,159 +51,1304 @@ shared_ptr<FileOpener> CopyFileOpener(optional_ptr<FileOpener> opener) {
 	return make_shared_ptr<DatabaseFileOpener>(*database_file_opener->TryGetDatabase());
 }
 
-template <typename T>
-typename std::enable_if<!std::is_void<T>::value, T>::type HedgedRequest(std::function<T()> fn,
-                                                                        std::chrono::milliseconds hedged_request_delay,
-                                                                        shared_ptr<HedgedRequestFsEntry> entry) {
-	auto token = make_shared_ptr<HedgedOutcomeToken<T>>();
-	vector<std::future<void>> job_futures;
-	auto &pool = entry->GetThreadPool();
-
-	auto submit = [&pool, fn, token, &job_futures]() {
-		job_futures.push_back(pool.Push([fn, token]() { RunHedgedJob(std::function<T()>(fn), token); }));
-	};
-
-	submit();
+// Identify the client whose settings and secrets the wrapped filesystem resolves through [opener], so requests of
+// different clients are never coalesced; 0 without opener.
+uint64_t GetOpenerId(optional_ptr<FileOpener> opener) {
+	if (opener == nullptr) {
+		return 0;
+	}
+	auto context = opener->TryGetClientContext();
+	if (context != nullptr) {
+		return reinterpret_cast<uintptr_t>(context.get());
+	}
+	auto database = opener->TryGetDatabase();
+	if (database != nullptr) {
+		return reinterpret_cast<uintptr_t>(database.get());
+	}
+	return reinterpret_cast<uintptr_t>(opener.get());
+}
 
-	auto config = entry->GetConfig();
+// Get elapsed time since [start] in microseconds.
+std::chrono::microseconds GetElapsedMicros(std::chrono::steady_clock::time_point start) {
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+}
 
-	// Keep spawning hedged requests at threshold intervals until one completes or max count reached.
-	while (true) {
-		{
-			concurrency::unique_lock<concurrency::mutex> lock(token->mu);
-			token->cv.wait_for(lock, hedged_request_delay,
-			                   [&token]() DUCKDB_REQUIRES(token->mu) { return token->completed; });
-			if (token->completed) {
-				break;
-			}
+// Record a failed attempt of [attempt_idx] from within its catch block, unless it's aborted due to cancellation after
+// another attempt completes. [trace] is nullptr if the request isn't traced.
+void RecordFailedAttempt(HedgedRequestStats &stats, HedgedRequestOperation operation, RequestTraceRecorder *trace,
+                         size_t attempt_idx) {
+	auto cancellation = CancellationToken::GetCurrent();
+	if (cancellation != nullptr && cancellation->IsCancelled()) {
+		if (trace != nullptr) {
+			trace->OnAttemptFinished(attempt_idx);
 		}
+		return;
+	}
+	stats.RecordFailedAttempt(operation);
+	if (trace != nullptr) {
+		trace->OnAttemptFinished(attempt_idx, std::current_exception());
+	}
+}
 
-		// We've reached upper bound, so don't spawn new hedged requests, simply wait for the first completed request.
-		if (job_futures.size() >= config.max_hedged_request_count) {
-			continue;
+// Run [fn] as the attempt of [attempt_idx], so its latency is recorded on success, failure is recorded into stats, and
+// both are traced into [trace] unless it's nullptr.
+template <typename Fn, typename T = decltype(std::declval<Fn &>()())>
+typename std::enable_if<!std::is_void<T>::value, T>::type
+RunInstrumentedAttempt(Fn &&fn, HedgedRequestOperation operation, LatencyTracker &latency_tracker,
+                       HedgedRequestStats &stats, RequestTraceRecorder *trace, size_t attempt_idx) {
+	const auto start = std::chrono::steady_clock::now();
+	if (trace != nullptr) {
+		trace->OnAttemptStarted(attempt_idx);
+	}
+	try {
+		T result = fn();
+		latency_tracker.Record(operation, GetElapsedMicros(start));
+		if (trace != nullptr) {
+			trace->OnAttemptFinished(attempt_idx);
 		}
+		return result;
+	} catch (...) {
+		RecordFailedAttempt(stats, operation, trace, attempt_idx);
+		throw;
+	}
+}
 
-		submit();
+template <typename Fn, typename T = decltype(std::declval<Fn &>()())>
+typename std::enable_if<std::is_void<T>::value>::type
+RunInstrumentedAttempt(Fn &&fn, HedgedRequestOperation operation, LatencyTracker &latency_tracker,
+                       HedgedRequestStats &stats, RequestTraceRecorder *trace, size_t attempt_idx) {
+	const auto start = std::chrono::steady_clock::now();
+	if (trace != nullptr) {
+		trace->OnAttemptStarted(attempt_idx);
 	}
+	try {
+		fn();
+		latency_tracker.Record(operation, GetElapsedMicros(start));
+		if (trace != nullptr) {
+			trace->OnAttemptFinished(attempt_idx);
+		}
+	} catch (...) {
+		RecordFailedAttempt(stats, operation, trace, attempt_idx);
+		throw;
+	}
+}
 
-	auto drain_pending_futures = [&]() {
-		for (auto &fut : job_futures) {
-			auto pending_fut = std::make_shared<std::future<void>>(std::move(fut));
-			entry->AddPendingRequest([pending_fut]() { pending_fut->wait(); });
+// Submit the primary request or a hedged request, which runs [run_job] on the thread pool in the [priority] class.
+// [run_job] returns whether the attempt's outcome wins. Attempts sharing a non-null [tie] are tied in the thread pool,
+// and [on_skipped] is invoked when the attempt is skipped.
+//
+// Both are invoked on the thread pool and should stay small, so the attempt is submitted without allocation.
+template <typename RunJob, typename OnSkipped>
+void SubmitHedgedAttempt(HedgedRequestFsEntry &entry, HedgedRequestOperation operation, size_t attempt_idx,
+                         JobPriority priority, const shared_ptr<JobTie> &tie, RunJob run_job, OnSkipped on_skipped) {
+	auto stats = entry.GetStats();
+	const bool is_hedge = attempt_idx > 0;
+	if (is_hedge) {
+		stats->RecordHedgedRequest(operation);
+	} else {
+		stats->RecordPrimaryRequest(operation);
+	}
+	stats->RecordAttemptStarted(operation);
+	auto attempt = [run_job = std::move(run_job), stats, operation, is_hedge]() {
+		const bool won = run_job();
+		if (won && is_hedge) {
+			stats->RecordHedgeWin(operation);
 		}
-		job_futures.clear();
+		stats->RecordAttemptFinished(operation);
 	};
+	if (tie == nullptr) {
+		entry.SubmitAttempt(std::move(attempt), priority);
+		return;
+	}
+	entry.SubmitAttempt(std::move(attempt), priority, tie,
+	                    [stats = std::move(stats), operation, on_skipped = std::move(on_skipped)]() {
+		                    stats->RecordSkippedAttempt(operation);
+		                    stats->RecordAttemptFinished(operation);
+		                    on_skipped();
+	                    });
+}
 
+// Waits for the outcome of a hedged request.
+struct HedgedOutcomeWaiter {
+	// Return whether the outcome is available, without blocking.
+	std::function<bool()> is_ready;
+	// Block until the outcome is available.
+	std::function<void()> wait;
+	// Only set in first-success mode: block until the outcome is available or more attempts have settled than the
+	// given ones, and return the settled attempts.
+	std::function<HedgedSettledAttempts(const HedgedSettledAttempts &)> wait_for_settled;
+	// Only set in first-success mode: decide the outcome with the latest failure, and return whether it's decided
+	// here rather than by an attempt which completed meanwhile.
+	std::function<bool()> fail;
+};
+
+// Return whether a failed attempt is worth retrying right away, i.e. an IO error or a transient HTTP error; other
+// errors are expected to fail again, so they're left to the regular hedging schedule.
+bool IsRetryableError(const std::exception_ptr &eptr) {
+	if (eptr == nullptr) {
+		return false;
+	}
 	try {
-		T result = WaitForHedgedOutcome(token);
-		drain_pending_futures();
-		return result;
+		std::rethrow_exception(eptr);
+	} catch (const std::exception &ex) {
+		const ErrorData error(ex);
+		if (error.Type() == ExceptionType::IO) {
+			return true;
+		}
+		if (error.Type() != ExceptionType::HTTP) {
+			return false;
+		}
+		// Timeouts, throttling and server errors are transient, while other client errors are not.
+		const auto &extra_info = error.ExtraInfo();
+		const auto status_code_iter = extra_info.find("status_code");
+		if (status_code_iter == extra_info.end()) {
+			return true;
+		}
+		const auto status_code = std::atoi(status_code_iter->second.c_str());
+		return status_code == 408 || status_code == 429 || status_code >= 500;
 	} catch (...) {
-		drain_pending_futures();
-		throw;
+		return false;
 	}
 }
 
-void HedgedRequest(std::function<void()> fn, std::chrono::milliseconds hedged_request_delay,
-                   shared_ptr<HedgedRequestFsEntry> entry) {
-	auto token = make_shared_ptr<HedgedOutcomeToken<void>>();
-	vector<std::future<void>> job_futures;
-	auto &pool = entry->GetThreadPool();
+// Get the number of attempts of a hedged request which have run or might still run, out of [attempt_count] submitted.
+size_t GetLiveAttemptCount(size_t attempt_count, const shared_ptr<JobTie> &tie) {
+	return tie == nullptr ? attempt_count : attempt_count - NumericCast<size_t>(tie->GetSkippedCount());
+}
+
+// Return whether a hedge should be submitted on a deadline of a hedged request with [attempt_count] attempts, which
+// consumes hedge budget if so.
+bool ShouldHedgeOnDeadline(HedgedRequestOperation operation, const HedgedRequestConfig &config,
+                           HedgedRequestFsEntry &entry, const shared_ptr<JobTie> &tie, size_t attempt_count) {
+	// Thread pool is backed up or hedge budget is exhausted, keep waiting for existing requests and retry on the next
+	// deadline.
+	if (GetLiveAttemptCount(attempt_count, tie) >= config.max_hedged_request_count) {
+		return false;
+	}
+	if (entry.ShouldSuppressHedge(config)) {
+		entry.GetStats()->RecordSuppressedHedge(operation);
+		return false;
+	}
+	return entry.TryAcquireHedgeBudget(config, operation);
+}
+
+// Return whether the deadline of a hedged request with [attempt_count] attempts should be re-armed.
+bool ShouldRearmDeadline(const HedgedRequestConfig &config, const shared_ptr<JobTie> &tie, size_t attempt_count) {
+	// We've reached upper bound, so don't spawn new hedged requests, simply wait for the first completed request.
+	// Queued tied attempts might still be skipped, which makes room for another hedge.
+	return GetLiveAttemptCount(attempt_count, tie) < config.max_hedged_request_count ||
+	       (tie != nullptr && tie->GetQueuedCount() > 0);
+}
+
+// In first-success mode, get the number of hedges to submit right away for failures in [settled] which aren't in
+// [seen] yet, if the latest failure is retryable; hedges are bounded by the max count and consume hedge budget.
+size_t GetRetryHedgeCount(HedgedRequestOperation operation, const HedgedRequestConfig &config,
+                          HedgedRequestFsEntry &entry, const HedgedSettledAttempts &seen,
+                          const HedgedSettledAttempts &settled, size_t attempt_count) {
+	if (!IsRetryableError(settled.last_failure)) {
+		return 0;
+	}
+	size_t hedge_count = 0;
+	for (auto idx = seen.failed; idx < settled.failed; ++idx) {
+		if (attempt_count + hedge_count - settled.skipped >= config.max_hedged_request_count ||
+		    !entry.TryAcquireHedgeBudget(config, operation)) {
+			break;
+		}
+		++hedge_count;
+	}
+	return hedge_count;
+}
 
-	auto submit = [&pool, fn, token, &job_futures]() {
-		job_futures.push_back(pool.Push([fn, token]() { RunHedgedVoidJob(std::function<void()>(fn), token); }));
+// Block until the outcome is available, spawning hedged requests at threshold intervals until one completes or max
+// count reached. Hedge deadlines are fired by the entry's hedge scheduler, so the caller only blocks in one untimed
+// wait. [submit] submits a new attempt in the given priority class, tied to its siblings by the given tie if tied
+// requests are enabled.
+//
+// With tied requests, an attempt still queued when a sibling starts is skipped, and doesn't count against the max
+// count. If the primary request has to wait in a saturated thread pool, a tied hedge is submitted right away without
+// taking hedge budget: only the first of them to be dequeued runs, so it cuts queueing delay without extra IO. It's
+// queued as a primary attempt, since it replaces the primary attempt instead of adding work.
+//
+// Hedges on deadline are queued behind primary attempts, and are suppressed while the thread pool is backed up, since
+// a hedge that has to queue cannot beat its primary attempt.
+//
+// If [waiter] supports first-success mode, failed attempts don't decide the outcome while another attempt could still
+// succeed. A retryable failure submits the next hedge right away instead of after the hedging delay, within the max
+// count and hedge budget; once no attempt is left running and none could be submitted, the latest failure is returned.
+//
+// Attempt submission and the returned outcome are traced into [trace], which has begun already, unless it's nullptr.
+void WaitAndHedge(HedgedRequestOperation operation, const HedgedRequestConfig &config, HedgedRequestFsEntry &entry,
+                  const HedgedOutcomeWaiter &waiter,
+                  const std::function<void(size_t, JobPriority, const shared_ptr<JobTie> &)> &submit,
+                  RequestTraceRecorder *trace) {
+	const auto start = std::chrono::steady_clock::now();
+	const auto tie = config.enable_tied_requests ? make_shared_ptr<JobTie>() : nullptr;
+	// Guards attempt submission, which happens on the scheduler thread on deadline, and on the caller thread on failure
+	// in first-success mode.
+	concurrency::mutex submit_mu;
+	size_t attempt_count = 0;
+	auto submit_next = [&](JobPriority priority) {
+		if (trace != nullptr) {
+			trace->OnAttemptSubmitted(attempt_count);
+		}
+		submit(attempt_count++, priority, tie);
 	};
+	submit_next(JobPriority::PRIMARY);
+	const bool can_hedge = attempt_count < config.max_hedged_request_count;
+	if (can_hedge && tie != nullptr && entry.GetThreadPool().IsSaturated()) {
+		submit_next(JobPriority::PRIMARY);
+	}
 
-	submit();
+	const auto hedged_request_delay = entry.GetHedgingDelay(config, operation);
+	entry.OnPrimaryRequest(config, operation);
 
-	auto config = entry->GetConfig();
+	// The timer is cancelled before return, which waits for a running callback, so it's safe to reference local states.
+	auto on_deadline = [&](HedgeScheduler::Clock::time_point &next_deadline) {
+		if (waiter.is_ready()) {
+			return false;
+		}
+		const concurrency::lock_guard<concurrency::mutex> submit_lock(submit_mu);
+		if (ShouldHedgeOnDeadline(operation, config, entry, tie, attempt_count)) {
+			submit_next(JobPriority::HEDGE);
+		}
+		if (!ShouldRearmDeadline(config, tie, attempt_count)) {
+			return false;
+		}
+		next_deadline = HedgeScheduler::Clock::now() + hedged_request_delay;
+		return true;
+	};
 
-	// Keep spawning hedged requests at threshold intervals until one completes or max count reached.
-	while (true) {
-		{
-			concurrency::unique_lock<concurrency::mutex> lock(token->mu);
-			token->cv.wait_for(lock, hedged_request_delay,
-			                   [&token]() DUCKDB_REQUIRES(token->mu) { return token->completed; });
-			if (token->completed) {
+	auto &scheduler = entry.GetHedgeScheduler();
+	// Scheduled by reference, which doesn't allocate.
+	const auto timer_id = can_hedge ? scheduler.Schedule(start + hedged_request_delay, std::ref(on_deadline)) : 0;
+	bool decided_by_caller = false;
+	if (waiter.wait_for_settled == nullptr) {
+		waiter.wait();
+	} else {
+		HedgedSettledAttempts seen;
+		while (true) {
+			auto settled = waiter.wait_for_settled(seen);
+			if (waiter.is_ready()) {
+				break;
+			}
+			const concurrency::lock_guard<concurrency::mutex> submit_lock(submit_mu);
+			const auto hedge_count = GetRetryHedgeCount(operation, config, entry, seen, settled, attempt_count);
+			for (size_t idx = 0; idx < hedge_count; ++idx) {
+				submit_next(JobPriority::HEDGE);
+			}
+			seen = std::move(settled);
+			// Only attempts which neither failed nor were skipped yet could still succeed.
+			if (attempt_count == seen.GetCount()) {
+				decided_by_caller = waiter.fail();
 				break;
 			}
 		}
+	}
+	if (can_hedge) {
+		scheduler.Cancel(timer_id);
+	}
+	// No hedge is submitted after the timer is cancelled.
+	ScopedHedgeCounter::Record(attempt_count - 1);
+	entry.GetStats()->RecordLatency(operation, GetElapsedMicros(start));
+	if (trace != nullptr) {
+		trace->OnRequestReturned(attempt_count, decided_by_caller);
+	}
+}
 
-		// We've reached upper bound, so don't spawn new hedged requests, simply wait for the first completed request.
-		if (job_futures.size() >= config.max_hedged_request_count) {
-			continue;
+// Get a waiter for [WaitAndHedge], which waits until an outcome is recorded into [token].
+template <typename T>
+HedgedOutcomeWaiter GetOutcomeWaiter(HedgedOutcomeToken<T> &token) {
+	HedgedOutcomeWaiter waiter;
+	waiter.is_ready = [&token]() {
+		const concurrency::lock_guard<concurrency::mutex> lock(token.mu);
+		return token.completed;
+	};
+	waiter.wait = [&token]() {
+		concurrency::unique_lock<concurrency::mutex> lock(token.mu);
+		token.cv.wait(lock, [&token]() DUCKDB_REQUIRES(token.mu) { return token.completed; });
+	};
+	if (token.first_success_wins) {
+		waiter.wait_for_settled = [&token](const HedgedSettledAttempts &seen) {
+			return WaitForSettledAttempts(token, seen);
+		};
+		waiter.fail = [&token]() { return FailHedgedOutcome(token); };
+	}
+	return waiter;
+}
+
+// Callback receiving successful results of losing attempts, which never applies to void requests.
+template <typename T>
+struct DiscardedResultCallback {
+	using type = std::function<void(T)>;
+};
+template <>
+struct DiscardedResultCallback<void> {
+	using type = std::function<void()>;
+};
+
+// State of a hedged request shared by all its attempts, which is allocated once per request: each attempt only
+// captures a pointer to it along with its attempt index, so attempts are submitted without allocation. Attempts which
+// lose the race keep it alive until they finish.
+template <typename T, typename Fn>
+struct HedgedCallState {
+	HedgedCallState(Fn fn_p, HedgedRequestOperation operation_p, HedgedRequestFsEntry &entry,
+	                typename DiscardedResultCallback<T>::type on_discarded_p)
+	    : fn(std::move(fn_p)), operation(operation_p), latency_tracker(entry.GetLatencyTracker()),
+	      stats(entry.GetStats()), on_discarded(std::move(on_discarded_p)) {
+	}
+
+	// Run the attempt of [attempt_idx] and record its outcome into [token], return whether it wins.
+	bool RunAttempt(size_t attempt_idx) {
+		const bool won = RunAttempt(attempt_idx, std::is_void<T> {});
+		if (won && trace != nullptr) {
+			trace->OnAttemptWon(attempt_idx);
 		}
+		return won;
+	}
 
-		submit();
+	HedgedOutcomeToken<T> token;
+	// Invoked with the attempt index, possibly by several attempts concurrently.
+	const Fn fn;
+	const HedgedRequestOperation operation;
+	const shared_ptr<LatencyTracker> latency_tracker;
+	const shared_ptr<HedgedRequestStats> stats;
+	// Receives successful results of losing attempts, if provided.
+	const typename DiscardedResultCallback<T>::type on_discarded;
+	RequestTraceRecorder trace_recorder;
+	// Points to [trace_recorder] if the request is traced, set before any attempt is submitted.
+	RequestTraceRecorder *trace = nullptr;
+
+private:
+	bool RunAttempt(size_t attempt_idx, std::false_type /*is_void*/) {
+		return RunHedgedJob(
+		    [this, attempt_idx]() {
+			    return RunInstrumentedAttempt([this, attempt_idx]() { return fn(attempt_idx); }, operation,
+			                                  *latency_tracker, *stats, trace, attempt_idx);
+		    },
+		    token, on_discarded);
+	}
+	bool RunAttempt(size_t attempt_idx, std::true_type /*is_void*/) {
+		return RunHedgedVoidJob(
+		    [this, attempt_idx]() {
+			    RunInstrumentedAttempt([this, attempt_idx]() { fn(attempt_idx); }, operation, *latency_tracker,
+			                           *stats, trace, attempt_idx);
+		    },
+		    token);
 	}
+};
+
+// Run the primary attempt of a call on the caller thread without hedging. Its latency still feeds the latency sketch,
+// so a regressed backend pushes the tail up and later calls go back to the hedged path.
+template <typename T, typename Fn>
+T RunInlineRequest(Fn &fn, HedgedRequestOperation operation, const HedgedRequestConfig &config,
+                   HedgedRequestFsEntry &entry) {
+	// Call latency is recorded on failure as well, as for hedged calls.
+	struct CallLatencyGuard {
+		HedgedRequestStats &stats;
+		HedgedRequestOperation operation;
+		std::chrono::steady_clock::time_point start;
+		~CallLatencyGuard() {
+			stats.RecordLatency(operation, GetElapsedMicros(start));
+		}
+	};
+	auto &stats = *entry.GetStats();
+	stats.RecordPrimaryRequest(operation);
+	stats.RecordInlineRequest(operation);
+	entry.OnPrimaryRequest(config, operation);
+	CallLatencyGuard guard {stats, operation, std::chrono::steady_clock::now()};
+	return RunInstrumentedAttempt([&fn]() { return fn(0); }, operation, *entry.GetLatencyTracker(), stats,
+	                              /*trace=*/nullptr, /*attempt_idx=*/0);
+}
 
-	auto drain_pending_futures = [&]() {
-		for (auto &fut : job_futures) {
-			auto pending_fut = std::make_shared<std::future<void>>(std::move(fut));
-			entry->AddPendingRequest([pending_fut]() { pending_fut->wait(); });
+// Issue a hedged request on [path], where each attempt receives its index: 0 for the primary attempt, then increasing
+// for hedged attempts. [on_discarded] receives successful results of losing attempts, if provided.
+//
+// The call runs inline instead, if the operation's observed latency never gets near the hedging delay.
+template <typename T, typename Fn>
+T HedgedRequestByAttempt(Fn &&fn, HedgedRequestOperation operation, const string &path,
+                         const HedgedRequestConfig &config, const shared_ptr<HedgedRequestFsEntry> &entry,
+                         typename DiscardedResultCallback<T>::type on_discarded = nullptr) {
+	if (entry->ShouldRunInline(config, operation)) {
+		return RunInlineRequest<T>(fn, operation, config, *entry);
+	}
+	using CallState = HedgedCallState<T, typename std::decay<Fn>::type>;
+	auto state = make_shared_ptr<CallState>(std::forward<Fn>(fn), operation, *entry, std::move(on_discarded));
+	state->token.first_success_wins = config.enable_first_success_wins;
+	if (config.enable_request_trace) {
+		state->trace = &state->trace_recorder;
+		state->trace->Begin(entry->GetRequestTrace(), operation, path);
+	}
+	auto submit = [&entry, &state](size_t attempt_idx, JobPriority priority, const shared_ptr<JobTie> &tie) {
+		SubmitHedgedAttempt(
+		    *entry, state->operation, attempt_idx, priority, tie,
+		    [state, attempt_idx]() { return state->RunAttempt(attempt_idx); },
+		    [state]() { RecordHedgedSkip(state->token); });
+	};
+	// Passed by reference, which doesn't allocate; it's only invoked before [WaitAndHedge] returns.
+	WaitAndHedge(operation, config, *entry, GetOutcomeWaiter(state->token), std::cref(submit), state->trace);
+
+	// Losing attempts keep running in background, and deregister from the entry themselves once they finish.
+	return WaitForHedgedOutcome(state->token);
+}
+
+// [on_discarded] receives successful results of losing attempts, if provided.
+template <typename T, typename Fn>
+typename std::enable_if<!std::is_void<T>::value, T>::type
+HedgedRequest(Fn &&fn, HedgedRequestOperation operation, const string &path, const HedgedRequestConfig &config,
+              const shared_ptr<HedgedRequestFsEntry> &entry, std::function<void(T)> on_discarded = nullptr) {
+	return HedgedRequestByAttempt<T>([fn = std::forward<Fn>(fn)](size_t) { return fn(); }, operation, path, config,
+	                                 entry, std::move(on_discarded));
+}
+
+template <typename Fn>
+void HedgedRequest(Fn &&fn, HedgedRequestOperation operation, const string &path, const HedgedRequestConfig &config,
+                   const shared_ptr<HedgedRequestFsEntry> &entry) {
+	HedgedRequestByAttempt<void>([fn = std::forward<Fn>(fn)](size_t) { fn(); }, operation, path, config, entry);
+}
+
+// Receives the outcome token of a hedged request started by [StartHedgedRequestByAttempt] once the outcome is decided,
+// so [WaitForHedgedOutcome] takes it without blocking.
+template <typename T>
+using HedgedCompletion = std::function<void(HedgedOutcomeToken<T> &)>;
+
+// Hedged request which doesn't block any thread while it's in flight: attempts are submitted by the starting thread,
+// hedges on deadline by the hedge scheduler, retries in first-success mode by the attempt which failed, and
+// [on_complete] runs on the thread pool once the outcome is decided. It serves callers issuing several hedged requests
+// at once, and requests issued from within thread pool jobs, since a job blocking on attempts queued behind it in the
+// same pool deadlocks once the pool runs at its max thread count.
+//
+// The state keeps itself alive until the outcome is decided and its timer is cancelled, so the scheduler only holds a
+// raw pointer and never drops the last reference on its own thread. Losing attempts keep it alive until they finish.
+template <typename T, typename Fn>
+struct AsyncHedgedCall {
+	AsyncHedgedCall(Fn fn, HedgedRequestOperation operation, const HedgedRequestConfig &config_p,
+	                shared_ptr<HedgedRequestFsEntry> entry_p, HedgedCompletion<T> on_complete_p)
+	    : call(std::move(fn), operation, *entry_p, /*on_discarded_p=*/nullptr), config(config_p),
+	      entry(std::move(entry_p)), on_complete(std::move(on_complete_p)),
+	      tie(config.enable_tied_requests ? make_shared_ptr<JobTie>() : nullptr) {
+		call.token.first_success_wins = config.enable_first_success_wins;
+	}
+
+	// Submit the primary attempt of [self] in the [priority] class, and schedule its hedge deadline.
+	static void Start(const shared_ptr<AsyncHedgedCall> &self, JobPriority priority) {
+		auto &state = *self;
+		state.start = std::chrono::steady_clock::now();
+		state.hedging_delay = state.entry->GetHedgingDelay(state.config, state.call.operation);
+		bool can_hedge = false;
+		{
+			const concurrency::lock_guard<concurrency::mutex> submit_lock(state.submit_mu);
+			state.keep_alive = self;
+			state.SubmitNext(priority);
+			can_hedge = state.attempt_count < state.config.max_hedged_request_count;
+			if (can_hedge && state.tie != nullptr && state.entry->GetThreadPool().IsSaturated()) {
+				state.SubmitNext(priority);
+			}
+		}
+		state.entry->OnPrimaryRequest(state.config, state.call.operation);
+		if (!can_hedge) {
+			return;
+		}
+
+		auto &scheduler = state.entry->GetHedgeScheduler();
+		auto *state_ptr = &state;
+		const auto timer_id = scheduler.Schedule(state.start + state.hedging_delay,
+		                                         [state_ptr](HedgeScheduler::Clock::time_point &next_deadline) {
+			                                         return state_ptr->OnDeadline(next_deadline);
+		                                         });
+		bool finished = false;
+		{
+			const concurrency::lock_guard<concurrency::mutex> submit_lock(state.submit_mu);
+			finished = state.finished;
+			if (!finished) {
+				state.timer_id = timer_id;
+			}
+		}
+		// The outcome is decided before the timer is known to [Finish], [self] keeps the state alive meanwhile.
+		if (finished) {
+			scheduler.Cancel(timer_id);
+		}
+	}
+
+private:
+	// Submit the next attempt in the [priority] class.
+	void SubmitNext(JobPriority priority) DUCKDB_REQUIRES(submit_mu) {
+		const auto attempt_idx = attempt_count++;
+		if (call.trace != nullptr) {
+			call.trace->OnAttemptSubmitted(attempt_idx);
+		}
+		SubmitHedgedAttempt(
+		    *entry, call.operation, attempt_idx, priority, tie,
+		    [self = keep_alive, attempt_idx]() { return self->RunAttempt(attempt_idx); },
+		    [self = keep_alive]() { self->OnSkipped(); });
+	}
+
+	bool RunAttempt(size_t attempt_idx) {
+		const bool won = call.RunAttempt(attempt_idx);
+		if (won) {
+			Finish(/*decided_by_caller=*/false);
+		} else if (call.token.first_success_wins) {
+			OnSettled();
+		}
+		return won;
+	}
+
+	void OnSkipped() {
+		RecordHedgedSkip(call.token);
+		if (call.token.first_success_wins) {
+			OnSettled();
+		}
+	}
+
+	// Invoked on the scheduler thread on the hedge deadline, return whether to re-arm it.
+	bool OnDeadline(HedgeScheduler::Clock::time_point &next_deadline) {
+		const concurrency::lock_guard<concurrency::mutex> submit_lock(submit_mu);
+		if (finished || IsOutcomeDecided()) {
+			return false;
+		}
+		if (ShouldHedgeOnDeadline(call.operation, config, *entry, tie, attempt_count)) {
+			SubmitNext(JobPriority::HEDGE);
+		}
+		if (!ShouldRearmDeadline(config, tie, attempt_count)) {
+			return false;
 		}
-		job_futures.clear();
+		next_deadline = HedgeScheduler::Clock::now() + hedging_delay;
+		return true;
+	}
+
+	// In first-success mode, hedge retryable failures right away, and fail the request once no attempt is left which
+	// could succeed.
+	void OnSettled() {
+		{
+			const concurrency::lock_guard<concurrency::mutex> submit_lock(submit_mu);
+			if (finished) {
+				return;
+			}
+			HedgedSettledAttempts settled;
+			{
+				const concurrency::lock_guard<concurrency::mutex> token_lock(call.token.mu);
+				// The winner finishes the request itself.
+				if (call.token.completed) {
+					return;
+				}
+				settled = call.token.settled;
+			}
+			// Attempts settle concurrently, a stale view has been handled already.
+			if (settled.GetCount() <= seen.GetCount()) {
+				return;
+			}
+			const auto hedge_count = GetRetryHedgeCount(call.operation, config, *entry, seen, settled, attempt_count);
+			for (size_t idx = 0; idx < hedge_count; ++idx) {
+				SubmitNext(JobPriority::HEDGE);
+			}
+			seen = std::move(settled);
+			// Only attempts which neither failed nor were skipped yet could still succeed.
+			if (attempt_count != seen.GetCount()) {
+				return;
+			}
+		}
+		Finish(FailHedgedOutcome(call.token));
+	}
+
+	bool IsOutcomeDecided() {
+		const concurrency::lock_guard<concurrency::mutex> token_lock(call.token.mu);
+		return call.token.completed;
+	}
+
+	// Invoked once the outcome is decided, only the first invocation takes effect.
+	void Finish(bool decided_by_caller) {
+		uint64_t pending_timer_id = 0;
+		size_t submitted_count = 0;
+		// Released on return, the caller holds its own reference.
+		shared_ptr<AsyncHedgedCall> self;
+		{
+			const concurrency::lock_guard<concurrency::mutex> submit_lock(submit_mu);
+			if (finished) {
+				return;
+			}
+			finished = true;
+			pending_timer_id = timer_id;
+			submitted_count = attempt_count;
+			self = std::move(keep_alive);
+		}
+		// No hedge is submitted after the timer is cancelled.
+		if (pending_timer_id != 0) {
+			entry->GetHedgeScheduler().Cancel(pending_timer_id);
+		}
+		entry->GetStats()->RecordLatency(call.operation, GetElapsedMicros(start));
+		if (call.trace != nullptr) {
+			call.trace->OnRequestReturned(submitted_count, decided_by_caller);
+		}
+		on_complete(call.token);
+	}
+
+public:
+	HedgedCallState<T, Fn> call;
+
+private:
+	const HedgedRequestConfig config;
+	const shared_ptr<HedgedRequestFsEntry> entry;
+	const HedgedCompletion<T> on_complete;
+	const shared_ptr<JobTie> tie;
+	// Set before the primary attempt is submitted.
+	std::chrono::steady_clock::time_point start;
+	std::chrono::milliseconds hedging_delay {0};
+
+	// Guards attempt submission, which happens on the starting thread, the scheduler thread on deadline, and on the
+	// thread pool on failure in first-success mode.
+	concurrency::mutex submit_mu;
+	size_t attempt_count DUCKDB_GUARDED_BY(submit_mu) = 0;
+	HedgedSettledAttempts seen DUCKDB_GUARDED_BY(submit_mu);
+	// Id of the hedge deadline timer, 0 if not scheduled.
+	uint64_t timer_id DUCKDB_GUARDED_BY(submit_mu) = 0;
+	bool finished DUCKDB_GUARDED_BY(submit_mu) = false;
+	shared_ptr<AsyncHedgedCall> keep_alive DUCKDB_GUARDED_BY(submit_mu);
+};
+
+// Start a hedged request on [path] without blocking, where each attempt receives its index; [on_complete] receives
+// the outcome on the thread pool once it's decided. The primary attempt is queued in the [priority] class. Unlike
+// [HedgedRequestByAttempt], the request never runs inline, since that would block the starting thread.
+template <typename T, typename Fn>
+void StartHedgedRequestByAttempt(Fn &&fn, HedgedRequestOperation operation, const string &path,
+                                 const HedgedRequestConfig &config, const shared_ptr<HedgedRequestFsEntry> &entry,
+                                 HedgedCompletion<T> on_complete, JobPriority priority = JobPriority::PRIMARY) {
+	using Call = AsyncHedgedCall<T, typename std::decay<Fn>::type>;
+	auto call = make_shared_ptr<Call>(std::forward<Fn>(fn), operation, config, entry, std::move(on_complete));
+	if (config.enable_request_trace) {
+		call->call.trace = &call->call.trace_recorder;
+		call->call.trace->Begin(entry->GetRequestTrace(), operation, path);
+	}
+	Call::Start(call, priority);
+}
+
+template <typename T, typename Fn>
+void StartHedgedRequest(Fn &&fn, HedgedRequestOperation operation, const string &path,
+                        const HedgedRequestConfig &config, const shared_ptr<HedgedRequestFsEntry> &entry,
+                        HedgedCompletion<T> on_complete) {
+	StartHedgedRequestByAttempt<T>([fn = std::forward<Fn>(fn)](size_t) -> T { return fn(); }, operation, path, config,
+	                               entry, std::move(on_complete));
+}
+
+// Hedged requests started together by one caller, which blocks in its own wait until they complete instead of
+// waiting from thread pool jobs. The first failure is kept. Completions reference the group, so it waits for all
+// requests on destruction.
+class HedgedRequestGroup {
+public:
+	// At most [max_in_flight_p] requests are in flight at once.
+	explicit HedgedRequestGroup(idx_t max_in_flight_p = UINT64_MAX)
+	    : max_in_flight(MaxValue<idx_t>(max_in_flight_p, 1)) {
+	}
+	~HedgedRequestGroup() {
+		WaitForInFlight(0);
+	}
+
+	HedgedRequestGroup(const HedgedRequestGroup &) = delete;
+	HedgedRequestGroup &operator=(const HedgedRequestGroup &) = delete;
+
+	// Block until fewer than the max requests are in flight, then account a new one. Return false without accounting
+	// it once a request has failed, since the group fails anyway.
+	bool Add() {
+		concurrency::unique_lock<concurrency::mutex> lock(mu);
+		cv.wait(lock, [this]() DUCKDB_REQUIRES(mu) { return in_flight < max_in_flight || eptr != nullptr; });
+		if (eptr != nullptr) {
+			return false;
+		}
+		++in_flight;
+		return true;
+	}
+
+	// Account a completed request, which failed with [failure] unless it's nullptr.
+	void Done(std::exception_ptr failure = nullptr) {
+		const concurrency::lock_guard<concurrency::mutex> lock(mu);
+		if (eptr == nullptr) {
+			eptr = std::move(failure);
+		}
+		--in_flight;
+		// Notified under lock, since the group might go away as soon as the waiter wakes up.
+		cv.notify_all();
+	}
+
+	// Block until all requests complete, and rethrow the first failure if any.
+	void Wait() {
+		WaitForInFlight(0);
+		const concurrency::lock_guard<concurrency::mutex> lock(mu);
+		if (eptr != nullptr) {
+			std::rethrow_exception(eptr);
+		}
+	}
+
+private:
+	void WaitForInFlight(idx_t max_count) {
+		concurrency::unique_lock<concurrency::mutex> lock(mu);
+		cv.wait(lock, [this, max_count]() DUCKDB_REQUIRES(mu) { return in_flight <= max_count; });
+	}
+
+	const idx_t max_in_flight;
+	concurrency::mutex mu;
+	std::condition_variable cv DUCKDB_GUARDED_BY(mu);
+	idx_t in_flight DUCKDB_GUARDED_BY(mu) = 0;
+	std::exception_ptr eptr DUCKDB_GUARDED_BY(mu);
+};
+
+// Make an attempt function for [HedgedRequestByAttempt], which issues [request] on [path] for the primary attempt,
+// while hedged attempts rotate through [replica_paths]. A failed replica attempt falls back to [path], so a broken
+// mirror degrades into a plain hedge instead of failing the request.
+template <typename T, typename Request>
+auto MakeReplicaAttempt(string path, vector<string> replica_paths, Request request) {
+	return [path = std::move(path), replica_paths = std::move(replica_paths),
+	        request = std::move(request)](size_t attempt_idx) -> T {
+		if (attempt_idx == 0 || replica_paths.empty()) {
+			return request(path);
+		}
+		const auto &replica_path = replica_paths[(attempt_idx - 1) % replica_paths.size()];
+		try {
+			return request(replica_path);
+		} catch (...) {
+			auto cancellation = CancellationToken::GetCurrent();
+			if (cancellation != nullptr && cancellation->IsCancelled()) {
+				throw;
+			}
+		}
+		return request(path);
+	};
+}
+
+// Make an attempt function for a hedged positional read of [nr_bytes] at [location] from [wrapped_handle], which reads
+// into its own pooled scratch buffer, so a losing attempt never touches the caller's buffer.
+auto MakeScratchRead(FileSystem &wrapped_fs, shared_ptr<FileHandle> wrapped_handle,
+                     shared_ptr<ReadBufferPool> buffer_pool, int64_t nr_bytes, idx_t location) {
+	// Capture shared pointer to make sure it's always valid on access.
+	return [fs_ptr = &wrapped_fs, wrapped_handle = std::move(wrapped_handle), buffer_pool = std::move(buffer_pool),
+	        nr_bytes, location]() {
+		auto attempt_buffer = buffer_pool->Acquire(NumericCast<idx_t>(nr_bytes));
+		fs_ptr->Read(*wrapped_handle, attempt_buffer.GetData(), nr_bytes, location);
+		return attempt_buffer;
+	};
+}
+
+// Abort a listing attempt which has lost the race, or whose stream has been closed by the caller.
+[[noreturn]] void ThrowListingAborted() {
+	throw IOException("HedgedFileSystem: listing attempt aborted");
+}
+
+// Start a hedged listing race on [path] streaming into [stream], and block until the race is decided, after which the
+// caller consumes pages of the winner from [stream]. [list] lists entries of one attempt into the given writer, and
+// returns the listing result.
+template <typename T>
+void HedgedListing(shared_ptr<ListingStream<T>> stream, std::function<bool(ListingPageWriter<T> &)> list,
+                   HedgedRequestOperation operation, const string &path, const HedgedRequestConfig &config,
+                   shared_ptr<HedgedRequestFsEntry> entry) {
+	auto latency_tracker = entry->GetLatencyTracker();
+	auto stats = entry->GetStats();
+	// Attempts already capture the stream and their own cancellation token, the recorder is allocated along with them.
+	shared_ptr<RequestTraceRecorder> trace;
+	if (config.enable_request_trace) {
+		trace = make_shared_ptr<RequestTraceRecorder>();
+		trace->Begin(entry->GetRequestTrace(), operation, path);
+	}
+	HedgedOutcomeWaiter waiter;
+	waiter.is_ready = [&stream]() { return stream->HasWinner(); };
+	waiter.wait = [&stream]() { stream->WaitForWinner(); };
+	auto submit = [&](size_t attempt_idx, JobPriority priority, const shared_ptr<JobTie> &tie) {
+		// Each attempt has its own cancellation token, which is cancelled once it loses the race.
+		auto cancellation = make_shared_ptr<CancellationToken>();
+		const auto attempt_id = stream->AddAttempt(cancellation);
+		auto run_job = [stream, list, attempt_id, attempt_idx, cancellation, operation, latency_tracker, stats,
+		                trace]() {
+			if (cancellation->IsCancelled()) {
+				return false;
+			}
+			ScopedCancellationToken scoped_cancellation(cancellation.get());
+			bool won = false;
+			try {
+				const bool listed = RunInstrumentedAttempt(
+				    [&]() {
+					    ListingPageWriter<T> writer(*stream, attempt_id);
+					    const bool listed = list(writer);
+					    writer.Flush();
+					    return listed;
+				    },
+				    operation, *latency_tracker, *stats, trace.get(), attempt_idx);
+				won = stream->Finish(attempt_id, listed, nullptr);
+			} catch (...) {
+				won = stream->Finish(attempt_id, /*listed=*/false, std::current_exception());
+			}
+			if (won && trace != nullptr) {
+				trace->OnAttemptWon(attempt_idx);
+			}
+			return won;
+		};
+		SubmitHedgedAttempt(*entry, operation, attempt_idx, priority, tie, std::move(run_job), []() {});
 	};
+	WaitAndHedge(operation, config, *entry, waiter, std::cref(submit), trace.get());
+}
 
+// Close the stream on scope exit, so attempts stop once the caller stops consuming, e.g. when the callback throws.
+template <typename T>
+struct ListingStreamCloser {
+	shared_ptr<ListingStream<T>> stream;
+	~ListingStreamCloser() {
+		stream->Close();
+	}
+};
+
+// Glob result which expands lazily, page by page from the winning hedged glob attempt.
+class HedgedGlobFileList : public LazyMultiFileList {
+public:
+	// [on_page_p] is invoked with every page before it's appended, if provided.
+	HedgedGlobFileList(shared_ptr<ListingStream<OpenFileInfo>> stream_p,
+	                   std::function<void(const vector<OpenFileInfo> &)> on_page_p)
+	    : LazyMultiFileList(/*context=*/nullptr), stream(std::move(stream_p)), on_page(std::move(on_page_p)) {
+	}
+	~HedgedGlobFileList() override {
+		stream->Close();
+	}
+
+protected:
+	bool ExpandNextPath() const override {
+		ListingStream<OpenFileInfo>::Page page;
+		if (!stream->Next(page)) {
+			return false;
+		}
+		if (on_page) {
+			on_page(page);
+		}
+		for (auto &cur_file : page) {
+			expanded_files.emplace_back(std::move(cur_file));
+		}
+		return true;
+	}
+
+private:
+	shared_ptr<ListingStream<OpenFileInfo>> stream;
+	std::function<void(const vector<OpenFileInfo> &)> on_page;
+};
+
+// Prefetched handles are opened read-only, and only handed out to opens with exactly the same flags.
+bool CanUsePrefetchedHandle(FileOpenFlags flags) {
+	return flags.GetFlagsInternal() == FileFlags::FILE_FLAGS_READ.GetFlagsInternal() &&
+	       flags.Lock() == FileLockType::NO_LOCK && flags.Compression() == FileCompressionType::UNCOMPRESSED;
+}
+
+// Pooled handles are opened without lock or compression, and must not modify the file.
+bool CanPoolHandle(FileOpenFlags flags) {
+	return !flags.OpenForWriting() && flags.Lock() == FileLockType::NO_LOCK &&
+	       flags.Compression() == FileCompressionType::UNCOMPRESSED;
+}
+
+// Keep [handle] opened by [wrapped_fs] with [flags] in the handle pool of [entry] under [key], after rewinding it,
+// return whether it's pooled. It doesn't reference the hedged filesystem, so losing attempts can pool their handles
+// after it's gone.
+bool PoolWrappedHandle(HedgedRequestFsEntry &entry, FileSystem &wrapped_fs, const string &key, FileOpenFlags flags,
+                       shared_ptr<FileHandle> handle) {
+	auto &pool = entry.GetFileHandlePool();
+	if (handle == nullptr || !pool.IsEnabled() || !CanPoolHandle(flags)) {
+		return false;
+	}
+	PooledHandleVersion version;
 	try {
-		WaitForHedgedOutcome(token);
+		// Non-positional reads of the next owner start from the beginning of the file.
+		wrapped_fs.Reset(*handle);
+		version.version_tag = wrapped_fs.GetVersionTag(*handle);
+		version.last_modified_time = wrapped_fs.GetLastModifiedTime(*handle);
 	} catch (...) {
-		drain_pending_futures();
-		throw;
+		// Not reusable, e.g. it cannot be rewound.
+		return false;
 	}
-	drain_pending_futures();
+	pool.Put(key, flags.GetFlagsInternal(), std::move(handle), std::move(version));
+	return true;
+}
+
+// Outcome of a ListFiles attempt, each attempt collects entries on its own.
+struct ListFilesResult {
+	bool success = false;
+	vector<std::pair<string, bool>> entries;
+};
+
+// Make an attempt function listing [directory] of [wrapped_fs] into a [ListFilesResult].
+auto MakeListFilesAttempt(FileSystem &wrapped_fs, string directory, shared_ptr<FileOpener> opener) {
+	return [fs_ptr = &wrapped_fs, directory = std::move(directory), opener = std::move(opener)]() {
+		ListFilesResult attempt_result;
+		attempt_result.success = fs_ptr->ListFiles(
+		    directory,
+		    [&attempt_result](const string &name, bool is_dir) { attempt_result.entries.emplace_back(name, is_dir); },
+		    opener.get());
+		return attempt_result;
+	};
 }
+
 } // namespace
 
 //===--------------------------------------------------------------------===//
 // HedgedFileSystem
 //===--------------------------------------------------------------------===//
 
-HedgedFileSystem::HedgedFileSystem(unique_ptr<FileSystem> wrapped_fs_p, shared_ptr<HedgedRequestFsEntry> entry_p)
-    : wrapped_fs(std::move(wrapped_fs_p)), entry(std::move(entry_p)) {
+HedgedFileSystem::HedgedFileSystem(unique_ptr<FileSystem> wrapped_fs_p, shared_ptr<HedgedRequestFsEntry> entry_p,
+                                   shared_ptr<MetadataCache> metadata_cache_p,
+                                   shared_ptr<ListingCache> listing_cache_p)
+    : wrapped_fs(std::move(wrapped_fs_p)), entry(std::move(entry_p)), metadata_cache(std::move(metadata_cache_p)),
+      listing_cache(std::move(listing_cache_p)) {
 	if (!this->wrapped_fs) {
 		throw InternalException("HedgedFileSystem: wrapped_fs cannot be null");
 	}
 	if (!this->entry) {
 		throw InternalException("HedgedFileSystem: entry cannot be null");
 	}
+	wrapped_fs_name = this->wrapped_fs->GetName();
 }
 
 HedgedFileSystem::~HedgedFileSystem() {
+	// Prefetched and pooled handles belong to the wrapped filesystem, which goes away along with this one.
+	entry->GetOpenPrefetchCache().ErasePrefix(GetHandleCacheKey(/*path=*/""));
+	entry->GetFileHandlePool().ErasePrefix(GetHandleCacheKey(/*path=*/""));
+	// Attempts still running on the wrapped filesystem are abandoned by the entry, which keeps it alive until they're
+	// done.
+	if (entry->GetInFlightAttemptCount() > 0) {
+		entry->RetainWrappedFileSystem(std::move(wrapped_fs));
+	}
+}
+
+HedgedRequestConfig HedgedFileSystem::GetRequestConfig(const string &path) const {
+	return entry->GetConfig(wrapped_fs_name, path);
+}
+
+MetadataCache *HedgedFileSystem::GetMetadataCache() const {
+	if (metadata_cache == nullptr || !metadata_cache->IsEnabled()) {
+		return nullptr;
+	}
+	return metadata_cache.get();
+}
+
+void HedgedFileSystem::InvalidateMetadata(const string &path) const {
+	auto *cache = GetMetadataCache();
+	if (cache != nullptr) {
+		cache->Invalidate(path);
+	}
+	entry->GetOpenPrefetchCache().Erase(GetHandleCacheKey(path));
+	entry->GetFileHandlePool().Erase(GetHandleCacheKey(path));
+}
+
+ListingCache *HedgedFileSystem::GetListingCache() const {
+	if (listing_cache == nullptr || !listing_cache->IsEnabled()) {
+		return nullptr;
+	}
+	return listing_cache.get();
+}
+
+void HedgedFileSystem::InvalidateListing(const string &path) const {
+	auto *cache = GetListingCache();
+	if (cache != nullptr) {
+		cache->Invalidate(path);
+	}
+}
+
+vector<string> HedgedFileSystem::GetReplicaPaths(const string &path) const {
+	return entry->GetConfigSnapshot()->ResolveReplicaPaths(path);
+}
+
+string HedgedFileSystem::GetHandleCacheKey(const string &path) const {
+	return StringUtil::Format("%s|%s", wrapped_fs_name, path);
+}
+
+bool HedgedFileSystem::CanPoolHandles() const {
+	// Pooled handles only know the file version they were opened on, so they're reused only on a file version known
+	// to be current from the metadata cache.
+	return entry->GetFileHandlePool().IsEnabled() && GetMetadataCache() != nullptr;
+}
+
+bool HedgedFileSystem::PoolHandle(const string &path, FileOpenFlags flags, shared_ptr<FileHandle> handle) {
+	if (!CanPoolHandles()) {
+		return false;
+	}
+	return PoolWrappedHandle(*entry, *wrapped_fs, GetHandleCacheKey(path), flags, std::move(handle));
+}
+
+shared_ptr<FileHandle> HedgedFileSystem::TakePooledHandle(const string &path, FileOpenFlags flags) {
+	auto *cache = GetMetadataCache();
+	return entry->GetFileHandlePool().TryTake(
+	    GetHandleCacheKey(path), flags.GetFlagsInternal(), [cache, &path](const PooledHandleVersion &version) {
+		    // Without a known current version the file may have changed since the handle was pooled.
+		    if (cache == nullptr) {
+			    return false;
+		    }
+		    string version_tag;
+		    if (!version.version_tag.empty() && cache->TryGetVersionTag(path, version_tag)) {
+			    return version_tag == version.version_tag;
+		    }
+		    timestamp_t last_modified_time;
+		    if (cache->TryGetLastModifiedTime(path, last_modified_time)) {
+			    return last_modified_time == version.last_modified_time;
+		    }
+		    return false;
+	    });
+}
+
+void HedgedFileSystem::PrefetchOpenFiles(const vector<OpenFileInfo> &files, idx_t file_count,
+                                         const shared_ptr<FileOpener> &opener) {
+	auto &cache = entry->GetOpenPrefetchCache();
+	auto *fs_ptr = wrapped_fs.get();
+	auto request_entry = entry;
+	auto metadata_cache_ptr = metadata_cache;
+	const auto prefetch_count = MinValue<idx_t>(file_count, files.size());
+	for (idx_t idx = 0; idx < prefetch_count; ++idx) {
+		const auto &path = files[idx].path;
+		auto key = GetHandleCacheKey(path);
+		if (!cache.TryStartPrefetch(key)) {
+			continue;
+		}
+		const auto config = GetRequestConfig(path);
+		auto open_file = MakeReplicaAttempt<unique_ptr<FileHandle>>(
+		    path, GetReplicaPaths(path), [fs_ptr, opener](const string &attempt_path) {
+			    return fs_ptr->OpenFile(attempt_path, FileFlags::FILE_FLAGS_READ, opener.get());
+		    });
+		// Stat along with the open, so metadata calls on the opened file are served by the metadata cache.
+		auto open_and_stat = [fs_ptr, path_copy = path, open_file = std::move(open_file),
+		                      metadata_cache_ptr](size_t attempt_idx) {
+			auto handle = open_file(attempt_idx);
+			if (handle != nullptr && metadata_cache_ptr != nullptr && metadata_cache_ptr->IsEnabled()) {
+				const auto stats = fs_ptr->Stats(*handle);
+				metadata_cache_ptr->PutStats(path_copy, stats);
+				if (stats.file_size >= 0) {
+					metadata_cache_ptr->PutFileSize(path_copy, stats.file_size);
+				}
+			}
+			return handle;
+		};
+		// The open itself is the housekeeping job, queued behind primary attempts and hedges so speculative opens only
+		// take otherwise idle workers; no worker waits on it.
+		StartHedgedRequestByAttempt<unique_ptr<FileHandle>>(
+		    std::move(open_and_stat), HedgedRequestOperation::OPEN_FILE, path, config, request_entry,
+		    [request_entry, key](HedgedOutcomeToken<unique_ptr<FileHandle>> &token) {
+			    unique_ptr<FileHandle> handle;
+			    try {
+				    handle = WaitForHedgedOutcome(token);
+			    } catch (...) {
+				    // Prefetch is speculative, the caller's own open reports the failure.
+				    handle.reset();
+			    }
+			    request_entry->GetOpenPrefetchCache().FinishPrefetch(key, std::move(handle));
+		    },
+		    JobPriority::HOUSEKEEPING);
+	}
+}
+
+string HedgedFileSystem::GetCoalescingKey(HedgedRequestOperation operation, const string &path, uint64_t opener_id) {
+	return StringUtil::Format("%s|%llu|%s", GetHedgedRequestOperationName(operation), opener_id, path);
+}
+
+template <typename T, typename Request>
+T HedgedFileSystem::CoalescedRequest(const HedgedRequestConfig &config, HedgedRequestOperation operation,
+                                     const string &path, uint64_t opener_id, const Request &request) {
+	if (!config.enable_request_coalescing) {
+		return request();
+	}
+	// Passed by reference, which doesn't allocate.
+	return single_flight.Do<T>(GetCoalescingKey(operation, path, opener_id), std::cref(request));
 }
 
 int64_t HedgedFileSystem::Read(FileHandle &handle, void *buffer, int64_t nr_bytes) {
 	auto &hedged_handle = handle.Cast<HedgedFileHandle>();
+	hedged_handle.FlushWriteBehind();
+	const auto config = GetRequestConfig(handle.GetPath());
+	int64_t bytes_read = 0;
+	if (TryReadAhead(hedged_handle, buffer, nr_bytes, config, bytes_read)) {
+		return bytes_read;
+	}
 	return wrapped_fs->Read(hedged_handle.GetWrappedHandle(), buffer, nr_bytes);
 }
 
-void HedgedFileSystem::Read(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location) {
-	auto &hedged_handle = handle.Cast<HedgedFileHandle>();
-	wrapped_fs->Read(hedged_handle.GetWrappedHandle(), buffer, nr_bytes, location);
+bool HedgedFileSystem::TryReadAhead(HedgedFileHandle &handle, void *buffer, int64_t nr_bytes,
+                                    const HedgedRequestConfig &config, int64_t &bytes_read) {
+	auto &state = handle.GetSequentialReadState();
+	if (!config.enable_read_ahead) {
+		StopReadAhead(handle);
+		return false;
+	}
+	// Blocks are fetched concurrently with positional reads on the wrapped handle, which is only safe for handles
+	// opened for parallel access.
+	const auto flags = handle.GetFlags();
+	if (nr_bytes <= 0 || flags.OpenForWriting() || !flags.RequireParallelAccess() || !wrapped_fs->CanSeek()) {
+		return false;
+	}
+
+	if (state.window == nullptr) {
+		// Detect sequential access from the wrapped handle position, and pass through until it's detected.
+		auto &wrapped_handle = handle.GetWrappedHandle();
+		const auto position = wrapped_fs->SeekPosition(wrapped_handle);
+		state.sequential_read_count = position == state.last_read_end ? state.sequential_read_count + 1 : 0;
+		if (state.sequential_read_count < READ_AHEAD_SEQUENTIAL_READ_THRESHOLD) {
+			bytes_read = wrapped_fs->Read(wrapped_handle, buffer, nr_bytes);
+			state.last_read_end = position + NumericCast<idx_t>(bytes_read);
+			return true;
+		}
+
+		// Take over the read position, blocks are fetched with hedged positional reads, each into its own pooled
+		// buffer, so the winner buffer becomes the block without extra copy. Fetches are started from the reader
+		// without blocking, so no thread pool job waits on attempts queued behind it.
+		auto *fs_ptr = wrapped_fs.get();
+		auto wrapped_handle_ptr = handle.GetWrappedHandlePtr();
+		auto buffer_pool = entry->GetReadBufferPool();
+		auto request_entry = entry;
+		ReadAheadWindow::BlockFetcher fetcher = [fs_ptr, wrapped_handle_ptr, buffer_pool, config, request_entry,
+		                                         handle_path = handle.GetPath()](
+		                                            idx_t location, idx_t block_bytes,
+		                                            ReadAheadWindow::BlockCallback on_fetched) {
+			StartHedgedRequest<PooledReadBuffer>(
+			    MakeScratchRead(*fs_ptr, wrapped_handle_ptr, buffer_pool, NumericCast<int64_t>(block_bytes), location),
+			    HedgedRequestOperation::READ, handle_path, config, request_entry,
+			    [on_fetched](HedgedOutcomeToken<PooledReadBuffer> &token) {
+				    PooledReadBuffer block_buffer;
+				    std::exception_ptr eptr;
+				    try {
+					    block_buffer = WaitForHedgedOutcome(token);
+				    } catch (...) {
+					    eptr = std::current_exception();
+				    }
+				    on_fetched(std::move(block_buffer), std::move(eptr));
+			    });
+		};
+		// Window is bounded by the per-handle memory cap, but always holds at least one block.
+		const auto max_window_blocks = config.read_ahead_max_bytes / config.read_ahead_block_bytes;
+		const auto window_blocks =
+		    MaxValue<idx_t>(MinValue<idx_t>(config.read_ahead_window_blocks, max_window_blocks), 1);
+		state.position = position;
+		state.file_size = NumericCast<idx_t>(GetFileSize(handle));
+		state.window = make_uniq<ReadAheadWindow>(std::move(fetcher), config.read_ahead_block_bytes, window_blocks);
+	}
+
+	const auto window_bytes_read = state.window->Read(static_cast<data_ptr_t>(buffer), NumericCast<idx_t>(nr_bytes),
+	                                                  state.position, state.file_size);
+	state.position += window_bytes_read;
+	bytes_read = NumericCast<int64_t>(window_bytes_read);
+	return true;
+}
+
+void HedgedFileSystem::StopReadAhead(HedgedFileHandle &handle) {
+	auto &state = handle.GetSequentialReadState();
+	state.sequential_read_count = 0;
+	if (state.window == nullptr) {
+		return;
+	}
+	state.window.reset();
+	wrapped_fs->Seek(handle.GetWrappedHandle(), state.position);
+	state.last_read_end = state.position;
 }
 
 void HedgedFileSystem::Write(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location) {
 	auto &hedged_handle = handle.Cast<HedgedFileHandle>();
-	wrapped_fs->Write(hedged_handle.GetWrappedHandle(), buffer, nr_bytes, location);
+	const auto config = GetRequestConfig(handle.GetPath());
+	auto *write_behind_buffer = GetWriteBehindBuffer(hedged_handle, nr_bytes, config);
+	if (write_behind_buffer != nullptr) {
+		write_behind_buffer->Write(static_cast<const_data_ptr_t>(buffer), NumericCast<idx_t>(nr_bytes), location);
+	} else {
+		wrapped_fs->Write(hedged_handle.GetWrappedHandle(), buffer, nr_bytes, location);
+	}
+	InvalidateMetadata(handle.GetPath());
 }
 
 int64_t HedgedFileSystem::Write(FileHandle &handle, void *buffer, int64_t nr_bytes) {
 	auto &hedged_handle = handle.Cast<HedgedFileHandle>();
-	return wrapped_fs->Write(hedged_handle.GetWrappedHandle(), buffer, nr_bytes);
+	const auto config = GetRequestConfig(handle.GetPath());
+	auto *write_behind_buffer = GetWriteBehindBuffer(hedged_handle, nr_bytes, config);
+	if (write_behind_buffer == nullptr) {
+		auto written = wrapped_fs->Write(hedged_handle.GetWrappedHandle(), buffer, nr_bytes);
+		InvalidateMetadata(handle.GetPath());
+		return written;
+	}
+
+	// Non-positional writes are buffered as positional ones from the logical position, the wrapped handle is moved
+	// there on flush.
+	auto &state = hedged_handle.GetWriteBehindState();
+	if (!state.has_position) {
+		state.position = wrapped_fs->SeekPosition(hedged_handle.GetWrappedHandle());
+		state.has_position = true;
+	}
+	write_behind_buffer->Write(static_cast<const_data_ptr_t>(buffer), NumericCast<idx_t>(nr_bytes), state.position);
+	state.position += NumericCast<idx_t>(nr_bytes);
+	InvalidateMetadata(handle.GetPath());
+	return nr_bytes;
+}
+
+WriteBehindBuffer *HedgedFileSystem::GetWriteBehindBuffer(HedgedFileHandle &handle, int64_t nr_bytes,
+                                                          const HedgedRequestConfig &config) {
+	auto &state = handle.GetWriteBehindState();
+	if (!config.enable_write_behind) {
+		handle.FlushWriteBehind();
+		return nullptr;
+	}
+	// Appends always go to the end of file, and unseekable files cannot be written out of order.
+	const auto flags = handle.GetFlags();
+	if (nr_bytes <= 0 || !flags.OpenForWriting() || flags.OpenForAppending() || !wrapped_fs->CanSeek()) {
+		return state.buffer.get();
+	}
+	if (state.buffer != nullptr) {
+		return state.buffer.get();
+	}
+
+	// Every part is written from its own pooled buffer, which is kept alive until all attempts writing it finish. Part
+	// writes are started without blocking, the buffer starts the next part from the completion of the previous one.
+	auto *fs_ptr = wrapped_fs.get();
+	auto wrapped_handle_ptr = handle.GetWrappedHandlePtr();
+	auto request_entry = entry;
+	WriteBehindBuffer::PartWriter writer = [fs_ptr, wrapped_handle_ptr, config, request_entry,
+	                                        handle_path = handle.GetPath()](
+	                                           shared_ptr<PooledReadBuffer> part, idx_t part_bytes, idx_t location,
+	                                           WriteBehindBuffer::PartCallback on_written) {
+		if (!config.enable_write_hedging) {
+			request_entry->SubmitAttempt([fs_ptr, wrapped_handle_ptr, part, part_bytes, location, on_written]() {
+				std::exception_ptr eptr;
+				try {
+					fs_ptr->Write(*wrapped_handle_ptr, part->GetData(), NumericCast<int64_t>(part_bytes), location);
+				} catch (...) {
+					eptr = std::current_exception();
+				}
+				on_written(std::move(eptr));
+			});
+			return;
+		}
+		// A losing attempt keeps writing the same bytes to the same range after the race is decided, possibly
+		// concurrently with the next part. Write hedging is only enabled by `hedged_fs_enable_write_hedging` or the
+		// `enable_write_hedging` policy option, by which the user declares positional writes of the wrapped
+		// filesystem idempotent and unordered.
+		StartHedgedRequest<void>(
+		    [fs_ptr, wrapped_handle_ptr, part, part_bytes, location]() {
+			    fs_ptr->Write(*wrapped_handle_ptr, part->GetData(), NumericCast<int64_t>(part_bytes), location);
+		    },
+		    HedgedRequestOperation::WRITE, handle_path, config, request_entry,
+		    [on_written](HedgedOutcomeToken<void> &token) {
+			    std::exception_ptr eptr;
+			    try {
+				    WaitForHedgedOutcome(token);
+			    } catch (...) {
+				    eptr = std::current_exception();
+			    }
+			    on_written(std::move(eptr));
+		    });
+	};
+	state.buffer = make_uniq<WriteBehindBuffer>(std::move(writer), entry->GetReadBufferPool(),
+	                                            config.write_behind_part_bytes,
+	                                            config.write_behind_max_outstanding_parts);
+	return state.buffer.get();
 }
 
 bool HedgedFileSystem::Trim(FileHandle &handle, idx_t offset_bytes, idx_t length_bytes) {
 	auto &hedged_handle = handle.Cast<HedgedFileHandle>();
+	hedged_handle.FlushWriteBehind();
 	return wrapped_fs->Trim(hedged_handle.GetWrappedHandle(), offset_bytes, length_bytes);
 }
 
 void HedgedFileSystem::Truncate(FileHandle &handle, int64_t new_size) {
 	auto &hedged_handle = handle.Cast<HedgedFileHandle>();
+	hedged_handle.FlushWriteBehind();
 	wrapped_fs->Truncate(hedged_handle.GetWrappedHandle(), new_size);
+	InvalidateMetadata(handle.GetPath());
 }
 
 void HedgedFileSystem::MoveFile(const string &source, const string &target, optional_ptr<FileOpener> opener) {
 	wrapped_fs->MoveFile(source, target, opener);
+	InvalidateMetadata(source);
+	InvalidateMetadata(target);
+	InvalidateListing(source);
+	InvalidateListing(target);
 }
 
 bool HedgedFileSystem::IsPipe(const string &filename, optional_ptr<FileOpener> opener) {
@@ -199,6 +1357,7 @@ bool HedgedFileSystem::IsPipe(const string &filename, optional_ptr<FileOpener> o
 
 void HedgedFileSystem::FileSync(FileHandle &handle) {
 	auto &hedged_handle = handle.Cast<HedgedFileHandle>();
+	hedged_handle.FlushWriteBehind();
 	wrapped_fs->FileSync(hedged_handle.GetWrappedHandle());
 }
 
@@ -244,16 +1403,37 @@ vector<string> HedgedFileSystem::ListSubSystems() {
 
 void HedgedFileSystem::Seek(FileHandle &handle, idx_t location) {
 	auto &hedged_handle = handle.Cast<HedgedFileHandle>();
+	hedged_handle.FlushWriteBehind();
+	auto &state = hedged_handle.GetSequentialReadState();
+	// Non-sequential access restarts sequential read detection.
+	state.window.reset();
+	state.sequential_read_count = 0;
+	state.last_read_end = location;
 	wrapped_fs->Seek(hedged_handle.GetWrappedHandle(), location);
 }
 
 void HedgedFileSystem::Reset(FileHandle &handle) {
 	auto &hedged_handle = handle.Cast<HedgedFileHandle>();
+	hedged_handle.FlushWriteBehind();
+	auto &state = hedged_handle.GetSequentialReadState();
+	state.window.reset();
+	state.sequential_read_count = 0;
+	state.last_read_end = 0;
 	wrapped_fs->Reset(hedged_handle.GetWrappedHandle());
 }
 
 idx_t HedgedFileSystem::SeekPosition(FileHandle &handle) {
 	auto &hedged_handle = handle.Cast<HedgedFileHandle>();
+	// Wrapped handle position stays untouched while reads are served by the read-ahead window.
+	const auto &state = hedged_handle.GetSequentialReadState();
+	if (state.window != nullptr) {
+		return state.position;
+	}
+	// Same for buffered non-positional writes.
+	const auto &write_behind_state = hedged_handle.GetWriteBehindState();
+	if (write_behind_state.has_position) {
+		return write_behind_state.position;
+	}
 	return wrapped_fs->SeekPosition(hedged_handle.GetWrappedHandle());
 }
 
@@ -272,220 +1452,771 @@ bool HedgedFileSystem::OnDiskFile(FileHandle &handle) {
 
 unique_ptr<FileHandle> HedgedFileSystem::OpenFile(const string &path, FileOpenFlags flags,
                                                   optional_ptr<FileOpener> opener) {
+	const auto opener_id = GetOpenerId(opener);
+	if (CanUsePrefetchedHandle(flags)) {
+		auto prefetched_handle = entry->GetOpenPrefetchCache().TryTake(GetHandleCacheKey(path));
+		if (prefetched_handle != nullptr) {
+			return make_uniq<HedgedFileHandle>(*this, std::move(prefetched_handle), path, opener_id);
+		}
+	}
+	const bool can_pool = CanPoolHandle(flags) && CanPoolHandles();
+	if (can_pool) {
+		auto pooled_handle = TakePooledHandle(path, flags);
+		if (pooled_handle != nullptr) {
+			return make_uniq<HedgedFileHandle>(*this, std::move(pooled_handle), path, opener_id);
+		}
+	}
+
+	const auto config = GetRequestConfig(path);
 	auto *fs_ptr = wrapped_fs.get();
 	auto opener_copy = CopyFileOpener(opener);
-	auto config = entry->GetConfig();
-	auto result = HedgedRequest<unique_ptr<FileHandle>>(
-	    std::function<unique_ptr<FileHandle>()>([fs_ptr, path_copy = path, flags, opener_copy]() {
-		    return fs_ptr->OpenFile(path_copy, flags, opener_copy.get());
-	    }),
-	    config.delays_ms[NumericCast<size_t>(HedgedRequestOperation::OPEN_FILE)], entry);
+	// Handles opened by losing attempts are pooled for later opens, instead of being closed.
+	std::function<void(unique_ptr<FileHandle>)> on_discarded;
+	if (can_pool) {
+		// Losing attempts may outlive this filesystem, so only the entry and the wrapped filesystem are referenced.
+		on_discarded = [request_entry = entry, fs_ptr, key = GetHandleCacheKey(path), flags](
+		                   unique_ptr<FileHandle> handle) {
+			if (handle != nullptr) {
+				PoolWrappedHandle(*request_entry, *fs_ptr, key, flags, MakeSharedFileHandle(std::move(handle)));
+			}
+		};
+	}
+	// Opens which could modify the file always go to the original path.
+	auto open_attempt = MakeReplicaAttempt<unique_ptr<FileHandle>>(
+	    path, flags.OpenForWriting() ? vector<string> {} : GetReplicaPaths(path),
+	    [fs_ptr, flags, opener_copy](const string &attempt_path) {
+		    return fs_ptr->OpenFile(attempt_path, flags, opener_copy.get());
+	    });
+	auto open_file = [&]() {
+		return HedgedRequestByAttempt<unique_ptr<FileHandle>>(open_attempt, HedgedRequestOperation::OPEN_FILE, path,
+		                                                      config, entry, on_discarded);
+	};
+	unique_ptr<FileHandle> result;
+	// File handle cannot be shared, so concurrent callers wait for the first open to complete and then open their own
+	// handle, which hits a warmed-up path; opens which could modify the file are never coalesced.
+	if (config.enable_request_coalescing && !flags.OpenForWriting()) {
+		const auto key = StringUtil::Format(
+		    "%s|%llu", GetCoalescingKey(HedgedRequestOperation::OPEN_FILE, path, opener_id), flags.GetFlagsInternal());
+		result = single_flight.DoOrFollow<unique_ptr<FileHandle>>(key, std::cref(open_file), std::cref(open_file));
+	} else {
+		result = open_file();
+	}
+	// File might be created or overwritten.
+	if (flags.OpenForWriting()) {
+		InvalidateMetadata(path);
+		InvalidateListing(path);
+	}
 	if (!result) {
 		return nullptr;
 	}
-	return make_uniq<HedgedFileHandle>(*this, std::move(result), path);
+	return make_uniq<HedgedFileHandle>(*this, std::move(result), path, opener_id);
+}
+
+void HedgedFileSystem::Read(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location) {
+	auto &hedged_handle = handle.Cast<HedgedFileHandle>();
+	hedged_handle.FlushWriteBehind();
+	const auto config = GetRequestConfig(handle.GetPath());
+	// Chunks and hedged attempts read the wrapped handle concurrently, which is only safe for handles opened for
+	// parallel access; others might keep per-handle read state, e.g. a read buffer.
+	if (nr_bytes <= 0 || !handle.GetFlags().RequireParallelAccess()) {
+		wrapped_fs->Read(hedged_handle.GetWrappedHandle(), buffer, nr_bytes, location);
+		return;
+	}
+	if (!config.enable_chunked_read || NumericCast<uint64_t>(nr_bytes) <= config.chunked_read_threshold_bytes) {
+		ReadRange(hedged_handle, buffer, nr_bytes, location, config);
+		return;
+	}
+
+	// Every chunk reads into its own disjoint slice of the caller's buffer, so one slow range only delays itself. The
+	// first chunk is read on the caller thread, and the rest are started from it without blocking, so no thread pool
+	// job waits on chunk attempts queued behind it.
+	const auto chunk_bytes = config.chunked_read_chunk_bytes;
+	const auto total_bytes = NumericCast<uint64_t>(nr_bytes);
+	const auto chunk_count = (total_bytes + chunk_bytes - 1) / chunk_bytes;
+	// Chunk reads reference the caller's buffer, the group waits for all of them before returning or rethrowing.
+	HedgedRequestGroup chunk_reads;
+	for (uint64_t chunk_idx = 1; chunk_idx < chunk_count && chunk_reads.Add(); ++chunk_idx) {
+		const auto chunk_offset = chunk_idx * chunk_bytes;
+		const auto chunk_size = MinValue<uint64_t>(chunk_bytes, total_bytes - chunk_offset);
+		StartReadRange(hedged_handle, static_cast<char *>(buffer) + chunk_offset, NumericCast<int64_t>(chunk_size),
+		               location + chunk_offset, config,
+		               [&chunk_reads](std::exception_ptr eptr) { chunk_reads.Done(std::move(eptr)); });
+	}
+	try {
+		ReadRange(hedged_handle, buffer, NumericCast<int64_t>(MinValue<uint64_t>(chunk_bytes, total_bytes)), location,
+		          config);
+	} catch (...) {
+		chunk_reads.Wait();
+		throw;
+	}
+	chunk_reads.Wait();
+}
+
+void HedgedFileSystem::ReadRange(HedgedFileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location,
+                                 const HedgedRequestConfig &config) {
+	if (!config.enable_read_hedging || nr_bytes <= 0) {
+		wrapped_fs->Read(handle.GetWrappedHandle(), buffer, nr_bytes, location);
+		return;
+	}
+
+	// The wrapped read cannot be interrupted, so a losing attempt keeps writing after the race is decided. To avoid
+	// touching caller's buffer after return, every attempt reads into its own pooled scratch buffer and only the winner
+	// gets copied out.
+	auto scratch = HedgedRequest<PooledReadBuffer>(
+	    MakeScratchRead(*wrapped_fs, handle.GetWrappedHandlePtr(), entry->GetReadBufferPool(), nr_bytes, location),
+	    HedgedRequestOperation::READ, handle.GetPath(), config, entry);
+	std::memcpy(buffer, scratch.GetData(), NumericCast<size_t>(nr_bytes));
+}
+
+void HedgedFileSystem::StartReadRange(HedgedFileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location,
+                                      const HedgedRequestConfig &config,
+                                      std::function<void(std::exception_ptr)> on_done) {
+	if (!config.enable_read_hedging) {
+		auto *fs_ptr = wrapped_fs.get();
+		entry->SubmitAttempt(
+		    [fs_ptr, wrapped_handle_ptr = handle.GetWrappedHandlePtr(), buffer, nr_bytes, location, on_done]() {
+			    std::exception_ptr eptr;
+			    try {
+				    fs_ptr->Read(*wrapped_handle_ptr, buffer, nr_bytes, location);
+			    } catch (...) {
+				    eptr = std::current_exception();
+			    }
+			    on_done(std::move(eptr));
+		    });
+		return;
+	}
+	StartHedgedRequest<PooledReadBuffer>(
+	    MakeScratchRead(*wrapped_fs, handle.GetWrappedHandlePtr(), entry->GetReadBufferPool(), nr_bytes, location),
+	    HedgedRequestOperation::READ, handle.GetPath(), config, entry,
+	    [buffer, nr_bytes, on_done](HedgedOutcomeToken<PooledReadBuffer> &token) {
+		    std::exception_ptr eptr;
+		    try {
+			    auto scratch = WaitForHedgedOutcome(token);
+			    std::memcpy(buffer, scratch.GetData(), NumericCast<size_t>(nr_bytes));
+		    } catch (...) {
+			    eptr = std::current_exception();
+		    }
+		    on_done(std::move(eptr));
+	    });
 }
 
 bool HedgedFileSystem::DirectoryExists(const string &directory, optional_ptr<FileOpener> opener) {
+	const auto config = GetRequestConfig(directory);
 	auto *fs_ptr = wrapped_fs.get();
 	auto opener_copy = CopyFileOpener(opener);
-	auto config = entry->GetConfig();
-	return HedgedRequest<bool>(std::function<bool()>([fs_ptr, directory_copy = directory, opener_copy]() {
-		                           return fs_ptr->DirectoryExists(directory_copy, opener_copy.get());
-	                           }),
-	                           config.delays_ms[NumericCast<size_t>(HedgedRequestOperation::DIRECTORY_EXISTS)], entry);
+	const auto opener_id = GetOpenerId(opener);
+	auto exists_attempt = MakeReplicaAttempt<bool>(
+	    directory, GetReplicaPaths(directory), [fs_ptr, opener_copy](const string &attempt_path) {
+		    return fs_ptr->DirectoryExists(attempt_path, opener_copy.get());
+	    });
+	return CoalescedRequest<bool>(config, HedgedRequestOperation::DIRECTORY_EXISTS, directory, opener_id, [&]() {
+		// Only invoked once, by the leader of coalesced requests.
+		return HedgedRequestByAttempt<bool>(std::move(exists_attempt), HedgedRequestOperation::DIRECTORY_EXISTS,
+		                                    directory, config, entry);
+	});
 }
 
 bool HedgedFileSystem::FileExists(const string &filename, optional_ptr<FileOpener> opener) {
+	auto *cache = GetMetadataCache();
+	bool file_exists = false;
+	if (cache != nullptr && cache->TryGetFileExists(filename, file_exists)) {
+		return file_exists;
+	}
+
+	const auto config = GetRequestConfig(filename);
 	auto *fs_ptr = wrapped_fs.get();
 	auto opener_copy = CopyFileOpener(opener);
-	auto config = entry->GetConfig();
-	return HedgedRequest<bool>(std::function<bool()>([fs_ptr, filename_copy = filename, opener_copy]() {
-		                           return fs_ptr->FileExists(filename_copy, opener_copy.get());
-	                           }),
-	                           config.delays_ms[NumericCast<size_t>(HedgedRequestOperation::FILE_EXISTS)], entry);
+	const auto opener_id = GetOpenerId(opener);
+	auto exists_attempt = MakeReplicaAttempt<bool>(
+	    filename, GetReplicaPaths(filename), [fs_ptr, opener_copy](const string &attempt_path) {
+		    return fs_ptr->FileExists(attempt_path, opener_copy.get());
+	    });
+	file_exists = CoalescedRequest<bool>(config, HedgedRequestOperation::FILE_EXISTS, filename, opener_id, [&]() {
+		// Only invoked once, by the leader of coalesced requests.
+		return HedgedRequestByAttempt<bool>(std::move(exists_attempt), HedgedRequestOperation::FILE_EXISTS, filename,
+		                                    config, entry);
+	});
+	if (cache != nullptr) {
+		cache->PutFileExists(filename, file_exists);
+	}
+	return file_exists;
 }
 
 bool HedgedFileSystem::ListFiles(const string &directory, const std::function<void(const string &, bool)> &callback,
                                  FileOpener *opener) {
-	auto results = make_shared_ptr<vector<std::pair<string, bool>>>();
-	auto results_mutex = make_shared_ptr<concurrency::mutex>();
+	auto *cache = GetListingCache();
+	ListingCache::Listing listing;
+	if (cache != nullptr && cache->TryGetListing(directory, listing)) {
+		for (auto &cur_entry : listing) {
+			callback(cur_entry.first, cur_entry.second);
+		}
+		return true;
+	}
 
+	const auto config = GetRequestConfig(directory);
 	auto *fs_ptr = wrapped_fs.get();
 	auto opener_copy = CopyFileOpener(opener);
-	auto config = entry->GetConfig();
-	bool success = HedgedRequest<bool>(
-	    std::function<bool()>([fs_ptr, directory_copy = directory, results, results_mutex, opener_copy]() {
-		    return fs_ptr->ListFiles(
-		        directory_copy,
-		        [results, results_mutex](const string &name, bool is_dir) {
-			        const concurrency::lock_guard<concurrency::mutex> lock(*results_mutex);
-			        results->emplace_back(name, is_dir);
-		        },
-		        opener_copy.get());
-	    }),
-	    config.delays_ms[NumericCast<size_t>(HedgedRequestOperation::LIST_FILES)], entry);
+	const auto opener_id = GetOpenerId(opener);
+	if (config.enable_streaming_listing) {
+		using Entry = std::pair<string, bool>;
+		auto stream = make_shared_ptr<ListingStream<Entry>>(config.listing_page_size, LISTING_MAX_BUFFERED_PAGES);
+		ListingStreamCloser<Entry> closer {stream};
+		HedgedListing<Entry>(
+		    stream,
+		    [fs_ptr, directory_copy = directory, opener_copy](ListingPageWriter<Entry> &writer) {
+			    return fs_ptr->ListFiles(
+			        directory_copy,
+			        [&writer](const string &name, bool is_dir) {
+				        if (!writer.Append(Entry(name, is_dir))) {
+					        ThrowListingAborted();
+				        }
+			        },
+			        opener_copy.get());
+		    },
+		    HedgedRequestOperation::LIST_FILES, directory, config, entry);
+
+		ListingStream<Entry>::Page page;
+		while (stream->Next(page)) {
+			for (auto &cur_entry : page) {
+				callback(cur_entry.first, cur_entry.second);
+				if (cache != nullptr) {
+					listing.emplace_back(std::move(cur_entry));
+				}
+			}
+		}
+		const bool success = stream->GetResult();
+		if (success && cache != nullptr) {
+			cache->PutListing(directory, std::move(listing));
+		}
+		return success;
+	}
 
-	if (success) {
-		for (auto &result : *results) {
-			callback(result.first, result.second);
+	// Materialized listing could be shared by concurrent identical calls.
+	auto result = CoalescedRequest<ListFilesResult>(
+	    config, HedgedRequestOperation::LIST_FILES, directory, opener_id, [&]() {
+		    return HedgedRequest<ListFilesResult>(MakeListFilesAttempt(*fs_ptr, directory, opener_copy),
+		                                          HedgedRequestOperation::LIST_FILES, directory, config, entry);
+	    });
+
+	if (result.success) {
+		for (auto &cur_entry : result.entries) {
+			callback(cur_entry.first, cur_entry.second);
+		}
+		if (cache != nullptr) {
+			cache->PutListing(directory, std::move(result.entries));
 		}
 	}
-	return success;
+	return result.success;
+}
+
+bool HedgedFileSystem::TryParallelGlob(const string &path, const FileGlobInput &input, optional_ptr<FileOpener> opener,
+                                       vector<OpenFileInfo> &files) {
+	const auto config = GetRequestConfig(path);
+	GlobPartitioning partitioning;
+	// Discovery lists the base directory, which is a full recursive listing on filesystems without delimiter listing.
+	if (config.glob_parallelism <= 1 || !ListsDirectoryLevels(wrapped_fs_name) ||
+	    !SplitGlobPattern(path, partitioning)) {
+		return false;
+	}
+
+	// Discover partitions with one hedged listing of the base directory.
+	vector<string> partitions;
+	const bool listed = ListFiles(
+	    partitioning.base,
+	    [&](const string &name, bool is_dir) {
+		    if (!is_dir) {
+			    return;
+		    }
+		    auto directory = GetPartitionDirectoryName(partitioning.base, name);
+		    if (!directory.empty() && duckdb::Glob(directory.c_str(), directory.size(), partitioning.segment.c_str(),
+		                                           partitioning.segment.size())) {
+			    partitions.emplace_back(std::move(directory));
+		    }
+	    },
+	    opener.get());
+	// Wrapped filesystem might not report directories, e.g. object stores without delimiter listing.
+	if (!listed || partitions.empty()) {
+		return false;
+	}
+	std::sort(partitions.begin(), partitions.end());
+
+	// Every partition is hedged independently, so a slow listing only delays its own partition. Partition globs are
+	// started from the caller thread with at most [glob_parallelism] in flight, so no thread pool job waits on them;
+	// no partition is started once any partition fails.
+	auto *fs_ptr = wrapped_fs.get();
+	auto opener_copy = CopyFileOpener(opener);
+	vector<vector<OpenFileInfo>> partition_files(partitions.size());
+	// Completions write into [partition_files], the group waits for all of them before returning or rethrowing.
+	HedgedRequestGroup partition_globs(config.glob_parallelism);
+	for (idx_t partition_idx = 0; partition_idx < partitions.size() && partition_globs.Add(); ++partition_idx) {
+		const auto pattern = partitioning.GetPartitionPattern(partitions[partition_idx]);
+		auto &cur_partition_files = partition_files[partition_idx];
+		StartHedgedRequest<vector<OpenFileInfo>>(
+		    [fs_ptr, pattern, input, opener_copy]() {
+			    return fs_ptr->Glob(pattern, input, opener_copy.get())->GetAllFiles();
+		    },
+		    HedgedRequestOperation::GLOB, pattern, GetRequestConfig(pattern), entry,
+		    [&partition_globs, &cur_partition_files](HedgedOutcomeToken<vector<OpenFileInfo>> &token) {
+			    std::exception_ptr eptr;
+			    try {
+				    cur_partition_files = WaitForHedgedOutcome(token);
+			    } catch (...) {
+				    eptr = std::current_exception();
+			    }
+			    partition_globs.Done(std::move(eptr));
+		    });
+	}
+	partition_globs.Wait();
+
+	// Merge in partition order.
+	for (auto &cur_partition_files : partition_files) {
+		for (auto &cur_file : cur_partition_files) {
+			files.emplace_back(std::move(cur_file));
+		}
+	}
+	return true;
+}
+
+bool HedgedFileSystem::TryCachedGlob(const string &path, optional_ptr<FileOpener> opener, vector<OpenFileInfo> &files) {
+	if (GetListingCache() == nullptr) {
+		return false;
+	}
+	// Expansion lists directory by directory, which a filesystem without delimiter listing answers with recursive
+	// listings not reporting directories; fall back before issuing any listing.
+	GlobLevels levels;
+	if (!ListsDirectoryLevels(wrapped_fs_name) || !SplitGlobLevels(path, levels)) {
+		return false;
+	}
+
+	const auto config = GetRequestConfig(path);
+	vector<string> directories {levels.base};
+	vector<OpenFileInfo> matched_files;
+	for (idx_t segment_idx = 0; segment_idx < levels.segments.size() && !directories.empty(); ++segment_idx) {
+		const auto &segment = levels.segments[segment_idx];
+		// The last level matches files, while other levels match directories; literal directory levels are descended
+		// without listing.
+		const bool is_last = segment_idx + 1 == levels.segments.size();
+		if (!is_last && !HasGlobWildcard(segment)) {
+			for (auto &cur_directory : directories) {
+				cur_directory += segment + "/";
+			}
+			continue;
+		}
+		const auto listings = ListDirectories(directories, opener, config.glob_parallelism);
+		vector<string> next_directories;
+		for (idx_t directory_idx = 0; directory_idx < directories.size(); ++directory_idx) {
+			const auto &directory = directories[directory_idx];
+			for (const auto &cur_entry : listings[directory_idx]) {
+				// Entries below direct children are skipped.
+				const auto name = GetPartitionDirectoryName(directory, cur_entry.first);
+				if (name.empty() || cur_entry.second == is_last ||
+				    !duckdb::Glob(name.c_str(), name.size(), segment.c_str(), segment.size())) {
+					continue;
+				}
+				if (is_last) {
+					matched_files.emplace_back(directory + name);
+				} else {
+					next_directories.emplace_back(directory + name + "/");
+				}
+			}
+		}
+		directories = std::move(next_directories);
+	}
+	// Fall back to the wrapped glob, which decides whether no match is an error.
+	if (matched_files.empty()) {
+		return false;
+	}
+	std::sort(matched_files.begin(), matched_files.end(),
+	          [](const OpenFileInfo &lhs, const OpenFileInfo &rhs) { return lhs.path < rhs.path; });
+	files = std::move(matched_files);
+	return true;
+}
+
+vector<ListingCache::Listing> HedgedFileSystem::ListDirectories(const vector<string> &directories,
+                                                                optional_ptr<FileOpener> opener, idx_t parallelism) {
+	vector<ListingCache::Listing> listings(directories.size());
+	auto *cache = GetListingCache();
+	vector<idx_t> uncached;
+	for (idx_t idx = 0; idx < directories.size(); ++idx) {
+		if (cache == nullptr || !cache->TryGetListing(directories[idx], listings[idx])) {
+			uncached.emplace_back(idx);
+		}
+	}
+	if (uncached.size() <= 1 || parallelism <= 1) {
+		for (auto idx : uncached) {
+			auto &listing = listings[idx];
+			ListFiles(
+			    directories[idx], [&listing](const string &name, bool is_dir) { listing.emplace_back(name, is_dir); },
+			    opener.get());
+		}
+		return listings;
+	}
+
+	// Uncached directories are listed by hedged listings started from the caller thread, with at most [parallelism]
+	// in flight, so no thread pool job waits on them; no listing is started once any listing fails.
+	auto opener_copy = CopyFileOpener(opener);
+	// Completions write into [listings], the group waits for all of them before returning or rethrowing.
+	HedgedRequestGroup directory_listings(parallelism);
+	for (idx_t uncached_idx = 0; uncached_idx < uncached.size() && directory_listings.Add(); ++uncached_idx) {
+		const auto &directory = directories[uncached[uncached_idx]];
+		auto &listing = listings[uncached[uncached_idx]];
+		StartHedgedRequest<ListFilesResult>(
+		    MakeListFilesAttempt(*wrapped_fs, directory, opener_copy), HedgedRequestOperation::LIST_FILES, directory,
+		    GetRequestConfig(directory), entry,
+		    [&directory_listings, &listing, cache, directory](HedgedOutcomeToken<ListFilesResult> &token) {
+			    std::exception_ptr eptr;
+			    try {
+				    auto result = WaitForHedgedOutcome(token);
+				    if (result.success) {
+					    if (cache != nullptr) {
+						    cache->PutListing(directory, result.entries);
+					    }
+					    listing = std::move(result.entries);
+				    }
+			    } catch (...) {
+				    eptr = std::current_exception();
+			    }
+			    directory_listings.Done(std::move(eptr));
+		    });
+	}
+	directory_listings.Wait();
+	return listings;
 }
 
 vector<OpenFileInfo> HedgedFileSystem::Glob(const string &path, FileOpener *opener) {
+	const auto config = GetRequestConfig(path);
 	auto *fs_ptr = wrapped_fs.get();
 	auto opener_copy = CopyFileOpener(opener);
-	auto config = entry->GetConfig();
-	return HedgedRequest<vector<OpenFileInfo>>(
-	    std::function<vector<OpenFileInfo>()>([fs_ptr, path_copy = path, opener_copy]() {
-		    auto result = fs_ptr->Glob(path_copy, FileGlobOptions::ALLOW_EMPTY, opener_copy.get());
-		    return result->GetAllFiles();
-	    }),
-	    config.delays_ms[NumericCast<size_t>(HedgedRequestOperation::GLOB)], entry);
+	const auto opener_id = GetOpenerId(opener);
+	auto files = CoalescedRequest<vector<OpenFileInfo>>(config, HedgedRequestOperation::GLOB, path, opener_id, [&]() {
+		vector<OpenFileInfo> files;
+		if (TryCachedGlob(path, opener, files) || TryParallelGlob(path, FileGlobOptions::ALLOW_EMPTY, opener, files)) {
+			return files;
+		}
+		return HedgedRequest<vector<OpenFileInfo>>(
+		    std::function<vector<OpenFileInfo>()>([fs_ptr, path_copy = path, opener_copy]() {
+			    auto result = fs_ptr->Glob(path_copy, FileGlobOptions::ALLOW_EMPTY, opener_copy.get());
+			    return result->GetAllFiles();
+		    }),
+		    HedgedRequestOperation::GLOB, path, config, entry);
+	});
+	PrefetchOpenFiles(files, config.open_prefetch_file_count, opener_copy);
+	return files;
+}
+
+unique_ptr<MultiFileList> HedgedFileSystem::GlobFilesExtended(const string &path, const FileGlobInput &input,
+                                                              optional_ptr<FileOpener> opener) {
+	const auto config = GetRequestConfig(path);
+	auto *fs_ptr = wrapped_fs.get();
+	auto opener_copy = CopyFileOpener(opener);
+	vector<OpenFileInfo> files;
+	if (TryCachedGlob(path, opener, files) || TryParallelGlob(path, input, opener, files)) {
+		PrefetchOpenFiles(files, config.open_prefetch_file_count, opener_copy);
+		return make_uniq<SimpleMultiFileList>(std::move(files));
+	}
+
+	if (!config.enable_streaming_listing) {
+		files = HedgedRequest<vector<OpenFileInfo>>(
+		    std::function<vector<OpenFileInfo>()>([fs_ptr, path_copy = path, input, opener_copy]() {
+			    auto result = fs_ptr->Glob(path_copy, input, opener_copy.get());
+			    return result->GetAllFiles();
+		    }),
+		    HedgedRequestOperation::GLOB, path, config, entry);
+		PrefetchOpenFiles(files, config.open_prefetch_file_count, opener_copy);
+		return make_uniq<SimpleMultiFileList>(std::move(files));
+	}
+
+	// Return once the first page is available, the rest is expanded on demand; files are prefetched as they're
+	// expanded, until the prefetch count is used up.
+	std::function<void(const vector<OpenFileInfo> &)> on_page;
+	if (config.open_prefetch_file_count > 0) {
+		on_page = [this, remaining = config.open_prefetch_file_count,
+		           opener_copy](const vector<OpenFileInfo> &page) mutable {
+			const auto prefetch_count = MinValue<idx_t>(remaining, page.size());
+			PrefetchOpenFiles(page, prefetch_count, opener_copy);
+			remaining -= prefetch_count;
+		};
+	}
+	auto stream = make_shared_ptr<ListingStream<OpenFileInfo>>(config.listing_page_size, LISTING_MAX_BUFFERED_PAGES);
+	auto result = make_uniq<HedgedGlobFileList>(stream, std::move(on_page));
+	HedgedListing<OpenFileInfo>(
+	    stream,
+	    [fs_ptr, path_copy = path, input, opener_copy](ListingPageWriter<OpenFileInfo> &writer) {
+		    auto files = fs_ptr->Glob(path_copy, input, opener_copy.get());
+		    for (const auto &cur_file : files->Files()) {
+			    if (!writer.Append(cur_file)) {
+				    ThrowListingAborted();
+			    }
+		    }
+		    return true;
+	    },
+	    HedgedRequestOperation::GLOB, path, config, entry);
+	return std::move(result);
+}
+
+bool HedgedFileSystem::SupportsGlobExtended() const {
+	return true;
 }
 
 int64_t HedgedFileSystem::GetFileSize(FileHandle &handle) {
+	// Buffered writes could extend the file.
+	handle.Cast<HedgedFileHandle>().FlushWriteBehind();
+	const auto &path = handle.GetPath();
+	auto *cache = GetMetadataCache();
+	int64_t file_size = 0;
+	if (cache != nullptr && cache->TryGetFileSize(path, file_size)) {
+		return file_size;
+	}
+
+	const auto config = GetRequestConfig(path);
 	auto &hedged_handle = handle.Cast<HedgedFileHandle>();
 	auto *fs_ptr = wrapped_fs.get();
 	auto wrapped_handle_ptr = hedged_handle.GetWrappedHandlePtr();
-	auto config = entry->GetConfig();
-	return HedgedRequest<int64_t>(
-	    std::function<int64_t()>(
-	        // Capture shared pointer to make sure it's always valid on access.
-	        [fs_ptr, wrapped_handle_ptr]() { return fs_ptr->GetFileSize(*wrapped_handle_ptr); }),
-	    config.delays_ms[NumericCast<size_t>(HedgedRequestOperation::GET_FILE_SIZE)], entry);
+	const auto opener_id = hedged_handle.GetOpenerId();
+	file_size = CoalescedRequest<int64_t>(config, HedgedRequestOperation::GET_FILE_SIZE, path, opener_id, [&]() {
+		return HedgedRequest<int64_t>(
+		    // Capture shared pointer to make sure it's always valid on access.
+		    [fs_ptr, wrapped_handle_ptr]() { return fs_ptr->GetFileSize(*wrapped_handle_ptr); },
+		    HedgedRequestOperation::GET_FILE_SIZE, path, config, entry);
+	});
+	if (cache != nullptr) {
+		cache->PutFileSize(path, file_size);
+	}
+	return file_size;
 }
 
 timestamp_t HedgedFileSystem::GetLastModifiedTime(FileHandle &handle) {
+	// Buffered writes modify the file once written.
+	handle.Cast<HedgedFileHandle>().FlushWriteBehind();
+	const auto &path = handle.GetPath();
+	auto *cache = GetMetadataCache();
+	timestamp_t last_modified_time;
+	if (cache != nullptr && cache->TryGetLastModifiedTime(path, last_modified_time)) {
+		return last_modified_time;
+	}
+
+	const auto config = GetRequestConfig(path);
 	auto &hedged_handle = handle.Cast<HedgedFileHandle>();
 	auto *fs_ptr = wrapped_fs.get();
 	auto wrapped_handle_ptr = hedged_handle.GetWrappedHandlePtr();
-	auto config = entry->GetConfig();
-	return HedgedRequest<timestamp_t>(
-	    std::function<timestamp_t()>(
-	        // Capture shared pointer to make sure it's always valid on access.
-	        [fs_ptr, wrapped_handle_ptr]() { return fs_ptr->GetLastModifiedTime(*wrapped_handle_ptr); }),
-	    config.delays_ms[NumericCast<size_t>(HedgedRequestOperation::GET_LAST_MODIFIED_TIME)], entry);
+	const auto opener_id = hedged_handle.GetOpenerId();
+	last_modified_time =
+	    CoalescedRequest<timestamp_t>(config, HedgedRequestOperation::GET_LAST_MODIFIED_TIME, path, opener_id, [&]() {
+		    return HedgedRequest<timestamp_t>(
+		        // Capture shared pointer to make sure it's always valid on access.
+		        [fs_ptr, wrapped_handle_ptr]() { return fs_ptr->GetLastModifiedTime(*wrapped_handle_ptr); },
+		        HedgedRequestOperation::GET_LAST_MODIFIED_TIME, path, config, entry);
+	    });
+	if (cache != nullptr) {
+		cache->PutLastModifiedTime(path, last_modified_time);
+	}
+	return last_modified_time;
 }
 
 string HedgedFileSystem::GetVersionTag(FileHandle &handle) {
+	const auto config = GetRequestConfig(handle.GetPath());
 	auto &hedged_handle = handle.Cast<HedgedFileHandle>();
 	auto *fs_ptr = wrapped_fs.get();
 	auto wrapped_handle_ptr = hedged_handle.GetWrappedHandlePtr();
-	auto config = entry->GetConfig();
-	return HedgedRequest<string>(
-	    std::function<string()>(
-	        // Capture shared pointer to make sure it's always valid on access.
-	        [fs_ptr, wrapped_handle_ptr]() { return fs_ptr->GetVersionTag(*wrapped_handle_ptr); }),
-	    config.delays_ms[NumericCast<size_t>(HedgedRequestOperation::GET_VERSION_TAG)], entry);
+	const auto opener_id = hedged_handle.GetOpenerId();
+	auto version_tag =
+	    CoalescedRequest<string>(config, HedgedRequestOperation::GET_VERSION_TAG, handle.GetPath(), opener_id, [&]() {
+		    return HedgedRequest<string>(
+		        // Capture shared pointer to make sure it's always valid on access.
+		        [fs_ptr, wrapped_handle_ptr]() { return fs_ptr->GetVersionTag(*wrapped_handle_ptr); },
+		        HedgedRequestOperation::GET_VERSION_TAG, handle.GetPath(), config, entry);
+	    });
+	// Version tag is always fetched, which keeps cached metadata consistent with the object version.
+	auto *cache = GetMetadataCache();
+	if (cache != nullptr) {
+		cache->PutVersionTag(handle.GetPath(), version_tag);
+	}
+	return version_tag;
 }
 
 FileType HedgedFileSystem::GetFileType(FileHandle &handle) {
+	const auto config = GetRequestConfig(handle.GetPath());
 	auto &hedged_handle = handle.Cast<HedgedFileHandle>();
 	auto *fs_ptr = wrapped_fs.get();
 	auto wrapped_handle_ptr = hedged_handle.GetWrappedHandlePtr();
-	auto config = entry->GetConfig();
-	return HedgedRequest<FileType>(
-	    std::function<FileType()>(
-	        // Capture shared pointer to make sure it's always valid on access.
-	        [fs_ptr, wrapped_handle_ptr]() { return fs_ptr->GetFileType(*wrapped_handle_ptr); }),
-	    config.delays_ms[NumericCast<size_t>(HedgedRequestOperation::GET_FILE_TYPE)], entry);
+	const auto opener_id = hedged_handle.GetOpenerId();
+	const auto &path = handle.GetPath();
+	return CoalescedRequest<FileType>(config, HedgedRequestOperation::GET_FILE_TYPE, path, opener_id, [&]() {
+		return HedgedRequest<FileType>(
+		    // Capture shared pointer to make sure it's always valid on access.
+		    [fs_ptr, wrapped_handle_ptr]() { return fs_ptr->GetFileType(*wrapped_handle_ptr); },
+		    HedgedRequestOperation::GET_FILE_TYPE, path, config, entry);
+	});
 }
 
 FileMetadata HedgedFileSystem::Stats(FileHandle &handle) {
+	handle.Cast<HedgedFileHandle>().FlushWriteBehind();
+	const auto &path = handle.GetPath();
+	auto *cache = GetMetadataCache();
+	FileMetadata stats;
+	if (cache != nullptr && cache->TryGetStats(path, stats)) {
+		return stats;
+	}
+
+	const auto config = GetRequestConfig(path);
 	auto &hedged_handle = handle.Cast<HedgedFileHandle>();
 	auto *fs_ptr = wrapped_fs.get();
 	auto wrapped_handle_ptr = hedged_handle.GetWrappedHandlePtr();
-	auto config = entry->GetConfig();
-	return HedgedRequest<FileMetadata>(
-	    std::function<FileMetadata()>(
-	        // Capture shared pointer to make sure it's always valid on access.
-	        [fs_ptr, wrapped_handle_ptr]() { return fs_ptr->Stats(*wrapped_handle_ptr); }),
-	    config.delays_ms[NumericCast<size_t>(HedgedRequestOperation::GET_STATS)], entry);
+	const auto opener_id = hedged_handle.GetOpenerId();
+	stats = CoalescedRequest<FileMetadata>(config, HedgedRequestOperation::GET_STATS, path, opener_id, [&]() {
+		return HedgedRequest<FileMetadata>(
+		    // Capture shared pointer to make sure it's always valid on access.
+		    [fs_ptr, wrapped_handle_ptr]() { return fs_ptr->Stats(*wrapped_handle_ptr); },
+		    HedgedRequestOperation::GET_STATS, path, config, entry);
+	});
+	if (cache != nullptr) {
+		cache->PutStats(path, stats);
+	}
+	return stats;
 }
 
 void HedgedFileSystem::CreateDirectory(const string &directory, optional_ptr<FileOpener> opener) {
+	const auto config = GetRequestConfig(directory);
 	auto *fs_ptr = wrapped_fs.get();
 	auto opener_copy = CopyFileOpener(opener);
-	auto config = entry->GetConfig();
 	HedgedRequest(std::function<void()>([fs_ptr, directory_copy = directory, opener_copy]() {
 		              fs_ptr->CreateDirectory(directory_copy, opener_copy.get());
 	              }),
-	              config.delays_ms[NumericCast<size_t>(HedgedRequestOperation::DIRECTORY_CREATE)], entry);
+	              HedgedRequestOperation::DIRECTORY_CREATE, directory, config, entry);
+	InvalidateMetadata(directory);
+	InvalidateListing(directory);
 }
 
 void HedgedFileSystem::CreateDirectoriesRecursive(const string &path, optional_ptr<FileOpener> opener) {
+	const auto config = GetRequestConfig(path);
 	auto *fs_ptr = wrapped_fs.get();
 	auto opener_copy = CopyFileOpener(opener);
-	auto config = entry->GetConfig();
 	HedgedRequest(std::function<void()>([fs_ptr, path_copy = path, opener_copy]() {
 		              fs_ptr->CreateDirectoriesRecursive(path_copy, opener_copy.get());
 	              }),
-	              config.delays_ms[NumericCast<size_t>(HedgedRequestOperation::DIRECTORY_CREATE)], entry);
+	              HedgedRequestOperation::DIRECTORY_CREATE, path, config, entry);
+	InvalidateMetadata(path);
+	InvalidateListing(path);
 }
 
 void HedgedFileSystem::RemoveFile(const string &filename, optional_ptr<FileOpener> opener) {
+	const auto config = GetRequestConfig(filename);
 	auto *fs_ptr = wrapped_fs.get();
 	auto opener_copy = CopyFileOpener(opener);
-	auto config = entry->GetConfig();
 	HedgedRequest(std::function<void()>([fs_ptr, filename_copy = filename, opener_copy]() {
 		              fs_ptr->RemoveFile(filename_copy, opener_copy.get());
 	              }),
-	              config.delays_ms[NumericCast<size_t>(HedgedRequestOperation::FILE_DELETE)], entry);
+	              HedgedRequestOperation::FILE_DELETE, filename, config, entry);
+	InvalidateMetadata(filename);
+	InvalidateListing(filename);
 }
 
 bool HedgedFileSystem::TryRemoveFile(const string &filename, optional_ptr<FileOpener> opener) {
+	const auto config = GetRequestConfig(filename);
 	auto *fs_ptr = wrapped_fs.get();
 	auto opener_copy = CopyFileOpener(opener);
-	auto config = entry->GetConfig();
 	auto removed =
 	    HedgedRequest<bool>(std::function<bool()>([fs_ptr, filename_copy = filename, opener_copy]() {
 		                        return fs_ptr->TryRemoveFile(filename_copy, opener_copy.get());
 	                        }),
-	                        config.delays_ms[NumericCast<size_t>(HedgedRequestOperation::FILE_DELETE)], entry);
+	                        HedgedRequestOperation::FILE_DELETE, filename, config, entry);
+	InvalidateMetadata(filename);
+	InvalidateListing(filename);
 	return removed;
 }
 
 void HedgedFileSystem::RemoveFiles(const vector<string> &filenames, optional_ptr<FileOpener> opener) {
+	const auto first_filename = filenames.empty() ? string() : filenames[0];
+	const auto config = GetRequestConfig(first_filename);
 	auto *fs_ptr = wrapped_fs.get();
 	auto opener_copy = CopyFileOpener(opener);
-	auto config = entry->GetConfig();
 	HedgedRequest(std::function<void()>([fs_ptr, filenames_copy = filenames, opener_copy]() {
 		              fs_ptr->RemoveFiles(filenames_copy, opener_copy.get());
 	              }),
-	              config.delays_ms[NumericCast<size_t>(HedgedRequestOperation::FILE_DELETE)], entry);
+	              HedgedRequestOperation::FILE_DELETE, first_filename, config, entry);
+	for (const auto &cur_filename : filenames) {
+		InvalidateMetadata(cur_filename);
+		InvalidateListing(cur_filename);
+	}
 }
 
 void HedgedFileSystem::RemoveDirectory(const string &directory, optional_ptr<FileOpener> opener) {
+	const auto config = GetRequestConfig(directory);
 	auto *fs_ptr = wrapped_fs.get();
 	auto opener_copy = CopyFileOpener(opener);
-	auto config = entry->GetConfig();
 	HedgedRequest(std::function<void()>([fs_ptr, directory_copy = directory, opener_copy]() {
 		              fs_ptr->RemoveDirectory(directory_copy, opener_copy.get());
 	              }),
-	              config.delays_ms[NumericCast<size_t>(HedgedRequestOperation::FILE_DELETE)], entry);
+	              HedgedRequestOperation::FILE_DELETE, directory, config, entry);
+	// All files under the directory are removed as well, along with their prefetched and pooled handles.
+	auto *cache = GetMetadataCache();
+	if (cache != nullptr) {
+		cache->InvalidatePrefix(directory);
+	}
+	entry->GetOpenPrefetchCache().ErasePrefix(GetHandleCacheKey(directory));
+	entry->GetFileHandlePool().ErasePrefix(GetHandleCacheKey(directory));
+	InvalidateListing(directory);
 }
 
 //===--------------------------------------------------------------------===//
 // HedgedFileHandle
 //===--------------------------------------------------------------------===//
 
-HedgedFileHandle::HedgedFileHandle(HedgedFileSystem &fs, unique_ptr<FileHandle> wrapped_handle, const string &path)
-    : FileHandle(fs, path, wrapped_handle->GetFlags()), hedged_fs(fs),
-      wrapped_handle(wrapped_handle.release(), [](FileHandle *handle) {
-	      if (handle) {
-		      handle->Close();
-		      delete handle;
-	      }
-      }) {
+HedgedFileHandle::HedgedFileHandle(HedgedFileSystem &fs, unique_ptr<FileHandle> wrapped_handle, const string &path,
+                                   uint64_t opener_id_p)
+    : HedgedFileHandle(fs, MakeSharedFileHandle(std::move(wrapped_handle)), path, opener_id_p) {
+}
+
+HedgedFileHandle::HedgedFileHandle(HedgedFileSystem &fs, shared_ptr<FileHandle> wrapped_handle_p, const string &path,
+                                   uint64_t opener_id_p)
+    : FileHandle(fs, path, wrapped_handle_p->GetFlags()), hedged_fs(fs), wrapped_handle(std::move(wrapped_handle_p)),
+      opener_id(opener_id_p) {
 }
 
 HedgedFileHandle::~HedgedFileHandle() {
+	// Don't lose buffered writes of a handle which isn't closed explicitly, there's no way to report failure though.
+	try {
+		FlushWriteBehind();
+	} catch (...) {
+	}
+	// Keep the wrapped handle for the next open of the same file, unless background reads still reference it; it's
+	// closed once they finish then.
+	sequential_read_state.window.reset();
+	if (wrapped_handle != nullptr && wrapped_handle.use_count() == 1) {
+		hedged_fs.PoolHandle(GetPath(), GetFlags(), std::move(wrapped_handle));
+	}
 }
 
 void HedgedFileHandle::Close() {
+	// Skip prefetches not started yet.
+	sequential_read_state.window.reset();
+	FlushWriteBehind();
+	if (wrapped_handle == nullptr) {
+		return;
+	}
+	// Background attempts still referencing the wrapped handle, e.g. losing hedged reads, close it once they finish.
+	auto handle = std::move(wrapped_handle);
+	if (handle.use_count() > 1) {
+		return;
+	}
+	// Otherwise it's pooled for the next open of the same file, or closed here so failures are reported.
+	if (!hedged_fs.PoolHandle(GetPath(), GetFlags(), handle)) {
+		handle->Close();
+	}
+}
+
+void HedgedFileHandle::FlushWriteBehind() {
+	if (write_behind_state.buffer == nullptr) {
+		return;
+	}
+	// Drop the buffer even on failure, so the failure is reported once and the handle is usable again.
+	auto buffer = std::move(write_behind_state.buffer);
+	const bool has_position = write_behind_state.has_position;
+	write_behind_state.has_position = false;
+	buffer->Flush();
+	if (has_position) {
+		wrapped_handle->Seek(write_behind_state.position);
+	}
 }
 
 } // namespace duckdb
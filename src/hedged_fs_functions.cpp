@@ -1,6 +1,8 @@
 #include "hedged_fs_functions.hpp"
 
 #include "duckdb/common/algorithm.hpp"
+#include "duckdb/common/error_data.hpp"
+#include "duckdb/common/numeric_utils.hpp"
 #include "duckdb/common/exception.hpp"
 #include "duckdb/common/file_system.hpp"
 #include "duckdb/common/opener_file_system.hpp"
@@ -12,6 +14,17 @@
 #include "duckdb/storage/object_cache.hpp"
 #include "hedged_file_system.hpp"
 #include "hedged_request_fs_entry.hpp"
+#include "hedged_request_stats.hpp"
+#include "hedging_policy.hpp"
+#include "latency_profile.hpp"
+#include "listing_cache.hpp"
+#include "metadata_cache.hpp"
+#include "request_trace.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <tuple>
 
 namespace duckdb {
 
@@ -31,6 +44,20 @@ shared_ptr<HedgedRequestFsEntry> GetOrCreateHedgedRequestFsEntry(ClientContext &
 	return object_cache.GetOrCreate<HedgedRequestFsEntry>(HedgedRequestFsEntry::ObjectType());
 }
 
+// Util to get or create MetadataCache
+shared_ptr<MetadataCache> GetOrCreateMetadataCache(ClientContext &context) {
+	auto &db = DatabaseInstance::GetDatabase(context);
+	auto &object_cache = db.GetObjectCache();
+	return object_cache.GetOrCreate<MetadataCache>(MetadataCache::ObjectType());
+}
+
+// Util to get or create ListingCache
+shared_ptr<ListingCache> GetOrCreateListingCache(ClientContext &context) {
+	auto &db = DatabaseInstance::GetDatabase(context);
+	auto &object_cache = db.GetObjectCache();
+	return object_cache.GetOrCreate<ListingCache>(ListingCache::ObjectType());
+}
+
 //===--------------------------------------------------------------------===//
 // hedged_fs_list_filesystems() - Table Function
 //===--------------------------------------------------------------------===//
@@ -80,6 +107,8 @@ void HedgedFsWrapFunction(DataChunk &args, ExpressionState &state, Vector &resul
 	auto &context = state.GetContext();
 	auto &vfs = GetVirtualFileSystem(context).Cast<VirtualFileSystem>();
 	auto entry = GetOrCreateHedgedRequestFsEntry(context);
+	auto metadata_cache = GetOrCreateMetadataCache(context);
+	auto listing_cache = GetOrCreateListingCache(context);
 
 	UnaryExecutor::Execute<string_t, bool>(args.data[0], result, args.size(), [&](string_t fs_name) {
 		string fs_str = fs_name.GetString();
@@ -89,7 +118,7 @@ void HedgedFsWrapFunction(DataChunk &args, ExpressionState &state, Vector &resul
 			    "Filesystem '%s' not found. Use hedged_fs_list_filesystems() to see available filesystems.", fs_str);
 		}
 
-		auto wrapped_fs = make_uniq<HedgedFileSystem>(std::move(extracted_fs), entry);
+		auto wrapped_fs = make_uniq<HedgedFileSystem>(std::move(extracted_fs), entry, metadata_cache, listing_cache);
 		string wrapped_name = wrapped_fs->GetName();
 		vfs.RegisterSubSystem(std::move(wrapped_fs));
 		auto &db = DatabaseInstance::GetDatabase(context);
@@ -100,6 +129,683 @@ void HedgedFsWrapFunction(DataChunk &args, ExpressionState &state, Vector &resul
 	});
 }
 
+//===--------------------------------------------------------------------===//
+// hedged_fs_set_policy(scope, target, option, value)
+//===--------------------------------------------------------------------===//
+
+void HedgedFsSetPolicyFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &context = state.GetContext();
+	auto entry = GetOrCreateHedgedRequestFsEntry(context);
+
+	for (idx_t row = 0; row < args.size(); ++row) {
+		auto scope = args.GetValue(0, row);
+		auto target = args.GetValue(1, row);
+		auto option = args.GetValue(2, row);
+		auto value = args.GetValue(3, row);
+		if (scope.IsNull() || target.IsNull() || option.IsNull() || value.IsNull()) {
+			throw InvalidInputException("hedged_fs_set_policy arguments cannot be NULL");
+		}
+		entry->SetPolicy(GetHedgingPolicyScope(scope.ToString()), target.ToString(), option.ToString(),
+		                 NumericCast<idx_t>(value.GetValue<uint64_t>()));
+		result.SetValue(row, Value::BOOLEAN(true));
+	}
+}
+
+//===--------------------------------------------------------------------===//
+// hedged_fs_clear_policies()
+//===--------------------------------------------------------------------===//
+
+void HedgedFsClearPoliciesFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &context = state.GetContext();
+	auto entry = GetOrCreateHedgedRequestFsEntry(context);
+	entry->ClearPolicies();
+	result.Reference(Value::BOOLEAN(true));
+}
+
+//===--------------------------------------------------------------------===//
+// hedged_fs_list_policies() - Table Function
+//===--------------------------------------------------------------------===//
+
+struct PolicyRow {
+	string scope;
+	string target;
+	string option;
+	idx_t value;
+};
+
+struct ListPoliciesData : public GlobalTableFunctionState {
+	vector<PolicyRow> rows;
+	idx_t current_idx;
+
+	ListPoliciesData() : current_idx(0) {
+	}
+};
+
+unique_ptr<FunctionData> ListPoliciesBind(ClientContext &context, TableFunctionBindInput &input,
+                                          vector<LogicalType> &return_types, vector<string> &names) {
+	names.emplace_back("scope");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+	names.emplace_back("target");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+	names.emplace_back("option");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+	names.emplace_back("value");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+	return nullptr;
+}
+
+unique_ptr<GlobalTableFunctionState> ListPoliciesInit(ClientContext &context, TableFunctionInitInput &input) {
+	auto result = make_uniq<ListPoliciesData>();
+	auto snapshot = GetOrCreateHedgedRequestFsEntry(context)->GetConfigSnapshot();
+
+	auto append_policy = [&result](HedgingPolicyScope scope, const string &target, const HedgingPolicy &policy) {
+		for (auto &cur_option : policy.ListOptions()) {
+			result->rows.emplace_back(
+			    PolicyRow {GetHedgingPolicyScopeName(scope), target, cur_option.first, cur_option.second});
+		}
+	};
+	for (const auto &cur_policy : snapshot->filesystem_policies) {
+		append_policy(HedgingPolicyScope::FILESYSTEM, cur_policy.first, cur_policy.second);
+	}
+	for (const auto &cur_policy : snapshot->prefix_policies) {
+		append_policy(HedgingPolicyScope::PREFIX, cur_policy.first, cur_policy.second);
+	}
+	std::sort(result->rows.begin(), result->rows.end(), [](const PolicyRow &lhs, const PolicyRow &rhs) {
+		return std::tie(lhs.scope, lhs.target, lhs.option) < std::tie(rhs.scope, rhs.target, rhs.option);
+	});
+	return std::move(result);
+}
+
+void ListPoliciesFunction(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
+	auto &state = data.global_state->Cast<ListPoliciesData>();
+
+	idx_t count = 0;
+	while (state.current_idx < state.rows.size() && count < STANDARD_VECTOR_SIZE) {
+		const auto &cur_row = state.rows[state.current_idx];
+		output.SetValue(0, count, Value(cur_row.scope));
+		output.SetValue(1, count, Value(cur_row.target));
+		output.SetValue(2, count, Value(cur_row.option));
+		output.SetValue(3, count, Value::UBIGINT(cur_row.value));
+
+		state.current_idx++;
+		count++;
+	}
+
+	output.SetCardinality(count);
+}
+
+//===--------------------------------------------------------------------===//
+// hedged_fs_add_replica(prefix, replica_prefix)
+//===--------------------------------------------------------------------===//
+
+void HedgedFsAddReplicaFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &context = state.GetContext();
+	auto entry = GetOrCreateHedgedRequestFsEntry(context);
+
+	for (idx_t row = 0; row < args.size(); ++row) {
+		auto prefix = args.GetValue(0, row);
+		auto replica_prefix = args.GetValue(1, row);
+		if (prefix.IsNull() || replica_prefix.IsNull()) {
+			throw InvalidInputException("hedged_fs_add_replica arguments cannot be NULL");
+		}
+		entry->AddReplica(prefix.ToString(), replica_prefix.ToString());
+		result.SetValue(row, Value::BOOLEAN(true));
+	}
+}
+
+//===--------------------------------------------------------------------===//
+// hedged_fs_clear_replicas()
+//===--------------------------------------------------------------------===//
+
+void HedgedFsClearReplicasFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &context = state.GetContext();
+	auto entry = GetOrCreateHedgedRequestFsEntry(context);
+	entry->ClearReplicas();
+	result.Reference(Value::BOOLEAN(true));
+}
+
+//===--------------------------------------------------------------------===//
+// hedged_fs_list_replicas() - Table Function
+//===--------------------------------------------------------------------===//
+
+struct ListReplicasData : public GlobalTableFunctionState {
+	vector<std::pair<string, string>> rows;
+	idx_t current_idx;
+
+	ListReplicasData() : current_idx(0) {
+	}
+};
+
+unique_ptr<FunctionData> ListReplicasBind(ClientContext &context, TableFunctionBindInput &input,
+                                          vector<LogicalType> &return_types, vector<string> &names) {
+	names.emplace_back("prefix");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+	names.emplace_back("replica_prefix");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+	return nullptr;
+}
+
+unique_ptr<GlobalTableFunctionState> ListReplicasInit(ClientContext &context, TableFunctionInitInput &input) {
+	auto result = make_uniq<ListReplicasData>();
+	auto snapshot = GetOrCreateHedgedRequestFsEntry(context)->GetConfigSnapshot();
+	for (const auto &cur_replica : snapshot->replica_prefixes) {
+		for (const auto &cur_replica_prefix : cur_replica.second) {
+			result->rows.emplace_back(cur_replica.first, cur_replica_prefix);
+		}
+	}
+	// Keep rotation order of mirrors within a prefix.
+	std::stable_sort(result->rows.begin(), result->rows.end(),
+	                 [](const std::pair<string, string> &lhs, const std::pair<string, string> &rhs) {
+		                 return lhs.first < rhs.first;
+	                 });
+	return std::move(result);
+}
+
+void ListReplicasFunction(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
+	auto &state = data.global_state->Cast<ListReplicasData>();
+
+	idx_t count = 0;
+	while (state.current_idx < state.rows.size() && count < STANDARD_VECTOR_SIZE) {
+		const auto &cur_row = state.rows[state.current_idx];
+		output.SetValue(0, count, Value(cur_row.first));
+		output.SetValue(1, count, Value(cur_row.second));
+
+		state.current_idx++;
+		count++;
+	}
+
+	output.SetCardinality(count);
+}
+
+//===--------------------------------------------------------------------===//
+// hedged_fs_stats() - Table Function
+//===--------------------------------------------------------------------===//
+
+struct StatsData : public GlobalTableFunctionState {
+	vector<HedgedOperationStats> stats;
+	idx_t current_idx;
+
+	StatsData() : current_idx(0) {
+	}
+};
+
+LogicalType GetLatencyBucketType() {
+	child_list_t<LogicalType> children;
+	children.emplace_back("upper_bound_us", LogicalType {LogicalTypeId::UBIGINT});
+	children.emplace_back("count", LogicalType {LogicalTypeId::UBIGINT});
+	return LogicalType::STRUCT(std::move(children));
+}
+
+unique_ptr<FunctionData> StatsBind(ClientContext &context, TableFunctionBindInput &input,
+                                   vector<LogicalType> &return_types, vector<string> &names) {
+	names.emplace_back("operation");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+	names.emplace_back("primary_requests");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+	names.emplace_back("hedged_requests");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+	names.emplace_back("hedge_wins");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+	names.emplace_back("failed_attempts");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+	names.emplace_back("skipped_attempts");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+	names.emplace_back("suppressed_hedges");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+	names.emplace_back("inline_requests");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+	names.emplace_back("pending_attempts");
+	return_types.emplace_back(LogicalType {LogicalTypeId::BIGINT});
+	names.emplace_back("hedge_win_rate");
+	return_types.emplace_back(LogicalType {LogicalTypeId::DOUBLE});
+	names.emplace_back("latency_histogram");
+	return_types.emplace_back(LogicalType::LIST(GetLatencyBucketType()));
+	return nullptr;
+}
+
+unique_ptr<GlobalTableFunctionState> StatsInit(ClientContext &context, TableFunctionInitInput &input) {
+	auto result = make_uniq<StatsData>();
+	auto stats = GetOrCreateHedgedRequestFsEntry(context)->GetStats();
+	for (size_t idx = 0; idx < static_cast<size_t>(HedgedRequestOperation::COUNT); ++idx) {
+		result->stats.emplace_back(stats->GetStats(static_cast<HedgedRequestOperation>(idx)));
+	}
+	return std::move(result);
+}
+
+// Only non-empty buckets are emitted, to keep the histogram readable.
+Value GetLatencyHistogramValue(const HedgedOperationStats &stats) {
+	vector<Value> buckets;
+	for (idx_t idx = 0; idx < HedgedOperationStats::LATENCY_BUCKET_COUNT; ++idx) {
+		if (stats.latency_histogram[idx] == 0) {
+			continue;
+		}
+		child_list_t<Value> bucket;
+		bucket.emplace_back("upper_bound_us", Value::UBIGINT(HedgedOperationStats::GetLatencyBucketUpperBound(idx)));
+		bucket.emplace_back("count", Value::UBIGINT(stats.latency_histogram[idx]));
+		buckets.emplace_back(Value::STRUCT(std::move(bucket)));
+	}
+	return Value::LIST(GetLatencyBucketType(), std::move(buckets));
+}
+
+void StatsFunction(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
+	auto &state = data.global_state->Cast<StatsData>();
+
+	idx_t count = 0;
+	while (state.current_idx < state.stats.size() && count < STANDARD_VECTOR_SIZE) {
+		const auto &cur_stats = state.stats[state.current_idx];
+		const auto operation = static_cast<HedgedRequestOperation>(state.current_idx);
+		output.SetValue(0, count, Value(GetHedgedRequestOperationName(operation)));
+		output.SetValue(1, count, Value::UBIGINT(cur_stats.primary_requests));
+		output.SetValue(2, count, Value::UBIGINT(cur_stats.hedged_requests));
+		output.SetValue(3, count, Value::UBIGINT(cur_stats.hedge_wins));
+		output.SetValue(4, count, Value::UBIGINT(cur_stats.failed_attempts));
+		output.SetValue(5, count, Value::UBIGINT(cur_stats.skipped_attempts));
+		output.SetValue(6, count, Value::UBIGINT(cur_stats.suppressed_hedges));
+		output.SetValue(7, count, Value::UBIGINT(cur_stats.inline_requests));
+		output.SetValue(8, count, Value::BIGINT(cur_stats.pending_attempts));
+		// Win rate is undefined when no hedged request has been issued.
+		output.SetValue(9, count,
+		                cur_stats.hedged_requests == 0
+		                    ? Value(LogicalType {LogicalTypeId::DOUBLE})
+		                    : Value::DOUBLE(static_cast<double>(cur_stats.hedge_wins) /
+		                                    static_cast<double>(cur_stats.hedged_requests)));
+		output.SetValue(10, count, GetLatencyHistogramValue(cur_stats));
+
+		state.current_idx++;
+		count++;
+	}
+
+	output.SetCardinality(count);
+}
+
+//===--------------------------------------------------------------------===//
+// hedged_fs_thread_pool_stats() - Table Function
+//===--------------------------------------------------------------------===//
+
+struct ThreadPoolStatsData : public GlobalTableFunctionState {
+	vector<JobQueueStats> stats;
+	idx_t current_idx;
+
+	ThreadPoolStatsData() : current_idx(0) {
+	}
+};
+
+unique_ptr<FunctionData> ThreadPoolStatsBind(ClientContext &context, TableFunctionBindInput &input,
+                                             vector<LogicalType> &return_types, vector<string> &names) {
+	names.emplace_back("priority");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+	names.emplace_back("queued_jobs");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+	names.emplace_back("dequeued_jobs");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+	names.emplace_back("avg_wait_us");
+	return_types.emplace_back(LogicalType {LogicalTypeId::DOUBLE});
+	names.emplace_back("recent_wait_us");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+	return nullptr;
+}
+
+unique_ptr<GlobalTableFunctionState> ThreadPoolStatsInit(ClientContext &context, TableFunctionInitInput &input) {
+	auto result = make_uniq<ThreadPoolStatsData>();
+	auto &thread_pool = GetOrCreateHedgedRequestFsEntry(context)->GetThreadPool();
+	for (size_t idx = 0; idx < static_cast<size_t>(JobPriority::COUNT); ++idx) {
+		result->stats.emplace_back(thread_pool.GetQueueStats(static_cast<JobPriority>(idx)));
+	}
+	return std::move(result);
+}
+
+void ThreadPoolStatsFunction(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
+	auto &state = data.global_state->Cast<ThreadPoolStatsData>();
+
+	idx_t count = 0;
+	while (state.current_idx < state.stats.size() && count < STANDARD_VECTOR_SIZE) {
+		const auto &cur_stats = state.stats[state.current_idx];
+		const auto priority = static_cast<JobPriority>(state.current_idx);
+		output.SetValue(0, count, Value(GetJobPriorityName(priority)));
+		output.SetValue(1, count, Value::UBIGINT(cur_stats.queued_jobs));
+		output.SetValue(2, count, Value::UBIGINT(cur_stats.dequeued_jobs));
+		// Average wait is undefined when no job has been dequeued.
+		output.SetValue(3, count,
+		                cur_stats.dequeued_jobs == 0
+		                    ? Value(LogicalType {LogicalTypeId::DOUBLE})
+		                    : Value::DOUBLE(static_cast<double>(cur_stats.total_wait_us) /
+		                                    static_cast<double>(cur_stats.dequeued_jobs)));
+		output.SetValue(4, count, Value::UBIGINT(cur_stats.recent_wait_us));
+
+		state.current_idx++;
+		count++;
+	}
+
+	output.SetCardinality(count);
+}
+
+//===--------------------------------------------------------------------===//
+// hedged_fs_recent_requests() - Table Function
+//===--------------------------------------------------------------------===//
+
+struct RecentRequestsData : public GlobalTableFunctionState {
+	vector<RequestTraceEvent> events;
+	idx_t current_idx;
+
+	RecentRequestsData() : current_idx(0) {
+	}
+};
+
+LogicalType GetRequestTraceAttemptType() {
+	child_list_t<LogicalType> children;
+	children.emplace_back("submit_us", LogicalType {LogicalTypeId::BIGINT});
+	children.emplace_back("start_us", LogicalType {LogicalTypeId::BIGINT});
+	children.emplace_back("finish_us", LogicalType {LogicalTypeId::BIGINT});
+	children.emplace_back("failed", LogicalType {LogicalTypeId::BOOLEAN});
+	return LogicalType::STRUCT(std::move(children));
+}
+
+unique_ptr<FunctionData> RecentRequestsBind(ClientContext &context, TableFunctionBindInput &input,
+                                            vector<LogicalType> &return_types, vector<string> &names) {
+	names.emplace_back("request_id");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+	names.emplace_back("operation");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+	names.emplace_back("path_hash");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+	names.emplace_back("path_prefix");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+	names.emplace_back("start_time");
+	return_types.emplace_back(LogicalType {LogicalTypeId::TIMESTAMP});
+	names.emplace_back("latency_us");
+	return_types.emplace_back(LogicalType {LogicalTypeId::BIGINT});
+	names.emplace_back("attempt_count");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+	names.emplace_back("winner_attempt");
+	return_types.emplace_back(LogicalType {LogicalTypeId::BIGINT});
+	names.emplace_back("failed");
+	return_types.emplace_back(LogicalType {LogicalTypeId::BOOLEAN});
+	names.emplace_back("error");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+	names.emplace_back("attempts");
+	return_types.emplace_back(LogicalType::LIST(GetRequestTraceAttemptType()));
+	return nullptr;
+}
+
+unique_ptr<GlobalTableFunctionState> RecentRequestsInit(ClientContext &context, TableFunctionInitInput &input) {
+	auto result = make_uniq<RecentRequestsData>();
+	result->events = GetOrCreateHedgedRequestFsEntry(context)->GetRequestTrace().GetRecentEvents();
+	return std::move(result);
+}
+
+// Stages an attempt didn't reach before the event was published are NULL.
+Value GetTraceTimestampValue(int64_t value_us) {
+	return value_us < 0 ? Value(LogicalType {LogicalTypeId::BIGINT}) : Value::BIGINT(value_us);
+}
+
+// Only traced attempts are emitted, namely the first RequestTraceEvent::MAX_ATTEMPTS of them.
+Value GetRequestTraceAttemptsValue(const RequestTraceEvent &event) {
+	vector<Value> attempts;
+	const auto traced_count = MinValue<uint64_t>(event.attempt_count, RequestTraceEvent::MAX_ATTEMPTS);
+	for (idx_t idx = 0; idx < traced_count; ++idx) {
+		const auto &cur_attempt = event.attempts[idx];
+		child_list_t<Value> attempt;
+		attempt.emplace_back("submit_us", GetTraceTimestampValue(cur_attempt.submit_us));
+		attempt.emplace_back("start_us", GetTraceTimestampValue(cur_attempt.start_us));
+		attempt.emplace_back("finish_us", GetTraceTimestampValue(cur_attempt.finish_us));
+		attempt.emplace_back("failed", Value::BOOLEAN(cur_attempt.failed));
+		attempts.emplace_back(Value::STRUCT(std::move(attempt)));
+	}
+	return Value::LIST(GetRequestTraceAttemptType(), std::move(attempts));
+}
+
+void RecentRequestsFunction(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
+	auto &state = data.global_state->Cast<RecentRequestsData>();
+
+	idx_t count = 0;
+	while (state.current_idx < state.events.size() && count < STANDARD_VECTOR_SIZE) {
+		const auto &cur_event = state.events[state.current_idx];
+		output.SetValue(0, count, Value::UBIGINT(cur_event.request_id));
+		output.SetValue(1, count, Value(GetHedgedRequestOperationName(cur_event.operation)));
+		output.SetValue(2, count, Value::UBIGINT(cur_event.path_hash));
+		output.SetValue(3, count, Value(string(cur_event.path_prefix)));
+		output.SetValue(4, count, Value::TIMESTAMP(timestamp_t(cur_event.start_time_us)));
+		output.SetValue(5, count, Value::BIGINT(cur_event.latency_us));
+		output.SetValue(6, count, Value::UBIGINT(cur_event.attempt_count));
+		output.SetValue(7, count,
+		                cur_event.winner_attempt < 0 ? Value(LogicalType {LogicalTypeId::BIGINT})
+		                                             : Value::BIGINT(cur_event.winner_attempt));
+		output.SetValue(8, count, Value::BOOLEAN(cur_event.failed));
+		output.SetValue(9, count,
+		                cur_event.error[0] == '\0' ? Value(LogicalType {LogicalTypeId::VARCHAR})
+		                                           : Value(string(cur_event.error)));
+		output.SetValue(10, count, GetRequestTraceAttemptsValue(cur_event));
+
+		state.current_idx++;
+		count++;
+	}
+
+	output.SetCardinality(count);
+}
+
+//===--------------------------------------------------------------------===//
+// hedged_fs_reset_stats()
+//===--------------------------------------------------------------------===//
+
+void HedgedFsResetStatsFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &context = state.GetContext();
+	auto entry = GetOrCreateHedgedRequestFsEntry(context);
+	entry->GetStats()->Reset();
+	result.Reference(Value::BOOLEAN(true));
+}
+
+//===--------------------------------------------------------------------===//
+// hedged_fs_invalidate_metadata_cache(path_prefix)
+//===--------------------------------------------------------------------===//
+
+void HedgedFsInvalidateMetadataCacheFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &context = state.GetContext();
+	auto metadata_cache = GetOrCreateMetadataCache(context);
+
+	UnaryExecutor::Execute<string_t, bool>(args.data[0], result, args.size(), [&](string_t path_prefix) {
+		metadata_cache->InvalidatePrefix(path_prefix.GetString());
+		return true;
+	});
+}
+
+//===--------------------------------------------------------------------===//
+// hedged_fs_invalidate_listing_cache(path_prefix)
+//===--------------------------------------------------------------------===//
+
+void HedgedFsInvalidateListingCacheFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &context = state.GetContext();
+	auto listing_cache = GetOrCreateListingCache(context);
+
+	UnaryExecutor::Execute<string_t, bool>(args.data[0], result, args.size(), [&](string_t path_prefix) {
+		listing_cache->InvalidatePrefix(path_prefix.GetString());
+		return true;
+	});
+}
+
+//===--------------------------------------------------------------------===//
+// hedged_fs_prefetch_metadata(pattern) - Table Function
+//===--------------------------------------------------------------------===//
+
+struct PrefetchMetadataBindData : public TableFunctionData {
+	// Glob patterns or plain paths, expanded in order.
+	vector<string> patterns;
+};
+
+struct PrefetchMetadataRow {
+	string path;
+	FileMetadata metadata;
+	double latency_ms = 0;
+	uint64_t hedged_requests = 0;
+	// Error message if the file failed to open or stat, empty on success.
+	string error;
+};
+
+struct PrefetchMetadataData : public GlobalTableFunctionState {
+	vector<PrefetchMetadataRow> rows;
+	idx_t current_idx;
+
+	PrefetchMetadataData() : current_idx(0) {
+	}
+};
+
+unique_ptr<FunctionData> PrefetchMetadataBind(ClientContext &context, TableFunctionBindInput &input,
+                                              vector<LogicalType> &return_types, vector<string> &names) {
+	auto result = make_uniq<PrefetchMetadataBindData>();
+	const auto &pattern = input.inputs[0];
+	if (pattern.IsNull()) {
+		throw InvalidInputException("hedged_fs_prefetch_metadata argument cannot be NULL");
+	}
+	if (pattern.type().id() == LogicalTypeId::LIST) {
+		for (const auto &cur_pattern : ListValue::GetChildren(pattern)) {
+			if (cur_pattern.IsNull()) {
+				throw InvalidInputException("hedged_fs_prefetch_metadata paths cannot be NULL");
+			}
+			result->patterns.emplace_back(cur_pattern.ToString());
+		}
+	} else {
+		result->patterns.emplace_back(pattern.ToString());
+	}
+
+	names.emplace_back("path");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+	names.emplace_back("file_size");
+	return_types.emplace_back(LogicalType {LogicalTypeId::BIGINT});
+	names.emplace_back("last_modified");
+	return_types.emplace_back(LogicalType {LogicalTypeId::TIMESTAMP});
+	names.emplace_back("latency_ms");
+	return_types.emplace_back(LogicalType {LogicalTypeId::DOUBLE});
+	names.emplace_back("hedged_requests");
+	return_types.emplace_back(LogicalType {LogicalTypeId::UBIGINT});
+	names.emplace_back("error");
+	return_types.emplace_back(LogicalType {LogicalTypeId::VARCHAR});
+	return std::move(result);
+}
+
+// Open and stat [row.path] through [fs], so the metadata cache and the handle pool of the hedged filesystem serving
+// the path are warmed up; failures are reported in the row instead of failing the whole prefetch.
+void PrefetchFileMetadata(FileSystem &fs, MetadataCache &metadata_cache, PrefetchMetadataRow &row) {
+	ScopedHedgeCounter hedge_counter;
+	const auto start = std::chrono::steady_clock::now();
+	try {
+		// The handle returns into the handle pool on destruction, if the pool is enabled.
+		auto handle = fs.OpenFile(row.path, FileFlags::FILE_FLAGS_READ);
+		row.metadata = fs.Stats(*handle);
+		// Stats are cached by the hedged filesystem, fill the other metadata derived from them as well.
+		if (metadata_cache.IsEnabled()) {
+			metadata_cache.PutFileExists(row.path, true);
+			if (row.metadata.file_size >= 0) {
+				metadata_cache.PutFileSize(row.path, row.metadata.file_size);
+			}
+			metadata_cache.PutLastModifiedTime(row.path, row.metadata.last_modification_time);
+		}
+	} catch (const std::exception &ex) {
+		row.error = ErrorData(ex).RawMessage();
+	}
+	const auto elapsed = std::chrono::steady_clock::now() - start;
+	row.latency_ms = std::chrono::duration<double, std::milli>(elapsed).count();
+	row.hedged_requests = hedge_counter.GetHedgedRequestCount();
+}
+
+unique_ptr<GlobalTableFunctionState> PrefetchMetadataInit(ClientContext &context, TableFunctionInitInput &input) {
+	auto result = make_uniq<PrefetchMetadataData>();
+	const auto &bind_data = input.bind_data->Cast<PrefetchMetadataBindData>();
+	// Client filesystem routes to the hedged filesystem wrapping each path, and resolves secrets with the client
+	// context.
+	auto &fs = FileSystem::GetFileSystem(context);
+	auto entry = GetOrCreateHedgedRequestFsEntry(context);
+	auto metadata_cache = GetOrCreateMetadataCache(context);
+
+	for (const auto &cur_pattern : bind_data.patterns) {
+		for (auto &cur_file : fs.Glob(cur_pattern)) {
+			PrefetchMetadataRow row;
+			row.path = std::move(cur_file.path);
+			result->rows.emplace_back(std::move(row));
+		}
+	}
+	if (result->rows.empty()) {
+		return std::move(result);
+	}
+
+	// Each worker picks the next file, so a slow file only holds up one worker.
+	auto &rows = result->rows;
+	std::atomic<idx_t> next_row {0};
+	auto prefetch_files = [&]() {
+		while (true) {
+			const auto row_idx = next_row.fetch_add(1, std::memory_order_relaxed);
+			if (row_idx >= rows.size()) {
+				return;
+			}
+			PrefetchFileMetadata(fs, *metadata_cache, rows[row_idx]);
+		}
+	};
+	const auto worker_count = MinValue<idx_t>(entry->GetConfig().metadata_prefetch_concurrency, rows.size());
+	vector<std::future<void>> workers;
+	workers.reserve(worker_count);
+	for (idx_t idx = 0; idx < worker_count; ++idx) {
+		workers.emplace_back(entry->GetThreadPool().Push(prefetch_files));
+	}
+	// Workers reference local states, wait for all of them before rethrowing any failure.
+	for (auto &cur_worker : workers) {
+		cur_worker.wait();
+	}
+	for (auto &cur_worker : workers) {
+		cur_worker.get();
+	}
+	return std::move(result);
+}
+
+void PrefetchMetadataFunction(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
+	auto &state = data.global_state->Cast<PrefetchMetadataData>();
+
+	idx_t count = 0;
+	while (state.current_idx < state.rows.size() && count < STANDARD_VECTOR_SIZE) {
+		const auto &cur_row = state.rows[state.current_idx];
+		const bool failed = !cur_row.error.empty();
+		output.SetValue(0, count, Value(cur_row.path));
+		// Metadata is NULL if the file failed to open or stat, or the filesystem doesn't report it.
+		output.SetValue(1, count,
+		                failed || cur_row.metadata.file_size < 0 ? Value(LogicalType {LogicalTypeId::BIGINT})
+		                                                         : Value::BIGINT(cur_row.metadata.file_size));
+		output.SetValue(2, count,
+		                failed ? Value(LogicalType {LogicalTypeId::TIMESTAMP})
+		                       : Value::TIMESTAMP(cur_row.metadata.last_modification_time));
+		output.SetValue(3, count, Value::DOUBLE(cur_row.latency_ms));
+		output.SetValue(4, count, Value::UBIGINT(cur_row.hedged_requests));
+		output.SetValue(5, count, failed ? Value(cur_row.error) : Value(LogicalType {LogicalTypeId::VARCHAR}));
+
+		state.current_idx++;
+		count++;
+	}
+
+	output.SetCardinality(count);
+}
+
+//===--------------------------------------------------------------------===//
+// hedged_fs_save_profile(path) / hedged_fs_load_profile(path)
+//===--------------------------------------------------------------------===//
+
+void HedgedFsSaveProfileFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &context = state.GetContext();
+	auto &fs = FileSystem::GetFileSystem(context);
+	auto entry = GetOrCreateHedgedRequestFsEntry(context);
+
+	UnaryExecutor::Execute<string_t, bool>(args.data[0], result, args.size(), [&](string_t path) {
+		SaveLatencyProfile(fs, path.GetString(), *entry->GetLatencyTracker());
+		return true;
+	});
+}
+
+void HedgedFsLoadProfileFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &context = state.GetContext();
+	auto &fs = FileSystem::GetFileSystem(context);
+	auto entry = GetOrCreateHedgedRequestFsEntry(context);
+
+	UnaryExecutor::Execute<string_t, bool>(args.data[0], result, args.size(), [&](string_t path) {
+		LoadLatencyProfile(fs, path.GetString(), *entry->GetLatencyTracker());
+		return true;
+	});
+}
+
 } // namespace
 
 TableFunction GetHedgedFsListFilesystemsFunction() {
@@ -113,4 +819,95 @@ ScalarFunction GetHedgedFsWrapFunction() {
 	                      /*return_type=*/LogicalType {LogicalTypeId::BOOLEAN}, HedgedFsWrapFunction);
 }
 
+ScalarFunction GetHedgedFsSetPolicyFunction() {
+	return ScalarFunction("hedged_fs_set_policy",
+	                      {/*scope=*/LogicalType {LogicalTypeId::VARCHAR},
+	                       /*target=*/LogicalType {LogicalTypeId::VARCHAR},
+	                       /*option=*/LogicalType {LogicalTypeId::VARCHAR},
+	                       /*value=*/LogicalType {LogicalTypeId::UBIGINT}},
+	                      /*return_type=*/LogicalType {LogicalTypeId::BOOLEAN}, HedgedFsSetPolicyFunction);
+}
+
+ScalarFunction GetHedgedFsClearPoliciesFunction() {
+	return ScalarFunction("hedged_fs_clear_policies", {}, /*return_type=*/LogicalType {LogicalTypeId::BOOLEAN},
+	                      HedgedFsClearPoliciesFunction);
+}
+
+TableFunction GetHedgedFsListPoliciesFunction() {
+	TableFunction func("hedged_fs_list_policies", {}, ListPoliciesFunction, ListPoliciesBind, ListPoliciesInit);
+	return func;
+}
+
+ScalarFunction GetHedgedFsAddReplicaFunction() {
+	return ScalarFunction("hedged_fs_add_replica",
+	                      {/*prefix=*/LogicalType {LogicalTypeId::VARCHAR},
+	                       /*replica_prefix=*/LogicalType {LogicalTypeId::VARCHAR}},
+	                      /*return_type=*/LogicalType {LogicalTypeId::BOOLEAN}, HedgedFsAddReplicaFunction);
+}
+
+ScalarFunction GetHedgedFsClearReplicasFunction() {
+	return ScalarFunction("hedged_fs_clear_replicas", {}, /*return_type=*/LogicalType {LogicalTypeId::BOOLEAN},
+	                      HedgedFsClearReplicasFunction);
+}
+
+TableFunction GetHedgedFsListReplicasFunction() {
+	TableFunction func("hedged_fs_list_replicas", {}, ListReplicasFunction, ListReplicasBind, ListReplicasInit);
+	return func;
+}
+
+TableFunction GetHedgedFsStatsFunction() {
+	TableFunction func("hedged_fs_stats", {}, StatsFunction, StatsBind, StatsInit);
+	return func;
+}
+
+TableFunction GetHedgedFsThreadPoolStatsFunction() {
+	TableFunction func("hedged_fs_thread_pool_stats", {}, ThreadPoolStatsFunction, ThreadPoolStatsBind,
+	                   ThreadPoolStatsInit);
+	return func;
+}
+
+TableFunction GetHedgedFsRecentRequestsFunction() {
+	TableFunction func("hedged_fs_recent_requests", {}, RecentRequestsFunction, RecentRequestsBind,
+	                   RecentRequestsInit);
+	return func;
+}
+
+ScalarFunction GetHedgedFsResetStatsFunction() {
+	return ScalarFunction("hedged_fs_reset_stats", {}, /*return_type=*/LogicalType {LogicalTypeId::BOOLEAN},
+	                      HedgedFsResetStatsFunction);
+}
+
+ScalarFunction GetHedgedFsInvalidateMetadataCacheFunction() {
+	return ScalarFunction("hedged_fs_invalidate_metadata_cache",
+	                      {/*path_prefix=*/LogicalType {LogicalTypeId::VARCHAR}},
+	                      /*return_type=*/LogicalType {LogicalTypeId::BOOLEAN},
+	                      HedgedFsInvalidateMetadataCacheFunction);
+}
+
+ScalarFunction GetHedgedFsInvalidateListingCacheFunction() {
+	return ScalarFunction("hedged_fs_invalidate_listing_cache",
+	                      {/*path_prefix=*/LogicalType {LogicalTypeId::VARCHAR}},
+	                      /*return_type=*/LogicalType {LogicalTypeId::BOOLEAN},
+	                      HedgedFsInvalidateListingCacheFunction);
+}
+
+TableFunctionSet GetHedgedFsPrefetchMetadataFunction() {
+	TableFunctionSet set("hedged_fs_prefetch_metadata");
+	for (auto &cur_type : {LogicalType {LogicalTypeId::VARCHAR}, LogicalType::LIST(LogicalTypeId::VARCHAR)}) {
+		set.AddFunction(TableFunction({/*pattern=*/cur_type}, PrefetchMetadataFunction, PrefetchMetadataBind,
+		                              PrefetchMetadataInit));
+	}
+	return set;
+}
+
+ScalarFunction GetHedgedFsSaveProfileFunction() {
+	return ScalarFunction("hedged_fs_save_profile", {/*path=*/LogicalType {LogicalTypeId::VARCHAR}},
+	                      /*return_type=*/LogicalType {LogicalTypeId::BOOLEAN}, HedgedFsSaveProfileFunction);
+}
+
+ScalarFunction GetHedgedFsLoadProfileFunction() {
+	return ScalarFunction("hedged_fs_load_profile", {/*path=*/LogicalType {LogicalTypeId::VARCHAR}},
+	                      /*return_type=*/LogicalType {LogicalTypeId::BOOLEAN}, HedgedFsLoadProfileFunction);
+}
+
 } // namespace duckdb
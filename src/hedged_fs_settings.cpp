@@ -1,12 +1,16 @@
 #include "hedged_fs_settings.hpp"
 
 #include "duckdb/common/exception.hpp"
+#include "duckdb/common/file_system.hpp"
 #include "duckdb/common/numeric_utils.hpp"
 #include "duckdb/main/client_context.hpp"
 #include "duckdb/main/database.hpp"
 #include "duckdb/storage/object_cache.hpp"
 #include "hedged_request_config.hpp"
 #include "hedged_request_fs_entry.hpp"
+#include "latency_profile.hpp"
+#include "listing_cache.hpp"
+#include "metadata_cache.hpp"
 
 namespace duckdb {
 
@@ -86,6 +90,16 @@ void SetDirectoryCreateHedgingDelay(ClientContext &context, SetScope scope, Valu
 	                  value_ms);
 }
 
+void SetReadHedgingDelay(ClientContext &context, SetScope scope, Value &parameter) {
+	auto value_ms = parameter.GetValue<uint64_t>();
+	UpdateConfigDelay(context, scope, "hedged_fs_read_delay_ms", HedgedRequestOperation::READ, value_ms);
+}
+
+void SetWriteHedgingDelay(ClientContext &context, SetScope scope, Value &parameter) {
+	auto value_ms = parameter.GetValue<uint64_t>();
+	UpdateConfigDelay(context, scope, "hedged_fs_write_delay_ms", HedgedRequestOperation::WRITE, value_ms);
+}
+
 void SetMaxHedgedRequestCount(ClientContext &context, SetScope scope, Value &parameter) {
 	auto max_count = parameter.GetValue<uint64_t>();
 	auto &db = DatabaseInstance::GetDatabase(context);
@@ -94,6 +108,398 @@ void SetMaxHedgedRequestCount(ClientContext &context, SetScope scope, Value &par
 	entry->UpdateMaxHedgedRequestCount(NumericCast<size_t>(max_count));
 }
 
+void SetEnableReadHedging(ClientContext &context, SetScope scope, Value &parameter) {
+	auto enable = parameter.GetValue<bool>();
+	auto &db = DatabaseInstance::GetDatabase(context);
+	auto &object_cache = db.GetObjectCache();
+	auto entry = object_cache.GetOrCreate<HedgedRequestFsEntry>(HedgedRequestFsEntry::ObjectType());
+	entry->UpdateEnableReadHedging(enable);
+}
+
+void SetEnableChunkedRead(ClientContext &context, SetScope scope, Value &parameter) {
+	auto enable = parameter.GetValue<bool>();
+	auto &db = DatabaseInstance::GetDatabase(context);
+	auto &object_cache = db.GetObjectCache();
+	auto entry = object_cache.GetOrCreate<HedgedRequestFsEntry>(HedgedRequestFsEntry::ObjectType());
+	entry->UpdateEnableChunkedRead(enable);
+}
+
+void SetChunkedReadThreshold(ClientContext &context, SetScope scope, Value &parameter) {
+	auto threshold_bytes = parameter.GetValue<uint64_t>();
+	auto &db = DatabaseInstance::GetDatabase(context);
+	auto &object_cache = db.GetObjectCache();
+	auto entry = object_cache.GetOrCreate<HedgedRequestFsEntry>(HedgedRequestFsEntry::ObjectType());
+	entry->UpdateChunkedReadThreshold(threshold_bytes);
+}
+
+void SetChunkedReadChunkSize(ClientContext &context, SetScope scope, Value &parameter) {
+	auto chunk_bytes = parameter.GetValue<uint64_t>();
+	auto &db = DatabaseInstance::GetDatabase(context);
+	auto &object_cache = db.GetObjectCache();
+	auto entry = object_cache.GetOrCreate<HedgedRequestFsEntry>(HedgedRequestFsEntry::ObjectType());
+	entry->UpdateChunkedReadChunkSize(chunk_bytes);
+}
+
+void SetEnableReadAhead(ClientContext &context, SetScope scope, Value &parameter) {
+	auto enable = parameter.GetValue<bool>();
+	auto &db = DatabaseInstance::GetDatabase(context);
+	auto &object_cache = db.GetObjectCache();
+	auto entry = object_cache.GetOrCreate<HedgedRequestFsEntry>(HedgedRequestFsEntry::ObjectType());
+	entry->UpdateEnableReadAhead(enable);
+}
+
+void SetReadAheadBlockSize(ClientContext &context, SetScope scope, Value &parameter) {
+	auto block_bytes = parameter.GetValue<uint64_t>();
+	auto &db = DatabaseInstance::GetDatabase(context);
+	auto &object_cache = db.GetObjectCache();
+	auto entry = object_cache.GetOrCreate<HedgedRequestFsEntry>(HedgedRequestFsEntry::ObjectType());
+	entry->UpdateReadAheadBlockSize(block_bytes);
+}
+
+void SetReadAheadWindowBlocks(ClientContext &context, SetScope scope, Value &parameter) {
+	auto window_blocks = parameter.GetValue<uint64_t>();
+	auto &db = DatabaseInstance::GetDatabase(context);
+	auto &object_cache = db.GetObjectCache();
+	auto entry = object_cache.GetOrCreate<HedgedRequestFsEntry>(HedgedRequestFsEntry::ObjectType());
+	entry->UpdateReadAheadWindowBlocks(window_blocks);
+}
+
+void SetReadAheadMaxBytes(ClientContext &context, SetScope scope, Value &parameter) {
+	auto max_bytes = parameter.GetValue<uint64_t>();
+	auto &db = DatabaseInstance::GetDatabase(context);
+	auto &object_cache = db.GetObjectCache();
+	auto entry = object_cache.GetOrCreate<HedgedRequestFsEntry>(HedgedRequestFsEntry::ObjectType());
+	entry->UpdateReadAheadMaxBytes(max_bytes);
+}
+
+void SetEnableWriteBehind(ClientContext &context, SetScope scope, Value &parameter) {
+	auto enable = parameter.GetValue<bool>();
+	auto &db = DatabaseInstance::GetDatabase(context);
+	auto &object_cache = db.GetObjectCache();
+	auto entry = object_cache.GetOrCreate<HedgedRequestFsEntry>(HedgedRequestFsEntry::ObjectType());
+	entry->UpdateEnableWriteBehind(enable);
+}
+
+void SetWriteBehindPartSize(ClientContext &context, SetScope scope, Value &parameter) {
+	auto part_bytes = parameter.GetValue<uint64_t>();
+	auto &db = DatabaseInstance::GetDatabase(context);
+	auto &object_cache = db.GetObjectCache();
+	auto entry = object_cache.GetOrCreate<HedgedRequestFsEntry>(HedgedRequestFsEntry::ObjectType());
+	entry->UpdateWriteBehindPartSize(part_bytes);
+}
+
+void SetWriteBehindMaxOutstandingParts(ClientContext &context, SetScope scope, Value &parameter) {
+	auto max_parts = parameter.GetValue<uint64_t>();
+	auto &db = DatabaseInstance::GetDatabase(context);
+	auto &object_cache = db.GetObjectCache();
+	auto entry = object_cache.GetOrCreate<HedgedRequestFsEntry>(HedgedRequestFsEntry::ObjectType());
+	entry->UpdateWriteBehindMaxOutstandingParts(max_parts);
+}
+
+void SetEnableWriteHedging(ClientContext &context, SetScope scope, Value &parameter) {
+	auto enable = parameter.GetValue<bool>();
+	auto &db = DatabaseInstance::GetDatabase(context);
+	auto &object_cache = db.GetObjectCache();
+	auto entry = object_cache.GetOrCreate<HedgedRequestFsEntry>(HedgedRequestFsEntry::ObjectType());
+	entry->UpdateEnableWriteHedging(enable);
+}
+
+void SetReadBufferPoolMaxBytes(ClientContext &context, SetScope scope, Value &parameter) {
+	auto max_bytes = parameter.GetValue<uint64_t>();
+	auto &db = DatabaseInstance::GetDatabase(context);
+	auto &object_cache = db.GetObjectCache();
+	auto entry = object_cache.GetOrCreate<HedgedRequestFsEntry>(HedgedRequestFsEntry::ObjectType());
+	entry->UpdateReadBufferPoolMaxBytes(NumericCast<idx_t>(max_bytes));
+}
+
+void SetEnableAdaptiveDelay(ClientContext &context, SetScope scope, Value &parameter) {
+	auto enable = parameter.GetValue<bool>();
+	auto &db = DatabaseInstance::GetDatabase(context);
+	auto &object_cache = db.GetObjectCache();
+	auto entry = object_cache.GetOrCreate<HedgedRequestFsEntry>(HedgedRequestFsEntry::ObjectType());
+	entry->UpdateEnableAdaptiveDelay(enable);
+}
+
+void SetAdaptiveDelayPercentile(ClientContext &context, SetScope scope, Value &parameter) {
+	auto percentile = parameter.GetValue<double>();
+	auto &db = DatabaseInstance::GetDatabase(context);
+	auto &object_cache = db.GetObjectCache();
+	auto entry = object_cache.GetOrCreate<HedgedRequestFsEntry>(HedgedRequestFsEntry::ObjectType());
+	entry->UpdateAdaptiveDelayPercentile(percentile);
+}
+
+void SetAdaptiveDelayMin(ClientContext &context, SetScope scope, Value &parameter) {
+	auto value_ms = parameter.GetValue<uint64_t>();
+	auto &db = DatabaseInstance::GetDatabase(context);
+	auto &object_cache = db.GetObjectCache();
+	auto entry = object_cache.GetOrCreate<HedgedRequestFsEntry>(HedgedRequestFsEntry::ObjectType());
+	entry->UpdateAdaptiveDelayMin(std::chrono::milliseconds(value_ms));
+}
+
+void SetAdaptiveDelayMax(ClientContext &context, SetScope scope, Value &parameter) {
+	auto value_ms = parameter.GetValue<uint64_t>();
+	auto &db = DatabaseInstance::GetDatabase(context);
+	auto &object_cache = db.GetObjectCache();
+	auto entry = object_cache.GetOrCreate<HedgedRequestFsEntry>(HedgedRequestFsEntry::ObjectType());
+	entry->UpdateAdaptiveDelayMax(std::chrono::milliseconds(value_ms));
+}
+
+void SetEnableInlineExecution(ClientContext &context, SetScope scope, Value &parameter) {
+	auto enable = parameter.GetValue<bool>();
+	auto &db = DatabaseInstance::GetDatabase(context);
+	auto &object_cache = db.GetObjectCache();
+	auto entry = object_cache.GetOrCreate<HedgedRequestFsEntry>(HedgedRequestFsEntry::ObjectType());
+	entry->UpdateEnableInlineExecution(enable);
+}
+
+void SetInlineSamplePercent(ClientContext &context, SetScope scope, Value &parameter) {
+	auto percent = parameter.GetValue<double>();
+	auto &db = DatabaseInstance::GetDatabase(context);
+	auto &object_cache = db.GetObjectCache();
+	auto entry = object_cache.GetOrCreate<HedgedRequestFsEntry>(HedgedRequestFsEntry::ObjectType());
+	entry->UpdateInlineSamplePercent(percent);
+}
+
+void SetEnableHedgeBudget(ClientContext &context, SetScope scope, Value &parameter) {
+	auto enable = parameter.GetValue<bool>();
+	auto &db = DatabaseInstance::GetDatabase(context);
+	auto &object_cache = db.GetObjectCache();
+	auto entry = object_cache.GetOrCreate<HedgedRequestFsEntry>(HedgedRequestFsEntry::ObjectType());
+	entry->UpdateEnableHedgeBudget(enable);
+}
+
+void SetHedgeBudgetPercent(ClientContext &context, SetScope scope, Value &parameter) {
+	auto percent = parameter.GetValue<double>();
+	auto &db = DatabaseInstance::GetDatabase(context);
+	auto &object_cache = db.GetObjectCache();
+	auto entry = object_cache.GetOrCreate<HedgedRequestFsEntry>(HedgedRequestFsEntry::ObjectType());
+	entry->UpdateHedgeBudgetPercent(percent);
+}
+
+void SetHedgeBudgetBurst(ClientContext &context, SetScope scope, Value &parameter) {
+	auto burst = parameter.GetValue<uint64_t>();
+	auto &db = DatabaseInstance::GetDatabase(context);
+	auto &object_cache = db.GetObjectCache();
+	auto entry = object_cache.GetOrCreate<HedgedRequestFsEntry>(HedgedRequestFsEntry::ObjectType());
+	entry->UpdateHedgeBudgetBurst(burst);
+}
+
+void SetHedgeBudgetPerOperation(ClientContext &context, SetScope scope, Value &parameter) {
+	auto per_operation = parameter.GetValue<bool>();
+	auto &db = DatabaseInstance::GetDatabase(context);
+	auto &object_cache = db.GetObjectCache();
+	auto entry = object_cache.GetOrCreate<HedgedRequestFsEntry>(HedgedRequestFsEntry::ObjectType());
+	entry->UpdateHedgeBudgetPerOperation(per_operation);
+}
+
+void SetThreadPoolMinThreads(ClientContext &context, SetScope scope, Value &parameter) {
+	auto min_threads = parameter.GetValue<uint64_t>();
+	auto &db = DatabaseInstance::GetDatabase(context);
+	auto &object_cache = db.GetObjectCache();
+	auto entry = object_cache.GetOrCreate<HedgedRequestFsEntry>(HedgedRequestFsEntry::ObjectType());
+	entry->UpdateThreadPoolMinThreads(NumericCast<idx_t>(min_threads));
+}
+
+void SetThreadPoolMaxThreads(ClientContext &context, SetScope scope, Value &parameter) {
+	auto max_threads = parameter.GetValue<uint64_t>();
+	auto &db = DatabaseInstance::GetDatabase(context);
+	auto &object_cache = db.GetObjectCache();
+	auto entry = object_cache.GetOrCreate<HedgedRequestFsEntry>(HedgedRequestFsEntry::ObjectType());
+	entry->UpdateThreadPoolMaxThreads(NumericCast<idx_t>(max_threads));
+}
+
+void SetEnableTiedRequests(ClientContext &context, SetScope scope, Value &parameter) {
+	auto enable = parameter.GetValue<bool>();
+	auto &db = DatabaseInstance::GetDatabase(context);
+	auto &object_cache = db.GetObjectCache();
+	auto entry = object_cache.GetOrCreate<HedgedRequestFsEntry>(HedgedRequestFsEntry::ObjectType());
+	entry->UpdateEnableTiedRequests(enable);
+}
+
+void SetHedgeMaxQueueDepth(ClientContext &context, SetScope scope, Value &parameter) {
+	auto max_depth = parameter.GetValue<uint64_t>();
+	auto &db = DatabaseInstance::GetDatabase(context);
+	auto &object_cache = db.GetObjectCache();
+	auto entry = object_cache.GetOrCreate<HedgedRequestFsEntry>(HedgedRequestFsEntry::ObjectType());
+	entry->UpdateHedgeMaxQueueDepth(max_depth);
+}
+
+void SetHedgeMaxQueueWait(ClientContext &context, SetScope scope, Value &parameter) {
+	auto value_ms = parameter.GetValue<uint64_t>();
+	auto &db = DatabaseInstance::GetDatabase(context);
+	auto &object_cache = db.GetObjectCache();
+	auto entry = object_cache.GetOrCreate<HedgedRequestFsEntry>(HedgedRequestFsEntry::ObjectType());
+	entry->UpdateHedgeMaxQueueWait(std::chrono::milliseconds(value_ms));
+}
+
+void SetEnableFirstSuccessWins(ClientContext &context, SetScope scope, Value &parameter) {
+	auto enable = parameter.GetValue<bool>();
+	auto &db = DatabaseInstance::GetDatabase(context);
+	auto &object_cache = db.GetObjectCache();
+	auto entry = object_cache.GetOrCreate<HedgedRequestFsEntry>(HedgedRequestFsEntry::ObjectType());
+	entry->UpdateEnableFirstSuccessWins(enable);
+}
+
+void SetEnableRequestTrace(ClientContext &context, SetScope scope, Value &parameter) {
+	auto enable = parameter.GetValue<bool>();
+	auto &db = DatabaseInstance::GetDatabase(context);
+	auto &object_cache = db.GetObjectCache();
+	auto entry = object_cache.GetOrCreate<HedgedRequestFsEntry>(HedgedRequestFsEntry::ObjectType());
+	entry->UpdateEnableRequestTrace(enable);
+}
+
+void SetShutdownTimeout(ClientContext &context, SetScope scope, Value &parameter) {
+	auto value_ms = parameter.GetValue<uint64_t>();
+	auto &db = DatabaseInstance::GetDatabase(context);
+	auto &object_cache = db.GetObjectCache();
+	auto entry = object_cache.GetOrCreate<HedgedRequestFsEntry>(HedgedRequestFsEntry::ObjectType());
+	entry->UpdateShutdownTimeout(std::chrono::milliseconds(value_ms));
+}
+
+void SetEnableRequestCoalescing(ClientContext &context, SetScope scope, Value &parameter) {
+	auto enable = parameter.GetValue<bool>();
+	auto &db = DatabaseInstance::GetDatabase(context);
+	auto &object_cache = db.GetObjectCache();
+	auto entry = object_cache.GetOrCreate<HedgedRequestFsEntry>(HedgedRequestFsEntry::ObjectType());
+	entry->UpdateEnableRequestCoalescing(enable);
+}
+
+void SetEnableStreamingListing(ClientContext &context, SetScope scope, Value &parameter) {
+	auto enable = parameter.GetValue<bool>();
+	auto &db = DatabaseInstance::GetDatabase(context);
+	auto &object_cache = db.GetObjectCache();
+	auto entry = object_cache.GetOrCreate<HedgedRequestFsEntry>(HedgedRequestFsEntry::ObjectType());
+	entry->UpdateEnableStreamingListing(enable);
+}
+
+void SetListingPageSize(ClientContext &context, SetScope scope, Value &parameter) {
+	auto page_size = parameter.GetValue<uint64_t>();
+	auto &db = DatabaseInstance::GetDatabase(context);
+	auto &object_cache = db.GetObjectCache();
+	auto entry = object_cache.GetOrCreate<HedgedRequestFsEntry>(HedgedRequestFsEntry::ObjectType());
+	entry->UpdateListingPageSize(page_size);
+}
+
+void SetGlobParallelism(ClientContext &context, SetScope scope, Value &parameter) {
+	auto parallelism = parameter.GetValue<uint64_t>();
+	auto &db = DatabaseInstance::GetDatabase(context);
+	auto &object_cache = db.GetObjectCache();
+	auto entry = object_cache.GetOrCreate<HedgedRequestFsEntry>(HedgedRequestFsEntry::ObjectType());
+	entry->UpdateGlobParallelism(parallelism);
+}
+
+void SetMetadataPrefetchConcurrency(ClientContext &context, SetScope scope, Value &parameter) {
+	auto concurrency = parameter.GetValue<uint64_t>();
+	auto &db = DatabaseInstance::GetDatabase(context);
+	auto &object_cache = db.GetObjectCache();
+	auto entry = object_cache.GetOrCreate<HedgedRequestFsEntry>(HedgedRequestFsEntry::ObjectType());
+	entry->UpdateMetadataPrefetchConcurrency(concurrency);
+}
+
+void SetEnableMetadataCache(ClientContext &context, SetScope scope, Value &parameter) {
+	auto enable = parameter.GetValue<bool>();
+	auto &db = DatabaseInstance::GetDatabase(context);
+	auto &object_cache = db.GetObjectCache();
+	auto metadata_cache = object_cache.GetOrCreate<MetadataCache>(MetadataCache::ObjectType());
+	metadata_cache->SetEnabled(enable);
+}
+
+void SetOpenPrefetchFileCount(ClientContext &context, SetScope scope, Value &parameter) {
+	auto file_count = parameter.GetValue<uint64_t>();
+	auto &db = DatabaseInstance::GetDatabase(context);
+	auto &object_cache = db.GetObjectCache();
+	auto entry = object_cache.GetOrCreate<HedgedRequestFsEntry>(HedgedRequestFsEntry::ObjectType());
+	entry->UpdateOpenPrefetchFileCount(file_count);
+}
+
+void SetOpenPrefetchTtl(ClientContext &context, SetScope scope, Value &parameter) {
+	auto value_ms = parameter.GetValue<uint64_t>();
+	auto &db = DatabaseInstance::GetDatabase(context);
+	auto &object_cache = db.GetObjectCache();
+	auto entry = object_cache.GetOrCreate<HedgedRequestFsEntry>(HedgedRequestFsEntry::ObjectType());
+	entry->UpdateOpenPrefetchTtl(std::chrono::milliseconds(value_ms));
+}
+
+void SetOpenPrefetchMaxBytes(ClientContext &context, SetScope scope, Value &parameter) {
+	auto max_bytes = parameter.GetValue<uint64_t>();
+	auto &db = DatabaseInstance::GetDatabase(context);
+	auto &object_cache = db.GetObjectCache();
+	auto entry = object_cache.GetOrCreate<HedgedRequestFsEntry>(HedgedRequestFsEntry::ObjectType());
+	entry->UpdateOpenPrefetchMaxBytes(NumericCast<idx_t>(max_bytes));
+}
+
+void SetHandlePoolMaxHandles(ClientContext &context, SetScope scope, Value &parameter) {
+	auto max_handles = parameter.GetValue<uint64_t>();
+	auto &db = DatabaseInstance::GetDatabase(context);
+	auto &object_cache = db.GetObjectCache();
+	auto entry = object_cache.GetOrCreate<HedgedRequestFsEntry>(HedgedRequestFsEntry::ObjectType());
+	entry->UpdateHandlePoolMaxHandles(NumericCast<idx_t>(max_handles));
+}
+
+void SetHandlePoolTtl(ClientContext &context, SetScope scope, Value &parameter) {
+	auto value_ms = parameter.GetValue<uint64_t>();
+	auto &db = DatabaseInstance::GetDatabase(context);
+	auto &object_cache = db.GetObjectCache();
+	auto entry = object_cache.GetOrCreate<HedgedRequestFsEntry>(HedgedRequestFsEntry::ObjectType());
+	entry->UpdateHandlePoolTtl(std::chrono::milliseconds(value_ms));
+}
+
+void SetMetadataCacheTtl(ClientContext &context, SetScope scope, Value &parameter) {
+	auto value_ms = parameter.GetValue<uint64_t>();
+	auto &db = DatabaseInstance::GetDatabase(context);
+	auto &object_cache = db.GetObjectCache();
+	auto metadata_cache = object_cache.GetOrCreate<MetadataCache>(MetadataCache::ObjectType());
+	metadata_cache->SetTtl(std::chrono::milliseconds(value_ms));
+}
+
+void SetMetadataCacheMaxBytes(ClientContext &context, SetScope scope, Value &parameter) {
+	auto max_bytes = parameter.GetValue<uint64_t>();
+	auto &db = DatabaseInstance::GetDatabase(context);
+	auto &object_cache = db.GetObjectCache();
+	auto metadata_cache = object_cache.GetOrCreate<MetadataCache>(MetadataCache::ObjectType());
+	metadata_cache->SetMaxBytes(NumericCast<idx_t>(max_bytes));
+}
+
+void SetEnableListingCache(ClientContext &context, SetScope scope, Value &parameter) {
+	auto enable = parameter.GetValue<bool>();
+	auto &db = DatabaseInstance::GetDatabase(context);
+	auto &object_cache = db.GetObjectCache();
+	auto listing_cache = object_cache.GetOrCreate<ListingCache>(ListingCache::ObjectType());
+	listing_cache->SetEnabled(enable);
+}
+
+void SetListingCacheTtl(ClientContext &context, SetScope scope, Value &parameter) {
+	auto value_ms = parameter.GetValue<uint64_t>();
+	auto &db = DatabaseInstance::GetDatabase(context);
+	auto &object_cache = db.GetObjectCache();
+	auto listing_cache = object_cache.GetOrCreate<ListingCache>(ListingCache::ObjectType());
+	listing_cache->SetTtl(std::chrono::milliseconds(value_ms));
+}
+
+void SetListingCacheMaxBytes(ClientContext &context, SetScope scope, Value &parameter) {
+	auto max_bytes = parameter.GetValue<uint64_t>();
+	auto &db = DatabaseInstance::GetDatabase(context);
+	auto &object_cache = db.GetObjectCache();
+	auto listing_cache = object_cache.GetOrCreate<ListingCache>(ListingCache::ObjectType());
+	listing_cache->SetMaxBytes(NumericCast<idx_t>(max_bytes));
+}
+
+void SetProfileAutoLoadPath(ClientContext &context, SetScope scope, Value &parameter) {
+	auto path = parameter.GetValue<string>();
+	if (path.empty()) {
+		return;
+	}
+	// A missing profile is skipped, so the first process sharing a profile path starts cold instead of failing.
+	auto &fs = FileSystem::GetFileSystem(context);
+	if (!fs.FileExists(path)) {
+		return;
+	}
+	auto &db = DatabaseInstance::GetDatabase(context);
+	auto &object_cache = db.GetObjectCache();
+	auto entry = object_cache.GetOrCreate<HedgedRequestFsEntry>(HedgedRequestFsEntry::ObjectType());
+	LoadLatencyProfile(fs, path, *entry->GetLatencyTracker());
+}
+
 } // namespace
 
 void RegisterHedgedFsSettings(DatabaseInstance &db) {
@@ -173,9 +579,267 @@ void RegisterHedgedFsSettings(DatabaseInstance &db) {
 	    Value::UBIGINT(DEFAULT_HEDGING_DELAYS_MS[NumericCast<size_t>(HedgedRequestOperation::DIRECTORY_CREATE)]),
 	    SetDirectoryCreateHedgingDelay);
 
+	config.AddExtensionOption(
+	    "hedged_fs_read_delay_ms",
+	    "Delay in milliseconds before starting hedged request for positional Read, only effective when read hedging is "
+	    "enabled",
+	    LogicalType::UBIGINT,
+	    Value::UBIGINT(DEFAULT_HEDGING_DELAYS_MS[NumericCast<size_t>(HedgedRequestOperation::READ)]),
+	    SetReadHedgingDelay);
+
+	config.AddExtensionOption(
+	    "hedged_fs_write_delay_ms",
+	    "Delay in milliseconds before starting hedged request for a part write, only effective when write hedging is "
+	    "enabled",
+	    LogicalType::UBIGINT,
+	    Value::UBIGINT(DEFAULT_HEDGING_DELAYS_MS[NumericCast<size_t>(HedgedRequestOperation::WRITE)]),
+	    SetWriteHedgingDelay);
+
+	config.AddExtensionOption("hedged_fs_enable_read_hedging",
+	                          "Whether to perform hedged requests for positional Read, each hedged attempt reads into "
+	                          "a pooled scratch buffer which is copied into the caller's buffer on success",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(DEFAULT_ENABLE_READ_HEDGING),
+	                          SetEnableReadHedging);
+
+	config.AddExtensionOption("hedged_fs_enable_chunked_read",
+	                          "Whether to split positional Read larger than hedged_fs_chunked_read_threshold_bytes "
+	                          "into chunks which are read concurrently, and hedged independently with read hedging",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(DEFAULT_ENABLE_CHUNKED_READ), SetEnableChunkedRead);
+
+	config.AddExtensionOption("hedged_fs_chunked_read_threshold_bytes",
+	                          "Positional Read larger than the threshold is split into chunks in chunked read mode",
+	                          LogicalType::UBIGINT, Value::UBIGINT(DEFAULT_CHUNKED_READ_THRESHOLD_BYTES),
+	                          SetChunkedReadThreshold);
+
+	config.AddExtensionOption("hedged_fs_chunked_read_chunk_bytes", "Size of one chunk in chunked read mode",
+	                          LogicalType::UBIGINT, Value::UBIGINT(DEFAULT_CHUNKED_READ_CHUNK_BYTES),
+	                          SetChunkedReadChunkSize);
+
+	config.AddExtensionOption("hedged_fs_enable_read_ahead",
+	                          "Whether to prefetch blocks ahead of sequential non-positional Read on read-only file "
+	                          "handles, each block is fetched with a hedged request",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(DEFAULT_ENABLE_READ_AHEAD), SetEnableReadAhead);
+
+	config.AddExtensionOption("hedged_fs_read_ahead_block_bytes", "Size of one block prefetched by read-ahead",
+	                          LogicalType::UBIGINT, Value::UBIGINT(DEFAULT_READ_AHEAD_BLOCK_BYTES),
+	                          SetReadAheadBlockSize);
+
+	config.AddExtensionOption("hedged_fs_read_ahead_window_blocks",
+	                          "Number of blocks prefetched ahead of the read position by read-ahead",
+	                          LogicalType::UBIGINT, Value::UBIGINT(DEFAULT_READ_AHEAD_WINDOW_BLOCKS),
+	                          SetReadAheadWindowBlocks);
+
+	config.AddExtensionOption("hedged_fs_read_ahead_max_bytes",
+	                          "Maximum bytes prefetched by read-ahead for one file handle, which bounds the window",
+	                          LogicalType::UBIGINT, Value::UBIGINT(DEFAULT_READ_AHEAD_MAX_BYTES),
+	                          SetReadAheadMaxBytes);
+
+	config.AddExtensionOption("hedged_fs_enable_write_behind",
+	                          "Whether to buffer Write on file handles opened for writing into parts, which are "
+	                          "written in background and awaited by FileSync and Close",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(DEFAULT_ENABLE_WRITE_BEHIND), SetEnableWriteBehind);
+
+	config.AddExtensionOption("hedged_fs_write_behind_part_bytes", "Size of one part written in write-behind mode",
+	                          LogicalType::UBIGINT, Value::UBIGINT(DEFAULT_WRITE_BEHIND_PART_BYTES),
+	                          SetWriteBehindPartSize);
+
+	config.AddExtensionOption("hedged_fs_write_behind_max_outstanding_parts",
+	                          "Maximum number of parts buffered for one file handle in write-behind mode, which are "
+	                          "written one at a time in order; further writes block until a part finishes",
+	                          LogicalType::UBIGINT, Value::UBIGINT(DEFAULT_WRITE_BEHIND_MAX_OUTSTANDING_PARTS),
+	                          SetWriteBehindMaxOutstandingParts);
+
+	config.AddExtensionOption("hedged_fs_enable_write_hedging",
+	                          "Whether to perform hedged requests for part writes in write-behind mode, only enable it "
+	                          "if positional writes of the wrapped filesystem are idempotent",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(DEFAULT_ENABLE_WRITE_HEDGING),
+	                          SetEnableWriteHedging);
+
+	config.AddExtensionOption("hedged_fs_read_buffer_pool_max_bytes",
+	                          "Maximum bytes of idle scratch buffers kept for reuse by hedged reads",
+	                          LogicalType::UBIGINT, Value::UBIGINT(DEFAULT_READ_BUFFER_POOL_MAX_BYTES),
+	                          SetReadBufferPoolMaxBytes);
+
+	config.AddExtensionOption("hedged_fs_enable_adaptive_delay",
+	                          "Whether to derive hedging delays from observed operation latency, instead of using the "
+	                          "static hedged_fs_*_delay_ms settings",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(DEFAULT_ENABLE_ADAPTIVE_DELAY),
+	                          SetEnableAdaptiveDelay);
+
+	config.AddExtensionOption("hedged_fs_adaptive_delay_percentile",
+	                          "Observed latency percentile (within (0, 100]) used as hedging delay in adaptive mode",
+	                          LogicalType::DOUBLE, Value::DOUBLE(DEFAULT_ADAPTIVE_DELAY_PERCENTILE),
+	                          SetAdaptiveDelayPercentile);
+
+	config.AddExtensionOption("hedged_fs_adaptive_delay_min_ms",
+	                          "Lower bound in milliseconds for hedging delay in adaptive mode", LogicalType::UBIGINT,
+	                          Value::UBIGINT(DEFAULT_ADAPTIVE_DELAY_MIN_MS), SetAdaptiveDelayMin);
+
+	config.AddExtensionOption("hedged_fs_adaptive_delay_max_ms",
+	                          "Upper bound in milliseconds for hedging delay in adaptive mode", LogicalType::UBIGINT,
+	                          Value::UBIGINT(DEFAULT_ADAPTIVE_DELAY_MAX_MS), SetAdaptiveDelayMax);
+
+	config.AddExtensionOption("hedged_fs_enable_inline_execution",
+	                          "Whether calls run on the caller thread without hedging, while observed tail latency of "
+	                          "their operation stays well below its hedging delay",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(DEFAULT_ENABLE_INLINE_EXECUTION),
+	                          SetEnableInlineExecution);
+
+	config.AddExtensionOption("hedged_fs_inline_sample_percent",
+	                          "Percentage of calls (within [0, 100]) still sent through the hedged path while their "
+	                          "operation runs inline, so a regressed backend is noticed",
+	                          LogicalType::DOUBLE, Value::DOUBLE(DEFAULT_INLINE_SAMPLE_PERCENT),
+	                          SetInlineSamplePercent);
+
+	config.AddExtensionOption("hedged_fs_enable_hedge_budget",
+	                          "Whether to bound hedged requests across all calls with a token bucket hedge budget",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(DEFAULT_ENABLE_HEDGE_BUDGET), SetEnableHedgeBudget);
+
+	config.AddExtensionOption("hedged_fs_hedge_budget_percent",
+	                          "Maximum percentage of primary requests which are allowed to spawn hedged requests",
+	                          LogicalType::DOUBLE, Value::DOUBLE(DEFAULT_HEDGE_BUDGET_PERCENT), SetHedgeBudgetPercent);
+
+	config.AddExtensionOption("hedged_fs_hedge_budget_burst",
+	                          "Maximum number of hedged requests which could be spawned in a burst under hedge budget",
+	                          LogicalType::UBIGINT, Value::UBIGINT(DEFAULT_HEDGE_BUDGET_BURST), SetHedgeBudgetBurst);
+
+	config.AddExtensionOption("hedged_fs_hedge_budget_per_operation",
+	                          "Whether each operation gets its own hedge budget, instead of sharing one for all "
+	                          "operations",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(DEFAULT_HEDGE_BUDGET_PER_OPERATION),
+	                          SetHedgeBudgetPerOperation);
+
 	config.AddExtensionOption("hedged_fs_max_hedged_request_count",
 	                          "Maximum number of hedged requests to spawn for each operation", LogicalType::UBIGINT,
 	                          Value::UBIGINT(DEFAULT_MAX_HEDGED_REQUEST_COUNT), SetMaxHedgedRequestCount);
+
+	config.AddExtensionOption("hedged_fs_thread_pool_min_threads",
+	                          "Minimum number of threads kept alive by the IO thread pool", LogicalType::UBIGINT,
+	                          Value::UBIGINT(DEFAULT_THREAD_POOL_MIN_THREADS), SetThreadPoolMinThreads);
+
+	config.AddExtensionOption("hedged_fs_thread_pool_max_threads",
+	                          "Maximum number of threads the IO thread pool could grow to", LogicalType::UBIGINT,
+	                          Value::UBIGINT(DEFAULT_THREAD_POOL_MAX_THREADS), SetThreadPoolMaxThreads);
+
+	config.AddExtensionOption("hedged_fs_enable_tied_requests",
+	                          "Whether sibling attempts of one hedged request are tied in the IO thread pool, so "
+	                          "attempts queued alongside the first one to start are skipped",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(DEFAULT_ENABLE_TIED_REQUESTS),
+	                          SetEnableTiedRequests);
+
+	config.AddExtensionOption("hedged_fs_hedge_max_queue_depth",
+	                          "Number of jobs queued in the IO thread pool at which hedges are suppressed, 0 disables",
+	                          LogicalType::UBIGINT, Value::UBIGINT(DEFAULT_HEDGE_MAX_QUEUE_DEPTH),
+	                          SetHedgeMaxQueueDepth);
+
+	config.AddExtensionOption("hedged_fs_hedge_max_queue_wait_ms",
+	                          "Recent queue wait time of hedges in the IO thread pool in milliseconds, at which hedges "
+	                          "are suppressed, 0 disables",
+	                          LogicalType::UBIGINT, Value::UBIGINT(DEFAULT_HEDGE_MAX_QUEUE_WAIT_MS),
+	                          SetHedgeMaxQueueWait);
+
+	config.AddExtensionOption("hedged_fs_enable_first_success_wins",
+	                          "Whether only the first successful attempt decides a hedged request, while failed "
+	                          "attempts are returned once no attempt is left, and retryable failures are hedged right "
+	                          "away",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(DEFAULT_ENABLE_FIRST_SUCCESS_WINS),
+	                          SetEnableFirstSuccessWins);
+
+	config.AddExtensionOption("hedged_fs_enable_request_trace",
+	                          "Whether every hedged call is traced into a fixed-size ring of recent requests, which "
+	                          "is listed by hedged_fs_recent_requests",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(DEFAULT_ENABLE_REQUEST_TRACE),
+	                          SetEnableRequestTrace);
+
+	config.AddExtensionOption("hedged_fs_shutdown_timeout_ms",
+	                          "Time in milliseconds to wait for in-flight attempts on shutdown, after which they're "
+	                          "abandoned to finish in background",
+	                          LogicalType::UBIGINT, Value::UBIGINT(DEFAULT_SHUTDOWN_TIMEOUT_MS), SetShutdownTimeout);
+
+	config.AddExtensionOption("hedged_fs_enable_request_coalescing",
+	                          "Whether concurrent identical metadata requests and read-only file opens on the same "
+	                          "path from the same client share one hedged request",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(DEFAULT_ENABLE_REQUEST_COALESCING),
+	                          SetEnableRequestCoalescing);
+
+	config.AddExtensionOption("hedged_fs_enable_streaming_listing",
+	                          "Whether to stream ListFiles and Glob results page by page from the first attempt to "
+	                          "list a page, instead of materializing the whole listing",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(DEFAULT_ENABLE_STREAMING_LISTING),
+	                          SetEnableStreamingListing);
+
+	config.AddExtensionOption("hedged_fs_listing_page_size",
+	                          "Number of entries in one page of streaming listing", LogicalType::UBIGINT,
+	                          Value::UBIGINT(DEFAULT_LISTING_PAGE_SIZE), SetListingPageSize);
+
+	config.AddExtensionOption("hedged_fs_glob_parallelism",
+	                          "Number of partitions listed concurrently by glob, where a pattern is split into one "
+	                          "partition per directory matching its first wildcard level; 1 disables parallel glob. "
+	                          "Only applies to filesystems listing one directory level, e.g. not to S3 or HTTP",
+	                          LogicalType::UBIGINT, Value::UBIGINT(DEFAULT_GLOB_PARALLELISM), SetGlobParallelism);
+
+	config.AddExtensionOption("hedged_fs_metadata_prefetch_concurrency",
+	                          "Number of files whose metadata is fetched concurrently by hedged_fs_prefetch_metadata",
+	                          LogicalType::UBIGINT, Value::UBIGINT(DEFAULT_METADATA_PREFETCH_CONCURRENCY),
+	                          SetMetadataPrefetchConcurrency);
+
+	config.AddExtensionOption("hedged_fs_metadata_cache_enabled",
+	                          "Whether to cache FileExists, GetFileSize, GetLastModifiedTime and Stats results of "
+	                          "wrapped filesystems",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(DEFAULT_ENABLE_METADATA_CACHE),
+	                          SetEnableMetadataCache);
+
+	config.AddExtensionOption("hedged_fs_open_prefetch_file_count",
+	                          "Number of files returned by Glob which are opened in background, so the next OpenFile "
+	                          "of them takes the prefetched handle; 0 disables open prefetch",
+	                          LogicalType::UBIGINT, Value::UBIGINT(DEFAULT_OPEN_PREFETCH_FILE_COUNT),
+	                          SetOpenPrefetchFileCount);
+
+	config.AddExtensionOption("hedged_fs_open_prefetch_ttl_ms",
+	                          "Time to live in milliseconds for prefetched file handles which are not opened",
+	                          LogicalType::UBIGINT, Value::UBIGINT(DEFAULT_OPEN_PREFETCH_TTL_MS), SetOpenPrefetchTtl);
+
+	config.AddExtensionOption("hedged_fs_open_prefetch_max_bytes",
+	                          "Maximum bytes of estimated memory held by prefetched file handles",
+	                          LogicalType::UBIGINT, Value::UBIGINT(DEFAULT_OPEN_PREFETCH_MAX_BYTES),
+	                          SetOpenPrefetchMaxBytes);
+
+	config.AddExtensionOption("hedged_fs_handle_pool_max_handles",
+	                          "Maximum number of idle read-only file handles kept for reuse, including handles opened "
+	                          "by losing OpenFile attempts, if hedged_fs_metadata_cache_enabled is set; 0 disables the "
+	                          "handle pool",
+	                          LogicalType::UBIGINT, Value::UBIGINT(DEFAULT_HANDLE_POOL_MAX_HANDLES),
+	                          SetHandlePoolMaxHandles);
+
+	config.AddExtensionOption("hedged_fs_handle_pool_ttl_ms",
+	                          "Time to live in milliseconds for idle pooled file handles", LogicalType::UBIGINT,
+	                          Value::UBIGINT(DEFAULT_HANDLE_POOL_TTL_MS), SetHandlePoolTtl);
+
+	config.AddExtensionOption("hedged_fs_metadata_cache_ttl_ms", "Time to live for cached metadata in milliseconds",
+	                          LogicalType::UBIGINT, Value::UBIGINT(DEFAULT_METADATA_CACHE_TTL_MS), SetMetadataCacheTtl);
+
+	config.AddExtensionOption("hedged_fs_metadata_cache_max_bytes", "Maximum bytes of memory used by cached metadata",
+	                          LogicalType::UBIGINT, Value::UBIGINT(DEFAULT_METADATA_CACHE_MAX_BYTES),
+	                          SetMetadataCacheMaxBytes);
+
+	config.AddExtensionOption("hedged_fs_listing_cache_enabled",
+	                          "Whether to cache ListFiles results of wrapped filesystems, and expand globs from cached "
+	                          "directory listings on filesystems listing one directory level, e.g. not on S3 or HTTP",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(DEFAULT_ENABLE_LISTING_CACHE),
+	                          SetEnableListingCache);
+
+	config.AddExtensionOption("hedged_fs_listing_cache_ttl_ms",
+	                          "Time to live for cached directory listings in milliseconds", LogicalType::UBIGINT,
+	                          Value::UBIGINT(DEFAULT_LISTING_CACHE_TTL_MS), SetListingCacheTtl);
+
+	config.AddExtensionOption("hedged_fs_listing_cache_max_bytes",
+	                          "Maximum bytes of memory used by cached directory listings", LogicalType::UBIGINT,
+	                          Value::UBIGINT(DEFAULT_LISTING_CACHE_MAX_BYTES), SetListingCacheMaxBytes);
+
+	config.AddExtensionOption("hedged_fs_profile_auto_load_path",
+	                          "Path of a latency profile written by hedged_fs_save_profile, which is loaded once the "
+	                          "setting is set; a missing profile is skipped, empty disables",
+	                          LogicalType::VARCHAR, Value(DEFAULT_PROFILE_AUTO_LOAD_PATH), SetProfileAutoLoadPath);
 }
 
 } // namespace duckdb
@@ -1,17 +1,34 @@
 #include "hedged_request_fs_entry.hpp"
 
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/helper.hpp"
 #include "duckdb/common/numeric_utils.hpp"
 
 #include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <thread>
 
 namespace duckdb {
 
-HedgedRequestFsEntry::HedgedRequestFsEntry() {
+HedgedRequestFsEntry::HedgedRequestFsEntry()
+    : config_snapshot(std::make_shared<const HedgedConfigSnapshot>()),
+      latency_tracker(make_shared_ptr<LatencyTracker>()), stats(make_shared_ptr<HedgedRequestStats>()),
+      request_trace(make_shared_ptr<RequestTraceRing>()), attempts(make_shared_ptr<AttemptRegistry>()),
+      read_buffer_pool(make_shared_ptr<ReadBufferPool>(DEFAULT_READ_BUFFER_POOL_MAX_BYTES)),
+      thread_pool(make_uniq<ThreadPool>(DEFAULT_THREAD_POOL_MIN_THREADS, DEFAULT_THREAD_POOL_MAX_THREADS)),
+      open_prefetch_cache(make_shared_ptr<OpenPrefetchCache>(hedge_scheduler)),
+      file_handle_pool(make_shared_ptr<FileHandlePool>()) {
 }
 
 HedgedRequestFsEntry::~HedgedRequestFsEntry() {
-	WaitAll();
+	// A pool worker cannot join itself, which happens when an attempt drops the last entry reference; its own attempt
+	// is still in flight, so attempts are abandoned right away.
+	const bool on_worker = thread_pool->IsWorkerThread();
+	if (Shutdown(on_worker ? std::chrono::milliseconds(0) : GetConfig().shutdown_timeout) && !on_worker) {
+		return;
+	}
+	AbandonAttempts();
 }
 
 optional_idx HedgedRequestFsEntry::GetEstimatedCacheMemory() const {
@@ -19,32 +36,114 @@ optional_idx HedgedRequestFsEntry::GetEstimatedCacheMemory() const {
 	return optional_idx {};
 }
 
-void HedgedRequestFsEntry::AddPendingRequest(std::function<void()> functor) {
-	auto future = thread_pool.Push(std::move(functor));
-	const concurrency::lock_guard<concurrency::mutex> lock(cache_mutex);
-	pending_requests.push_back(std::move(future));
-	CleanupCompleted();
+void HedgedRequestFsEntry::AttemptRegistry::OnAttemptFinished() {
+	if (in_flight.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+		return;
+	}
+	// Notify under the lock, so waiters cannot miss the wakeup between checking the counter and blocking.
+	const concurrency::lock_guard<concurrency::mutex> lock(mu);
+	completion_cv.notify_all();
+}
+
+bool HedgedRequestFsEntry::AttemptRegistry::WaitUntil(std::chrono::steady_clock::time_point deadline) {
+	concurrency::unique_lock<concurrency::mutex> lock(mu);
+	return completion_cv.wait_until(lock, deadline,
+	                                [this]() { return in_flight.load(std::memory_order_acquire) == 0; });
 }
 
-void HedgedRequestFsEntry::CleanupCompleted() DUCKDB_REQUIRES(cache_mutex) {
-	pending_requests.erase(std::remove_if(pending_requests.begin(), pending_requests.end(),
-	                                      [](std::future<void> &f) {
-		                                      return f.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
-	                                      }),
-	                       pending_requests.end());
+void HedgedRequestFsEntry::AttemptRegistry::Wait() {
+	concurrency::unique_lock<concurrency::mutex> lock(mu);
+	completion_cv.wait(lock, [this]() { return in_flight.load(std::memory_order_acquire) == 0; });
 }
 
 void HedgedRequestFsEntry::WaitAll() {
+	attempts->Wait();
+}
+
+bool HedgedRequestFsEntry::Shutdown(std::chrono::milliseconds timeout) {
+	attempts->shutdown.Cancel();
+	return attempts->WaitUntil(std::chrono::steady_clock::now() + timeout);
+}
+
+void HedgedRequestFsEntry::RetainWrappedFileSystem(unique_ptr<FileSystem> wrapped_fs) {
 	const concurrency::lock_guard<concurrency::mutex> lock(cache_mutex);
-	for (auto &future : pending_requests) {
-		future.wait();
+	retained_filesystems.emplace_back(std::move(wrapped_fs));
+}
+
+void HedgedRequestFsEntry::AbandonAttempts() {
+	vector<unique_ptr<FileSystem>> filesystems;
+	{
+		const concurrency::lock_guard<concurrency::mutex> lock(cache_mutex);
+		filesystems = std::move(retained_filesystems);
 	}
-	pending_requests.clear();
+	// The scheduler goes away with the entry, so expired prefetched handles are closed by the reaper instead.
+	open_prefetch_cache->StopSweeping();
+	// Stats, latency sketches and buffers are already shared with attempts. The pool is released before wrapped
+	// filesystems, since its workers might still be inside them until they're joined; so are the handle caches, whose
+	// handles belong to the filesystems.
+	std::thread([registry = attempts, trace = request_trace, pool = std::move(thread_pool),
+	             prefetch_cache = open_prefetch_cache, handle_pool = file_handle_pool,
+	             filesystems = std::move(filesystems)]() mutable {
+		registry->Wait();
+		pool.reset();
+		prefetch_cache.reset();
+		handle_pool.reset();
+		filesystems.clear();
+	}).detach();
 }
 
 HedgedRequestConfig HedgedRequestFsEntry::GetConfig() const {
+	return GetConfigSnapshot()->config;
+}
+
+HedgedRequestConfig HedgedRequestFsEntry::GetConfig(const string &filesystem_name, const string &path) const {
+	return GetConfigSnapshot()->Resolve(filesystem_name, path);
+}
+
+void HedgedRequestFsEntry::UpdateConfigSnapshot(const std::function<void(HedgedConfigSnapshot &)> &update) {
 	const concurrency::lock_guard<concurrency::mutex> lock(cache_mutex);
-	return config;
+	auto new_snapshot = std::make_shared<HedgedConfigSnapshot>(*config_snapshot);
+	update(*new_snapshot);
+	std::atomic_store(&config_snapshot, std::shared_ptr<const HedgedConfigSnapshot>(std::move(new_snapshot)));
+}
+
+void HedgedRequestFsEntry::SetPolicy(HedgingPolicyScope scope, const string &target, const string &option,
+                                     idx_t value) {
+	if (target.empty()) {
+		throw InvalidInputException("Hedging policy target cannot be empty");
+	}
+	// Validate option before publishing a new snapshot.
+	HedgingPolicy validated_policy;
+	validated_policy.SetOption(option, value);
+
+	UpdateConfigSnapshot([&](HedgedConfigSnapshot &snapshot) {
+		if (scope == HedgingPolicyScope::FILESYSTEM) {
+			snapshot.filesystem_policies[target].SetOption(option, value);
+		} else {
+			snapshot.GetOrCreatePrefixPolicy(target).SetOption(option, value);
+		}
+	});
+}
+
+void HedgedRequestFsEntry::ClearPolicies() {
+	UpdateConfigSnapshot([](HedgedConfigSnapshot &snapshot) {
+		snapshot.filesystem_policies.clear();
+		snapshot.prefix_policies.clear();
+	});
+}
+
+void HedgedRequestFsEntry::AddReplica(const string &prefix, const string &replica_prefix) {
+	if (prefix.empty() || replica_prefix.empty()) {
+		throw InvalidInputException("Replica prefix cannot be empty");
+	}
+	if (prefix == replica_prefix) {
+		throw InvalidInputException("Prefix '%s' cannot be a replica of itself", prefix);
+	}
+	UpdateConfigSnapshot([&](HedgedConfigSnapshot &snapshot) { snapshot.AddReplica(prefix, replica_prefix); });
+}
+
+void HedgedRequestFsEntry::ClearReplicas() {
+	UpdateConfigSnapshot([](HedgedConfigSnapshot &snapshot) { snapshot.replica_prefixes.clear(); });
 }
 
 void HedgedRequestFsEntry::UpdateConfig(HedgedRequestOperation operation, std::chrono::milliseconds delay_ms) {
@@ -53,13 +152,332 @@ void HedgedRequestFsEntry::UpdateConfig(HedgedRequestOperation operation, std::c
 		throw InvalidInputException("Invalid operation: %d", NumericCast<int>(operation));
 	}
 
-	const concurrency::lock_guard<concurrency::mutex> lock(cache_mutex);
-	config.delays_ms[NumericCast<size_t>(operation)] = delay_ms;
+	UpdateConfigSnapshot([&](HedgedConfigSnapshot &snapshot) {
+		snapshot.config.delays_ms[NumericCast<size_t>(operation)] = delay_ms;
+	});
+}
+
+void HedgedRequestFsEntry::UpdateThreadPoolMinThreads(idx_t min_threads) {
+	if (min_threads == 0 || min_threads > thread_pool->GetMaxThreadCount()) {
+		throw InvalidInputException("Thread pool min thread count must be within [1, %llu], but got %llu",
+		                            thread_pool->GetMaxThreadCount(), min_threads);
+	}
+	thread_pool->SetThreadLimits(min_threads, thread_pool->GetMaxThreadCount());
+}
+
+void HedgedRequestFsEntry::UpdateThreadPoolMaxThreads(idx_t max_threads) {
+	if (max_threads < thread_pool->GetMinThreadCount() || max_threads > ThreadPool::MAX_THREAD_COUNT) {
+		throw InvalidInputException("Thread pool max thread count must be within [%llu, %llu], but got %llu",
+		                            thread_pool->GetMinThreadCount(), ThreadPool::MAX_THREAD_COUNT, max_threads);
+	}
+	thread_pool->SetThreadLimits(thread_pool->GetMinThreadCount(), max_threads);
 }
 
 void HedgedRequestFsEntry::UpdateMaxHedgedRequestCount(size_t max_count) {
+	UpdateConfigSnapshot([&](HedgedConfigSnapshot &snapshot) { snapshot.config.max_hedged_request_count = max_count; });
+}
+
+std::chrono::milliseconds HedgedRequestFsEntry::GetHedgingDelay(const HedgedRequestConfig &config_p,
+                                                                HedgedRequestOperation operation) const {
+	const auto static_delay = config_p.delays_ms[NumericCast<size_t>(operation)];
+	if (!config_p.enable_adaptive_delay) {
+		return static_delay;
+	}
+
+	// Fallback to static delay before enough samples are collected.
+	const auto &sketch = latency_tracker->GetSketch(operation);
+	if (sketch.GetSampleCount() < ADAPTIVE_DELAY_MIN_SAMPLE_COUNT) {
+		return static_delay;
+	}
+
+	const auto latency = sketch.GetQuantile(config_p.adaptive_delay_percentile / 100.0);
+	auto delay = std::chrono::duration_cast<std::chrono::milliseconds>(latency);
+	if (delay < latency) {
+		delay += std::chrono::milliseconds(1);
+	}
+	delay = std::min(delay, config_p.adaptive_delay_max);
+	delay = std::max(delay, config_p.adaptive_delay_min);
+	return delay;
+}
+
+void HedgedRequestFsEntry::UpdateEnableAdaptiveDelay(bool enable) {
+	UpdateConfigSnapshot([&](HedgedConfigSnapshot &snapshot) { snapshot.config.enable_adaptive_delay = enable; });
+}
+
+void HedgedRequestFsEntry::UpdateAdaptiveDelayPercentile(double percentile) {
+	if (percentile <= 0.0 || percentile > 100.0) {
+		throw InvalidInputException("Adaptive delay percentile must be within (0, 100], but got %f", percentile);
+	}
+	UpdateConfigSnapshot([&](HedgedConfigSnapshot &snapshot) {
+		snapshot.config.adaptive_delay_percentile = percentile;
+	});
+}
+
+void HedgedRequestFsEntry::UpdateAdaptiveDelayMin(std::chrono::milliseconds delay_ms) {
+	UpdateConfigSnapshot([&](HedgedConfigSnapshot &snapshot) { snapshot.config.adaptive_delay_min = delay_ms; });
+}
+
+void HedgedRequestFsEntry::UpdateAdaptiveDelayMax(std::chrono::milliseconds delay_ms) {
+	UpdateConfigSnapshot([&](HedgedConfigSnapshot &snapshot) { snapshot.config.adaptive_delay_max = delay_ms; });
+}
+
+bool HedgedRequestFsEntry::ShouldRunInline(const HedgedRequestConfig &config_p, HedgedRequestOperation operation) {
+	if (!config_p.enable_inline_execution) {
+		return false;
+	}
+
+	// Keep hedging until enough samples are collected, and as long as tail latency gets anywhere near the delay.
+	const auto &sketch = latency_tracker->GetSketch(operation);
+	if (sketch.GetSampleCount() < INLINE_EXECUTION_MIN_SAMPLE_COUNT) {
+		return false;
+	}
+	const auto tail_latency = sketch.GetQuantile(INLINE_EXECUTION_TAIL_QUANTILE);
+	if (tail_latency * INLINE_EXECUTION_HEADROOM >= GetHedgingDelay(config_p, operation)) {
+		return false;
+	}
+
+	// Every n-th call is sampled through the hedged path, so a regressed backend still gets hedged on those calls
+	// while their latency pushes the tail back up.
+	if (config_p.inline_sample_percent <= 0.0) {
+		return true;
+	}
+	const auto sample_period =
+	    std::max<uint64_t>(1, static_cast<uint64_t>(std::llround(100.0 / config_p.inline_sample_percent)));
+	const auto call_idx =
+	    inline_call_counts[NumericCast<size_t>(operation)].fetch_add(1, std::memory_order_relaxed);
+	return call_idx % sample_period != 0;
+}
+
+void HedgedRequestFsEntry::UpdateEnableInlineExecution(bool enable) {
+	UpdateConfigSnapshot([&](HedgedConfigSnapshot &snapshot) { snapshot.config.enable_inline_execution = enable; });
+}
+
+void HedgedRequestFsEntry::UpdateInlineSamplePercent(double percent) {
+	if (percent < 0.0 || percent > 100.0) {
+		throw InvalidInputException("Inline sample percent must be within [0, 100], but got %f", percent);
+	}
+	UpdateConfigSnapshot([&](HedgedConfigSnapshot &snapshot) { snapshot.config.inline_sample_percent = percent; });
+}
+
+HedgeBudget &HedgedRequestFsEntry::GetHedgeBudget(const HedgedRequestConfig &config_p,
+                                                  HedgedRequestOperation operation) {
+	if (config_p.hedge_budget_per_operation) {
+		return operation_hedge_budgets[NumericCast<size_t>(operation)];
+	}
+	return global_hedge_budget;
+}
+
+void HedgedRequestFsEntry::OnPrimaryRequest(const HedgedRequestConfig &config_p, HedgedRequestOperation operation) {
+	if (!config_p.enable_hedge_budget) {
+		return;
+	}
+	GetHedgeBudget(config_p, operation).OnPrimaryRequest();
+}
+
+bool HedgedRequestFsEntry::TryAcquireHedgeBudget(const HedgedRequestConfig &config_p,
+                                                 HedgedRequestOperation operation) {
+	if (!config_p.enable_hedge_budget) {
+		return true;
+	}
+	return GetHedgeBudget(config_p, operation).TryAcquire();
+}
+
+bool HedgedRequestFsEntry::ShouldSuppressHedge(const HedgedRequestConfig &config_p) const {
+	const auto queued_jobs = thread_pool->GetQueuedJobCount();
+	if (queued_jobs == 0) {
+		return false;
+	}
+	if (config_p.hedge_max_queue_depth > 0 && queued_jobs >= config_p.hedge_max_queue_depth) {
+		return true;
+	}
+	// Wait time is only meaningful while jobs are queued, since the moving average isn't updated on an idle pool.
+	const auto max_wait_us = static_cast<uint64_t>(
+	    std::chrono::duration_cast<std::chrono::microseconds>(config_p.hedge_max_queue_wait).count());
+	return max_wait_us > 0 && thread_pool->GetQueueStats(JobPriority::HEDGE).recent_wait_us >= max_wait_us;
+}
+
+void HedgedRequestFsEntry::ConfigureHedgeBudgets() DUCKDB_REQUIRES(cache_mutex) {
+	const double ratio = hedge_budget_percent / 100.0;
+	const auto burst = static_cast<double>(hedge_budget_burst);
+	global_hedge_budget.Configure(ratio, burst);
+	for (auto &budget : operation_hedge_budgets) {
+		budget.Configure(ratio, burst);
+	}
+}
+
+void HedgedRequestFsEntry::UpdateEnableHedgeBudget(bool enable) {
+	UpdateConfigSnapshot([&](HedgedConfigSnapshot &snapshot) { snapshot.config.enable_hedge_budget = enable; });
+}
+
+void HedgedRequestFsEntry::UpdateHedgeBudgetPercent(double percent) {
+	if (percent < 0.0) {
+		throw InvalidInputException("Hedge budget percent cannot be negative, but got %f", percent);
+	}
 	const concurrency::lock_guard<concurrency::mutex> lock(cache_mutex);
-	config.max_hedged_request_count = max_count;
+	hedge_budget_percent = percent;
+	ConfigureHedgeBudgets();
+}
+
+void HedgedRequestFsEntry::UpdateHedgeBudgetBurst(uint64_t burst) {
+	const concurrency::lock_guard<concurrency::mutex> lock(cache_mutex);
+	hedge_budget_burst = burst;
+	ConfigureHedgeBudgets();
+}
+
+void HedgedRequestFsEntry::UpdateHedgeBudgetPerOperation(bool per_operation) {
+	UpdateConfigSnapshot([&](HedgedConfigSnapshot &snapshot) {
+		snapshot.config.hedge_budget_per_operation = per_operation;
+	});
+}
+
+void HedgedRequestFsEntry::UpdateEnableReadHedging(bool enable) {
+	UpdateConfigSnapshot([&](HedgedConfigSnapshot &snapshot) { snapshot.config.enable_read_hedging = enable; });
+}
+
+void HedgedRequestFsEntry::UpdateEnableChunkedRead(bool enable) {
+	UpdateConfigSnapshot([&](HedgedConfigSnapshot &snapshot) { snapshot.config.enable_chunked_read = enable; });
+}
+
+void HedgedRequestFsEntry::UpdateChunkedReadThreshold(uint64_t threshold_bytes) {
+	UpdateConfigSnapshot([&](HedgedConfigSnapshot &snapshot) {
+		snapshot.config.chunked_read_threshold_bytes = threshold_bytes;
+	});
+}
+
+void HedgedRequestFsEntry::UpdateChunkedReadChunkSize(uint64_t chunk_bytes) {
+	if (chunk_bytes == 0) {
+		throw InvalidInputException("Chunked read chunk size must be positive");
+	}
+	UpdateConfigSnapshot([&](HedgedConfigSnapshot &snapshot) {
+		snapshot.config.chunked_read_chunk_bytes = chunk_bytes;
+	});
+}
+
+void HedgedRequestFsEntry::UpdateEnableReadAhead(bool enable) {
+	UpdateConfigSnapshot([&](HedgedConfigSnapshot &snapshot) { snapshot.config.enable_read_ahead = enable; });
+}
+
+void HedgedRequestFsEntry::UpdateReadAheadBlockSize(uint64_t block_bytes) {
+	if (block_bytes == 0) {
+		throw InvalidInputException("Read-ahead block size must be positive");
+	}
+	UpdateConfigSnapshot([&](HedgedConfigSnapshot &snapshot) { snapshot.config.read_ahead_block_bytes = block_bytes; });
+}
+
+void HedgedRequestFsEntry::UpdateReadAheadWindowBlocks(uint64_t window_blocks) {
+	if (window_blocks == 0) {
+		throw InvalidInputException("Read-ahead window must contain at least one block");
+	}
+	UpdateConfigSnapshot([&](HedgedConfigSnapshot &snapshot) {
+		snapshot.config.read_ahead_window_blocks = window_blocks;
+	});
+}
+
+void HedgedRequestFsEntry::UpdateReadAheadMaxBytes(uint64_t max_bytes) {
+	UpdateConfigSnapshot([&](HedgedConfigSnapshot &snapshot) { snapshot.config.read_ahead_max_bytes = max_bytes; });
+}
+
+void HedgedRequestFsEntry::UpdateEnableWriteBehind(bool enable) {
+	UpdateConfigSnapshot([&](HedgedConfigSnapshot &snapshot) { snapshot.config.enable_write_behind = enable; });
+}
+
+void HedgedRequestFsEntry::UpdateWriteBehindPartSize(uint64_t part_bytes) {
+	if (part_bytes == 0) {
+		throw InvalidInputException("Write-behind part size must be positive");
+	}
+	UpdateConfigSnapshot([&](HedgedConfigSnapshot &snapshot) { snapshot.config.write_behind_part_bytes = part_bytes; });
+}
+
+void HedgedRequestFsEntry::UpdateWriteBehindMaxOutstandingParts(uint64_t max_parts) {
+	if (max_parts == 0) {
+		throw InvalidInputException("Write-behind must allow at least one outstanding part");
+	}
+	UpdateConfigSnapshot([&](HedgedConfigSnapshot &snapshot) {
+		snapshot.config.write_behind_max_outstanding_parts = max_parts;
+	});
+}
+
+void HedgedRequestFsEntry::UpdateEnableWriteHedging(bool enable) {
+	UpdateConfigSnapshot([&](HedgedConfigSnapshot &snapshot) { snapshot.config.enable_write_hedging = enable; });
+}
+
+void HedgedRequestFsEntry::UpdateReadBufferPoolMaxBytes(idx_t max_bytes) {
+	read_buffer_pool->SetMaxBytes(max_bytes);
+}
+
+void HedgedRequestFsEntry::UpdateEnableTiedRequests(bool enable) {
+	UpdateConfigSnapshot([&](HedgedConfigSnapshot &snapshot) { snapshot.config.enable_tied_requests = enable; });
+}
+
+void HedgedRequestFsEntry::UpdateHedgeMaxQueueDepth(uint64_t max_depth) {
+	UpdateConfigSnapshot([&](HedgedConfigSnapshot &snapshot) { snapshot.config.hedge_max_queue_depth = max_depth; });
+}
+
+void HedgedRequestFsEntry::UpdateHedgeMaxQueueWait(std::chrono::milliseconds max_wait) {
+	UpdateConfigSnapshot([&](HedgedConfigSnapshot &snapshot) { snapshot.config.hedge_max_queue_wait = max_wait; });
+}
+
+void HedgedRequestFsEntry::UpdateEnableFirstSuccessWins(bool enable) {
+	UpdateConfigSnapshot([&](HedgedConfigSnapshot &snapshot) { snapshot.config.enable_first_success_wins = enable; });
+}
+
+void HedgedRequestFsEntry::UpdateEnableRequestTrace(bool enable) {
+	UpdateConfigSnapshot([&](HedgedConfigSnapshot &snapshot) { snapshot.config.enable_request_trace = enable; });
+}
+
+void HedgedRequestFsEntry::UpdateShutdownTimeout(std::chrono::milliseconds timeout) {
+	UpdateConfigSnapshot([&](HedgedConfigSnapshot &snapshot) { snapshot.config.shutdown_timeout = timeout; });
+}
+
+void HedgedRequestFsEntry::UpdateEnableRequestCoalescing(bool enable) {
+	UpdateConfigSnapshot([&](HedgedConfigSnapshot &snapshot) { snapshot.config.enable_request_coalescing = enable; });
+}
+
+void HedgedRequestFsEntry::UpdateEnableStreamingListing(bool enable) {
+	UpdateConfigSnapshot([&](HedgedConfigSnapshot &snapshot) { snapshot.config.enable_streaming_listing = enable; });
+}
+
+void HedgedRequestFsEntry::UpdateListingPageSize(uint64_t page_size) {
+	if (page_size == 0) {
+		throw InvalidInputException("Listing page size must be positive");
+	}
+	UpdateConfigSnapshot([&](HedgedConfigSnapshot &snapshot) { snapshot.config.listing_page_size = page_size; });
+}
+
+void HedgedRequestFsEntry::UpdateGlobParallelism(uint64_t parallelism) {
+	if (parallelism == 0) {
+		throw InvalidInputException("Glob parallelism must be positive");
+	}
+	UpdateConfigSnapshot([&](HedgedConfigSnapshot &snapshot) { snapshot.config.glob_parallelism = parallelism; });
+}
+
+void HedgedRequestFsEntry::UpdateMetadataPrefetchConcurrency(uint64_t concurrency) {
+	if (concurrency == 0) {
+		throw InvalidInputException("Metadata prefetch concurrency must be positive");
+	}
+	UpdateConfigSnapshot(
+	    [&](HedgedConfigSnapshot &snapshot) { snapshot.config.metadata_prefetch_concurrency = concurrency; });
+}
+
+void HedgedRequestFsEntry::UpdateOpenPrefetchFileCount(uint64_t file_count) {
+	UpdateConfigSnapshot(
+	    [&](HedgedConfigSnapshot &snapshot) { snapshot.config.open_prefetch_file_count = file_count; });
+}
+
+void HedgedRequestFsEntry::UpdateOpenPrefetchTtl(std::chrono::milliseconds ttl_ms) {
+	open_prefetch_cache->SetTtl(ttl_ms);
+}
+
+void HedgedRequestFsEntry::UpdateOpenPrefetchMaxBytes(idx_t max_bytes) {
+	open_prefetch_cache->SetMaxBytes(max_bytes);
+}
+
+void HedgedRequestFsEntry::UpdateHandlePoolMaxHandles(idx_t max_handles) {
+	file_handle_pool->SetMaxHandles(max_handles);
+}
+
+void HedgedRequestFsEntry::UpdateHandlePoolTtl(std::chrono::milliseconds ttl_ms) {
+	file_handle_pool->SetTtl(ttl_ms);
 }
 
 } // namespace duckdb
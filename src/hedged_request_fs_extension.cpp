@@ -23,6 +23,33 @@ void LoadInternal(ExtensionLoader &loader) {
 	loader.RegisterFunction(GetHedgedFsListFilesystemsFunction());
 	loader.RegisterFunction(GetHedgedFsWrapFunction());
 
+	// Register hedging policy functions
+	loader.RegisterFunction(GetHedgedFsSetPolicyFunction());
+	loader.RegisterFunction(GetHedgedFsClearPoliciesFunction());
+	loader.RegisterFunction(GetHedgedFsListPoliciesFunction());
+
+	// Register replica functions
+	loader.RegisterFunction(GetHedgedFsAddReplicaFunction());
+	loader.RegisterFunction(GetHedgedFsClearReplicasFunction());
+	loader.RegisterFunction(GetHedgedFsListReplicasFunction());
+
+	// Register observability functions
+	loader.RegisterFunction(GetHedgedFsStatsFunction());
+	loader.RegisterFunction(GetHedgedFsResetStatsFunction());
+	loader.RegisterFunction(GetHedgedFsThreadPoolStatsFunction());
+	loader.RegisterFunction(GetHedgedFsRecentRequestsFunction());
+
+	// Register metadata cache functions
+	loader.RegisterFunction(GetHedgedFsInvalidateMetadataCacheFunction());
+	loader.RegisterFunction(GetHedgedFsPrefetchMetadataFunction());
+
+	// Register listing cache functions
+	loader.RegisterFunction(GetHedgedFsInvalidateListingCacheFunction());
+
+	// Register latency profile functions
+	loader.RegisterFunction(GetHedgedFsSaveProfileFunction());
+	loader.RegisterFunction(GetHedgedFsLoadProfileFunction());
+
 	// Register MockFileSystem at extension load for testing purpose
 	auto &opener_fs = db.GetFileSystem().Cast<OpenerFileSystem>();
 	auto &vfs = opener_fs.GetFileSystem();
@@ -0,0 +1,97 @@
+#include "hedged_request_stats.hpp"
+
+#include "duckdb/common/numeric_utils.hpp"
+
+namespace duckdb {
+
+namespace {
+// Assign shards to threads in round-robin, so threads spread evenly over shards.
+std::atomic<idx_t> next_shard_idx {0};
+
+thread_local ScopedHedgeCounter *current_hedge_counter = nullptr;
+} // namespace
+
+constexpr idx_t HedgedOperationStats::LATENCY_BUCKET_COUNT;
+
+uint64_t HedgedOperationStats::GetLatencyBucketUpperBound(idx_t bucket_idx) {
+	return uint64_t(1) << bucket_idx;
+}
+
+idx_t HedgedOperationStats::GetLatencyBucket(std::chrono::microseconds latency) {
+	if (latency.count() <= 0) {
+		return 0;
+	}
+	auto value = NumericCast<uint64_t>(latency.count());
+	idx_t bucket_idx = 1;
+	while (value >>= 1) {
+		++bucket_idx;
+	}
+	return bucket_idx < LATENCY_BUCKET_COUNT ? bucket_idx : LATENCY_BUCKET_COUNT - 1;
+}
+
+HedgedRequestStats::HedgedRequestStats() {
+	for (auto &shard : shards) {
+		for (auto &counters : shard.operations) {
+			for (auto &bucket : counters.latency_histogram) {
+				bucket.store(0, std::memory_order_relaxed);
+			}
+		}
+	}
+}
+
+HedgedRequestStats::OperationCounters &HedgedRequestStats::GetCounters(HedgedRequestOperation operation) {
+	thread_local idx_t shard_idx = next_shard_idx.fetch_add(1, std::memory_order_relaxed) % SHARD_COUNT;
+	return shards[shard_idx].operations[NumericCast<size_t>(operation)];
+}
+
+HedgedOperationStats HedgedRequestStats::GetStats(HedgedRequestOperation operation) const {
+	HedgedOperationStats stats;
+	for (const auto &shard : shards) {
+		const auto &counters = shard.operations[NumericCast<size_t>(operation)];
+		stats.primary_requests += counters.primary_requests.load(std::memory_order_relaxed);
+		stats.hedged_requests += counters.hedged_requests.load(std::memory_order_relaxed);
+		stats.hedge_wins += counters.hedge_wins.load(std::memory_order_relaxed);
+		stats.failed_attempts += counters.failed_attempts.load(std::memory_order_relaxed);
+		stats.skipped_attempts += counters.skipped_attempts.load(std::memory_order_relaxed);
+		stats.suppressed_hedges += counters.suppressed_hedges.load(std::memory_order_relaxed);
+		stats.inline_requests += counters.inline_requests.load(std::memory_order_relaxed);
+		stats.pending_attempts += counters.pending_attempts.load(std::memory_order_relaxed);
+		for (idx_t idx = 0; idx < HedgedOperationStats::LATENCY_BUCKET_COUNT; ++idx) {
+			stats.latency_histogram[idx] += counters.latency_histogram[idx].load(std::memory_order_relaxed);
+		}
+	}
+	return stats;
+}
+
+void HedgedRequestStats::Reset() {
+	for (auto &shard : shards) {
+		for (auto &counters : shard.operations) {
+			counters.primary_requests.store(0, std::memory_order_relaxed);
+			counters.hedged_requests.store(0, std::memory_order_relaxed);
+			counters.hedge_wins.store(0, std::memory_order_relaxed);
+			counters.failed_attempts.store(0, std::memory_order_relaxed);
+			counters.skipped_attempts.store(0, std::memory_order_relaxed);
+			counters.suppressed_hedges.store(0, std::memory_order_relaxed);
+			counters.inline_requests.store(0, std::memory_order_relaxed);
+			for (auto &bucket : counters.latency_histogram) {
+				bucket.store(0, std::memory_order_relaxed);
+			}
+		}
+	}
+}
+
+ScopedHedgeCounter::ScopedHedgeCounter() : previous(current_hedge_counter) {
+	current_hedge_counter = this;
+}
+
+ScopedHedgeCounter::~ScopedHedgeCounter() {
+	current_hedge_counter = previous;
+}
+
+void ScopedHedgeCounter::Record(uint64_t count) {
+	if (current_hedge_counter != nullptr) {
+		current_hedge_counter->hedged_requests += count;
+	}
+}
+
+} // namespace duckdb
@@ -0,0 +1,203 @@
+#include "hedging_policy.hpp"
+
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/numeric_utils.hpp"
+#include "duckdb/common/string_util.hpp"
+
+#include <algorithm>
+
+namespace duckdb {
+
+namespace {
+constexpr const char *DELAY_OPTION_SUFFIX = "_delay_ms";
+constexpr const char *MAX_HEDGED_REQUEST_COUNT_OPTION = "max_hedged_request_count";
+constexpr const char *ENABLE_WRITE_HEDGING_OPTION = "enable_write_hedging";
+constexpr const char *ENABLE_INLINE_EXECUTION_OPTION = "enable_inline_execution";
+
+// Get the value keyed by [prefix] in [entries] sorted by prefix length in descending order, which is created if not
+// exists.
+template <typename T>
+T &GetOrCreateByPrefix(vector<std::pair<string, T>> &entries, const string &prefix) {
+	for (auto &cur_entry : entries) {
+		if (cur_entry.first == prefix) {
+			return cur_entry.second;
+		}
+	}
+	// Keep longer prefixes first, so lookup could stop at the first match.
+	auto iter = std::find_if(entries.begin(), entries.end(), [&prefix](const std::pair<string, T> &cur_entry) {
+		return cur_entry.first.size() < prefix.size();
+	});
+	iter = entries.emplace(iter, prefix, T {});
+	return iter->second;
+}
+} // namespace
+
+string GetHedgedRequestOperationName(HedgedRequestOperation operation) {
+	switch (operation) {
+	case HedgedRequestOperation::OPEN_FILE:
+		return "open_file";
+	case HedgedRequestOperation::GLOB:
+		return "glob";
+	case HedgedRequestOperation::FILE_EXISTS:
+		return "file_exists";
+	case HedgedRequestOperation::DIRECTORY_EXISTS:
+		return "directory_exists";
+	case HedgedRequestOperation::GET_FILE_SIZE:
+		return "get_file_size";
+	case HedgedRequestOperation::GET_LAST_MODIFIED_TIME:
+		return "get_last_modified_time";
+	case HedgedRequestOperation::GET_FILE_TYPE:
+		return "get_file_type";
+	case HedgedRequestOperation::GET_VERSION_TAG:
+		return "get_version_tag";
+	case HedgedRequestOperation::LIST_FILES:
+		return "list_files";
+	case HedgedRequestOperation::GET_STATS:
+		return "get_stats";
+	case HedgedRequestOperation::FILE_DELETE:
+		return "delete";
+	case HedgedRequestOperation::DIRECTORY_CREATE:
+		return "create_directory";
+	case HedgedRequestOperation::READ:
+		return "read";
+	case HedgedRequestOperation::WRITE:
+		return "write";
+	default:
+		throw InvalidInputException("Invalid operation: %d", NumericCast<int>(operation));
+	}
+}
+
+HedgingPolicyScope GetHedgingPolicyScope(const string &scope_name) {
+	const auto lower_scope_name = StringUtil::Lower(scope_name);
+	if (lower_scope_name == "filesystem") {
+		return HedgingPolicyScope::FILESYSTEM;
+	}
+	if (lower_scope_name == "prefix") {
+		return HedgingPolicyScope::PREFIX;
+	}
+	throw InvalidInputException("Unknown hedging policy scope '%s', expected 'filesystem' or 'prefix'", scope_name);
+}
+
+string GetHedgingPolicyScopeName(HedgingPolicyScope scope) {
+	return scope == HedgingPolicyScope::FILESYSTEM ? "filesystem" : "prefix";
+}
+
+//===--------------------------------------------------------------------===//
+// HedgingPolicy
+//===--------------------------------------------------------------------===//
+
+void HedgingPolicy::SetOption(const string &option, idx_t value) {
+	const auto lower_option = StringUtil::Lower(option);
+	if (lower_option == MAX_HEDGED_REQUEST_COUNT_OPTION) {
+		max_hedged_request_count = value;
+		return;
+	}
+	if (lower_option == ENABLE_WRITE_HEDGING_OPTION) {
+		enable_write_hedging = value;
+		return;
+	}
+	if (lower_option == ENABLE_INLINE_EXECUTION_OPTION) {
+		enable_inline_execution = value;
+		return;
+	}
+	for (size_t idx = 0; idx < NumericCast<size_t>(HedgedRequestOperation::COUNT); ++idx) {
+		const auto operation = static_cast<HedgedRequestOperation>(idx);
+		if (lower_option == GetHedgedRequestOperationName(operation) + DELAY_OPTION_SUFFIX) {
+			delays_ms[idx] = value;
+			return;
+		}
+	}
+	throw InvalidInputException(
+	    "Unknown hedging policy option '%s', expected '<operation>_delay_ms', 'max_hedged_request_count', "
+	    "'enable_write_hedging' or 'enable_inline_execution'",
+	    option);
+}
+
+void HedgingPolicy::ApplyTo(HedgedRequestConfig &config) const {
+	for (size_t idx = 0; idx < delays_ms.size(); ++idx) {
+		if (delays_ms[idx].IsValid()) {
+			config.delays_ms[idx] = std::chrono::milliseconds(NumericCast<int64_t>(delays_ms[idx].GetIndex()));
+		}
+	}
+	if (max_hedged_request_count.IsValid()) {
+		config.max_hedged_request_count = NumericCast<size_t>(max_hedged_request_count.GetIndex());
+	}
+	if (enable_write_hedging.IsValid()) {
+		config.enable_write_hedging = enable_write_hedging.GetIndex() != 0;
+	}
+	if (enable_inline_execution.IsValid()) {
+		config.enable_inline_execution = enable_inline_execution.GetIndex() != 0;
+	}
+}
+
+vector<std::pair<string, idx_t>> HedgingPolicy::ListOptions() const {
+	vector<std::pair<string, idx_t>> options;
+	for (size_t idx = 0; idx < delays_ms.size(); ++idx) {
+		if (delays_ms[idx].IsValid()) {
+			options.emplace_back(GetHedgedRequestOperationName(static_cast<HedgedRequestOperation>(idx)) +
+			                         DELAY_OPTION_SUFFIX,
+			                     delays_ms[idx].GetIndex());
+		}
+	}
+	if (max_hedged_request_count.IsValid()) {
+		options.emplace_back(MAX_HEDGED_REQUEST_COUNT_OPTION, max_hedged_request_count.GetIndex());
+	}
+	if (enable_write_hedging.IsValid()) {
+		options.emplace_back(ENABLE_WRITE_HEDGING_OPTION, enable_write_hedging.GetIndex());
+	}
+	if (enable_inline_execution.IsValid()) {
+		options.emplace_back(ENABLE_INLINE_EXECUTION_OPTION, enable_inline_execution.GetIndex());
+	}
+	std::sort(options.begin(), options.end());
+	return options;
+}
+
+//===--------------------------------------------------------------------===//
+// HedgedConfigSnapshot
+//===--------------------------------------------------------------------===//
+
+HedgingPolicy &HedgedConfigSnapshot::GetOrCreatePrefixPolicy(const string &prefix) {
+	return GetOrCreateByPrefix(prefix_policies, prefix);
+}
+
+void HedgedConfigSnapshot::AddReplica(const string &prefix, const string &replica_prefix) {
+	auto &replicas = GetOrCreateByPrefix(replica_prefixes, prefix);
+	if (std::find(replicas.begin(), replicas.end(), replica_prefix) == replicas.end()) {
+		replicas.emplace_back(replica_prefix);
+	}
+}
+
+vector<string> HedgedConfigSnapshot::ResolveReplicaPaths(const string &path) const {
+	vector<string> replica_paths;
+	for (const auto &cur_replica : replica_prefixes) {
+		if (!StringUtil::StartsWith(path, cur_replica.first)) {
+			continue;
+		}
+		const auto suffix = path.substr(cur_replica.first.size());
+		replica_paths.reserve(cur_replica.second.size());
+		for (const auto &cur_replica_prefix : cur_replica.second) {
+			replica_paths.emplace_back(cur_replica_prefix + suffix);
+		}
+		break;
+	}
+	return replica_paths;
+}
+
+HedgedRequestConfig HedgedConfigSnapshot::Resolve(const string &filesystem_name, const string &path) const {
+	HedgedRequestConfig resolved = config;
+	if (!filesystem_policies.empty()) {
+		auto iter = filesystem_policies.find(filesystem_name);
+		if (iter != filesystem_policies.end()) {
+			iter->second.ApplyTo(resolved);
+		}
+	}
+	for (const auto &cur_policy : prefix_policies) {
+		if (StringUtil::StartsWith(path, cur_policy.first)) {
+			cur_policy.second.ApplyTo(resolved);
+			break;
+		}
+	}
+	return resolved;
+}
+
+} // namespace duckdb
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "duckdb/common/optional_ptr.hpp"
+#include "duckdb/common/shared_ptr.hpp"
+#include "duckdb/common/vector.hpp"
+#include "mutex.hpp"
+#include "thread_annotation.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+
+namespace duckdb {
+
+// Cancellation token shared by all attempts of one hedged request, which is cancelled once the first attempt completes.
+//
+// Attempts which haven't started are dropped; in-flight attempts are not interrupted by the extension, but wrapped
+// filesystems could opt in to cooperative cancellation: the token of the attempt running on the current thread is
+// exposed via [GetCurrent], so a wrapped filesystem could poll [IsCancelled], register a callback to abort its
+// outstanding IO, or use [WaitFor] instead of sleeping for retry backoff.
+class CancellationToken {
+public:
+	using CallbackId = idx_t;
+
+	CancellationToken() = default;
+
+	CancellationToken(const CancellationToken &) = delete;
+	CancellationToken &operator=(const CancellationToken &) = delete;
+
+	bool IsCancelled() const {
+		return cancelled.load(std::memory_order_acquire);
+	}
+
+	// Cancel the token and invoke all registered callbacks, only the first invocation takes effect.
+	void Cancel();
+
+	// Register a callback invoked on cancellation; if the token is already cancelled, the callback is invoked inline.
+	// Return an id to unregister the callback.
+	CallbackId AddCallback(std::function<void()> callback);
+
+	// Unregister callback, which is a no-op if it's already invoked.
+	void RemoveCallback(CallbackId id);
+
+	// Block until the token is cancelled or [timeout] elapses, return whether the token is cancelled.
+	bool WaitFor(std::chrono::microseconds timeout);
+
+	// Get the cancellation token of the hedged attempt running on the current thread, or nullptr if there's none.
+	static optional_ptr<CancellationToken> GetCurrent();
+
+private:
+	friend class ScopedCancellationToken;
+
+	std::atomic<bool> cancelled {false};
+	concurrency::mutex mu;
+	std::condition_variable cv DUCKDB_GUARDED_BY(mu);
+	CallbackId next_callback_id DUCKDB_GUARDED_BY(mu) = 0;
+	vector<std::pair<CallbackId, std::function<void()>>> callbacks DUCKDB_GUARDED_BY(mu);
+};
+
+// Install the cancellation token for the current thread within the scope.
+class ScopedCancellationToken {
+public:
+	explicit ScopedCancellationToken(optional_ptr<CancellationToken> token);
+	~ScopedCancellationToken();
+
+	ScopedCancellationToken(const ScopedCancellationToken &) = delete;
+	ScopedCancellationToken &operator=(const ScopedCancellationToken &) = delete;
+
+private:
+	optional_ptr<CancellationToken> previous;
+};
+
+} // namespace duckdb
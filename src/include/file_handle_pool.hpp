@@ -0,0 +1,89 @@
+#pragma once
+
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/shared_ptr.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "mutex.hpp"
+#include "thread_annotation.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <list>
+
+namespace duckdb {
+
+// Share [handle], which is closed once its last reference is released.
+shared_ptr<FileHandle> MakeSharedFileHandle(unique_ptr<FileHandle> handle);
+
+// Version of the file a pooled handle has been opened on, used to validate the handle before it's reused.
+struct PooledHandleVersion {
+	// Empty if the wrapped filesystem doesn't provide version tags.
+	string version_tag;
+	timestamp_t last_modified_time;
+};
+
+// Bounded pool of idle read-only file handles, keyed by wrapped filesystem and path, and by open flags.
+//
+// Handles come from losing OpenFile attempts and from closed handles nobody else references, and are handed out to
+// the next open of the same file with the same flags. Idle handles expire after the configured time to live, which is
+// checked on access; once the pool is full, the least recently pooled handle is closed first.
+class FileHandlePool {
+public:
+	FileHandlePool();
+
+	FileHandlePool(const FileHandlePool &) = delete;
+	FileHandlePool &operator=(const FileHandlePool &) = delete;
+
+	// Pool is disabled with zero max handles.
+	bool IsEnabled() const {
+		return max_handles.load(std::memory_order_relaxed) > 0;
+	}
+	void SetTtl(std::chrono::milliseconds ttl_p);
+	// Update the bound on pooled handles, handles beyond the new bound are closed.
+	void SetMaxHandles(idx_t max_handles_p);
+
+	// Keep [handle] opened with [flags] on [version] of the file, no-op if the pool is disabled.
+	void Put(const string &key, idx_t flags, shared_ptr<FileHandle> handle, PooledHandleVersion version);
+	// Take the most recently pooled handle for [key] and [flags]; handles which are expired or which [is_current]
+	// rejects are closed. Return nullptr if there's none.
+	shared_ptr<FileHandle> TryTake(const string &key, idx_t flags,
+	                               const std::function<bool(const PooledHandleVersion &)> &is_current);
+
+	// Drop all handles of [key], for all flags.
+	void Erase(const string &key);
+	// Drop all handles whose key starts with [prefix].
+	void ErasePrefix(const string &prefix);
+
+	idx_t GetHandleCount() const;
+
+private:
+	struct PooledHandle {
+		string key;
+		idx_t flags;
+		shared_ptr<FileHandle> handle;
+		PooledHandleVersion version;
+		std::chrono::steady_clock::time_point expire_at;
+	};
+	// Handles are kept in pooling order, which is also expiry order since they share one time to live.
+	using HandleList = std::list<PooledHandle>;
+
+	// Move expired handles into [evicted].
+	void EvictExpired(std::chrono::steady_clock::time_point now, vector<shared_ptr<FileHandle>> &evicted)
+	    DUCKDB_REQUIRES(mu);
+	// Move the oldest handles into [evicted] until at most [limit] handles are pooled.
+	void EvictToLimit(idx_t limit, vector<shared_ptr<FileHandle>> &evicted) DUCKDB_REQUIRES(mu);
+	void EraseHandle(HandleList::iterator iter, vector<shared_ptr<FileHandle>> &evicted) DUCKDB_REQUIRES(mu);
+
+	std::atomic<int64_t> ttl_ms;
+	std::atomic<idx_t> max_handles;
+
+	mutable concurrency::mutex mu;
+	HandleList handles DUCKDB_GUARDED_BY(mu);
+	// Pooled handles of a key, in pooling order.
+	unordered_map<string, vector<HandleList::iterator>> index DUCKDB_GUARDED_BY(mu);
+	// Number of pooled handles, so lookups into an empty pool don't take the lock.
+	std::atomic<idx_t> handle_count {0};
+};
+
+} // namespace duckdb
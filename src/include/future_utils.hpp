@@ -1,24 +1,73 @@
 #pragma once
 
+#include "cancellation_token.hpp"
 #include "duckdb/common/helper.hpp"
 #include "duckdb/common/shared_ptr.hpp"
-#include "duckdb/common/unique_ptr.hpp"
 #include "mutex.hpp"
 #include "thread_annotation.hpp"
 
 #include <condition_variable>
 #include <exception>
 #include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 namespace duckdb {
 
+// Inline storage of the winning result of a hedged request, which is constructed at most once.
+template <typename T>
+class HedgedResultStorage {
+public:
+	HedgedResultStorage() = default;
+	~HedgedResultStorage() {
+		if (has_value) {
+			Get().~T();
+		}
+	}
+
+	HedgedResultStorage(const HedgedResultStorage &) = delete;
+	HedgedResultStorage &operator=(const HedgedResultStorage &) = delete;
+
+	void Emplace(T &&value) {
+		new (&storage) T(std::move(value));
+		has_value = true;
+	}
+	T &Get() {
+		return *reinterpret_cast<T *>(&storage);
+	}
+
+private:
+	typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+	bool has_value = false;
+};
+
+// Attempts which ended without deciding the outcome of a hedged request in first-success mode.
+struct HedgedSettledAttempts {
+	// Number of failed attempts, and the latest failure.
+	uint64_t failed = 0;
+	std::exception_ptr last_failure;
+	// Number of tied attempts skipped in the thread pool, which never ran.
+	uint64_t skipped = 0;
+
+	uint64_t GetCount() const {
+		return failed + skipped;
+	}
+};
+
 template <typename T>
 struct HedgedOutcomeToken {
 	concurrency::mutex mu;
 	std::condition_variable cv DUCKDB_GUARDED_BY(mu);
 	bool completed DUCKDB_GUARDED_BY(mu) = false;
 	std::exception_ptr eptr DUCKDB_GUARDED_BY(mu);
-	unique_ptr<T> value DUCKDB_GUARDED_BY(mu);
+	HedgedResultStorage<T> value DUCKDB_GUARDED_BY(mu);
+	// Cancelled once the outcome is recorded, so remaining attempts could be dropped or aborted.
+	CancellationToken cancellation;
+	// In first-success mode, a failed attempt is only recorded into [settled], and the outcome is decided by the first
+	// successful attempt or by [FailHedgedOutcome]. Set before any attempt is submitted.
+	bool first_success_wins = false;
+	HedgedSettledAttempts settled DUCKDB_GUARDED_BY(mu);
 };
 
 template <>
@@ -27,67 +76,151 @@ struct HedgedOutcomeToken<void> {
 	std::condition_variable cv DUCKDB_GUARDED_BY(mu);
 	bool completed DUCKDB_GUARDED_BY(mu) = false;
 	std::exception_ptr eptr DUCKDB_GUARDED_BY(mu);
+	// Cancelled once the outcome is recorded, so remaining attempts could be dropped or aborted.
+	CancellationToken cancellation;
+	// In first-success mode, a failed attempt is only recorded into [settled], and the outcome is decided by the first
+	// successful attempt or by [FailHedgedOutcome]. Set before any attempt is submitted.
+	bool first_success_wins = false;
+	HedgedSettledAttempts settled DUCKDB_GUARDED_BY(mu);
 };
 
 template <typename T>
-T WaitForHedgedOutcome(shared_ptr<HedgedOutcomeToken<T>> token) {
-	concurrency::unique_lock<concurrency::mutex> lock(token->mu);
-	token->cv.wait(lock, [token]() DUCKDB_REQUIRES(token->mu) { return token->completed; });
-	if (token->eptr != nullptr) {
-		std::rethrow_exception(token->eptr);
+T WaitForHedgedOutcome(HedgedOutcomeToken<T> &token) {
+	concurrency::unique_lock<concurrency::mutex> lock(token.mu);
+	token.cv.wait(lock, [&token]() DUCKDB_REQUIRES(token.mu) { return token.completed; });
+	if (token.eptr != nullptr) {
+		std::rethrow_exception(token.eptr);
+	}
+	return std::move(token.value.Get());
+}
+
+inline void WaitForHedgedOutcome(HedgedOutcomeToken<void> &token) {
+	concurrency::unique_lock<concurrency::mutex> lock(token.mu);
+	token.cv.wait(lock, [&token]() DUCKDB_REQUIRES(token.mu) { return token.completed; });
+	if (token.eptr != nullptr) {
+		std::rethrow_exception(token.eptr);
 	}
-	return std::move(*token->value);
 }
 
-inline void WaitForHedgedOutcome(shared_ptr<HedgedOutcomeToken<void>> token) {
-	concurrency::unique_lock<concurrency::mutex> lock(token->mu);
-	token->cv.wait(lock, [token]() DUCKDB_REQUIRES(token->mu) { return token->completed; });
-	if (token->eptr != nullptr) {
-		std::rethrow_exception(token->eptr);
+template <typename T>
+T WaitForHedgedOutcome(const shared_ptr<HedgedOutcomeToken<T>> &token) {
+	return WaitForHedgedOutcome(*token);
+}
+
+// Record the outcome of an attempt, first completed attempt wins and outcome of later ones is discarded.
+// Return whether the given outcome is recorded.
+template <typename T, typename Fn>
+bool RecordHedgedOutcome(HedgedOutcomeToken<T> &token, Fn &&record) {
+	{
+		concurrency::unique_lock<concurrency::mutex> lock(token.mu);
+		if (token.completed) {
+			return false;
+		}
+		record();
+		token.completed = true;
+		token.cv.notify_all();
 	}
+	token.cancellation.Cancel();
+	return true;
 }
 
+// Record a failed attempt in first-success mode, which doesn't decide the outcome.
 template <typename T>
-void RunHedgedJob(std::function<T()> fn, shared_ptr<HedgedOutcomeToken<T>> token) {
+void RecordHedgedFailure(HedgedOutcomeToken<T> &token, std::exception_ptr eptr) {
+	const concurrency::lock_guard<concurrency::mutex> lock(token.mu);
+	if (token.completed) {
+		return;
+	}
+	token.settled.failed++;
+	token.settled.last_failure = std::move(eptr);
+	token.cv.notify_all();
+}
+
+// Record a tied attempt skipped in the thread pool, no-op unless in first-success mode.
+template <typename T>
+void RecordHedgedSkip(HedgedOutcomeToken<T> &token) {
+	if (!token.first_success_wins) {
+		return;
+	}
+	const concurrency::lock_guard<concurrency::mutex> lock(token.mu);
+	token.settled.skipped++;
+	token.cv.notify_all();
+}
+
+// Decide the outcome with the latest failure in first-success mode, once no attempt is left which could succeed.
+// Return whether the failure is recorded.
+template <typename T>
+bool FailHedgedOutcome(HedgedOutcomeToken<T> &token) {
+	return RecordHedgedOutcome(token,
+	                           [&token]() DUCKDB_REQUIRES(token.mu) { token.eptr = token.settled.last_failure; });
+}
+
+// Block until the outcome is decided, or more attempts have settled than [seen]; return the settled attempts.
+template <typename T>
+HedgedSettledAttempts WaitForSettledAttempts(HedgedOutcomeToken<T> &token, const HedgedSettledAttempts &seen) {
+	concurrency::unique_lock<concurrency::mutex> lock(token.mu);
+	token.cv.wait(lock, [&token, &seen]() DUCKDB_REQUIRES(token.mu) {
+		return token.completed || token.settled.GetCount() > seen.GetCount();
+	});
+	return token.settled;
+}
+
+// Run an attempt and record its outcome, return whether the outcome wins.
+// If provided, a successful result which loses the race is handed to [on_discarded] instead of being destroyed.
+template <typename T, typename Fn>
+bool RunHedgedJob(Fn &&fn, HedgedOutcomeToken<T> &token, const std::function<void(T)> &on_discarded = nullptr) {
+	// Another attempt has completed before this one gets scheduled, simply drop it.
+	if (token.cancellation.IsCancelled()) {
+		return false;
+	}
+	ScopedCancellationToken scoped_cancellation(&token.cancellation);
 	try {
 		T r = fn();
-		{
-			concurrency::unique_lock<concurrency::mutex> lock(token->mu);
-			ALWAYS_ASSERT(!token->completed);
-			token->value = make_uniq<T>(std::move(r));
-			token->completed = true;
-			token->cv.notify_all();
+		const bool won =
+		    RecordHedgedOutcome(token, [&]() DUCKDB_REQUIRES(token.mu) { token.value.Emplace(std::move(r)); });
+		if (!won && on_discarded) {
+			on_discarded(std::move(r));
 		}
+		return won;
 	} catch (...) {
-		{
-			concurrency::unique_lock<concurrency::mutex> lock(token->mu);
-			ALWAYS_ASSERT(!token->completed);
-			token->eptr = std::current_exception();
-			token->completed = true;
-			token->cv.notify_all();
+		auto eptr = std::current_exception();
+		if (token.first_success_wins) {
+			RecordHedgedFailure(token, std::move(eptr));
+			return false;
 		}
+		return RecordHedgedOutcome(token, [&]() DUCKDB_REQUIRES(token.mu) { token.eptr = std::move(eptr); });
 	}
 }
 
-inline void RunHedgedVoidJob(std::function<void()> fn, shared_ptr<HedgedOutcomeToken<void>> token) {
+template <typename T, typename Fn>
+bool RunHedgedJob(Fn &&fn, const shared_ptr<HedgedOutcomeToken<T>> &token,
+                  const std::function<void(T)> &on_discarded = nullptr) {
+	return RunHedgedJob(std::forward<Fn>(fn), *token, on_discarded);
+}
+
+template <typename Fn>
+bool RunHedgedVoidJob(Fn &&fn, HedgedOutcomeToken<void> &token) {
+	// Another attempt has completed before this one gets scheduled, simply drop it.
+	if (token.cancellation.IsCancelled()) {
+		return false;
+	}
+	ScopedCancellationToken scoped_cancellation(&token.cancellation);
 	try {
 		fn();
-		{
-			concurrency::unique_lock<concurrency::mutex> lock(token->mu);
-			if (!token->completed) {
-				token->completed = true;
-			}
-			token->cv.notify_all();
-		}
+		return RecordHedgedOutcome(token, []() {});
 	} catch (...) {
-		{
-			concurrency::unique_lock<concurrency::mutex> lock(token->mu);
-			ALWAYS_ASSERT(!token->completed);
-			token->eptr = std::current_exception();
-			token->completed = true;
-			token->cv.notify_all();
+		auto eptr = std::current_exception();
+		if (token.first_success_wins) {
+			RecordHedgedFailure(token, std::move(eptr));
+			return false;
 		}
+		return RecordHedgedOutcome(token, [&]() DUCKDB_REQUIRES(token.mu) { token.eptr = std::move(eptr); });
 	}
 }
 
+template <typename Fn>
+bool RunHedgedVoidJob(Fn &&fn, const shared_ptr<HedgedOutcomeToken<void>> &token) {
+	return RunHedgedVoidJob(std::forward<Fn>(fn), *token);
+}
+
 } // namespace duckdb
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/vector.hpp"
+
+namespace duckdb {
+
+// Glob pattern split at its first wildcard level, e.g. "s3://bucket/events/*/*.parquet" is split into base
+// "s3://bucket/events/", segment "*" and suffix "/*.parquet". Every directory under [base] matching [segment] is listed
+// as one partition, namely "<base><directory><suffix>".
+struct GlobPartitioning {
+	string base;
+	string segment;
+	string suffix;
+
+	// Get the glob pattern for the partition of the given directory name.
+	string GetPartitionPattern(const string &directory) const {
+		return base + directory + suffix;
+	}
+};
+
+// Glob pattern split into the directory of its first wildcard and the path segments below, e.g.
+// "s3://bucket/events/date=*/hour=*/*.parquet" is split into base "s3://bucket/events/" and segments "date=*", "hour=*"
+// and "*.parquet". Directories are expanded level by level, and the last segment matches files.
+struct GlobLevels {
+	string base;
+	vector<string> segments;
+};
+
+// Return whether [segment] has any wildcard.
+bool HasGlobWildcard(const string &segment);
+
+// Split [pattern] into levels. Return false if the pattern cannot be expanded level by level, namely it has no
+// wildcard, the first wildcard is in the scheme part, it has an empty segment, or a segment is recursive ("**").
+bool SplitGlobLevels(const string &pattern, GlobLevels &levels);
+
+// Split [pattern] at its first wildcard level. Return false if the pattern cannot be partitioned, namely it has no
+// wildcard, the first wildcard is in the last path segment or the scheme part, or the segment is recursive ("**").
+bool SplitGlobPattern(const string &pattern, GlobPartitioning &partitioning);
+
+// Get the directory name relative to [base] for an entry returned by ListFiles, which could be either a bare name or a
+// full path, with trailing separator stripped. Return empty string if the entry is not a direct child of [base].
+string GetPartitionDirectoryName(const string &base, const string &listed_name);
+
+// Return whether ListFiles of the filesystem named [filesystem_name] lists one directory level and reports
+// subdirectories, which globs expanded level by level rely on. Object stores without delimiter listing, e.g. httpfs's
+// S3 filesystem, list every key under the prefix instead, so listing a base directory is a full recursive listing.
+bool ListsDirectoryLevels(const string &filesystem_name);
+
+} // namespace duckdb
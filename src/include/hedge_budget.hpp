@@ -0,0 +1,41 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace duckdb {
+
+// Token bucket which bounds hedged requests relative to primary requests, as recommended by "The Tail at Scale".
+//
+// Every primary request deposits [ratio] tokens and every hedged request consumes one token, so over time at most
+// [ratio] of primary requests get hedged; [burst] caps accumulated tokens, which bounds hedges spawned at once after a
+// quiet period. The bucket starts full.
+class HedgeBudget {
+public:
+	HedgeBudget();
+
+	HedgeBudget(const HedgeBudget &) = delete;
+	HedgeBudget &operator=(const HedgeBudget &) = delete;
+
+	// Update the deposit ratio per primary request and the bucket capacity.
+	void Configure(double ratio, double burst);
+
+	// Deposit tokens for a new primary request.
+	void OnPrimaryRequest();
+
+	// Try to consume one token for a hedged request, return false if the budget is exhausted.
+	bool TryAcquire();
+
+	// Get the number of available tokens.
+	double GetAvailableTokens() const;
+
+private:
+	// Tokens are kept in fixed point, so the bucket could be updated with a single atomic operation.
+	static constexpr int64_t TOKEN_SCALE = 1000000;
+
+	std::atomic<int64_t> tokens;
+	std::atomic<int64_t> deposit;
+	std::atomic<int64_t> capacity;
+};
+
+} // namespace duckdb
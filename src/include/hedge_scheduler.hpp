@@ -0,0 +1,83 @@
+#pragma once
+
+#include "duckdb/common/unordered_map.hpp"
+#include "mutex.hpp"
+#include "thread_annotation.hpp"
+#include "timer_wheel.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <thread>
+
+namespace duckdb {
+
+// Single scheduler thread which owns hedge deadlines of all in-flight hedged requests.
+//
+// Deadlines are kept in a hierarchical timer wheel, and the thread only wakes up when a timer fires or the wheel
+// cascades, instead of every waiting caller polling on a timed wait. Callbacks run on the scheduler thread, so they're
+// expected to be short, e.g. submitting an attempt to the thread pool.
+class HedgeScheduler {
+public:
+	using Clock = std::chrono::steady_clock;
+	// Invoked on the scheduler thread when the timer fires; return true and set [next_deadline] to re-arm the timer.
+	using Callback = std::function<bool(Clock::time_point &next_deadline)>;
+
+	static constexpr std::chrono::milliseconds DEFAULT_TICK = std::chrono::milliseconds(1);
+
+	explicit HedgeScheduler(std::chrono::milliseconds tick_p = DEFAULT_TICK);
+	~HedgeScheduler();
+
+	HedgeScheduler(const HedgeScheduler &) = delete;
+	HedgeScheduler &operator=(const HedgeScheduler &) = delete;
+
+	// Schedule [callback] to be invoked at [deadline], and return the timer id.
+	uint64_t Schedule(Clock::time_point deadline, Callback callback);
+
+	// Cancel the given timer, return false if it has already fired without re-arming. If its callback is running, block
+	// until it completes, so states referenced by the callback could be released once cancelled.
+	bool Cancel(uint64_t timer_id);
+
+	// Get the number of timers pending to fire.
+	idx_t GetPendingTimerCount() const;
+
+	// Get the number of times the scheduler thread has woken up.
+	uint64_t GetWakeupCount() const {
+		return wakeup_count.load(std::memory_order_relaxed);
+	}
+
+private:
+	struct Timer {
+		Callback callback;
+		// Set if the timer is cancelled while its callback is running.
+		bool cancelled = false;
+	};
+
+	// Main loop of the scheduler thread.
+	void Run();
+	// Convert between time points and ticks; deadlines are rounded up, so timers never fire early.
+	uint64_t GetTick(Clock::time_point time_point) const;
+	uint64_t GetDeadlineTick(Clock::time_point deadline) const;
+	Clock::time_point GetTickTime(uint64_t tick) const;
+
+	const std::chrono::milliseconds tick;
+	const Clock::time_point start_time;
+
+	mutable concurrency::mutex mu;
+	std::condition_variable wakeup_cv DUCKDB_GUARDED_BY(mu);
+	std::condition_variable callback_completion_cv DUCKDB_GUARDED_BY(mu);
+	TimerWheel wheel DUCKDB_GUARDED_BY(mu);
+	unordered_map<uint64_t, Timer> timers DUCKDB_GUARDED_BY(mu);
+	uint64_t next_timer_id DUCKDB_GUARDED_BY(mu) = 1;
+	// Id of the timer whose callback is running, 0 if none.
+	uint64_t running_timer_id DUCKDB_GUARDED_BY(mu) = 0;
+	// Tick the scheduler thread is sleeping until, used to decide whether a new timer needs to wake it up earlier.
+	uint64_t planned_wakeup_tick DUCKDB_GUARDED_BY(mu) = UINT64_MAX;
+	bool stopped DUCKDB_GUARDED_BY(mu) = false;
+	std::atomic<uint64_t> wakeup_count {0};
+	std::thread thread;
+};
+
+} // namespace duckdb
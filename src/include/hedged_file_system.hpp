@@ -2,7 +2,13 @@
 
 #include "duckdb/common/file_system.hpp"
 #include "duckdb/common/shared_ptr.hpp"
+#include "file_handle_pool.hpp"
 #include "hedged_request_fs_entry.hpp"
+#include "listing_cache.hpp"
+#include "metadata_cache.hpp"
+#include "read_ahead_window.hpp"
+#include "single_flight.hpp"
+#include "write_behind_buffer.hpp"
 
 namespace duckdb {
 
@@ -11,9 +17,13 @@ class HedgedFileHandle;
 class HedgedRequestFsEntry;
 
 // HedgedFileSystem is a wrapper filesystem that performs hedged requests on slow IO operations.
+// If [metadata_cache_p] is provided, metadata calls are served from the cache when possible. If [listing_cache_p] is
+// provided, directory listings are served from the cache, and globs are expanded from cached listings.
 class HedgedFileSystem : public FileSystem {
 public:
-	HedgedFileSystem(unique_ptr<FileSystem> wrapped_fs, shared_ptr<HedgedRequestFsEntry> entry_p);
+	HedgedFileSystem(unique_ptr<FileSystem> wrapped_fs, shared_ptr<HedgedRequestFsEntry> entry_p,
+	                 shared_ptr<MetadataCache> metadata_cache_p = nullptr,
+	                 shared_ptr<ListingCache> listing_cache_p = nullptr);
 	~HedgedFileSystem() override;
 
 	// Hedged request operations
@@ -22,6 +32,8 @@ public:
 
 	bool DirectoryExists(const string &directory, optional_ptr<FileOpener> opener = nullptr) override;
 	bool FileExists(const string &filename, optional_ptr<FileOpener> opener = nullptr) override;
+	// In streaming listing mode, [callback] is invoked page by page as the winning attempt lists. If the winner fails
+	// mid-listing, [callback] has already seen a partial set of entries when the failure is thrown.
 	bool ListFiles(const string &directory, const std::function<void(const string &, bool)> &callback,
 	               FileOpener *opener = nullptr) override;
 	vector<OpenFileInfo> Glob(const string &path, FileOpener *opener = nullptr) override;
@@ -32,6 +44,9 @@ public:
 	FileType GetFileType(FileHandle &handle) override;
 	FileMetadata Stats(FileHandle &handle) override;
 
+	// Hedged only when read hedging is enabled.
+	void Read(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location) override;
+
 	void CreateDirectory(const string &directory, optional_ptr<FileOpener> opener = nullptr) override;
 	void CreateDirectoriesRecursive(const string &path, optional_ptr<FileOpener> opener = nullptr) override;
 
@@ -40,11 +55,12 @@ public:
 	void RemoveDirectory(const string &directory, optional_ptr<FileOpener> opener = nullptr) override;
 	void RemoveFiles(const vector<string> &filenames, optional_ptr<FileOpener> opener = nullptr) override;
 
-	// Delegate to wrapped filesystem
-	int64_t Read(FileHandle &handle, void *buffer, int64_t nr_bytes) override;
-	void Read(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location) override;
+	// Buffered and written in background when write-behind is enabled.
 	void Write(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location) override;
 	int64_t Write(FileHandle &handle, void *buffer, int64_t nr_bytes) override;
+
+	// Delegate to wrapped filesystem
+	int64_t Read(FileHandle &handle, void *buffer, int64_t nr_bytes) override;
 	bool Trim(FileHandle &handle, idx_t offset_bytes, idx_t length_bytes) override;
 	void Truncate(FileHandle &handle, int64_t new_size) override;
 
@@ -71,20 +87,105 @@ public:
 	bool CanSeek() override;
 	bool OnDiskFile(FileHandle &handle) override;
 
+protected:
+	// Hedged glob, which streams matched files page by page in streaming listing mode.
+	unique_ptr<MultiFileList> GlobFilesExtended(const string &path, const FileGlobInput &input,
+	                                            optional_ptr<FileOpener> opener) override;
+	bool SupportsGlobExtended() const override;
+
 private:
+	// Resolve the effective hedging config for a request to [path].
+	HedgedRequestConfig GetRequestConfig(const string &path) const;
+	// Get [path] rewritten onto each of its mirrors, which hedged attempts of read-only requests rotate through.
+	vector<string> GetReplicaPaths(const string &path) const;
+	// Get the metadata cache if it's enabled, otherwise nullptr.
+	MetadataCache *GetMetadataCache() const;
+	// Drop cached metadata and the prefetched handle for [path], which is modified through this filesystem.
+	void InvalidateMetadata(const string &path) const;
+	// Get the listing cache if it's enabled, otherwise nullptr.
+	ListingCache *GetListingCache() const;
+	// Drop cached listings affected by creating or removing [path] through this filesystem.
+	void InvalidateListing(const string &path) const;
+	// Get the key of [path] in the open prefetch cache and the handle pool.
+	string GetHandleCacheKey(const string &path) const;
+	// Whether handles are pooled, which requires both the handle pool and the metadata cache.
+	bool CanPoolHandles() const;
+	// Keep [handle] opened on [path] with [flags] in the handle pool after rewinding it, return whether it's pooled.
+	// The handle is closed once released instead if handles aren't pooled or it cannot be reused.
+	bool PoolHandle(const string &path, FileOpenFlags flags, shared_ptr<FileHandle> handle);
+	// Take a pooled handle of [path] opened with [flags], which is reused only if it matches the cached file version.
+	shared_ptr<FileHandle> TakePooledHandle(const string &path, FileOpenFlags flags);
+	// Open the first [file_count] of [files] in background, so the next OpenFile of them takes the prefetched handle.
+	void PrefetchOpenFiles(const vector<OpenFileInfo> &files, idx_t file_count, const shared_ptr<FileOpener> &opener);
+	// Positional read of one range into [buffer], which is hedged if read hedging is enabled.
+	void ReadRange(HedgedFileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location,
+	               const HedgedRequestConfig &config);
+	// Start a positional read of one range into [buffer] without blocking, which is hedged if read hedging is enabled;
+	// [on_done] receives the failure if any on the thread pool once the read completes.
+	void StartReadRange(HedgedFileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location,
+	                    const HedgedRequestConfig &config, std::function<void(std::exception_ptr)> on_done);
+	// Serve a sequential read through the read-ahead window, and start read-ahead once sequential reads are detected.
+	// Return false if the read should be passed through to the wrapped handle.
+	bool TryReadAhead(HedgedFileHandle &handle, void *buffer, int64_t nr_bytes, const HedgedRequestConfig &config,
+	                  int64_t &bytes_read);
+	// Stop read-ahead on the handle, so reads go to the wrapped handle at the current logical position again.
+	void StopReadAhead(HedgedFileHandle &handle);
+	// Get the write-behind buffer of the handle, which is created on first use; return nullptr if writes should be
+	// passed through to the wrapped handle.
+	WriteBehindBuffer *GetWriteBehindBuffer(HedgedFileHandle &handle, int64_t nr_bytes,
+	                                        const HedgedRequestConfig &config);
+	// Glob [path] by listing partitions split at its first wildcard level concurrently, each hedged on its own.
+	// Return false if parallel glob is disabled or the pattern cannot be partitioned, and [files] is left untouched.
+	bool TryParallelGlob(const string &path, const FileGlobInput &input, optional_ptr<FileOpener> opener,
+	                     vector<OpenFileInfo> &files);
+	// Glob [path] by walking directory listings level by level, which are served from the listing cache once warm.
+	// Return false if the listing cache is disabled, the pattern isn't supported, the wrapped filesystem doesn't list
+	// directories level by level, or nothing matches; [files] is left untouched then.
+	bool TryCachedGlob(const string &path, optional_ptr<FileOpener> opener, vector<OpenFileInfo> &files);
+	// Get listings of [directories] through ListFiles, uncached ones are listed by up to glob parallelism workers.
+	// A directory which cannot be listed gets an empty listing.
+	vector<ListingCache::Listing> ListDirectories(const vector<string> &directories, optional_ptr<FileOpener> opener,
+	                                              idx_t parallelism);
+	// Get the key to coalesce concurrent identical requests of the client identified by [opener_id].
+	static string GetCoalescingKey(HedgedRequestOperation operation, const string &path, uint64_t opener_id);
+	// Issue [request], which shares its outcome with concurrent requests of the same [operation] on [path] from the
+	// same client if coalescing is enabled; the coalescing key is only built when coalescing is enabled.
+	template <typename T, typename Request>
+	T CoalescedRequest(const HedgedRequestConfig &config, HedgedRequestOperation operation, const string &path,
+	                   uint64_t opener_id, const Request &request);
+
+	// Handles return their wrapped handle into the pool on destruction.
+	friend class HedgedFileHandle;
+
 	unique_ptr<FileSystem> wrapped_fs;
+	// Name of the wrapped filesystem, used to lookup filesystem policies.
+	string wrapped_fs_name;
 	shared_ptr<HedgedRequestFsEntry> entry;
+	shared_ptr<MetadataCache> metadata_cache;
+	shared_ptr<ListingCache> listing_cache;
+	SingleFlight single_flight;
 };
 
 // HedgedFileHandle wraps a file handle and delegates to HedgedFileSystem for hedged reads
 class HedgedFileHandle : public FileHandle {
 public:
-	HedgedFileHandle(HedgedFileSystem &fs, unique_ptr<FileHandle> wrapped_handle, const string &path);
+	// [opener_id] identifies the client which opened the handle, whose metadata requests on the handle are only
+	// coalesced with those of the same client.
+	HedgedFileHandle(HedgedFileSystem &fs, unique_ptr<FileHandle> wrapped_handle, const string &path,
+	                 uint64_t opener_id_p);
+	// Wrap a handle which is already shared, e.g. taken from the handle pool.
+	HedgedFileHandle(HedgedFileSystem &fs, shared_ptr<FileHandle> wrapped_handle_p, const string &path,
+	                 uint64_t opener_id_p);
+	// Idle wrapped handles of read-only opens go into the handle pool.
 	~HedgedFileHandle() override;
 
+	// Flush buffered writes and close the wrapped handle, or put it into the handle pool.
 	void Close() override;
 
 	FileHandle &GetWrappedHandle() {
+		if (wrapped_handle == nullptr) {
+			throw IOException("File handle of \"%s\" is already closed", path);
+		}
 		return *wrapped_handle;
 	}
 
@@ -92,9 +193,30 @@ public:
 		return wrapped_handle;
 	}
 
+	uint64_t GetOpenerId() const {
+		return opener_id;
+	}
+
+	// Sequential read detection and read-ahead state, only accessed by the thread reading the handle.
+	SequentialReadState &GetSequentialReadState() {
+		return sequential_read_state;
+	}
+
+	// Write-behind state, only accessed by the thread writing the handle.
+	WriteBehindState &GetWriteBehindState() {
+		return write_behind_state;
+	}
+
+	// Block wait until all buffered writes reach the wrapped handle, and move the wrapped handle to the logical
+	// position of non-positional writes; rethrow the first failed part write if any. No-op if nothing is buffered.
+	void FlushWriteBehind();
+
 private:
 	HedgedFileSystem &hedged_fs;
 	shared_ptr<FileHandle> wrapped_handle;
+	const uint64_t opener_id;
+	SequentialReadState sequential_read_state;
+	WriteBehindState write_behind_state;
 };
 
 } // namespace duckdb
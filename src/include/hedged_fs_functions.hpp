@@ -1,5 +1,6 @@
 #pragma once
 
+#include "duckdb/function/function_set.hpp"
 #include "duckdb/function/scalar_function.hpp"
 #include "duckdb/function/table_function.hpp"
 
@@ -15,4 +16,86 @@ TableFunction GetHedgedFsListFilesystemsFunction();
 // Throws an error if the requested filesystem does not exist.
 ScalarFunction GetHedgedFsWrapFunction();
 
+// Scalar function: hedged_fs_set_policy(scope VARCHAR, target VARCHAR, option VARCHAR, value UBIGINT) -> BOOLEAN
+// Override hedging option for a wrapped filesystem (scope 'filesystem', target is the filesystem name), or for paths
+// with the given prefix (scope 'prefix', e.g. 's3://hot-bucket/'); the longest matching prefix wins.
+// Option is either '<operation>_delay_ms' (e.g. 'open_file_delay_ms') or 'max_hedged_request_count'.
+ScalarFunction GetHedgedFsSetPolicyFunction();
+
+// Scalar function: hedged_fs_clear_policies() -> BOOLEAN
+// Remove all filesystem and prefix policies.
+ScalarFunction GetHedgedFsClearPoliciesFunction();
+
+// Table function: hedged_fs_list_policies()
+// Lists all policy options.
+// Columns: scope VARCHAR, target VARCHAR, option VARCHAR, value UBIGINT
+TableFunction GetHedgedFsListPoliciesFunction();
+
+// Scalar function: hedged_fs_add_replica(prefix VARCHAR, replica_prefix VARCHAR) -> BOOLEAN
+// Add a mirror for paths with the given prefix, e.g. 's3://bucket-us-west/' for 's3://bucket-us-east/'. Hedged
+// attempts of read-only opens and existence checks rotate through the mirrors of the longest matching prefix, while the
+// primary attempt keeps its original path. Mirrors have to be served by the same wrapped filesystem.
+ScalarFunction GetHedgedFsAddReplicaFunction();
+
+// Scalar function: hedged_fs_clear_replicas() -> BOOLEAN
+// Remove all replica mappings.
+ScalarFunction GetHedgedFsClearReplicasFunction();
+
+// Table function: hedged_fs_list_replicas()
+// Lists all replica mappings, mirrors of a prefix are listed in rotation order.
+// Columns: prefix VARCHAR, replica_prefix VARCHAR
+TableFunction GetHedgedFsListReplicasFunction();
+
+// Table function: hedged_fs_stats()
+// Lists hedged request counters for each operation, accumulated since load or the last reset.
+// Columns: operation VARCHAR, primary_requests UBIGINT, hedged_requests UBIGINT, hedge_wins UBIGINT,
+// failed_attempts UBIGINT, skipped_attempts UBIGINT, suppressed_hedges UBIGINT, inline_requests UBIGINT,
+// pending_attempts BIGINT, hedge_win_rate DOUBLE, latency_histogram STRUCT(upper_bound_us UBIGINT, count UBIGINT)[]
+TableFunction GetHedgedFsStatsFunction();
+
+// Table function: hedged_fs_thread_pool_stats()
+// Lists IO thread pool queueing stats for each priority class, accumulated since load.
+// Columns: priority VARCHAR, queued_jobs UBIGINT, dequeued_jobs UBIGINT, avg_wait_us DOUBLE, recent_wait_us UBIGINT
+TableFunction GetHedgedFsThreadPoolStatsFunction();
+
+// Table function: hedged_fs_recent_requests()
+// Lists the most recent hedged calls traced into the fixed-size request trace ring, ordered by request id. Attempt
+// timestamps are microseconds since the call started, NULL for stages not reached when the call returned; only the
+// first 8 attempts of a call are listed.
+// Columns: request_id UBIGINT, operation VARCHAR, path_hash UBIGINT, path_prefix VARCHAR, start_time TIMESTAMP,
+// latency_us BIGINT, attempt_count UBIGINT, winner_attempt BIGINT, failed BOOLEAN, error VARCHAR,
+// attempts STRUCT(submit_us BIGINT, start_us BIGINT, finish_us BIGINT, failed BOOLEAN)[]
+TableFunction GetHedgedFsRecentRequestsFunction();
+
+// Scalar function: hedged_fs_reset_stats() -> BOOLEAN
+// Reset all hedged request counters, except pending attempts which are still in flight.
+ScalarFunction GetHedgedFsResetStatsFunction();
+
+// Scalar function: hedged_fs_invalidate_metadata_cache(path_prefix VARCHAR) -> BOOLEAN
+// Drop cached metadata for all paths starting with the given prefix, empty prefix drops all cached metadata.
+ScalarFunction GetHedgedFsInvalidateMetadataCacheFunction();
+
+// Scalar function: hedged_fs_invalidate_listing_cache(path_prefix VARCHAR) -> BOOLEAN
+// Drop cached listings of all directories starting with the given prefix, empty prefix drops all cached listings.
+ScalarFunction GetHedgedFsInvalidateListingCacheFunction();
+
+// Table function: hedged_fs_prefetch_metadata(pattern VARCHAR | paths VARCHAR[])
+// Warm up metadata of a file set before a query: the glob pattern, or each of the paths or patterns, is expanded, and
+// every file is opened and stat'ed with hedged requests, at most hedged_fs_metadata_prefetch_concurrency files at a
+// time. Results are kept in the metadata cache and the handle pool if they're enabled. One row is returned per file,
+// files which failed have NULL metadata and their error message.
+// Columns: path VARCHAR, file_size BIGINT, last_modified TIMESTAMP, latency_ms DOUBLE, hedged_requests UBIGINT,
+// error VARCHAR
+TableFunctionSet GetHedgedFsPrefetchMetadataFunction();
+
+// Scalar function: hedged_fs_save_profile(path VARCHAR) -> BOOLEAN
+// Write the latency profile, namely latency sketches of all operations which adaptive hedging delays derive from, to
+// the given path on any filesystem, overwriting an existing file.
+ScalarFunction GetHedgedFsSaveProfileFunction();
+
+// Scalar function: hedged_fs_load_profile(path VARCHAR) -> BOOLEAN
+// Replace latency sketches with those in the latency profile at the given path, so adaptive hedging delays start
+// from the profiled latency instead of the static delays.
+ScalarFunction GetHedgedFsLoadProfileFunction();
+
 } // namespace duckdb
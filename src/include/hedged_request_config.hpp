@@ -20,6 +20,8 @@ enum class HedgedRequestOperation : size_t {
 	GET_STATS = 9,
 	FILE_DELETE = 10,
 	DIRECTORY_CREATE = 11,
+	READ = 12,
+	WRITE = 13,
 	COUNT
 };
 
@@ -36,20 +38,258 @@ constexpr duckdb::array<int64_t, static_cast<size_t>(HedgedRequestOperation::COU
     5000, // LIST_FILES
     3000, // GET_STATS
     3000, // FILE_DELETE
-    3000  // DIRECTORY_CREATE
+    3000, // DIRECTORY_CREATE
+    3000, // READ
+    3000  // WRITE
 };
 
 // Default maximum number of hedged requests to spawn
 constexpr size_t DEFAULT_MAX_HEDGED_REQUEST_COUNT = 3;
 
+// Positional reads are not hedged by default, since every hedged attempt needs its own scratch buffer and an extra copy
+constexpr bool DEFAULT_ENABLE_READ_HEDGING = false;
+
+// Default upper bound for idle scratch buffer memory kept for hedged reads
+constexpr size_t DEFAULT_READ_BUFFER_POOL_MAX_BYTES = 64 * 1024 * 1024;
+
+// Large positional reads are issued as one request by default; in chunked mode reads larger than the threshold are
+// split into fixed-size chunks which are read concurrently.
+constexpr bool DEFAULT_ENABLE_CHUNKED_READ = false;
+constexpr uint64_t DEFAULT_CHUNKED_READ_THRESHOLD_BYTES = 8 * 1024 * 1024;
+constexpr uint64_t DEFAULT_CHUNKED_READ_CHUNK_BYTES = 2 * 1024 * 1024;
+
+// Sequential reads are passed through by default; with read-ahead, blocks after the read position are prefetched once
+// [READ_AHEAD_SEQUENTIAL_READ_THRESHOLD] consecutive sequential reads are observed on a handle.
+constexpr bool DEFAULT_ENABLE_READ_AHEAD = false;
+constexpr uint64_t DEFAULT_READ_AHEAD_BLOCK_BYTES = 1024 * 1024;
+constexpr uint64_t DEFAULT_READ_AHEAD_WINDOW_BLOCKS = 4;
+// Default upper bound for prefetched memory of one file handle
+constexpr uint64_t DEFAULT_READ_AHEAD_MAX_BYTES = 16 * 1024 * 1024;
+constexpr uint64_t READ_AHEAD_SEQUENTIAL_READ_THRESHOLD = 2;
+
+// Writes are passed through by default; with write-behind, writes are buffered into parts of
+// [write_behind_part_bytes], which are written in background one at a time in order, with at most
+// [write_behind_max_outstanding_parts] parts buffered.
+constexpr bool DEFAULT_ENABLE_WRITE_BEHIND = false;
+constexpr uint64_t DEFAULT_WRITE_BEHIND_PART_BYTES = 8 * 1024 * 1024;
+constexpr uint64_t DEFAULT_WRITE_BEHIND_MAX_OUTSTANDING_PARTS = 4;
+
+// Part writes are not hedged by default, since a losing attempt keeps writing the same bytes after the race is decided,
+// which is only safe if positional writes of the wrapped filesystem are idempotent.
+constexpr bool DEFAULT_ENABLE_WRITE_HEDGING = false;
+
+// Adaptive hedging delay is disabled by default, so the static per-operation delays above are used.
+constexpr bool DEFAULT_ENABLE_ADAPTIVE_DELAY = false;
+
+// Default latency percentile used as hedging delay in adaptive mode
+constexpr double DEFAULT_ADAPTIVE_DELAY_PERCENTILE = 95.0;
+
+// Default lower and upper bound of adaptive hedging delays in milliseconds
+constexpr int64_t DEFAULT_ADAPTIVE_DELAY_MIN_MS = 10;
+constexpr int64_t DEFAULT_ADAPTIVE_DELAY_MAX_MS = 30000;
+
+// Minimum number of latency samples for an operation before its adaptive delay takes effect
+constexpr uint64_t ADAPTIVE_DELAY_MIN_SAMPLE_COUNT = 64;
+
+// Hedge budget is disabled by default, so hedged requests are only bounded by the max hedged request count per call.
+constexpr bool DEFAULT_ENABLE_HEDGE_BUDGET = false;
+
+// Default percentage of primary requests which are allowed to spawn a hedged request
+constexpr double DEFAULT_HEDGE_BUDGET_PERCENT = 10.0;
+
+// Default number of hedged requests which could be spawned in a burst
+constexpr uint64_t DEFAULT_HEDGE_BUDGET_BURST = 10;
+
+// Hedge budget is shared by all operations by default.
+constexpr bool DEFAULT_HEDGE_BUDGET_PER_OPERATION = false;
+
+// Default thread count bounds for the elastic IO thread pool.
+constexpr uint64_t DEFAULT_THREAD_POOL_MIN_THREADS = 4;
+constexpr uint64_t DEFAULT_THREAD_POOL_MAX_THREADS = 256;
+
+// Sibling attempts of one hedged request are tied in the IO thread pool by default: once one attempt starts, siblings
+// queued alongside it are skipped, and a tied hedge is submitted along with the primary request if the pool is
+// saturated.
+constexpr bool DEFAULT_ENABLE_TIED_REQUESTS = true;
+
+// Hedges on deadline are suppressed while the IO thread pool has at least this many queued jobs, or jobs of the hedge
+// priority class recently waited at least this long in queues; 0 disables the check.
+constexpr uint64_t DEFAULT_HEDGE_MAX_QUEUE_DEPTH = 256;
+constexpr uint64_t DEFAULT_HEDGE_MAX_QUEUE_WAIT_MS = 1000;
+
+// The first attempt to complete decides the outcome by default, even if it failed; in first-success mode, only the
+// first successful attempt does, and retryable failures are hedged right away.
+constexpr bool DEFAULT_ENABLE_FIRST_SUCCESS_WINS = false;
+
+// Every hedged call is traced into the entry's ring of recent requests by default, which takes neither lock nor
+// allocation.
+constexpr bool DEFAULT_ENABLE_REQUEST_TRACE = true;
+
+// On shutdown, queued attempts are dropped and in-flight ones are waited for up to this long, after which they're
+// abandoned to finish in background.
+constexpr uint64_t DEFAULT_SHUTDOWN_TIMEOUT_MS = 10000;
+
+// Coalescing concurrent identical metadata requests and file opens of one client into one hedged request is opt-in.
+constexpr bool DEFAULT_ENABLE_REQUEST_COALESCING = false;
+
+// Listings are fully materialized from the winning attempt by default. Streaming is opt-in, since a hedge can only win
+// before the first page, and a winner failing mid-listing leaves the caller with a partial listing.
+constexpr bool DEFAULT_ENABLE_STREAMING_LISTING = false;
+
+// Default number of entries in one listing page; the first attempt to list a full page wins the race.
+constexpr uint64_t DEFAULT_LISTING_PAGE_SIZE = 1000;
+
+// Number of listing pages buffered ahead of the caller in streaming listing mode.
+constexpr uint64_t LISTING_MAX_BUFFERED_PAGES = 4;
+
+// Number of glob partitions listed concurrently, 1 disables parallel glob.
+constexpr uint64_t DEFAULT_GLOB_PARALLELISM = 1;
+
+// Number of files returned by a glob which are opened speculatively in background, 0 disables open prefetch.
+constexpr uint64_t DEFAULT_OPEN_PREFETCH_FILE_COUNT = 0;
+
+// Number of files whose metadata is fetched concurrently by hedged_fs_prefetch_metadata.
+constexpr uint64_t DEFAULT_METADATA_PREFETCH_CONCURRENCY = 16;
+
+// Default time to live for unused prefetched file handles in milliseconds
+constexpr int64_t DEFAULT_OPEN_PREFETCH_TTL_MS = 10000;
+
+// Default upper bound for estimated memory held by prefetched file handles, and the estimate for one handle
+constexpr uint64_t DEFAULT_OPEN_PREFETCH_MAX_BYTES = 16 * 1024 * 1024;
+constexpr uint64_t OPEN_PREFETCH_HANDLE_ESTIMATED_BYTES = 64 * 1024;
+
+// Number of idle file handles kept for reuse, 0 disables the handle pool.
+constexpr uint64_t DEFAULT_HANDLE_POOL_MAX_HANDLES = 0;
+
+// Default time to live for idle pooled file handles in milliseconds
+constexpr int64_t DEFAULT_HANDLE_POOL_TTL_MS = 30000;
+
+// Metadata cache is disabled by default, so every metadata call reaches the wrapped filesystem.
+constexpr bool DEFAULT_ENABLE_METADATA_CACHE = false;
+
+// Default time to live for cached metadata in milliseconds
+constexpr int64_t DEFAULT_METADATA_CACHE_TTL_MS = 30000;
+
+// Default upper bound for memory consumed by cached metadata
+constexpr uint64_t DEFAULT_METADATA_CACHE_MAX_BYTES = 16 * 1024 * 1024;
+
+// Listing cache is disabled by default, so every ListFiles and Glob reaches the wrapped filesystem.
+constexpr bool DEFAULT_ENABLE_LISTING_CACHE = false;
+
+// Default time to live for cached directory listings in milliseconds
+constexpr int64_t DEFAULT_LISTING_CACHE_TTL_MS = 30000;
+
+// Default upper bound for memory consumed by cached directory listings
+constexpr uint64_t DEFAULT_LISTING_CACHE_MAX_BYTES = 32 * 1024 * 1024;
+
+// Inline execution is disabled by default, so every call goes through the hedged path.
+constexpr bool DEFAULT_ENABLE_INLINE_EXECUTION = false;
+
+// Default percentage of calls still sent through the hedged path while an operation runs inline, so a regressed
+// backend is noticed and hedging resumes
+constexpr double DEFAULT_INLINE_SAMPLE_PERCENT = 1.0;
+
+// Minimum number of latency samples for an operation before its calls could run inline
+constexpr uint64_t INLINE_EXECUTION_MIN_SAMPLE_COUNT = 1024;
+
+// Operation runs inline only if this latency quantile, multiplied by the headroom, stays below its hedging delay
+constexpr double INLINE_EXECUTION_TAIL_QUANTILE = 0.999;
+constexpr int64_t INLINE_EXECUTION_HEADROOM = 2;
+
+// No latency profile is loaded by default, so adaptive hedging delays start from an empty sketch.
+constexpr const char *DEFAULT_PROFILE_AUTO_LOAD_PATH = "";
+
 // Configuration for hedged request thresholds, notice it's different from operation timeouts.
 struct HedgedRequestConfig {
 	// Delay before starting hedged request for each operation (in milliseconds)
 	duckdb::array<std::chrono::milliseconds, static_cast<size_t>(HedgedRequestOperation::COUNT)> delays_ms;
 	// Maximum number of hedged requests to spawn
 	size_t max_hedged_request_count;
+	// Whether to hedge positional reads
+	bool enable_read_hedging;
+	// Whether to split large positional reads into concurrently read chunks
+	bool enable_chunked_read;
+	// Positional reads larger than the threshold are split into chunks of [chunked_read_chunk_bytes]
+	uint64_t chunked_read_threshold_bytes;
+	uint64_t chunked_read_chunk_bytes;
+	// Whether to prefetch blocks ahead of sequential reads
+	bool enable_read_ahead;
+	// Size of one prefetched block, number of blocks in the read-ahead window and its memory bound for one handle
+	uint64_t read_ahead_block_bytes;
+	uint64_t read_ahead_window_blocks;
+	uint64_t read_ahead_max_bytes;
+	// Whether to buffer writes and write them part by part in background
+	bool enable_write_behind;
+	// Size of one part, and the number of parts written concurrently in write-behind mode
+	uint64_t write_behind_part_bytes;
+	uint64_t write_behind_max_outstanding_parts;
+	// Whether to hedge part writes in write-behind mode, only safe if writes of the wrapped filesystem are idempotent
+	bool enable_write_hedging;
+	// Whether to derive hedging delays from observed latency, instead of using [delays_ms]
+	bool enable_adaptive_delay;
+	// Latency percentile (within [0, 100]) used as hedging delay in adaptive mode
+	double adaptive_delay_percentile;
+	// Lower and upper bound of adaptive hedging delays
+	std::chrono::milliseconds adaptive_delay_min;
+	std::chrono::milliseconds adaptive_delay_max;
+	// Whether to bound hedged requests across calls with a token bucket
+	bool enable_hedge_budget;
+	// Whether each operation gets its own hedge budget, instead of sharing one
+	bool hedge_budget_per_operation;
+	// Whether sibling attempts are tied in the IO thread pool, so only one of those queued together runs
+	bool enable_tied_requests;
+	// Thresholds of IO thread pool queue depth and hedge queue wait time, above which hedges are suppressed
+	uint64_t hedge_max_queue_depth;
+	std::chrono::milliseconds hedge_max_queue_wait;
+	// Whether failed attempts are only returned once no attempt is left which could succeed
+	bool enable_first_success_wins;
+	// Whether hedged calls are traced into the ring of recent requests
+	bool enable_request_trace;
+	// Whether concurrent identical requests share one hedged request
+	bool enable_request_coalescing;
+	// Whether to stream ListFiles and Glob results page by page
+	bool enable_streaming_listing;
+	// Number of entries in one listing page
+	uint64_t listing_page_size;
+	// Number of glob partitions listed concurrently
+	uint64_t glob_parallelism;
+	// Number of files returned by a glob which are opened in background ahead of the caller
+	uint64_t open_prefetch_file_count;
+	// Number of files whose metadata is fetched concurrently by hedged_fs_prefetch_metadata
+	uint64_t metadata_prefetch_concurrency;
+	// Time to wait for in-flight attempts on shutdown before they're abandoned
+	std::chrono::milliseconds shutdown_timeout;
+	// Whether calls run on the caller thread without hedging, while observed latency never reaches the hedging delay
+	bool enable_inline_execution;
+	// Percentage of calls (within [0, 100]) still sent through the hedged path while an operation runs inline
+	double inline_sample_percent;
 
-	HedgedRequestConfig() : max_hedged_request_count(DEFAULT_MAX_HEDGED_REQUEST_COUNT) {
+	HedgedRequestConfig()
+	    : max_hedged_request_count(DEFAULT_MAX_HEDGED_REQUEST_COUNT), enable_read_hedging(DEFAULT_ENABLE_READ_HEDGING),
+	      enable_chunked_read(DEFAULT_ENABLE_CHUNKED_READ),
+	      chunked_read_threshold_bytes(DEFAULT_CHUNKED_READ_THRESHOLD_BYTES),
+	      chunked_read_chunk_bytes(DEFAULT_CHUNKED_READ_CHUNK_BYTES), enable_read_ahead(DEFAULT_ENABLE_READ_AHEAD),
+	      read_ahead_block_bytes(DEFAULT_READ_AHEAD_BLOCK_BYTES),
+	      read_ahead_window_blocks(DEFAULT_READ_AHEAD_WINDOW_BLOCKS),
+	      read_ahead_max_bytes(DEFAULT_READ_AHEAD_MAX_BYTES), enable_write_behind(DEFAULT_ENABLE_WRITE_BEHIND),
+	      write_behind_part_bytes(DEFAULT_WRITE_BEHIND_PART_BYTES),
+	      write_behind_max_outstanding_parts(DEFAULT_WRITE_BEHIND_MAX_OUTSTANDING_PARTS),
+	      enable_write_hedging(DEFAULT_ENABLE_WRITE_HEDGING),
+	      enable_adaptive_delay(DEFAULT_ENABLE_ADAPTIVE_DELAY),
+	      adaptive_delay_percentile(DEFAULT_ADAPTIVE_DELAY_PERCENTILE),
+	      adaptive_delay_min(DEFAULT_ADAPTIVE_DELAY_MIN_MS), adaptive_delay_max(DEFAULT_ADAPTIVE_DELAY_MAX_MS),
+	      enable_hedge_budget(DEFAULT_ENABLE_HEDGE_BUDGET),
+	      hedge_budget_per_operation(DEFAULT_HEDGE_BUDGET_PER_OPERATION),
+	      enable_tied_requests(DEFAULT_ENABLE_TIED_REQUESTS), hedge_max_queue_depth(DEFAULT_HEDGE_MAX_QUEUE_DEPTH),
+	      hedge_max_queue_wait(DEFAULT_HEDGE_MAX_QUEUE_WAIT_MS),
+	      enable_first_success_wins(DEFAULT_ENABLE_FIRST_SUCCESS_WINS),
+	      enable_request_trace(DEFAULT_ENABLE_REQUEST_TRACE),
+	      enable_request_coalescing(DEFAULT_ENABLE_REQUEST_COALESCING),
+	      enable_streaming_listing(DEFAULT_ENABLE_STREAMING_LISTING), listing_page_size(DEFAULT_LISTING_PAGE_SIZE),
+	      glob_parallelism(DEFAULT_GLOB_PARALLELISM), open_prefetch_file_count(DEFAULT_OPEN_PREFETCH_FILE_COUNT),
+	      metadata_prefetch_concurrency(DEFAULT_METADATA_PREFETCH_CONCURRENCY),
+	      shutdown_timeout(DEFAULT_SHUTDOWN_TIMEOUT_MS), enable_inline_execution(DEFAULT_ENABLE_INLINE_EXECUTION),
+	      inline_sample_percent(DEFAULT_INLINE_SAMPLE_PERCENT) {
 		for (size_t idx = 0; idx < NumericCast<size_t>(HedgedRequestOperation::COUNT); ++idx) {
 			delays_ms[idx] = std::chrono::milliseconds(DEFAULT_HEDGING_DELAYS_MS[idx]);
 		}
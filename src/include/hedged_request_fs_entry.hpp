@@ -1,16 +1,34 @@
 #pragma once
 
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/unique_ptr.hpp"
 #include "duckdb/common/vector.hpp"
 #include "duckdb/storage/object_cache.hpp"
+#include "cancellation_token.hpp"
+#include "file_handle_pool.hpp"
+#include "hedge_budget.hpp"
+#include "hedge_scheduler.hpp"
 #include "hedged_request_config.hpp"
+#include "hedged_request_stats.hpp"
+#include "hedging_policy.hpp"
+#include "latency_sketch.hpp"
+#include "open_prefetch_cache.hpp"
+#include "read_buffer_pool.hpp"
+#include "request_trace.hpp"
 #include "thread_annotation.hpp"
 #include "thread_pool.hpp"
 
-#include <future>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
 
 namespace duckdb {
 
-// Cache to manage pending requests that didn't win the hedged race
+// Cache to manage hedged request configs, and in-flight attempts including those which didn't win the hedged race
+//
+// On destruction, queued attempts are dropped and in-flight ones are signalled to cancel, then waited for up to the
+// shutdown timeout. Attempts still running afterwards, e.g. stuck on a hung connection, are abandoned: the thread pool
+// and everything they use is handed to a detached reaper thread, which releases it once they all return.
 class HedgedRequestFsEntry : public ObjectCacheEntry {
 public:
 	HedgedRequestFsEntry();
@@ -26,34 +44,314 @@ public:
 		return "hedged_request_fs_entry";
 	}
 
-	// Queue pending operations; functor represents a type-eraused operation.
-	void AddPendingRequest(std::function<void()> functor);
+	// Submit an attempt to the thread pool in the [priority] class; the attempt is tracked as in-flight until it
+	// finishes, no matter it wins the hedged race or not. Small attempts are submitted without allocation.
+	template <typename Attempt>
+	void SubmitAttempt(Attempt &&attempt, JobPriority priority = JobPriority::PRIMARY);
+	// Submit an attempt tied to its siblings sharing [tie], [on_skipped] runs instead if the thread pool skips it.
+	template <typename Attempt, typename OnSkipped>
+	void SubmitAttempt(Attempt &&attempt, JobPriority priority, shared_ptr<JobTie> tie, OnSkipped &&on_skipped);
 
-	// Block wait for all pending requests to complete.
+	// Block wait for all in-flight attempts to complete.
 	void WaitAll();
 
-	// Get the hedged request configuration
+	// Get the number of in-flight attempts.
+	uint64_t GetInFlightAttemptCount() const {
+		return attempts->in_flight.load(std::memory_order_acquire);
+	}
+
+	// Drop queued attempts, and cancel the token installed for running ones, then wait up to [timeout] for in-flight
+	// attempts to complete. Return whether none is left. Attempts submitted afterwards are dropped as well.
+	bool Shutdown(std::chrono::milliseconds timeout);
+
+	// Keep [wrapped_fs] alive until in-flight attempts, which could still use it, complete; invoked by a hedged
+	// filesystem going away while its losing attempts are still running.
+	void RetainWrappedFileSystem(unique_ptr<FileSystem> wrapped_fs);
+
+	// Get the global hedged request configuration, which doesn't take any policy into account.
 	HedgedRequestConfig GetConfig() const;
 
+	// Get the effective hedged request configuration for a request to [path] on the wrapped filesystem named
+	// [filesystem_name], which is lock free.
+	HedgedRequestConfig GetConfig(const string &filesystem_name, const string &path) const;
+
+	// Get the current config snapshot, which is immutable.
+	std::shared_ptr<const HedgedConfigSnapshot> GetConfigSnapshot() const {
+		return std::atomic_load(&config_snapshot);
+	}
+
+	// Set a policy option for the given filesystem name or path prefix.
+	void SetPolicy(HedgingPolicyScope scope, const string &target, const string &option, idx_t value);
+
+	// Remove all filesystem and prefix policies.
+	void ClearPolicies();
+
+	// Add [replica_prefix] as a mirror of paths starting with [prefix], so hedged attempts of those paths rotate
+	// through the mirrors while the primary attempt keeps its original path.
+	void AddReplica(const string &prefix, const string &replica_prefix);
+
+	// Remove all replica mappings.
+	void ClearReplicas();
+
 	// Update a specific operation's delay threshold directly
 	void UpdateConfig(HedgedRequestOperation operation, std::chrono::milliseconds delay_ms);
 
 	// Update the maximum number of hedged requests to spawn
 	void UpdateMaxHedgedRequestCount(size_t max_count);
 
+	// Get the delay before spawning hedged requests for the given operation. In adaptive mode it's the configured
+	// latency percentile observed for the operation, clamped into the configured bound.
+	std::chrono::milliseconds GetHedgingDelay(const HedgedRequestConfig &config_p,
+	                                          HedgedRequestOperation operation) const;
+
+	// Enable or disable adaptive hedging delay
+	void UpdateEnableAdaptiveDelay(bool enable);
+
+	// Update the latency percentile used as adaptive hedging delay
+	void UpdateAdaptiveDelayPercentile(double percentile);
+
+	// Update lower and upper bound for adaptive hedging delay
+	void UpdateAdaptiveDelayMin(std::chrono::milliseconds delay_ms);
+	void UpdateAdaptiveDelayMax(std::chrono::milliseconds delay_ms);
+
+	// Return whether a call of the given operation should run on the caller thread without hedging, since even its
+	// tail latency stays well below the hedging delay; a sampled fraction of calls still goes through the hedged path.
+	bool ShouldRunInline(const HedgedRequestConfig &config_p, HedgedRequestOperation operation);
+
+	// Enable or disable inline execution, and update the percentage of calls sampled through the hedged path
+	void UpdateEnableInlineExecution(bool enable);
+	void UpdateInlineSamplePercent(double percent);
+
+	// Latency sketches for all operations, which are fed by every completed attempt.
+	shared_ptr<LatencyTracker> GetLatencyTracker() const {
+		return latency_tracker;
+	}
+
+	// Counters for all hedged requests.
+	shared_ptr<HedgedRequestStats> GetStats() const {
+		return stats;
+	}
+
+	// Trace events of the most recent hedged calls.
+	RequestTraceRing &GetRequestTrace() {
+		return *request_trace;
+	}
+
+	// Account a new primary request into the hedge budget, no-op if hedge budget is disabled.
+	void OnPrimaryRequest(const HedgedRequestConfig &config_p, HedgedRequestOperation operation);
+
+	// Try to consume hedge budget before spawning a hedged request, always succeeds if hedge budget is disabled.
+	bool TryAcquireHedgeBudget(const HedgedRequestConfig &config_p, HedgedRequestOperation operation);
+
+	// Return whether a hedge should be skipped since the IO thread pool is backed up beyond the configured thresholds,
+	// so the hedge would queue behind the work delaying its primary attempt.
+	bool ShouldSuppressHedge(const HedgedRequestConfig &config_p) const;
+
+	// Enable or disable hedge budget
+	void UpdateEnableHedgeBudget(bool enable);
+
+	// Update the percentage of primary requests which are allowed to be hedged, and the burst size
+	void UpdateHedgeBudgetPercent(double percent);
+	void UpdateHedgeBudgetBurst(uint64_t burst);
+
+	// Whether to keep a separate hedge budget for each operation
+	void UpdateHedgeBudgetPerOperation(bool per_operation);
+
+	// Enable or disable hedging for positional reads
+	void UpdateEnableReadHedging(bool enable);
+
+	// Enable or disable chunked positional reads, and update the read size threshold and chunk size
+	void UpdateEnableChunkedRead(bool enable);
+	void UpdateChunkedReadThreshold(uint64_t threshold_bytes);
+	void UpdateChunkedReadChunkSize(uint64_t chunk_bytes);
+
+	// Enable or disable read-ahead for sequential reads, and update its block size, window size and memory bound
+	void UpdateEnableReadAhead(bool enable);
+	void UpdateReadAheadBlockSize(uint64_t block_bytes);
+	void UpdateReadAheadWindowBlocks(uint64_t window_blocks);
+	void UpdateReadAheadMaxBytes(uint64_t max_bytes);
+
+	// Enable or disable write-behind, and update its part size and the number of parts written concurrently
+	void UpdateEnableWriteBehind(bool enable);
+	void UpdateWriteBehindPartSize(uint64_t part_bytes);
+	void UpdateWriteBehindMaxOutstandingParts(uint64_t max_parts);
+
+	// Enable or disable hedging for part writes in write-behind mode
+	void UpdateEnableWriteHedging(bool enable);
+
+	// Update the upper bound for idle scratch buffer memory used by hedged reads
+	void UpdateReadBufferPoolMaxBytes(idx_t max_bytes);
+
+	// Enable or disable tied attempts in the IO thread pool
+	void UpdateEnableTiedRequests(bool enable);
+
+	// Update the IO thread pool queue depth and hedge queue wait time thresholds for hedge suppression, 0 disables
+	void UpdateHedgeMaxQueueDepth(uint64_t max_depth);
+	void UpdateHedgeMaxQueueWait(std::chrono::milliseconds max_wait);
+
+	// Enable or disable first-success mode, where failed attempts don't decide the outcome while others could succeed
+	void UpdateEnableFirstSuccessWins(bool enable);
+
+	// Enable or disable tracing of hedged calls into the ring of recent requests
+	void UpdateEnableRequestTrace(bool enable);
+
+	// Enable or disable coalescing of concurrent identical requests
+	void UpdateEnableRequestCoalescing(bool enable);
+
+	// Update the time to wait for in-flight attempts on shutdown, before they're abandoned
+	void UpdateShutdownTimeout(std::chrono::milliseconds timeout);
+
+	// Enable or disable streaming listing, and update the number of entries in one listing page
+	void UpdateEnableStreamingListing(bool enable);
+	void UpdateListingPageSize(uint64_t page_size);
+
+	// Update the number of glob partitions listed concurrently
+	void UpdateGlobParallelism(uint64_t parallelism);
+
+	// Update the number of files whose metadata is fetched concurrently by hedged_fs_prefetch_metadata
+	void UpdateMetadataPrefetchConcurrency(uint64_t concurrency);
+
+	// Update the number of globbed files opened in background, the time to live of unused prefetched handles, and
+	// their memory bound
+	void UpdateOpenPrefetchFileCount(uint64_t file_count);
+	void UpdateOpenPrefetchTtl(std::chrono::milliseconds ttl_ms);
+	void UpdateOpenPrefetchMaxBytes(idx_t max_bytes);
+
+	// Update the number of idle file handles kept for reuse, and their time to live
+	void UpdateHandlePoolMaxHandles(idx_t max_handles);
+	void UpdateHandlePoolTtl(std::chrono::milliseconds ttl_ms);
+
+	// Scratch buffer pool for hedged reads.
+	shared_ptr<ReadBufferPool> GetReadBufferPool() const {
+		return read_buffer_pool;
+	}
+
+	// Update thread count bounds for the thread pool
+	void UpdateThreadPoolMinThreads(idx_t min_threads);
+	void UpdateThreadPoolMaxThreads(idx_t max_threads);
+
 	// Per-database thread pool.
 	ThreadPool &GetThreadPool() {
-		return thread_pool;
+		return *thread_pool;
+	}
+
+	// Scheduler which fires hedge deadlines of all in-flight hedged requests.
+	HedgeScheduler &GetHedgeScheduler() {
+		return hedge_scheduler;
+	}
+
+	// File handles opened in background for globbed files.
+	OpenPrefetchCache &GetOpenPrefetchCache() {
+		return *open_prefetch_cache;
+	}
+
+	// Idle file handles kept for reuse by later opens.
+	FileHandlePool &GetFileHandlePool() {
+		return *file_handle_pool;
 	}
 
 private:
-	// Try to clean up completed requests in a non-blocking style.
-	void CleanupCompleted() DUCKDB_REQUIRES(cache_mutex);
+	// Get the hedge budget to use for the given operation.
+	HedgeBudget &GetHedgeBudget(const HedgedRequestConfig &config_p, HedgedRequestOperation operation);
+
+	// Copy-on-write update of the config snapshot.
+	void UpdateConfigSnapshot(const std::function<void(HedgedConfigSnapshot &)> &update);
+
+	// Apply budget ratio and burst to all hedge budgets.
+	void ConfigureHedgeBudgets() DUCKDB_REQUIRES(cache_mutex);
+
+	// Hand the thread pool and everything in-flight attempts use to a detached reaper thread, which releases them once
+	// all attempts complete.
+	void AbandonAttempts();
+
+	// Registry of in-flight attempts, which is shared with the reaper so it outlives the entry if attempts are
+	// abandoned on shutdown.
+	struct AttemptRegistry {
+		// Number of attempts submitted to thread pool but not finished yet; waiters are notified on [mu] when it drops
+		// to zero.
+		std::atomic<uint64_t> in_flight {0};
+		concurrency::mutex mu;
+		std::condition_variable completion_cv DUCKDB_GUARDED_BY(mu);
+		// Cancelled on shutdown, jobs which haven't started are dropped and running ones see it as their current
+		// cancellation token, unless they install their own.
+		CancellationToken shutdown;
+
+		// Deregister a finished attempt, and wake up waiters once there's no attempt in flight.
+		void OnAttemptFinished();
+		// Block until no attempt is in flight, or [deadline] passes; return whether no attempt is in flight.
+		bool WaitUntil(std::chrono::steady_clock::time_point deadline);
+		void Wait();
+	};
+
+	// Thread pool job which deregisters the attempt once it finishes, including the case when the attempt throws or
+	// is dropped on shutdown.
+	template <typename Fn>
+	struct TrackedJob {
+		AttemptRegistry *registry;
+		Fn fn;
+
+		void operator()() {
+			struct AttemptGuard {
+				AttemptRegistry &registry;
+				~AttemptGuard() {
+					registry.OnAttemptFinished();
+				}
+			};
+			AttemptGuard guard {*registry};
+			if (registry->shutdown.IsCancelled()) {
+				return;
+			}
+			ScopedCancellationToken scoped_cancellation(&registry->shutdown);
+			fn();
+		}
+	};
+	// Wrap [fn] into a thread pool job, which deregisters the attempt once it finishes.
+	template <typename Fn>
+	TrackedJob<typename std::decay<Fn>::type> MakeTrackedJob(Fn &&fn) {
+		return TrackedJob<typename std::decay<Fn>::type> {attempts.get(), std::forward<Fn>(fn)};
+	}
 
 	mutable concurrency::mutex cache_mutex;
-	vector<std::future<void>> pending_requests DUCKDB_GUARDED_BY(cache_mutex);
-	HedgedRequestConfig config DUCKDB_GUARDED_BY(cache_mutex);
-	ThreadPool thread_pool;
+	// Writers serialize on [cache_mutex], readers load the snapshot atomically without lock.
+	std::shared_ptr<const HedgedConfigSnapshot> config_snapshot;
+	double hedge_budget_percent DUCKDB_GUARDED_BY(cache_mutex) = DEFAULT_HEDGE_BUDGET_PERCENT;
+	uint64_t hedge_budget_burst DUCKDB_GUARDED_BY(cache_mutex) = DEFAULT_HEDGE_BUDGET_BURST;
+	HedgeBudget global_hedge_budget;
+	array<HedgeBudget, static_cast<size_t>(HedgedRequestOperation::COUNT)> operation_hedge_budgets;
+	shared_ptr<LatencyTracker> latency_tracker;
+	shared_ptr<HedgedRequestStats> stats;
+	// Number of calls which could run inline for each operation, used to pick those sampled through the hedged path.
+	array<std::atomic<uint64_t>, static_cast<size_t>(HedgedRequestOperation::COUNT)> inline_call_counts {};
+	// Members below which attempts use are shared with, or moved to, the reaper if attempts are abandoned.
+	shared_ptr<RequestTraceRing> request_trace;
+	shared_ptr<AttemptRegistry> attempts;
+	// Wrapped filesystems of hedged filesystems which went away while attempts were in flight. Declared before the
+	// handle caches, so their handles are closed before the filesystems go away.
+	vector<unique_ptr<FileSystem>> retained_filesystems DUCKDB_GUARDED_BY(cache_mutex);
+	// Declared before thread pool, so buffers held by queued attempts are returned before the pool goes away.
+	shared_ptr<ReadBufferPool> read_buffer_pool;
+	unique_ptr<ThreadPool> thread_pool;
+	// Declared after thread pool, so it stops firing timers before the pool goes away.
+	HedgeScheduler hedge_scheduler;
+	// Declared after scheduler, so its sweep timer is cancelled before the scheduler goes away. Handle caches are
+	// moved to the reaper along with the wrapped filesystems, since late attempts still put handles into them.
+	shared_ptr<OpenPrefetchCache> open_prefetch_cache;
+	shared_ptr<FileHandlePool> file_handle_pool;
 };
 
+template <typename Attempt>
+void HedgedRequestFsEntry::SubmitAttempt(Attempt &&attempt, JobPriority priority) {
+	attempts->in_flight.fetch_add(1, std::memory_order_acq_rel);
+	thread_pool->Submit(MakeTrackedJob(std::forward<Attempt>(attempt)), priority);
+}
+
+template <typename Attempt, typename OnSkipped>
+void HedgedRequestFsEntry::SubmitAttempt(Attempt &&attempt, JobPriority priority, shared_ptr<JobTie> tie,
+                                         OnSkipped &&on_skipped) {
+	attempts->in_flight.fetch_add(1, std::memory_order_acq_rel);
+	// Exactly one of the attempt and [on_skipped] runs, so the attempt is deregistered once either way.
+	thread_pool->Submit(MakeTrackedJob(std::forward<Attempt>(attempt)), priority, std::move(tie),
+	                   MakeTrackedJob(std::forward<OnSkipped>(on_skipped)));
+}
+
 } // namespace duckdb
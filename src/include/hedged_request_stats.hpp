@@ -0,0 +1,142 @@
+#pragma once
+
+#include "duckdb/common/array.hpp"
+#include "hedged_request_config.hpp"
+
+#include <atomic>
+#include <chrono>
+
+namespace duckdb {
+
+// Aggregated stats for one operation.
+struct HedgedOperationStats {
+	static constexpr idx_t LATENCY_BUCKET_COUNT = 32;
+
+	// Number of calls, each of them issues one primary request.
+	uint64_t primary_requests = 0;
+	// Number of hedged requests issued on top of primary requests.
+	uint64_t hedged_requests = 0;
+	// Number of calls whose outcome came from a hedged request.
+	uint64_t hedge_wins = 0;
+	// Number of attempts which failed, excluding those failed due to cancellation.
+	uint64_t failed_attempts = 0;
+	// Number of tied attempts skipped in the IO thread pool, since a sibling attempt queued alongside started first.
+	uint64_t skipped_attempts = 0;
+	// Number of hedges not issued on their deadline, since the IO thread pool was backed up.
+	uint64_t suppressed_hedges = 0;
+	// Number of calls run on the caller thread without hedging, which are also counted as primary requests.
+	uint64_t inline_requests = 0;
+	// Number of attempts submitted but not finished yet.
+	int64_t pending_attempts = 0;
+	// Histogram of call latency in microseconds; bucket i counts latency within [2^(i-1), 2^i), the first bucket counts
+	// latency below 1us, and the last bucket also counts everything above.
+	array<uint64_t, LATENCY_BUCKET_COUNT> latency_histogram {};
+
+	// Get the exclusive upper bound in microseconds of the given latency bucket.
+	static uint64_t GetLatencyBucketUpperBound(idx_t bucket_idx);
+	// Get the latency bucket for the given latency.
+	static idx_t GetLatencyBucket(std::chrono::microseconds latency);
+};
+
+// Counters for hedged requests, updated on every hedged request call.
+//
+// Counters are sharded by thread and padded to separate cache lines, so concurrent updates from different threads
+// don't contend; readers sum up all shards, which gives an approximate but consistent-enough view.
+class HedgedRequestStats {
+public:
+	HedgedRequestStats();
+
+	HedgedRequestStats(const HedgedRequestStats &) = delete;
+	HedgedRequestStats &operator=(const HedgedRequestStats &) = delete;
+
+	void RecordPrimaryRequest(HedgedRequestOperation operation) {
+		GetCounters(operation).primary_requests.fetch_add(1, std::memory_order_relaxed);
+	}
+	void RecordHedgedRequest(HedgedRequestOperation operation) {
+		GetCounters(operation).hedged_requests.fetch_add(1, std::memory_order_relaxed);
+	}
+	void RecordHedgeWin(HedgedRequestOperation operation) {
+		GetCounters(operation).hedge_wins.fetch_add(1, std::memory_order_relaxed);
+	}
+	void RecordFailedAttempt(HedgedRequestOperation operation) {
+		GetCounters(operation).failed_attempts.fetch_add(1, std::memory_order_relaxed);
+	}
+	void RecordSkippedAttempt(HedgedRequestOperation operation) {
+		GetCounters(operation).skipped_attempts.fetch_add(1, std::memory_order_relaxed);
+	}
+	void RecordSuppressedHedge(HedgedRequestOperation operation) {
+		GetCounters(operation).suppressed_hedges.fetch_add(1, std::memory_order_relaxed);
+	}
+	void RecordInlineRequest(HedgedRequestOperation operation) {
+		GetCounters(operation).inline_requests.fetch_add(1, std::memory_order_relaxed);
+	}
+	void RecordAttemptStarted(HedgedRequestOperation operation) {
+		GetCounters(operation).pending_attempts.fetch_add(1, std::memory_order_relaxed);
+	}
+	// Attempt might finish on a different shard, which is fine since only the sum over all shards is meaningful.
+	void RecordAttemptFinished(HedgedRequestOperation operation) {
+		GetCounters(operation).pending_attempts.fetch_sub(1, std::memory_order_relaxed);
+	}
+	void RecordLatency(HedgedRequestOperation operation, std::chrono::microseconds latency) {
+		GetCounters(operation)
+		    .latency_histogram[HedgedOperationStats::GetLatencyBucket(latency)]
+		    .fetch_add(1, std::memory_order_relaxed);
+	}
+
+	// Get stats for the given operation, summed over all shards.
+	HedgedOperationStats GetStats(HedgedRequestOperation operation) const;
+
+	// Reset all counters except pending attempts, which reflect attempts still in flight.
+	void Reset();
+
+private:
+	static constexpr idx_t SHARD_COUNT = 16;
+	static constexpr idx_t CACHE_LINE_SIZE = 64;
+
+	struct OperationCounters {
+		std::atomic<uint64_t> primary_requests {0};
+		std::atomic<uint64_t> hedged_requests {0};
+		std::atomic<uint64_t> hedge_wins {0};
+		std::atomic<uint64_t> failed_attempts {0};
+		std::atomic<uint64_t> skipped_attempts {0};
+		std::atomic<uint64_t> suppressed_hedges {0};
+		std::atomic<uint64_t> inline_requests {0};
+		std::atomic<int64_t> pending_attempts {0};
+		array<std::atomic<uint64_t>, HedgedOperationStats::LATENCY_BUCKET_COUNT> latency_histogram;
+	};
+
+	// Padded instead of over-aligned, so the shard array doesn't require aligned allocation.
+	struct Shard {
+		array<OperationCounters, static_cast<size_t>(HedgedRequestOperation::COUNT)> operations;
+		char padding[CACHE_LINE_SIZE];
+	};
+
+	// Get counters of the current thread's shard.
+	OperationCounters &GetCounters(HedgedRequestOperation operation);
+
+	array<Shard, SHARD_COUNT> shards;
+};
+
+// Count hedged requests issued by hedged calls made on the current thread within the scope, e.g. to report how many
+// hedges each file needed in hedged_fs_prefetch_metadata. Scopes could nest, and only the innermost one counts.
+class ScopedHedgeCounter {
+public:
+	ScopedHedgeCounter();
+	~ScopedHedgeCounter();
+
+	ScopedHedgeCounter(const ScopedHedgeCounter &) = delete;
+	ScopedHedgeCounter &operator=(const ScopedHedgeCounter &) = delete;
+
+	uint64_t GetHedgedRequestCount() const {
+		return hedged_requests;
+	}
+
+	// Add [count] hedged requests issued by a hedged call on the current thread to the innermost scope, if any.
+	static void Record(uint64_t count);
+
+private:
+	ScopedHedgeCounter *previous;
+	uint64_t hedged_requests = 0;
+};
+
+} // namespace duckdb
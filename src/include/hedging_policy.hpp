@@ -0,0 +1,74 @@
+#pragma once
+
+#include "duckdb/common/array.hpp"
+#include "duckdb/common/optional_idx.hpp"
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "duckdb/common/vector.hpp"
+#include "hedged_request_config.hpp"
+
+#include <utility>
+
+namespace duckdb {
+
+// Get the name of the operation used by settings and policy options, e.g. "open_file".
+string GetHedgedRequestOperationName(HedgedRequestOperation operation);
+
+enum class HedgingPolicyScope : uint8_t {
+	// Policy applies to all requests to the wrapped filesystem with the given name.
+	FILESYSTEM,
+	// Policy applies to all requests whose path starts with the given prefix.
+	PREFIX,
+};
+
+// Get the policy scope from its name, throw InvalidInputException if unknown.
+HedgingPolicyScope GetHedgingPolicyScope(const string &scope_name);
+string GetHedgingPolicyScopeName(HedgingPolicyScope scope);
+
+// Overrides on top of the global hedging config, unset options inherit from the enclosing scope.
+struct HedgingPolicy {
+	array<optional_idx, static_cast<size_t>(HedgedRequestOperation::COUNT)> delays_ms;
+	optional_idx max_hedged_request_count;
+	// Non-zero declares positional writes of the target idempotent, so part writes in write-behind mode are hedged.
+	optional_idx enable_write_hedging;
+	// Non-zero lets calls on the target run inline while their latency never gets near the hedging delay.
+	optional_idx enable_inline_execution;
+
+	// Set option by name, which is "<operation>_delay_ms", "max_hedged_request_count", "enable_write_hedging" or
+	// "enable_inline_execution".
+	// Throw InvalidInputException if the option is unknown.
+	void SetOption(const string &option, idx_t value);
+
+	// Apply all set options onto the given [config].
+	void ApplyTo(HedgedRequestConfig &config) const;
+
+	// Get all set options, ordered by option name.
+	vector<std::pair<string, idx_t>> ListOptions() const;
+};
+
+// Immutable snapshot of the global hedging config and all policies; updates create a new snapshot and swap it in
+// atomically, so readers on the hot path never take a lock.
+struct HedgedConfigSnapshot {
+	HedgedRequestConfig config;
+	// Keyed by wrapped filesystem name.
+	unordered_map<string, HedgingPolicy> filesystem_policies;
+	// Sorted by prefix length in descending order, so the first matching prefix is the longest one.
+	vector<std::pair<string, HedgingPolicy>> prefix_policies;
+	// Mirrors of path prefixes, sorted by prefix length in descending order like [prefix_policies].
+	vector<std::pair<string, vector<string>>> replica_prefixes;
+
+	// Get the policy for the given prefix, which is created if not exists.
+	HedgingPolicy &GetOrCreatePrefixPolicy(const string &prefix);
+
+	// Add [replica_prefix] as a mirror of all paths starting with [prefix], no-op if it's added already.
+	void AddReplica(const string &prefix, const string &replica_prefix);
+
+	// Get [path] rewritten onto each mirror of its longest matching prefix in insertion order, empty if there's none.
+	vector<string> ResolveReplicaPaths(const string &path) const;
+
+	// Resolve effective config for a request, layered as global config, filesystem policy, then the longest matching
+	// prefix policy.
+	HedgedRequestConfig Resolve(const string &filesystem_name, const string &path) const;
+};
+
+} // namespace duckdb
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "duckdb/common/typedefs.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <random>
+
+namespace duckdb {
+
+// Latency distribution of simulated IO, sampled with a caller provided random engine so simulations are reproducible
+// from a seed.
+class LatencyDistribution {
+public:
+	enum class Kind : uint8_t { FIXED, LOGNORMAL, BIMODAL, PARETO };
+
+	// Zero latency.
+	LatencyDistribution();
+
+	static LatencyDistribution Fixed(std::chrono::microseconds latency);
+	// Lognormal latency with [median], where the log of latency has standard deviation [sigma].
+	static LatencyDistribution LogNormal(std::chrono::microseconds median, double sigma);
+	// Slow replica: with [slow_probability] a lognormal sample around [slow_median], otherwise around [fast_median].
+	static LatencyDistribution Bimodal(std::chrono::microseconds fast_median, std::chrono::microseconds slow_median,
+	                                   double slow_probability, double sigma);
+	// Pareto latency with minimum [scale] and tail index [shape], a smaller shape has a heavier tail; samples are
+	// capped at [max].
+	static LatencyDistribution Pareto(std::chrono::microseconds scale, double shape, std::chrono::microseconds max);
+
+	std::chrono::microseconds Sample(std::mt19937_64 &rng) const;
+
+	Kind GetKind() const {
+		return kind;
+	}
+
+private:
+	LatencyDistribution(Kind kind_p, std::chrono::microseconds primary_p, std::chrono::microseconds secondary_p,
+	                    double shape_p, double probability_p);
+
+	// Draw a lognormal sample around [median].
+	std::chrono::microseconds SampleLogNormal(std::mt19937_64 &rng, std::chrono::microseconds median) const;
+
+	Kind kind;
+	// Fixed latency, lognormal or fast median, or pareto scale.
+	std::chrono::microseconds primary;
+	// Slow median, or pareto cap.
+	std::chrono::microseconds secondary;
+	// Lognormal sigma, or pareto tail index.
+	double shape;
+	// Probability of the slow mode.
+	double probability;
+};
+
+} // namespace duckdb
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/string.hpp"
+#include "latency_sketch.hpp"
+
+namespace duckdb {
+
+// Latency profile, which persists latency sketches of all operations so a new process starts with the adaptive hedging
+// delays learned by an earlier one, instead of the static defaults.
+//
+// The binary format is a sequence of unsigned LEB128 varints: [LATENCY_PROFILE_MAGIC], format version,
+// [LatencySketch::SUB_BUCKET_BITS], and the number of operations; then for each operation its name length and name
+// bytes, the number of non-empty buckets, and each non-empty bucket as (index delta from the previous non-empty bucket,
+// sample count). Operations are keyed by name, so profiles stay readable when operations are added or reordered;
+// operations unknown to the reader are skipped.
+constexpr uint64_t LATENCY_PROFILE_MAGIC = 0x50534648; // "HFSP"
+constexpr uint64_t LATENCY_PROFILE_VERSION = 1;
+
+// Serialize sketches of all operations in [tracker].
+string SerializeLatencyProfile(const LatencyTracker &tracker);
+
+// Replace sketches in [tracker] with those in profile [data], sketches of operations not in the profile are kept.
+// The profile is validated as a whole before any sketch is replaced. Throw InvalidInputException if [data] is not a
+// valid profile.
+void DeserializeLatencyProfile(const string &data, LatencyTracker &tracker);
+
+// Write the latency profile of [tracker] to [path] on [fs], overwriting an existing file.
+void SaveLatencyProfile(FileSystem &fs, const string &path, const LatencyTracker &tracker);
+
+// Load the latency profile at [path] on [fs] into [tracker].
+void LoadLatencyProfile(FileSystem &fs, const string &path, LatencyTracker &tracker);
+
+} // namespace duckdb
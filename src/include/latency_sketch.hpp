@@ -0,0 +1,87 @@
+#pragma once
+
+#include "duckdb/common/array.hpp"
+#include "hedged_request_config.hpp"
+#include "mutex.hpp"
+#include "thread_annotation.hpp"
+
+#include <atomic>
+#include <chrono>
+
+namespace duckdb {
+
+// Streaming quantile sketch for operation latency.
+//
+// Latencies (in microseconds) are recorded into log-linear buckets, each power-of-two range is split into
+// [SUB_BUCKET_COUNT] linear sub-buckets, which bounds relative error of reported quantiles to ~12%. Recording is
+// lock-free; once [DECAY_SAMPLE_COUNT] samples are accumulated all buckets are halved, so the sketch keeps following
+// the recent latency distribution instead of the whole history.
+class LatencySketch {
+public:
+	static constexpr idx_t SUB_BUCKET_BITS = 3;
+	static constexpr idx_t SUB_BUCKET_COUNT = idx_t(1) << SUB_BUCKET_BITS;
+	static constexpr idx_t BUCKET_COUNT = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+	static constexpr uint64_t DECAY_SAMPLE_COUNT = 4096;
+
+	LatencySketch();
+
+	LatencySketch(const LatencySketch &) = delete;
+	LatencySketch &operator=(const LatencySketch &) = delete;
+
+	void Record(std::chrono::microseconds latency);
+
+	// Get latency at the given [quantile] within [0, 1], which is the upper bound of the bucket it falls into.
+	// Return 0 if there's no sample.
+	std::chrono::microseconds GetQuantile(double quantile) const;
+
+	// Get number of samples currently accounted by the sketch.
+	uint64_t GetSampleCount() const;
+
+	// Get a snapshot of sample counts in all buckets, e.g. to persist the sketch.
+	array<uint64_t, BUCKET_COUNT> GetBucketCounts() const;
+
+	// Replace all buckets with [counts], which are halved until below [DECAY_SAMPLE_COUNT] in total like on decay.
+	void SetBucketCounts(const array<uint64_t, BUCKET_COUNT> &counts);
+
+	void Reset();
+
+	// Get the bucket index for the given latency value.
+	static idx_t GetBucketIndex(uint64_t value);
+	// Get the inclusive upper bound of the given bucket.
+	static uint64_t GetBucketUpperBound(idx_t index);
+
+private:
+	// Halve all buckets to age out old samples.
+	void Decay();
+
+	array<std::atomic<uint64_t>, BUCKET_COUNT> buckets;
+	std::atomic<uint64_t> sample_count;
+	concurrency::mutex decay_mutex;
+};
+
+// Latency sketches for all hedged operations.
+class LatencyTracker {
+public:
+	LatencyTracker() = default;
+
+	LatencyTracker(const LatencyTracker &) = delete;
+	LatencyTracker &operator=(const LatencyTracker &) = delete;
+
+	void Record(HedgedRequestOperation operation, std::chrono::microseconds latency) {
+		GetSketch(operation).Record(latency);
+	}
+
+	LatencySketch &GetSketch(HedgedRequestOperation operation) {
+		return sketches[static_cast<size_t>(operation)];
+	}
+	const LatencySketch &GetSketch(HedgedRequestOperation operation) const {
+		return sketches[static_cast<size_t>(operation)];
+	}
+
+	void Reset();
+
+private:
+	array<LatencySketch, static_cast<size_t>(HedgedRequestOperation::COUNT)> sketches;
+};
+
+} // namespace duckdb
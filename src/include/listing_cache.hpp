@@ -0,0 +1,108 @@
+#pragma once
+
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/unique_ptr.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "duckdb/common/vector.hpp"
+#include "duckdb/storage/object_cache.hpp"
+#include "mutex.hpp"
+#include "thread_annotation.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <list>
+
+namespace duckdb {
+
+// Cache for directory listings returned by the wrapped filesystems, so warm globs are expanded without listing.
+//
+// Listings are stored in a trie keyed by path components, so everything under a prefix is found by walking one
+// subtree; trailing separators are ignored, e.g. "s3://bucket/dir" and "s3://bucket/dir/" share one listing. Each
+// listing expires on its own, and all listings together are bounded by [max_bytes] evicting in LRU order.
+class ListingCache : public ObjectCacheEntry {
+public:
+	// Entries as reported by ListFiles, namely name and whether it's a directory.
+	using Listing = vector<std::pair<string, bool>>;
+
+	ListingCache();
+	~ListingCache() override = default;
+
+	optional_idx GetEstimatedCacheMemory() const override;
+
+	string GetObjectType() override {
+		return "hedged_fs_listing_cache";
+	}
+
+	static string ObjectType() {
+		return "hedged_fs_listing_cache";
+	}
+
+	bool IsEnabled() const {
+		return enabled.load(std::memory_order_relaxed);
+	}
+	// Disabling the cache also drops all cached listings.
+	void SetEnabled(bool enable);
+	void SetTtl(std::chrono::milliseconds ttl_p);
+	// Update memory bound, listings beyond the new bound are evicted.
+	void SetMaxBytes(idx_t max_bytes_p);
+
+	// Lookup the cached listing of [directory], return false on miss or expiration.
+	bool TryGetListing(const string &directory, Listing &listing);
+	// Cache the listing of [directory], which isn't cached if it alone exceeds the memory bound.
+	void PutListing(const string &directory, Listing listing);
+
+	// Drop listings of [path], of all directories under it, and of all its ancestors, since creating or removing an
+	// entry could add or drop implicit parent directories on object stores.
+	void Invalidate(const string &path);
+	// Drop listings of all directories starting with [prefix]; empty prefix drops everything.
+	void InvalidatePrefix(const string &prefix);
+
+	// Get the estimated memory consumption and number of cached listings.
+	idx_t GetCachedBytes() const;
+	idx_t GetListingCount() const;
+
+private:
+	struct Node;
+	using LruList = std::list<Node *>;
+
+	struct Node {
+		Node *parent = nullptr;
+		// Path component of the node, and the directory of its listing.
+		string name;
+		string directory;
+		unordered_map<string, unique_ptr<Node>> children;
+		bool has_listing = false;
+		Listing listing;
+		std::chrono::steady_clock::time_point expire_at;
+		idx_t estimated_bytes = 0;
+		// Valid only if it has listing.
+		LruList::iterator lru_pos;
+	};
+
+	// Split [path] into trie components, trailing separators are ignored.
+	static vector<string> SplitPath(const string &path);
+	static idx_t EstimateBytes(const string &directory, const Listing &listing);
+
+	// Get the node of [path], nullptr if there's none.
+	Node *FindNode(const string &path) DUCKDB_REQUIRES(mu);
+	Node &GetOrCreateNode(const string &path) DUCKDB_REQUIRES(mu);
+	void DropListing(Node &node) DUCKDB_REQUIRES(mu);
+	// Drop listings of [node] and all nodes under it, and remove nodes under it.
+	void DropSubtree(Node &node) DUCKDB_REQUIRES(mu);
+	// Remove [node] and its ancestors which hold neither listing nor children.
+	void Prune(Node *node) DUCKDB_REQUIRES(mu);
+	void EvictToLimit() DUCKDB_REQUIRES(mu);
+
+	std::atomic<bool> enabled;
+	// Time to live in milliseconds.
+	std::atomic<int64_t> ttl_ms;
+	std::atomic<idx_t> max_bytes;
+
+	mutable concurrency::mutex mu;
+	Node root DUCKDB_GUARDED_BY(mu);
+	// Nodes with listing, the most recently used one is at the front.
+	LruList lru DUCKDB_GUARDED_BY(mu);
+	idx_t cached_bytes DUCKDB_GUARDED_BY(mu) = 0;
+};
+
+} // namespace duckdb
@@ -0,0 +1,222 @@
+#pragma once
+
+#include "cancellation_token.hpp"
+#include "duckdb/common/deque.hpp"
+#include "duckdb/common/optional_idx.hpp"
+#include "duckdb/common/shared_ptr.hpp"
+#include "duckdb/common/vector.hpp"
+#include "mutex.hpp"
+#include "thread_annotation.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+
+namespace duckdb {
+
+// Channel between hedged listing attempts and the caller, which streams listed entries in pages.
+//
+// Every attempt lists on its own; the first attempt to publish a page, or to finish, wins the race and other attempts
+// get cancelled. Pages of the winner are buffered up to [max_buffered_pages] for the caller, the winner blocks while
+// the buffer is full, so memory is bounded no matter how many entries are listed.
+template <typename T>
+class ListingStream {
+public:
+	using Page = vector<T>;
+
+	ListingStream(idx_t page_size_p, idx_t max_buffered_pages_p)
+	    : page_size(page_size_p), max_buffered_pages(max_buffered_pages_p) {
+	}
+
+	ListingStream(const ListingStream &) = delete;
+	ListingStream &operator=(const ListingStream &) = delete;
+
+	idx_t GetPageSize() const {
+		return page_size;
+	}
+
+	// Register a new attempt and return its id; [cancellation] is cancelled once the attempt loses the race, or the
+	// caller closes the stream.
+	idx_t AddAttempt(shared_ptr<CancellationToken> cancellation) {
+		idx_t attempt_id = 0;
+		{
+			const concurrency::lock_guard<concurrency::mutex> lock(mu);
+			attempt_id = cancellations.size();
+			if (!winner.IsValid() && !closed) {
+				cancellations.emplace_back(std::move(cancellation));
+				return attempt_id;
+			}
+			cancellations.emplace_back(nullptr);
+		}
+		// Race is already decided, the attempt is dropped on start.
+		cancellation->Cancel();
+		return attempt_id;
+	}
+
+	// Publish a page listed by the given attempt, which blocks while the buffer is full.
+	// Return false if the attempt has lost or the stream is closed, in which case the attempt should stop listing.
+	bool Publish(idx_t attempt_id, Page page) {
+		vector<shared_ptr<CancellationToken>> losers;
+		{
+			concurrency::unique_lock<concurrency::mutex> lock(mu);
+			if (!TryClaim(attempt_id, losers)) {
+				return false;
+			}
+			producer_cv.wait(lock, [this]() DUCKDB_REQUIRES(mu) {
+				return closed || pages.size() < max_buffered_pages;
+			});
+			if (closed) {
+				return false;
+			}
+			pages.emplace_back(std::move(page));
+			consumer_cv.notify_all();
+		}
+		CancelAll(losers);
+		return true;
+	}
+
+	// Mark the given attempt as finished, with [listed] as its result on success, or [eptr] on failure.
+	// Return whether the attempt is the winner.
+	bool Finish(idx_t attempt_id, bool listed, std::exception_ptr eptr) {
+		vector<shared_ptr<CancellationToken>> losers;
+		{
+			const concurrency::lock_guard<concurrency::mutex> lock(mu);
+			if (!TryClaim(attempt_id, losers)) {
+				return false;
+			}
+			result = listed;
+			failure = std::move(eptr);
+			finished = true;
+			consumer_cv.notify_all();
+		}
+		CancelAll(losers);
+		return true;
+	}
+
+	// Return whether the race is decided.
+	bool HasWinner() const {
+		const concurrency::lock_guard<concurrency::mutex> lock(mu);
+		return winner.IsValid();
+	}
+
+	// Block until the race is decided.
+	void WaitForWinner() {
+		concurrency::unique_lock<concurrency::mutex> lock(mu);
+		consumer_cv.wait(lock, [this]() DUCKDB_REQUIRES(mu) { return winner.IsValid(); });
+	}
+
+	// Get the next page of the winner, return false once all pages are consumed; winner's exception is rethrown.
+	bool Next(Page &page) {
+		concurrency::unique_lock<concurrency::mutex> lock(mu);
+		consumer_cv.wait(lock, [this]() DUCKDB_REQUIRES(mu) { return !pages.empty() || finished; });
+		if (!pages.empty()) {
+			page = std::move(pages.front());
+			pages.pop_front();
+			producer_cv.notify_all();
+			return true;
+		}
+		if (failure != nullptr) {
+			std::rethrow_exception(failure);
+		}
+		return false;
+	}
+
+	// Get the result of the winner, only valid after [Next] returns false.
+	bool GetResult() const {
+		const concurrency::lock_guard<concurrency::mutex> lock(mu);
+		return result;
+	}
+
+	// Close the stream from the caller side, all attempts stop on their next publish.
+	void Close() {
+		vector<shared_ptr<CancellationToken>> to_cancel;
+		{
+			const concurrency::lock_guard<concurrency::mutex> lock(mu);
+			if (closed) {
+				return;
+			}
+			closed = true;
+			pages.clear();
+			to_cancel = std::move(cancellations);
+			producer_cv.notify_all();
+		}
+		CancelAll(to_cancel);
+	}
+
+private:
+	// Claim the race for the given attempt, and collect tokens of other attempts to cancel.
+	// Return whether the attempt is the winner and the stream is still open.
+	bool TryClaim(idx_t attempt_id, vector<shared_ptr<CancellationToken>> &losers) DUCKDB_REQUIRES(mu) {
+		if (closed) {
+			return false;
+		}
+		if (winner.IsValid()) {
+			return winner.GetIndex() == attempt_id && !finished;
+		}
+		winner = attempt_id;
+		for (idx_t idx = 0; idx < cancellations.size(); ++idx) {
+			if (idx != attempt_id && cancellations[idx] != nullptr) {
+				losers.emplace_back(std::move(cancellations[idx]));
+			}
+		}
+		consumer_cv.notify_all();
+		return true;
+	}
+
+	// Cancel outside of the lock, since cancellation callbacks might take arbitrary time.
+	static void CancelAll(const vector<shared_ptr<CancellationToken>> &tokens) {
+		for (const auto &cur_token : tokens) {
+			if (cur_token != nullptr) {
+				cur_token->Cancel();
+			}
+		}
+	}
+
+	const idx_t page_size;
+	const idx_t max_buffered_pages;
+
+	mutable concurrency::mutex mu;
+	std::condition_variable consumer_cv DUCKDB_GUARDED_BY(mu);
+	std::condition_variable producer_cv DUCKDB_GUARDED_BY(mu);
+	vector<shared_ptr<CancellationToken>> cancellations DUCKDB_GUARDED_BY(mu);
+	optional_idx winner DUCKDB_GUARDED_BY(mu);
+	deque<Page> pages DUCKDB_GUARDED_BY(mu);
+	bool finished DUCKDB_GUARDED_BY(mu) = false;
+	bool closed DUCKDB_GUARDED_BY(mu) = false;
+	bool result DUCKDB_GUARDED_BY(mu) = false;
+	std::exception_ptr failure DUCKDB_GUARDED_BY(mu);
+};
+
+// Buffer entries listed by one attempt, and publish them to the stream page by page.
+template <typename T>
+class ListingPageWriter {
+public:
+	ListingPageWriter(ListingStream<T> &stream_p, idx_t attempt_id_p) : stream(stream_p), attempt_id(attempt_id_p) {
+	}
+
+	// Append a listed entry, return false if the attempt should stop listing.
+	bool Append(T value) {
+		page.emplace_back(std::move(value));
+		if (page.size() < stream.GetPageSize()) {
+			return true;
+		}
+		return Flush();
+	}
+
+	// Publish buffered entries, return false if the attempt should stop listing.
+	bool Flush() {
+		if (page.empty()) {
+			return true;
+		}
+		typename ListingStream<T>::Page cur_page;
+		cur_page.swap(page);
+		return stream.Publish(attempt_id, std::move(cur_page));
+	}
+
+private:
+	ListingStream<T> &stream;
+	const idx_t attempt_id;
+	typename ListingStream<T>::Page page;
+};
+
+} // namespace duckdb
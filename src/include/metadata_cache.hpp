@@ -0,0 +1,121 @@
+#pragma once
+
+#include "duckdb/common/array.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "duckdb/storage/object_cache.hpp"
+#include "mutex.hpp"
+#include "thread_annotation.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <list>
+
+namespace duckdb {
+
+// Cache for file metadata returned by the wrapped filesystems, keyed by path.
+//
+// Each metadata field is filled and expired independently, since they're fetched by different calls. Entries are
+// spread over shards by path, each shard is bounded by its share of [max_bytes] and evicts in LRU order. When a
+// different version tag is observed for a path, cached metadata for the path is dropped.
+class MetadataCache : public ObjectCacheEntry {
+public:
+	MetadataCache();
+	~MetadataCache() override = default;
+
+	optional_idx GetEstimatedCacheMemory() const override;
+
+	string GetObjectType() override {
+		return "hedged_fs_metadata_cache";
+	}
+
+	static string ObjectType() {
+		return "hedged_fs_metadata_cache";
+	}
+
+	bool IsEnabled() const {
+		return enabled.load(std::memory_order_relaxed);
+	}
+	// Disabling the cache also drops all cached entries.
+	void SetEnabled(bool enable);
+	void SetTtl(std::chrono::milliseconds ttl_p);
+	// Update memory bound, entries beyond the new bound are evicted.
+	void SetMaxBytes(idx_t max_bytes_p);
+
+	// Lookup cached metadata for [path], return false on miss or expiration.
+	bool TryGetFileExists(const string &path, bool &file_exists);
+	bool TryGetFileSize(const string &path, int64_t &file_size);
+	bool TryGetLastModifiedTime(const string &path, timestamp_t &last_modified_time);
+	bool TryGetStats(const string &path, FileMetadata &stats);
+
+	void PutFileExists(const string &path, bool file_exists);
+	void PutFileSize(const string &path, int64_t file_size);
+	void PutLastModifiedTime(const string &path, timestamp_t last_modified_time);
+	void PutStats(const string &path, const FileMetadata &stats);
+
+	// Record the version tag of [path], cached metadata is dropped if it's fetched for another version.
+	void PutVersionTag(const string &path, const string &version_tag);
+	// Lookup the last recorded version tag of [path], return false if there's none.
+	bool TryGetVersionTag(const string &path, string &version_tag);
+
+	// Drop cached metadata for [path].
+	void Invalidate(const string &path);
+	// Drop cached metadata for all paths starting with [prefix]; empty prefix drops everything.
+	void InvalidatePrefix(const string &prefix);
+
+	// Get the estimated memory consumption and number of cached entries.
+	idx_t GetCachedBytes() const;
+	idx_t GetEntryCount() const;
+
+private:
+	static constexpr idx_t SHARD_COUNT = 16;
+
+	template <typename T>
+	struct CachedField {
+		bool valid = false;
+		T value {};
+		std::chrono::steady_clock::time_point expire_at;
+	};
+
+	struct Entry {
+		string path;
+		string version_tag;
+		CachedField<bool> file_exists;
+		CachedField<int64_t> file_size;
+		CachedField<timestamp_t> last_modified_time;
+		CachedField<FileMetadata> stats;
+		idx_t estimated_bytes = 0;
+	};
+
+	using EntryList = std::list<Entry>;
+
+	struct Shard {
+		mutable concurrency::mutex mu;
+		// Most recently used entry is at the front.
+		EntryList lru DUCKDB_GUARDED_BY(mu);
+		unordered_map<string, EntryList::iterator> index DUCKDB_GUARDED_BY(mu);
+		idx_t cached_bytes DUCKDB_GUARDED_BY(mu) = 0;
+	};
+
+	Shard &GetShard(const string &path);
+	idx_t GetShardMaxBytes() const;
+
+	// Lookup [path] and read the field if it's valid, promote the entry on hit.
+	template <typename T>
+	bool TryGetField(const string &path, CachedField<T> Entry::*field, T &value);
+	// Insert or update the field of [path], then evict entries beyond the shard memory bound.
+	template <typename T>
+	void PutField(const string &path, CachedField<T> Entry::*field, const T &value);
+
+	static void EraseEntry(Shard &shard, EntryList::iterator iter) DUCKDB_REQUIRES(shard.mu);
+	static void UpdateEstimatedBytes(Shard &shard, Entry &entry) DUCKDB_REQUIRES(shard.mu);
+	void EvictToLimit(Shard &shard) DUCKDB_REQUIRES(shard.mu);
+
+	std::atomic<bool> enabled;
+	// Time to live in milliseconds.
+	std::atomic<int64_t> ttl_ms;
+	std::atomic<idx_t> max_bytes;
+	array<Shard, SHARD_COUNT> shards;
+};
+
+} // namespace duckdb
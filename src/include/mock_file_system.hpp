@@ -1,10 +1,14 @@
 #pragma once
 
 #include "duckdb/common/local_file_system.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "hedged_request_config.hpp"
+#include "latency_distribution.hpp"
 #include "mutex.hpp"
 #include "thread_annotation.hpp"
 
 #include <chrono>
+#include <random>
 
 namespace duckdb {
 
@@ -14,18 +18,37 @@ class MockFileSystem : public LocalFileSystem {
 public:
 	MockFileSystem();
 
+	// Delay for all operations without a latency distribution.
 	void SetDelay(std::chrono::milliseconds delay_p);
 
+	// Sample delays of [operation] from [distribution], instead of the fixed delay.
+	void SetLatencyDistribution(HedgedRequestOperation operation, LatencyDistribution distribution);
+	// Delay for operations on paths starting with [path_prefix], which takes precedence over other delays. Only
+	// applies to operations taking a path, e.g. OpenFile and FileExists, but not those taking a handle.
+	// Prefixes are matched in the order they're first set.
+	void SetPathDelay(const string &path_prefix, std::chrono::milliseconds path_delay);
+	// Reseed the random engine which samples latency distributions.
+	void SetSeed(uint64_t seed);
+
 	// After simulated delay, throw IOException.
 	void SetSimulateIoFailure(bool failure);
 
 	void SetSkipSimulatedIoFailureCalls(int count);
 
+	// After simulated delay, throw IOException for the next [count] calls only, e.g. a transient backend error.
+	void SetTransientIoFailureCount(int count);
+
+	// Get the number of simulated IO operations invoked so far.
+	uint64_t GetIoOperationCount() const;
+
 	string GetName() const override;
 
 	unique_ptr<FileHandle> OpenFile(const string &path, FileOpenFlags flags,
 	                                optional_ptr<FileOpener> opener = nullptr) override;
 
+	void Read(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location) override;
+	void Write(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location) override;
+
 	int64_t GetFileSize(FileHandle &handle) override;
 	timestamp_t GetLastModifiedTime(FileHandle &handle) override;
 	string GetVersionTag(FileHandle &handle) override;
@@ -54,12 +77,17 @@ protected:
 	bool SupportsListFilesExtended() const override;
 
 private:
-	void SimulateDelay();
+	void SimulateDelay(HedgedRequestOperation operation, const string &path = string());
 
-	concurrency::mutex delay_mutex;
+	mutable concurrency::mutex delay_mutex;
 	std::chrono::milliseconds delay DUCKDB_GUARDED_BY(delay_mutex);
+	unordered_map<idx_t, LatencyDistribution> latency_distributions DUCKDB_GUARDED_BY(delay_mutex);
+	vector<std::pair<string, std::chrono::milliseconds>> path_delays DUCKDB_GUARDED_BY(delay_mutex);
+	std::mt19937_64 rng DUCKDB_GUARDED_BY(delay_mutex);
 	bool simulate_io_failure DUCKDB_GUARDED_BY(delay_mutex) = false;
 	int skip_simulated_io_failure_calls DUCKDB_GUARDED_BY(delay_mutex) = 0;
+	int transient_io_failure_count DUCKDB_GUARDED_BY(delay_mutex) = 0;
+	uint64_t io_operation_count DUCKDB_GUARDED_BY(delay_mutex) = 0;
 };
 
 } // namespace duckdb
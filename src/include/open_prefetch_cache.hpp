@@ -0,0 +1,98 @@
+#pragma once
+
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "hedge_scheduler.hpp"
+#include "mutex.hpp"
+#include "thread_annotation.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <list>
+
+namespace duckdb {
+
+// File handles opened speculatively for files returned by a glob, keyed by wrapped filesystem and path.
+//
+// A handle is kept until the next OpenFile of its path takes it, or it expires after the configured time to live and
+// gets closed by a sweep timer on the hedge scheduler. Handles are bounded by their estimated memory; when a new
+// prefetch doesn't fit, the oldest handles are evicted first.
+class OpenPrefetchCache {
+public:
+	explicit OpenPrefetchCache(HedgeScheduler &scheduler_p);
+	~OpenPrefetchCache();
+
+	OpenPrefetchCache(const OpenPrefetchCache &) = delete;
+	OpenPrefetchCache &operator=(const OpenPrefetchCache &) = delete;
+
+	void SetTtl(std::chrono::milliseconds ttl_p);
+	// Update memory bound, handles beyond the new bound are evicted.
+	void SetMaxBytes(idx_t max_bytes_p);
+
+	// Register a prefetch for [key]; return false if [key] is cached or being prefetched already, or there's no room
+	// left for it.
+	bool TryStartPrefetch(const string &key);
+	// Complete the prefetch for [key], [handle] is nullptr if the open failed. The handle is closed if the prefetch
+	// has been erased in the meantime.
+	void FinishPrefetch(const string &key, unique_ptr<FileHandle> handle);
+
+	// Take the prefetched handle for [key], waiting for its prefetch if it's still in flight; return nullptr if there's
+	// none.
+	unique_ptr<FileHandle> TryTake(const string &key);
+
+	// Cancel the sweep timer and don't arm it again, so the cache can outlive the scheduler; expired handles are
+	// still evicted by later calls, and closed on destruction.
+	void StopSweeping();
+
+	// Drop the handle for [key], a prefetch still in flight is discarded once it completes.
+	void Erase(const string &key);
+	// Drop all handles whose key starts with [prefix], after waiting for their in-flight prefetches.
+	void ErasePrefix(const string &prefix);
+
+	// Get the number of cached handles, and their estimated memory including in-flight prefetches.
+	idx_t GetHandleCount() const;
+	idx_t GetCachedBytes() const;
+
+private:
+	struct CachedHandle {
+		string key;
+		unique_ptr<FileHandle> handle;
+		std::chrono::steady_clock::time_point expire_at;
+	};
+	// Handles are kept in insertion order, which is also expiry order since they share one time to live.
+	using HandleList = std::list<CachedHandle>;
+
+	static idx_t GetEstimatedBytes(const string &key);
+	// Move expired handles into [evicted].
+	void EvictExpired(std::chrono::steady_clock::time_point now, vector<unique_ptr<FileHandle>> &evicted)
+	    DUCKDB_REQUIRES(mu);
+	// Move the oldest handles into [evicted] until [required_bytes] fits into the memory bound, return false if it
+	// doesn't fit even without any cached handle.
+	bool EvictForRoom(idx_t required_bytes, vector<unique_ptr<FileHandle>> &evicted) DUCKDB_REQUIRES(mu);
+	void EraseHandle(HandleList::iterator iter, vector<unique_ptr<FileHandle>> &evicted) DUCKDB_REQUIRES(mu);
+	// Arm the sweep timer for the oldest handle, if it's not armed yet.
+	void ArmSweepTimer() DUCKDB_REQUIRES(mu);
+	// Close dropped handles, which happens without lock.
+	static void CloseHandles(vector<unique_ptr<FileHandle>> &handles);
+
+	HedgeScheduler &scheduler;
+	std::atomic<int64_t> ttl_ms;
+	std::atomic<idx_t> max_bytes;
+
+	mutable concurrency::mutex mu;
+	std::condition_variable prefetch_completion_cv DUCKDB_GUARDED_BY(mu);
+	HandleList handles DUCKDB_GUARDED_BY(mu);
+	unordered_map<string, HandleList::iterator> index DUCKDB_GUARDED_BY(mu);
+	// In-flight prefetches, mapped to whether they've been erased.
+	unordered_map<string, bool> in_flight DUCKDB_GUARDED_BY(mu);
+	// Estimated memory of cached handles and in-flight prefetches.
+	idx_t cached_bytes DUCKDB_GUARDED_BY(mu) = 0;
+	// Timer id of the armed sweep timer, 0 if there's none.
+	uint64_t sweep_timer_id DUCKDB_GUARDED_BY(mu) = 0;
+	bool sweeping_stopped DUCKDB_GUARDED_BY(mu) = false;
+	// Number of cached handles and in-flight prefetches, so erasing from an empty cache doesn't take the lock.
+	std::atomic<idx_t> tracked_count {0};
+};
+
+} // namespace duckdb
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace duckdb {
+
+// Move-only type-erased job for the thread pool.
+//
+// Callables up to [INLINE_BYTES] are stored inline, so submitting a typical hedged attempt, which only captures a few
+// pointers, doesn't allocate; larger callables fall back to one heap allocation like std::function.
+class PoolJob {
+public:
+	static constexpr size_t INLINE_BYTES = 64;
+
+	PoolJob() noexcept = default;
+	PoolJob(std::nullptr_t) noexcept { // NOLINT: implicit conversion like std::function
+	}
+
+	template <typename Fn, typename = typename std::enable_if<
+	                           !std::is_same<typename std::decay<Fn>::type, PoolJob>::value &&
+	                           !std::is_same<typename std::decay<Fn>::type, std::nullptr_t>::value>::type>
+	PoolJob(Fn &&fn) { // NOLINT: implicit conversion like std::function
+		using Callable = typename std::decay<Fn>::type;
+		if (IsEmpty(fn)) {
+			return;
+		}
+		Emplace<Callable>(std::forward<Fn>(fn), std::integral_constant<bool, IsStoredInline<Callable>()> {});
+	}
+
+	PoolJob(PoolJob &&other) noexcept {
+		MoveFrom(other);
+	}
+	PoolJob &operator=(PoolJob &&other) noexcept {
+		if (this != &other) {
+			Reset();
+			MoveFrom(other);
+		}
+		return *this;
+	}
+	PoolJob(const PoolJob &) = delete;
+	PoolJob &operator=(const PoolJob &) = delete;
+
+	~PoolJob() {
+		Reset();
+	}
+
+	explicit operator bool() const noexcept {
+		return ops != nullptr;
+	}
+
+	void operator()() {
+		if (ops == nullptr) {
+			throw std::bad_function_call();
+		}
+		ops->invoke(&storage);
+	}
+
+	// Return whether [Fn] is stored inline without allocation.
+	template <typename Fn>
+	static constexpr bool IsStoredInline() {
+		return sizeof(Fn) <= INLINE_BYTES && alignof(Fn) <= alignof(std::max_align_t) &&
+		       std::is_nothrow_move_constructible<Fn>::value;
+	}
+
+private:
+	struct Ops {
+		void (*invoke)(void *storage);
+		// Move-construct the callable into [dst] and destroy the one in [src].
+		void (*relocate)(void *dst, void *src);
+		void (*destroy)(void *storage);
+	};
+
+	template <typename Fn>
+	struct InlineOps {
+		static void Invoke(void *storage) {
+			(*static_cast<Fn *>(storage))();
+		}
+		static void Relocate(void *dst, void *src) noexcept {
+			new (dst) Fn(std::move(*static_cast<Fn *>(src)));
+			static_cast<Fn *>(src)->~Fn();
+		}
+		static void Destroy(void *storage) noexcept {
+			static_cast<Fn *>(storage)->~Fn();
+		}
+		static constexpr Ops OPS {Invoke, Relocate, Destroy};
+	};
+
+	// Heap-allocated callables keep their pointer in the inline storage.
+	template <typename Fn>
+	struct HeapOps {
+		static void Invoke(void *storage) {
+			(**static_cast<Fn **>(storage))();
+		}
+		static void Relocate(void *dst, void *src) noexcept {
+			*static_cast<Fn **>(dst) = *static_cast<Fn **>(src);
+		}
+		static void Destroy(void *storage) noexcept {
+			delete *static_cast<Fn **>(storage);
+		}
+		static constexpr Ops OPS {Invoke, Relocate, Destroy};
+	};
+
+	template <typename Fn>
+	static bool IsEmpty(const Fn &) {
+		return false;
+	}
+	static bool IsEmpty(const std::function<void()> &fn) {
+		return !fn;
+	}
+
+	template <typename Callable, typename Fn>
+	void Emplace(Fn &&fn, std::true_type /*inline*/) {
+		new (&storage) Callable(std::forward<Fn>(fn));
+		ops = &InlineOps<Callable>::OPS;
+	}
+	template <typename Callable, typename Fn>
+	void Emplace(Fn &&fn, std::false_type /*inline*/) {
+		*reinterpret_cast<Callable **>(&storage) = new Callable(std::forward<Fn>(fn));
+		ops = &HeapOps<Callable>::OPS;
+	}
+
+	void MoveFrom(PoolJob &other) noexcept {
+		if (other.ops == nullptr) {
+			return;
+		}
+		other.ops->relocate(&storage, &other.storage);
+		ops = other.ops;
+		other.ops = nullptr;
+	}
+	void Reset() noexcept {
+		if (ops == nullptr) {
+			return;
+		}
+		ops->destroy(&storage);
+		ops = nullptr;
+	}
+
+	typename std::aligned_storage<INLINE_BYTES, alignof(std::max_align_t)>::type storage;
+	const Ops *ops = nullptr;
+};
+
+template <typename Fn>
+constexpr PoolJob::Ops PoolJob::InlineOps<Fn>::OPS;
+template <typename Fn>
+constexpr PoolJob::Ops PoolJob::HeapOps<Fn>::OPS;
+
+} // namespace duckdb
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "duckdb/common/deque.hpp"
+#include "duckdb/common/shared_ptr.hpp"
+#include "duckdb/common/unique_ptr.hpp"
+#include "mutex.hpp"
+#include "read_buffer_pool.hpp"
+#include "thread_annotation.hpp"
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+
+namespace duckdb {
+
+// Window of blocks prefetched ahead of a sequential reader.
+//
+// Blocks following the read position are fetched asynchronously, at most [window_blocks] of them are kept in a
+// bounded ring; reads are served from fetched blocks, and every consumed block is replaced by the next one. Not thread
+// safe, a window is owned by the thread reading the file handle.
+class ReadAheadWindow {
+public:
+	// Receives the buffer of a fetched block, or the failure of its fetch.
+	using BlockCallback = std::function<void(PooledReadBuffer buffer, std::exception_ptr eptr)>;
+	// Start fetching [nr_bytes] at [location] into a new buffer without blocking, and invoke [on_fetched] once done,
+	// possibly on another thread.
+	using BlockFetcher = std::function<void(idx_t location, idx_t nr_bytes, BlockCallback on_fetched)>;
+
+	ReadAheadWindow(BlockFetcher fetcher_p, idx_t block_size_p, idx_t window_blocks_p);
+
+	ReadAheadWindow(const ReadAheadWindow &) = delete;
+	ReadAheadWindow &operator=(const ReadAheadWindow &) = delete;
+
+	// Read up to [nr_bytes] at [location] of a file with [file_size] bytes into [buffer], and prefetch blocks after it.
+	// Return the number of bytes read, which is less than [nr_bytes] only at end of file. Failure of a block fetch is
+	// rethrown once the block is read.
+	idx_t Read(data_ptr_t buffer, idx_t nr_bytes, idx_t location, idx_t file_size);
+
+	// Drop all prefetched blocks, fetches in flight complete into the dropped blocks.
+	void Reset();
+
+	// Get the number of blocks either fetched or being fetched.
+	idx_t GetBlockCount() const {
+		return blocks.size();
+	}
+
+private:
+	struct Block {
+		idx_t location = 0;
+		idx_t size = 0;
+		concurrency::mutex mu;
+		std::condition_variable cv DUCKDB_GUARDED_BY(mu);
+		bool done DUCKDB_GUARDED_BY(mu) = false;
+		PooledReadBuffer buffer DUCKDB_GUARDED_BY(mu);
+		std::exception_ptr eptr DUCKDB_GUARDED_BY(mu);
+	};
+
+	// Schedule fetches until the window is full or end of file is reached.
+	void Fill(idx_t file_size);
+	// Block wait until the given block is fetched, rethrow its failure if any.
+	static void WaitForBlock(Block &block);
+
+	const BlockFetcher fetcher;
+	const idx_t block_size;
+	const idx_t window_blocks;
+	deque<shared_ptr<Block>> blocks;
+	// Location of the next block to fetch.
+	idx_t next_block_location = 0;
+};
+
+// Per-handle state to detect sequential reads, and read ahead once detected.
+struct SequentialReadState {
+	// End position of the last read, and the number of consecutive reads which start where the previous one ends.
+	idx_t last_read_end = 0;
+	idx_t sequential_read_count = 0;
+	// Set once read-ahead takes over, after which reads are served by the window at [position], and wrapped handle
+	// position stays untouched.
+	unique_ptr<ReadAheadWindow> window;
+	idx_t position = 0;
+	idx_t file_size = 0;
+};
+
+} // namespace duckdb
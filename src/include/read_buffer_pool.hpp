@@ -0,0 +1,76 @@
+#pragma once
+
+#include "duckdb/common/array.hpp"
+#include "duckdb/common/shared_ptr.hpp"
+#include "duckdb/common/unique_ptr.hpp"
+#include "duckdb/common/vector.hpp"
+#include "mutex.hpp"
+#include "thread_annotation.hpp"
+
+namespace duckdb {
+
+class ReadBufferPool;
+
+// Scratch buffer leased from ReadBufferPool, which is returned to the pool on destruction.
+class PooledReadBuffer {
+public:
+	PooledReadBuffer() = default;
+	PooledReadBuffer(shared_ptr<ReadBufferPool> pool_p, unique_ptr<data_t[]> data_p, idx_t capacity_p);
+	~PooledReadBuffer();
+
+	PooledReadBuffer(const PooledReadBuffer &) = delete;
+	PooledReadBuffer &operator=(const PooledReadBuffer &) = delete;
+	PooledReadBuffer(PooledReadBuffer &&other) noexcept;
+	PooledReadBuffer &operator=(PooledReadBuffer &&other) noexcept;
+
+	data_ptr_t GetData() const {
+		return data.get();
+	}
+	idx_t GetCapacity() const {
+		return capacity;
+	}
+
+private:
+	void Release();
+
+	shared_ptr<ReadBufferPool> pool;
+	unique_ptr<data_t[]> data;
+	idx_t capacity = 0;
+};
+
+// Size-classed pool of scratch buffers used by hedged reads; buffer sizes are rounded up to power of two, and at most
+// [max_bytes] of idle buffers are kept for reuse.
+class ReadBufferPool : public enable_shared_from_this<ReadBufferPool> {
+public:
+	explicit ReadBufferPool(idx_t max_bytes_p);
+
+	// Get a buffer with at least [size] bytes.
+	PooledReadBuffer Acquire(idx_t size);
+
+	// Update the upper bound for idle buffer memory, idle buffers beyond the new bound are released.
+	void SetMaxBytes(idx_t max_bytes_p);
+
+	// Get the total bytes of idle buffers kept by the pool.
+	idx_t GetCachedBytes() const;
+
+private:
+	friend class PooledReadBuffer;
+
+	// Smallest size class is 4KiB, largest is 256MiB; larger buffers are never pooled.
+	static constexpr idx_t MIN_SIZE_CLASS_SHIFT = 12;
+	static constexpr idx_t SIZE_CLASS_COUNT = 17;
+
+	// Get the size class index for the requested [size], or SIZE_CLASS_COUNT if it's too large to pool.
+	static idx_t GetSizeClass(idx_t size);
+	static idx_t GetSizeClassCapacity(idx_t size_class);
+
+	void Return(unique_ptr<data_t[]> data, idx_t capacity);
+	void EvictToLimit() DUCKDB_REQUIRES(mu);
+
+	mutable concurrency::mutex mu;
+	idx_t max_bytes DUCKDB_GUARDED_BY(mu);
+	idx_t cached_bytes DUCKDB_GUARDED_BY(mu) = 0;
+	array<vector<unique_ptr<data_t[]>>, SIZE_CLASS_COUNT> free_buffers DUCKDB_GUARDED_BY(mu);
+};
+
+} // namespace duckdb
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "duckdb/common/array.hpp"
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/vector.hpp"
+#include "hedged_request_config.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+
+namespace duckdb {
+
+// Timestamps of one attempt in microseconds since its request started, -1 if the attempt didn't reach the stage
+// before the event was published, e.g. a losing attempt which is still running.
+struct RequestTraceAttempt {
+	int64_t submit_us;
+	int64_t start_us;
+	int64_t finish_us;
+	bool failed;
+};
+
+// Trace event of one hedged call. It's trivially copyable and fixed-size, so publishing doesn't allocate; the path and
+// error message are truncated to fit.
+struct RequestTraceEvent {
+	static constexpr idx_t MAX_ATTEMPTS = 8;
+	static constexpr idx_t PATH_PREFIX_BYTES = 64;
+	static constexpr idx_t ERROR_BYTES = 128;
+
+	// Assigned on publish, increasing from 1.
+	uint64_t request_id;
+	HedgedRequestOperation operation;
+	uint64_t path_hash;
+	// Null-terminated prefix of the path.
+	char path_prefix[PATH_PREFIX_BYTES];
+	// Wall clock start time in microseconds since epoch.
+	int64_t start_time_us;
+	int64_t latency_us;
+	// Number of submitted attempts, only the first [MAX_ATTEMPTS] of them are traced.
+	uint64_t attempt_count;
+	// Index of the attempt whose outcome is returned, -1 if the outcome is the latest failure in first-success mode.
+	int64_t winner_attempt;
+	// Whether the request returned an error.
+	bool failed;
+	RequestTraceAttempt attempts[MAX_ATTEMPTS];
+	// Null-terminated message of the first failed attempt, empty if no attempt failed.
+	char error[ERROR_BYTES];
+};
+
+// Fixed-size ring of the most recent trace events, which is written without lock or allocation.
+//
+// Every slot is a sequence lock: the writer marks the slot odd while it stores the event as relaxed atomic words, then
+// even once it's done; readers skip slots which are being written, or have been overwritten while they're read.
+class RequestTraceRing {
+public:
+	static constexpr idx_t CAPACITY = 1024;
+
+	RequestTraceRing();
+
+	RequestTraceRing(const RequestTraceRing &) = delete;
+	RequestTraceRing &operator=(const RequestTraceRing &) = delete;
+
+	// Publish [event], overwriting the oldest one if the ring is full; its request id is assigned here.
+	void Publish(RequestTraceEvent event);
+
+	// Get events still in the ring, ordered by request id.
+	vector<RequestTraceEvent> GetRecentEvents() const;
+
+private:
+	static constexpr idx_t WORD_COUNT = (sizeof(RequestTraceEvent) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+	struct Slot {
+		// 0 if never written, [2 * id - 1] while event [id] is being written, and [2 * id] once it's written.
+		std::atomic<uint64_t> sequence;
+		array<std::atomic<uint64_t>, WORD_COUNT> words;
+	};
+
+	// Id of the latest published event.
+	std::atomic<uint64_t> last_request_id;
+	array<Slot, CAPACITY> slots;
+};
+
+// Collects the trace of one in-flight hedged call, which attempts update concurrently from thread pool workers.
+//
+// The event is published once both the caller has returned and the winning attempt has recorded its win, so the
+// winner is known no matter which of them gets there first. Losing attempts which finish later don't show up.
+class RequestTraceRecorder {
+public:
+	RequestTraceRecorder() = default;
+
+	RequestTraceRecorder(const RequestTraceRecorder &) = delete;
+	RequestTraceRecorder &operator=(const RequestTraceRecorder &) = delete;
+
+	// Start tracing a call of [operation] on [path] into [ring]; invoked by the caller before any attempt is submitted.
+	void Begin(RequestTraceRing &ring, HedgedRequestOperation operation, const string &path);
+
+	void OnAttemptSubmitted(size_t attempt_idx);
+	void OnAttemptStarted(size_t attempt_idx);
+	// Record that the attempt finished, with [error] if it failed; failures aborted by cancellation pass nullptr.
+	void OnAttemptFinished(size_t attempt_idx, const std::exception_ptr &error = nullptr);
+	// Invoked by the attempt whose outcome is returned, after the outcome is recorded.
+	void OnAttemptWon(size_t attempt_idx);
+
+	// Invoked by the caller once the outcome is decided, with the number of submitted attempts. [decided_by_caller]
+	// is set if the caller decided the outcome itself, so no attempt will record a win.
+	void OnRequestReturned(uint64_t attempt_count, bool decided_by_caller);
+
+private:
+	// Publish the event once both the caller and the winner are done.
+	void Release();
+
+	RequestTraceRing *ring = nullptr;
+	// Fields known when the call begins, others are filled on publish.
+	RequestTraceEvent event;
+	std::chrono::steady_clock::time_point start;
+	// Per-attempt timestamps relative to [start], -1 if not reached.
+	array<std::atomic<int64_t>, RequestTraceEvent::MAX_ATTEMPTS> submit_us;
+	array<std::atomic<int64_t>, RequestTraceEvent::MAX_ATTEMPTS> start_us;
+	array<std::atomic<int64_t>, RequestTraceEvent::MAX_ATTEMPTS> finish_us;
+	array<std::atomic<bool>, RequestTraceEvent::MAX_ATTEMPTS> attempt_failed;
+	std::atomic<int64_t> winner_attempt {-1};
+	// The first failed attempt claims [error_message], which is readable once [error_ready] is set.
+	std::atomic<bool> error_claimed {false};
+	std::atomic<bool> error_ready {false};
+	char error_message[RequestTraceEvent::ERROR_BYTES];
+	// The caller and the winning attempt each release once.
+	std::atomic<uint32_t> pending_releases {2};
+};
+
+} // namespace duckdb
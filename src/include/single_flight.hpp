@@ -0,0 +1,109 @@
+#pragma once
+
+#include "duckdb/common/string.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "mutex.hpp"
+#include "thread_annotation.hpp"
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+
+namespace duckdb {
+
+// Coalesce concurrent calls with the same key: the first caller (leader) issues the request, while callers arriving
+// before it completes (followers) wait for and share its outcome. Once the leader completes, the next call with the
+// same key issues a new request.
+class SingleFlight {
+public:
+	SingleFlight() = default;
+
+	SingleFlight(const SingleFlight &) = delete;
+	SingleFlight &operator=(const SingleFlight &) = delete;
+
+	// Run [fn] as leader, or get a copy of the in-flight leader's result; leader's exception is rethrown to followers.
+	template <typename T>
+	T Do(const string &key, const std::function<T()> &fn);
+
+	// Same as [Do], but followers invoke [follow_fn] after the leader succeeds instead of copying its result, which is
+	// used for non-copyable results.
+	template <typename T>
+	T DoOrFollow(const string &key, const std::function<T()> &fn, const std::function<T()> &follow_fn);
+
+	// Get the number of in-flight keys.
+	idx_t GetInFlightCount() const;
+
+private:
+	struct Flight {
+		concurrency::mutex mu;
+		std::condition_variable cv DUCKDB_GUARDED_BY(mu);
+		bool completed DUCKDB_GUARDED_BY(mu) = false;
+		std::exception_ptr eptr DUCKDB_GUARDED_BY(mu);
+		// Copy of leader's result, only set for [Do] when there're followers.
+		std::shared_ptr<void> value DUCKDB_GUARDED_BY(mu);
+	};
+
+	struct FlightState {
+		std::shared_ptr<Flight> flight;
+		idx_t follower_count = 0;
+	};
+
+	// Join the in-flight call for [key], or start a new one, in which case [is_leader] is set.
+	std::shared_ptr<Flight> Join(const string &key, bool &is_leader);
+	// Remove the in-flight call for [key], so later calls start a new one; return the number of followers joined.
+	idx_t Leave(const string &key);
+	// Publish the outcome to followers.
+	static void Complete(Flight &flight, std::shared_ptr<void> value, std::exception_ptr eptr);
+	// Wait for the leader to complete, and rethrow its exception if any.
+	static void Wait(Flight &flight);
+
+	mutable concurrency::mutex mu;
+	unordered_map<string, FlightState> flights DUCKDB_GUARDED_BY(mu);
+};
+
+template <typename T>
+T SingleFlight::Do(const string &key, const std::function<T()> &fn) {
+	bool is_leader = false;
+	auto flight = Join(key, is_leader);
+	if (!is_leader) {
+		Wait(*flight);
+		const concurrency::lock_guard<concurrency::mutex> lock(flight->mu);
+		return *std::static_pointer_cast<T>(flight->value);
+	}
+
+	try {
+		T result = fn();
+		// Only copy the result if someone is waiting for it.
+		const auto follower_count = Leave(key);
+		Complete(*flight, follower_count > 0 ? std::make_shared<T>(result) : nullptr, nullptr);
+		return result;
+	} catch (...) {
+		Leave(key);
+		Complete(*flight, nullptr, std::current_exception());
+		throw;
+	}
+}
+
+template <typename T>
+T SingleFlight::DoOrFollow(const string &key, const std::function<T()> &fn, const std::function<T()> &follow_fn) {
+	bool is_leader = false;
+	auto flight = Join(key, is_leader);
+	if (!is_leader) {
+		Wait(*flight);
+		return follow_fn();
+	}
+
+	try {
+		T result = fn();
+		Leave(key);
+		Complete(*flight, nullptr, nullptr);
+		return result;
+	} catch (...) {
+		Leave(key);
+		Complete(*flight, nullptr, std::current_exception());
+		throw;
+	}
+}
+
+} // namespace duckdb
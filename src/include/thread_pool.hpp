@@ -1,10 +1,15 @@
 #pragma once
 
-#include "duckdb/common/queue.hpp"
-#include "duckdb/common/vector.hpp"
+#include "duckdb/common/array.hpp"
+#include "duckdb/common/deque.hpp"
+#include "duckdb/common/shared_ptr.hpp"
+#include "duckdb/common/unique_ptr.hpp"
 #include "mutex.hpp"
+#include "pool_job.hpp"
 #include "thread_annotation.hpp"
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <functional>
 #include <future>
@@ -15,10 +20,92 @@
 
 namespace duckdb {
 
+// Priority class of a job, workers always take queued jobs of a higher class first.
+enum class JobPriority : uint8_t {
+	// Work a caller is waiting for, e.g. the primary attempt of a hedged request.
+	PRIMARY = 0,
+	// Hedged attempts, which shouldn't delay other callers' primary attempts.
+	HEDGE = 1,
+	// Speculative and background work, e.g. open prefetch and read-ahead.
+	HOUSEKEEPING = 2,
+	COUNT
+};
+
+// Get the name of the priority class, e.g. "primary".
+const char *GetJobPriorityName(JobPriority priority);
+
+// Queueing stats of one priority class.
+struct JobQueueStats {
+	// Number of jobs waiting in queues.
+	uint64_t queued_jobs = 0;
+	// Number of jobs taken by workers so far, and their total time spent in queues.
+	uint64_t dequeued_jobs = 0;
+	uint64_t total_wait_us = 0;
+	// Exponentially weighted moving average of queue wait time, which follows recent load.
+	uint64_t recent_wait_us = 0;
+};
+
+// Sibling jobs tied together, e.g. attempts of one hedged request, of which any one would do.
+//
+// Once a worker starts one of them, siblings submitted before that and still queued are skipped at dequeue time;
+// siblings submitted afterwards still run, since they're issued on purpose while a sibling is already running.
+class JobTie {
+public:
+	JobTie() = default;
+
+	JobTie(const JobTie &) = delete;
+	JobTie &operator=(const JobTie &) = delete;
+
+	// Get the number of siblings skipped so far.
+	uint64_t GetSkippedCount() const {
+		return skipped.load(std::memory_order_acquire);
+	}
+	// Get the number of siblings neither started nor skipped yet.
+	uint64_t GetQueuedCount() const {
+		// Load finished counters first, so they never exceed the submitted count.
+		const auto finished = started.load(std::memory_order_acquire) + skipped.load(std::memory_order_acquire);
+		return submitted.load(std::memory_order_acquire) - finished;
+	}
+
+private:
+	friend class ThreadPool;
+
+	// Register a sibling on submission, and return its ordinal.
+	uint64_t Enqueue() {
+		return submitted.fetch_add(1, std::memory_order_acq_rel);
+	}
+	// Called when the sibling of [ordinal] is dequeued, return false if it should be skipped.
+	bool TryStart(uint64_t ordinal);
+
+	std::atomic<uint64_t> submitted {0};
+	// Siblings with ordinals below it were submitted before a sibling started.
+	std::atomic<uint64_t> started_before {0};
+	std::atomic<uint64_t> started {0};
+	std::atomic<uint64_t> skipped {0};
+};
+
+// Elastic thread pool for blocking IO jobs.
+//
+// Each worker owns a job deque; jobs submitted from a worker go to its own deque, other jobs are spread over all
+// deques, and idle workers steal from others, so there's no single lock shared by all submitters and workers. Each
+// deque is split by priority class, and a worker takes the highest class queued anywhere before lower ones. Jobs are
+// expected to block on IO, so a new worker is spawned whenever a job is submitted while no worker is idle, up to the
+// max thread count; workers idle for longer than the idle timeout are retired down to the min thread count. Jobs
+// submitted once the pool is being destroyed, e.g. by jobs still running, run inline on the submitting thread.
 class ThreadPool {
 public:
+	// Move-only, callables capturing up to [PoolJob::INLINE_BYTES] are submitted without allocation.
+	using Job = PoolJob;
+
+	// Upper bound for the max thread count.
+	static constexpr size_t MAX_THREAD_COUNT = 1024;
+	static constexpr std::chrono::milliseconds DEFAULT_IDLE_TIMEOUT = std::chrono::milliseconds(30000);
+
 	ThreadPool();
+	// Fixed-size thread pool.
 	explicit ThreadPool(size_t thread_num);
+	ThreadPool(size_t min_thread_num, size_t max_thread_num,
+	           std::chrono::milliseconds idle_timeout = DEFAULT_IDLE_TIMEOUT);
 
 	ThreadPool(const ThreadPool &) = delete;
 	ThreadPool &operator=(const ThreadPool &) = delete;
@@ -29,33 +116,117 @@ public:
 	template <typename Fn, typename... Args>
 	auto Push(Fn &&fn, Args &&...args) -> std::future<typename std::result_of<Fn(Args...)>::type>;
 
+	// Submit a fire-and-forget job, which avoids the future and packaged task overhead of [Push]. Exception thrown by
+	// the job is swallowed.
+	void Submit(Job job, JobPriority priority = JobPriority::PRIMARY);
+
+	// Submit a fire-and-forget job tied to sibling jobs sharing [tie]; if it's skipped since a sibling started first,
+	// [on_skipped] runs instead of it.
+	void Submit(Job job, JobPriority priority, shared_ptr<JobTie> tie, Job on_skipped);
+
+	// Return whether submitted jobs wait in queues, since all workers are busy and no more worker could be spawned.
+	bool IsSaturated() const;
+
+	// Get the number of jobs waiting in queues, of all priority classes.
+	size_t GetQueuedJobCount() const;
+	// Get queueing stats of the given priority class.
+	JobQueueStats GetQueueStats(JobPriority priority) const;
+
 	// Block until the threadpool is idle (all workers idle and job queue empty).
 	void Wait();
 
+	// Update thread count bound, [min_thread_num] and [max_thread_num] are clamped into [1, MAX_THREAD_COUNT].
+	// Workers beyond the new max count are retired once they become idle.
+	void SetThreadLimits(size_t min_thread_num, size_t max_thread_num);
+
+	size_t GetMinThreadCount() const;
+	size_t GetMaxThreadCount() const;
+	// Get the number of live workers.
+	size_t GetThreadCount() const;
+	// Get the number of workers idle waiting for jobs.
+	size_t GetIdleThreadCount() const;
+	// Return whether the current thread is a worker of this pool.
+	bool IsWorkerThread() const;
+
 private:
-	using Job = std::function<void(void)>;
+	static constexpr size_t PRIORITY_COUNT = static_cast<size_t>(JobPriority::COUNT);
+
+	struct QueuedJob {
+		Job job;
+		JobPriority priority = JobPriority::PRIMARY;
+		std::chrono::steady_clock::time_point enqueue_time;
+		// Set for tied jobs only.
+		shared_ptr<JobTie> tie;
+		uint64_t tie_ordinal = 0;
+		Job on_skipped;
+	};
+
+	struct WorkerSlot {
+		concurrency::mutex mu;
+		// One deque for each priority class.
+		array<deque<QueuedJob>, PRIORITY_COUNT> jobs DUCKDB_GUARDED_BY(mu);
+		// Accessed under pool mutex.
+		std::thread thread;
+		bool running = false;
+	};
+
+	// Push the job into a deque, and wake up or spawn a worker for it.
+	void Enqueue(QueuedJob job);
+	// Run a dequeued job, or its skip callback if a tied sibling started first, and record its completion.
+	void RunJob(QueuedJob &job);
+	// Run the worker loop on the given slot.
+	void WorkerLoop(size_t slot_idx);
+	// Pop a job of the highest priority class from the worker's own deque, or steal one from other deques.
+	bool TryPopJob(size_t slot_idx, QueuedJob &job);
+	// Pop a job of [priority] from the worker's own deque, or steal one from other deques.
+	bool TryPopJob(size_t slot_idx, JobPriority priority, QueuedJob &job);
+	// Record the queue wait time of a dequeued job.
+	void RecordDequeue(const QueuedJob &job);
+	// Spawn a new worker, reusing a slot whose worker has retired.
+	void SpawnWorker() DUCKDB_REQUIRES(mutex_);
+	// Spawn a worker if no one is idle and max thread count is not reached.
+	void MaybeSpawnWorker();
 
-	size_t idle_num_ DUCKDB_GUARDED_BY(mutex_) = 0;
-	bool stopped_ DUCKDB_GUARDED_BY(mutex_) = false;
-	concurrency::mutex mutex_;
+	mutable concurrency::mutex mutex_;
 	std::condition_variable new_job_cv_ DUCKDB_GUARDED_BY(mutex_);
 	std::condition_variable job_completion_cv_ DUCKDB_GUARDED_BY(mutex_);
-	queue<Job> jobs_ DUCKDB_GUARDED_BY(mutex_);
-	vector<std::thread> workers_ DUCKDB_GUARDED_BY(mutex_);
+	// Only set under [mutex_], and loaded without lock on submission.
+	std::atomic<bool> stopped_ {false};
+	const std::chrono::milliseconds idle_timeout_;
+
+	// Thread count and bounds are only updated under [mutex_], atomics allow lock-free check on submission.
+	std::atomic<size_t> min_thread_num_;
+	std::atomic<size_t> max_thread_num_;
+	std::atomic<size_t> thread_num_ {0};
+	std::atomic<size_t> idle_num_ {0};
+
+	// Number of jobs sitting in deques, and number of submitted jobs not finished yet.
+	std::atomic<size_t> queued_jobs_ {0};
+	std::atomic<size_t> unfinished_jobs_ {0};
+	// Queueing stats for each priority class.
+	struct PriorityCounters {
+		std::atomic<size_t> queued_jobs {0};
+		std::atomic<uint64_t> dequeued_jobs {0};
+		std::atomic<uint64_t> total_wait_us {0};
+		std::atomic<uint64_t> recent_wait_us {0};
+	};
+	array<PriorityCounters, PRIORITY_COUNT> priority_counters_;
+	// Round-robin cursor to spread jobs submitted by non-worker threads.
+	std::atomic<size_t> next_slot_ {0};
+
+	// Slots are allocated on demand and never freed before destruction, [slot_num_] publishes allocated slots.
+	array<unique_ptr<WorkerSlot>, MAX_THREAD_COUNT> slots_;
+	std::atomic<size_t> slot_num_ {0};
 };
 
 template <typename Fn, typename... Args>
 auto ThreadPool::Push(Fn &&fn, Args &&...args) -> std::future<typename std::result_of<Fn(Args...)>::type> {
 	using Ret = typename std::result_of<Fn(Args...)>::type;
 
-	auto job =
-	    std::make_shared<std::packaged_task<Ret()>>(std::bind(std::forward<Fn>(fn), std::forward<Args>(args)...));
-	std::future<Ret> result = job->get_future();
-	{
-		const concurrency::lock_guard<concurrency::mutex> lck(mutex_);
-		jobs_.emplace([job = std::move(job)]() mutable { (*job)(); });
-		new_job_cv_.notify_one();
-	}
+	// Jobs are move-only, so the packaged task is submitted as is.
+	std::packaged_task<Ret()> job(std::bind(std::forward<Fn>(fn), std::forward<Args>(args)...));
+	std::future<Ret> result = job.get_future();
+	Submit(std::move(job));
 	return result;
 }
 
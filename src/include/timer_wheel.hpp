@@ -0,0 +1,73 @@
+#pragma once
+
+#include "duckdb/common/array.hpp"
+#include "duckdb/common/typedefs.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "duckdb/common/vector.hpp"
+
+#include <cstdint>
+#include <list>
+
+namespace duckdb {
+
+// Hierarchical timer wheel keyed by tick, as described in "Hashed and Hierarchical Timing Wheels" by Varghese and
+// Lauck.
+//
+// Level 0 has one slot per tick, and every slot of level N covers a full rotation of level N - 1. A timer is placed on
+// the lowest level whose range covers its remaining ticks, and cascades down a level each time the level below wraps,
+// so insertion, removal and expiry are all O(1). Timers beyond the range of the top level are parked in the top level
+// and placed again once they come down. Not thread safe.
+class TimerWheel {
+public:
+	static constexpr idx_t SLOT_BITS = 6;
+	static constexpr idx_t SLOT_COUNT = 1 << SLOT_BITS;
+	static constexpr idx_t LEVEL_COUNT = 4;
+
+	explicit TimerWheel(uint64_t start_tick = 0);
+
+	// Add a timer expiring at [expire_tick], a timer which has already expired fires on the next tick.
+	// [timer_id] must not be registered yet.
+	void Add(uint64_t timer_id, uint64_t expire_tick);
+
+	// Remove a registered timer, return false if it's not registered.
+	bool Remove(uint64_t timer_id);
+
+	// Advance the wheel to [now_tick], and append ids of expired timers into [expired] in expiry order; expired
+	// timers are removed from the wheel.
+	void Advance(uint64_t now_tick, vector<uint64_t> &expired);
+
+	// Get the next tick to advance to, which is either the next expiry or a cascade point before it.
+	// Only meaningful when the wheel is not empty.
+	uint64_t GetNextWakeupTick() const;
+
+	uint64_t GetCurrentTick() const {
+		return current_tick;
+	}
+	idx_t GetTimerCount() const {
+		return timers.size();
+	}
+	bool IsEmpty() const {
+		return timers.empty();
+	}
+
+private:
+	static constexpr uint64_t SLOT_MASK = SLOT_COUNT - 1;
+
+	struct TimerLocation {
+		uint64_t expire_tick = 0;
+		idx_t level = 0;
+		idx_t slot = 0;
+		std::list<uint64_t>::iterator position;
+	};
+
+	// Place a registered timer into the wheel relative to the current tick.
+	void Place(uint64_t timer_id, TimerLocation &location);
+	// Move all timers in the given slot down, relative to the current tick.
+	void Cascade(idx_t level, idx_t slot);
+
+	uint64_t current_tick;
+	array<array<std::list<uint64_t>, SLOT_COUNT>, LEVEL_COUNT> slots;
+	unordered_map<uint64_t, TimerLocation> timers;
+};
+
+} // namespace duckdb
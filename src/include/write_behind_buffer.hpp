@@ -0,0 +1,106 @@
+#pragma once
+
+#include "duckdb/common/deque.hpp"
+#include "duckdb/common/shared_ptr.hpp"
+#include "duckdb/common/unique_ptr.hpp"
+#include "mutex.hpp"
+#include "read_buffer_pool.hpp"
+#include "thread_annotation.hpp"
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+
+namespace duckdb {
+
+// Buffer which accumulates writes into part-sized buffers, and writes full parts in background.
+//
+// Contiguous writes are appended into the current part, which is submitted once it's full or a write doesn't continue
+// it. Parts are written one at a time in submission order, so storages which only accept writes in order (e.g. S3
+// multipart uploads) see the same write sequence as without buffering; only buffering overlaps with the writes. At
+// most [max_outstanding_parts] parts are buffered, and a writer submitting another part blocks until one of them
+// finishes, so buffered memory is bounded by [max_outstanding_parts + 1] parts. Not thread safe, a buffer is owned by
+// the thread writing the file handle.
+class WriteBehindBuffer {
+public:
+	// Receives the failure of a part write, or nullptr on success.
+	using PartCallback = std::function<void(std::exception_ptr eptr)>;
+	// Start writing [nr_bytes] of [part] at [location] in background without blocking, and invoke [on_written] once
+	// the write completes; the next part is only started afterwards. The part stays alive as long as a copy of [part]
+	// is held, and it only counts as finished once all copies are released, so a writer which spawns background
+	// attempts (e.g. hedged writes) should hand a copy to each of them.
+	using PartWriter = std::function<void(shared_ptr<PooledReadBuffer> part, idx_t nr_bytes, idx_t location,
+	                                      PartCallback on_written)>;
+
+	WriteBehindBuffer(PartWriter writer_p, shared_ptr<ReadBufferPool> buffer_pool_p, idx_t part_size_p,
+	                  idx_t max_outstanding_parts_p);
+	// Wait for all submitted parts, buffered data which is not submitted yet is dropped.
+	~WriteBehindBuffer();
+
+	WriteBehindBuffer(const WriteBehindBuffer &) = delete;
+	WriteBehindBuffer &operator=(const WriteBehindBuffer &) = delete;
+
+	// Buffer [nr_bytes] of [buffer] to be written at [location]. Failure of a previously submitted part is rethrown,
+	// after which the buffer keeps failing.
+	void Write(const_data_ptr_t buffer, idx_t nr_bytes, idx_t location);
+
+	// Submit the current part, and block wait until all parts are written; rethrow the first part failure if any.
+	void Flush();
+
+	// Get the number of parts submitted but not finished yet.
+	idx_t GetOutstandingPartCount() const;
+
+private:
+	// Part submitted but not started yet.
+	struct PendingPart {
+		shared_ptr<PooledReadBuffer> part;
+		idx_t nr_bytes;
+		idx_t location;
+	};
+
+	// Completion state shared with part writes.
+	struct PartState {
+		explicit PartState(PartWriter writer_p) : writer(std::move(writer_p)) {
+		}
+
+		const PartWriter writer;
+		concurrency::mutex mu;
+		std::condition_variable cv DUCKDB_GUARDED_BY(mu);
+		idx_t outstanding_parts DUCKDB_GUARDED_BY(mu) = 0;
+		// Parts waiting for the part being written.
+		deque<PendingPart> pending_parts DUCKDB_GUARDED_BY(mu);
+		bool writing DUCKDB_GUARDED_BY(mu) = false;
+		std::exception_ptr eptr DUCKDB_GUARDED_BY(mu);
+	};
+
+	// Submit the current part if it holds any data, after waiting for a free slot.
+	void SubmitCurrentPart();
+	// Block wait until at most [max_parts] parts are outstanding.
+	void WaitForOutstandingParts(idx_t max_parts);
+	// Rethrow the first part failure if any.
+	void ThrowIfFailed();
+	// Start writing [part], which is the only part being written.
+	static void StartPart(const shared_ptr<PartState> &state, PendingPart part);
+	// Record the outcome of the part being written, and start the next pending part if any.
+	static void OnPartWritten(const shared_ptr<PartState> &state, std::exception_ptr eptr);
+
+	const shared_ptr<ReadBufferPool> buffer_pool;
+	const idx_t part_size;
+	const idx_t max_outstanding_parts;
+	const shared_ptr<PartState> state;
+	// Part being filled, which covers [current_location, current_location + current_size).
+	PooledReadBuffer current_part;
+	idx_t current_location = 0;
+	idx_t current_size = 0;
+};
+
+// Per-handle write-behind state, only accessed by the thread writing the handle.
+struct WriteBehindState {
+	// Set once a write is buffered, and dropped after the buffer is flushed.
+	unique_ptr<WriteBehindBuffer> buffer;
+	// Logical position of non-positional writes; once set, the wrapped handle is moved to it after flush.
+	bool has_position = false;
+	idx_t position = 0;
+};
+
+} // namespace duckdb
@@ -0,0 +1,84 @@
+#include "latency_distribution.hpp"
+
+#include "duckdb/common/exception.hpp"
+
+#include <cmath>
+
+namespace duckdb {
+
+LatencyDistribution::LatencyDistribution()
+    : LatencyDistribution(Kind::FIXED, std::chrono::microseconds(0), std::chrono::microseconds(0), /*shape_p=*/0,
+                          /*probability_p=*/0) {
+}
+
+LatencyDistribution::LatencyDistribution(Kind kind_p, std::chrono::microseconds primary_p,
+                                         std::chrono::microseconds secondary_p, double shape_p, double probability_p)
+    : kind(kind_p), primary(primary_p), secondary(secondary_p), shape(shape_p), probability(probability_p) {
+}
+
+LatencyDistribution LatencyDistribution::Fixed(std::chrono::microseconds latency) {
+	if (latency.count() < 0) {
+		throw InvalidInputException("Latency must be non-negative");
+	}
+	return LatencyDistribution(Kind::FIXED, latency, std::chrono::microseconds(0), /*shape_p=*/0,
+	                           /*probability_p=*/0);
+}
+
+LatencyDistribution LatencyDistribution::LogNormal(std::chrono::microseconds median, double sigma) {
+	if (median.count() <= 0 || sigma < 0) {
+		throw InvalidInputException("Lognormal latency needs a positive median and non-negative sigma");
+	}
+	return LatencyDistribution(Kind::LOGNORMAL, median, std::chrono::microseconds(0), sigma, /*probability_p=*/0);
+}
+
+LatencyDistribution LatencyDistribution::Bimodal(std::chrono::microseconds fast_median,
+                                                 std::chrono::microseconds slow_median, double slow_probability,
+                                                 double sigma) {
+	if (fast_median.count() <= 0 || slow_median.count() <= 0 || sigma < 0) {
+		throw InvalidInputException("Bimodal latency needs positive medians and non-negative sigma");
+	}
+	if (slow_probability < 0 || slow_probability > 1) {
+		throw InvalidInputException("Slow probability must be within [0, 1]");
+	}
+	return LatencyDistribution(Kind::BIMODAL, fast_median, slow_median, sigma, slow_probability);
+}
+
+LatencyDistribution LatencyDistribution::Pareto(std::chrono::microseconds scale, double shape,
+                                                std::chrono::microseconds max) {
+	if (scale.count() <= 0 || shape <= 0 || max < scale) {
+		throw InvalidInputException("Pareto latency needs a positive scale and shape, and a cap of at least scale");
+	}
+	return LatencyDistribution(Kind::PARETO, scale, max, shape, /*probability_p=*/0);
+}
+
+std::chrono::microseconds LatencyDistribution::Sample(std::mt19937_64 &rng) const {
+	switch (kind) {
+	case Kind::FIXED:
+		return primary;
+	case Kind::LOGNORMAL:
+		return SampleLogNormal(rng, primary);
+	case Kind::BIMODAL: {
+		std::bernoulli_distribution is_slow(probability);
+		return SampleLogNormal(rng, is_slow(rng) ? secondary : primary);
+	}
+	case Kind::PARETO: {
+		// Inverse transform sampling, uniform within (0, 1] so the sample is finite.
+		std::uniform_real_distribution<double> uniform(0.0, 1.0);
+		const double sample_us = static_cast<double>(primary.count()) / std::pow(1.0 - uniform(rng), 1.0 / shape);
+		if (sample_us >= static_cast<double>(secondary.count())) {
+			return secondary;
+		}
+		return std::chrono::microseconds(static_cast<int64_t>(sample_us));
+	}
+	default:
+		throw InternalException("Unknown latency distribution kind");
+	}
+}
+
+std::chrono::microseconds LatencyDistribution::SampleLogNormal(std::mt19937_64 &rng,
+                                                               std::chrono::microseconds median) const {
+	std::lognormal_distribution<double> lognormal(std::log(static_cast<double>(median.count())), shape);
+	return std::chrono::microseconds(static_cast<int64_t>(lognormal(rng)));
+}
+
+} // namespace duckdb
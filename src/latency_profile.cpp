@@ -0,0 +1,171 @@
+#include "latency_profile.hpp"
+
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/numeric_utils.hpp"
+#include "duckdb/common/vector.hpp"
+#include "hedging_policy.hpp"
+
+#include <utility>
+
+namespace duckdb {
+
+namespace {
+
+constexpr size_t OPERATION_COUNT = static_cast<size_t>(HedgedRequestOperation::COUNT);
+
+void WriteVarint(string &out, uint64_t value) {
+	while (value >= 0x80) {
+		out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+		value >>= 7;
+	}
+	out.push_back(static_cast<char>(value));
+}
+
+// Sequential reader over profile bytes, which throws on truncated or malformed input.
+class ProfileReader {
+public:
+	explicit ProfileReader(const string &data_p) : data(data_p) {
+	}
+
+	uint64_t ReadVarint() {
+		uint64_t value = 0;
+		for (idx_t shift = 0; shift < 64; shift += 7) {
+			if (offset >= data.size()) {
+				throw InvalidInputException("Truncated latency profile");
+			}
+			const auto byte = static_cast<uint8_t>(data[offset++]);
+			value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+			if ((byte & 0x80) == 0) {
+				return value;
+			}
+		}
+		throw InvalidInputException("Malformed varint in latency profile");
+	}
+
+	string ReadString() {
+		const auto length = ReadVarint();
+		if (length > data.size() - offset) {
+			throw InvalidInputException("Truncated latency profile");
+		}
+		string value = data.substr(offset, NumericCast<size_t>(length));
+		offset += NumericCast<idx_t>(length);
+		return value;
+	}
+
+	bool AtEnd() const {
+		return offset == data.size();
+	}
+
+private:
+	const string &data;
+	idx_t offset = 0;
+};
+
+// Get the operation with the given name, return false if the name is unknown.
+bool TryGetOperation(const string &name, HedgedRequestOperation &operation) {
+	for (size_t idx = 0; idx < OPERATION_COUNT; ++idx) {
+		const auto cur_operation = static_cast<HedgedRequestOperation>(idx);
+		if (GetHedgedRequestOperationName(cur_operation) == name) {
+			operation = cur_operation;
+			return true;
+		}
+	}
+	return false;
+}
+
+} // namespace
+
+string SerializeLatencyProfile(const LatencyTracker &tracker) {
+	string out;
+	WriteVarint(out, LATENCY_PROFILE_MAGIC);
+	WriteVarint(out, LATENCY_PROFILE_VERSION);
+	WriteVarint(out, LatencySketch::SUB_BUCKET_BITS);
+	WriteVarint(out, OPERATION_COUNT);
+	for (size_t idx = 0; idx < OPERATION_COUNT; ++idx) {
+		const auto operation = static_cast<HedgedRequestOperation>(idx);
+		const auto name = GetHedgedRequestOperationName(operation);
+		WriteVarint(out, name.size());
+		out.append(name);
+
+		const auto counts = tracker.GetSketch(operation).GetBucketCounts();
+		uint64_t non_empty_buckets = 0;
+		for (auto count : counts) {
+			non_empty_buckets += count != 0;
+		}
+		WriteVarint(out, non_empty_buckets);
+		idx_t prev_bucket = 0;
+		for (idx_t bucket = 0; bucket < counts.size(); ++bucket) {
+			if (counts[bucket] == 0) {
+				continue;
+			}
+			WriteVarint(out, bucket - prev_bucket);
+			WriteVarint(out, counts[bucket]);
+			prev_bucket = bucket;
+		}
+	}
+	return out;
+}
+
+void DeserializeLatencyProfile(const string &data, LatencyTracker &tracker) {
+	ProfileReader reader(data);
+	if (reader.ReadVarint() != LATENCY_PROFILE_MAGIC) {
+		throw InvalidInputException("Not a latency profile");
+	}
+	const auto version = reader.ReadVarint();
+	if (version != LATENCY_PROFILE_VERSION) {
+		throw InvalidInputException("Unsupported latency profile version %llu, expected %llu", version,
+		                            LATENCY_PROFILE_VERSION);
+	}
+	const auto sub_bucket_bits = reader.ReadVarint();
+	if (sub_bucket_bits != LatencySketch::SUB_BUCKET_BITS) {
+		throw InvalidInputException("Latency profile has %llu sub-bucket bits, expected %llu", sub_bucket_bits,
+		                            LatencySketch::SUB_BUCKET_BITS);
+	}
+
+	// Parse the whole profile first, so a malformed profile doesn't leave sketches partially replaced.
+	vector<std::pair<HedgedRequestOperation, array<uint64_t, LatencySketch::BUCKET_COUNT>>> sketches;
+	const auto operation_count = reader.ReadVarint();
+	for (uint64_t op_idx = 0; op_idx < operation_count; ++op_idx) {
+		const auto name = reader.ReadString();
+		array<uint64_t, LatencySketch::BUCKET_COUNT> counts {};
+		const auto non_empty_buckets = reader.ReadVarint();
+		uint64_t bucket = 0;
+		for (uint64_t bucket_idx = 0; bucket_idx < non_empty_buckets; ++bucket_idx) {
+			const auto delta = reader.ReadVarint();
+			if (delta >= LatencySketch::BUCKET_COUNT - bucket || (bucket_idx > 0 && delta == 0)) {
+				throw InvalidInputException("Invalid bucket index in latency profile for operation '%s'", name);
+			}
+			bucket += delta;
+			counts[NumericCast<idx_t>(bucket)] = reader.ReadVarint();
+		}
+
+		HedgedRequestOperation operation;
+		if (TryGetOperation(name, operation)) {
+			sketches.emplace_back(operation, counts);
+		}
+	}
+	if (!reader.AtEnd()) {
+		throw InvalidInputException("Unexpected trailing bytes in latency profile");
+	}
+
+	for (const auto &cur_sketch : sketches) {
+		tracker.GetSketch(cur_sketch.first).SetBucketCounts(cur_sketch.second);
+	}
+}
+
+void SaveLatencyProfile(FileSystem &fs, const string &path, const LatencyTracker &tracker) {
+	auto data = SerializeLatencyProfile(tracker);
+	auto handle = fs.OpenFile(path, FileFlags::FILE_FLAGS_WRITE | FileFlags::FILE_FLAGS_FILE_CREATE_NEW);
+	fs.Write(*handle, const_cast<char *>(data.data()), NumericCast<int64_t>(data.size()), /*location=*/0);
+	handle->Close();
+}
+
+void LoadLatencyProfile(FileSystem &fs, const string &path, LatencyTracker &tracker) {
+	auto handle = fs.OpenFile(path, FileFlags::FILE_FLAGS_READ);
+	const auto file_size = fs.GetFileSize(*handle);
+	string data(NumericCast<size_t>(file_size), '\0');
+	fs.Read(*handle, const_cast<char *>(data.data()), file_size, /*location=*/0);
+	DeserializeLatencyProfile(data, tracker);
+}
+
+} // namespace duckdb
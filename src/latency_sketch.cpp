@@ -0,0 +1,165 @@
+#include "latency_sketch.hpp"
+
+#include "duckdb/common/numeric_utils.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace duckdb {
+
+namespace {
+// Get the index of the most significant bit, [value] must be non-zero.
+idx_t MostSignificantBit(uint64_t value) {
+	idx_t msb = 0;
+	while (value >>= 1) {
+		++msb;
+	}
+	return msb;
+}
+
+// Sum up bucket counts, saturating at UINT64_MAX.
+template <typename Counts>
+uint64_t SaturatingSum(const Counts &counts) {
+	uint64_t total = 0;
+	for (auto count : counts) {
+		total = count > UINT64_MAX - total ? UINT64_MAX : total + count;
+	}
+	return total;
+}
+} // namespace
+
+//===--------------------------------------------------------------------===//
+// LatencySketch
+//===--------------------------------------------------------------------===//
+
+LatencySketch::LatencySketch() : sample_count(0) {
+	for (auto &bucket : buckets) {
+		bucket.store(0, std::memory_order_relaxed);
+	}
+}
+
+idx_t LatencySketch::GetBucketIndex(uint64_t value) {
+	// Values smaller than sub-bucket count get an exact bucket.
+	if (value < SUB_BUCKET_COUNT) {
+		return NumericCast<idx_t>(value);
+	}
+	const auto msb = MostSignificantBit(value);
+	const auto shift = msb - SUB_BUCKET_BITS;
+	const auto sub_bucket = (value >> shift) & (SUB_BUCKET_COUNT - 1);
+	return (shift + 1) * SUB_BUCKET_COUNT + sub_bucket;
+}
+
+uint64_t LatencySketch::GetBucketUpperBound(idx_t index) {
+	if (index < SUB_BUCKET_COUNT) {
+		return index;
+	}
+	const auto shift = index / SUB_BUCKET_COUNT - 1;
+	const auto sub_bucket = index % SUB_BUCKET_COUNT;
+	// Saturate for the last power-of-two range, whose upper bound doesn't fit into 64 bits.
+	if (shift + SUB_BUCKET_BITS >= 63) {
+		return UINT64_MAX;
+	}
+	const uint64_t lower_bound = (SUB_BUCKET_COUNT + sub_bucket) << shift;
+	return lower_bound + (uint64_t(1) << shift) - 1;
+}
+
+void LatencySketch::Record(std::chrono::microseconds latency) {
+	const auto value = latency.count() < 0 ? uint64_t(0) : NumericCast<uint64_t>(latency.count());
+	buckets[GetBucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+	if (sample_count.fetch_add(1, std::memory_order_relaxed) + 1 >= DECAY_SAMPLE_COUNT) {
+		Decay();
+	}
+}
+
+void LatencySketch::Decay() {
+	// Only one thread decays at a time, concurrent recorders simply skip.
+	concurrency::unique_lock<concurrency::mutex> lock(decay_mutex, std::try_to_lock);
+	if (!lock.owns_lock()) {
+		return;
+	}
+	if (sample_count.load(std::memory_order_relaxed) < DECAY_SAMPLE_COUNT) {
+		return;
+	}
+	// Samples recorded concurrently with decay might be halved or not, which is fine for an approximation.
+	uint64_t remaining = 0;
+	for (auto &bucket : buckets) {
+		const auto halved = bucket.load(std::memory_order_relaxed) / 2;
+		bucket.store(halved, std::memory_order_relaxed);
+		remaining += halved;
+	}
+	sample_count.store(remaining, std::memory_order_relaxed);
+}
+
+std::chrono::microseconds LatencySketch::GetQuantile(double quantile) const {
+	array<uint64_t, BUCKET_COUNT> snapshot;
+	uint64_t total = 0;
+	for (idx_t idx = 0; idx < BUCKET_COUNT; ++idx) {
+		snapshot[idx] = buckets[idx].load(std::memory_order_relaxed);
+		total += snapshot[idx];
+	}
+	if (total == 0) {
+		return std::chrono::microseconds(0);
+	}
+
+	const double clamped_quantile = std::min(std::max(quantile, 0.0), 1.0);
+	const auto target = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(clamped_quantile * total)));
+	idx_t bucket_idx = 0;
+	uint64_t cumulative = 0;
+	for (; bucket_idx < BUCKET_COUNT - 1; ++bucket_idx) {
+		cumulative += snapshot[bucket_idx];
+		if (cumulative >= target) {
+			break;
+		}
+	}
+	const auto upper_bound = std::min<uint64_t>(GetBucketUpperBound(bucket_idx), INT64_MAX);
+	return std::chrono::microseconds(NumericCast<int64_t>(upper_bound));
+}
+
+uint64_t LatencySketch::GetSampleCount() const {
+	return sample_count.load(std::memory_order_relaxed);
+}
+
+array<uint64_t, LatencySketch::BUCKET_COUNT> LatencySketch::GetBucketCounts() const {
+	array<uint64_t, BUCKET_COUNT> counts;
+	for (idx_t idx = 0; idx < BUCKET_COUNT; ++idx) {
+		counts[idx] = buckets[idx].load(std::memory_order_relaxed);
+	}
+	return counts;
+}
+
+void LatencySketch::SetBucketCounts(const array<uint64_t, BUCKET_COUNT> &counts) {
+	auto decayed_counts = counts;
+	uint64_t total = SaturatingSum(decayed_counts);
+	while (total >= DECAY_SAMPLE_COUNT) {
+		for (auto &count : decayed_counts) {
+			count /= 2;
+		}
+		total = SaturatingSum(decayed_counts);
+	}
+
+	const concurrency::lock_guard<concurrency::mutex> lock(decay_mutex);
+	for (idx_t idx = 0; idx < BUCKET_COUNT; ++idx) {
+		buckets[idx].store(decayed_counts[idx], std::memory_order_relaxed);
+	}
+	sample_count.store(total, std::memory_order_relaxed);
+}
+
+void LatencySketch::Reset() {
+	const concurrency::lock_guard<concurrency::mutex> lock(decay_mutex);
+	for (auto &bucket : buckets) {
+		bucket.store(0, std::memory_order_relaxed);
+	}
+	sample_count.store(0, std::memory_order_relaxed);
+}
+
+//===--------------------------------------------------------------------===//
+// LatencyTracker
+//===--------------------------------------------------------------------===//
+
+void LatencyTracker::Reset() {
+	for (auto &sketch : sketches) {
+		sketch.Reset();
+	}
+}
+
+} // namespace duckdb
@@ -0,0 +1,222 @@
+#include "listing_cache.hpp"
+
+#include "hedged_request_config.hpp"
+
+namespace duckdb {
+
+namespace {
+
+// Rough per-listing overhead for trie node, map node and LRU node, and per-entry overhead in the listing.
+constexpr idx_t LISTING_OVERHEAD_BYTES = 256;
+constexpr idx_t ENTRY_OVERHEAD_BYTES = sizeof(std::pair<string, bool>);
+
+} // namespace
+
+ListingCache::ListingCache()
+    : enabled(DEFAULT_ENABLE_LISTING_CACHE), ttl_ms(DEFAULT_LISTING_CACHE_TTL_MS),
+      max_bytes(DEFAULT_LISTING_CACHE_MAX_BYTES) {
+}
+
+optional_idx ListingCache::GetEstimatedCacheMemory() const {
+	// Listing cache keeps its own memory bound, and holds settings which cannot be lost on eviction.
+	return optional_idx {};
+}
+
+void ListingCache::SetEnabled(bool enable) {
+	enabled.store(enable, std::memory_order_relaxed);
+	if (!enable) {
+		InvalidatePrefix("");
+	}
+}
+
+void ListingCache::SetTtl(std::chrono::milliseconds ttl_p) {
+	ttl_ms.store(ttl_p.count(), std::memory_order_relaxed);
+}
+
+void ListingCache::SetMaxBytes(idx_t max_bytes_p) {
+	max_bytes.store(max_bytes_p, std::memory_order_relaxed);
+	const concurrency::lock_guard<concurrency::mutex> lock(mu);
+	EvictToLimit();
+}
+
+vector<string> ListingCache::SplitPath(const string &path) {
+	vector<string> components;
+	idx_t begin = 0;
+	while (begin <= path.size()) {
+		auto end = path.find('/', begin);
+		if (end == string::npos) {
+			end = path.size();
+		}
+		components.emplace_back(path.substr(begin, end - begin));
+		begin = end + 1;
+	}
+	while (!components.empty() && components.back().empty()) {
+		components.pop_back();
+	}
+	return components;
+}
+
+idx_t ListingCache::EstimateBytes(const string &directory, const Listing &listing) {
+	idx_t estimated_bytes = sizeof(Node) + LISTING_OVERHEAD_BYTES + 2 * directory.size();
+	for (const auto &cur_entry : listing) {
+		estimated_bytes += ENTRY_OVERHEAD_BYTES + cur_entry.first.size();
+	}
+	return estimated_bytes;
+}
+
+ListingCache::Node *ListingCache::FindNode(const string &path) {
+	auto *node = &root;
+	for (const auto &cur_component : SplitPath(path)) {
+		auto iter = node->children.find(cur_component);
+		if (iter == node->children.end()) {
+			return nullptr;
+		}
+		node = iter->second.get();
+	}
+	return node;
+}
+
+ListingCache::Node &ListingCache::GetOrCreateNode(const string &path) {
+	auto *node = &root;
+	for (auto &cur_component : SplitPath(path)) {
+		auto &child = node->children[cur_component];
+		if (child == nullptr) {
+			child = make_uniq<Node>();
+			child->parent = node;
+			child->name = std::move(cur_component);
+		}
+		node = child.get();
+	}
+	return *node;
+}
+
+bool ListingCache::TryGetListing(const string &directory, Listing &listing) {
+	if (!IsEnabled()) {
+		return false;
+	}
+	const concurrency::lock_guard<concurrency::mutex> lock(mu);
+	auto *node = FindNode(directory);
+	if (node == nullptr || !node->has_listing) {
+		return false;
+	}
+	if (node->expire_at <= std::chrono::steady_clock::now()) {
+		DropListing(*node);
+		Prune(node);
+		return false;
+	}
+	listing = node->listing;
+	lru.splice(lru.begin(), lru, node->lru_pos);
+	return true;
+}
+
+void ListingCache::PutListing(const string &directory, Listing listing) {
+	if (!IsEnabled()) {
+		return;
+	}
+	const auto expire_at =
+	    std::chrono::steady_clock::now() + std::chrono::milliseconds(ttl_ms.load(std::memory_order_relaxed));
+	const auto estimated_bytes = EstimateBytes(directory, listing);
+	const concurrency::lock_guard<concurrency::mutex> lock(mu);
+	if (estimated_bytes > max_bytes.load(std::memory_order_relaxed)) {
+		// Don't keep an older listing of the directory either.
+		auto *node = FindNode(directory);
+		if (node != nullptr && node->has_listing) {
+			DropListing(*node);
+			Prune(node);
+		}
+		return;
+	}
+	auto &node = GetOrCreateNode(directory);
+	if (node.has_listing) {
+		cached_bytes -= node.estimated_bytes;
+		lru.splice(lru.begin(), lru, node.lru_pos);
+	} else {
+		lru.emplace_front(&node);
+		node.lru_pos = lru.begin();
+		node.has_listing = true;
+	}
+	node.directory = directory;
+	node.listing = std::move(listing);
+	node.expire_at = expire_at;
+	node.estimated_bytes = estimated_bytes;
+	cached_bytes += estimated_bytes;
+	EvictToLimit();
+}
+
+void ListingCache::Invalidate(const string &path) {
+	const concurrency::lock_guard<concurrency::mutex> lock(mu);
+	auto *node = &root;
+	for (const auto &cur_component : SplitPath(path)) {
+		DropListing(*node);
+		auto iter = node->children.find(cur_component);
+		if (iter == node->children.end()) {
+			Prune(node);
+			return;
+		}
+		node = iter->second.get();
+	}
+	DropSubtree(*node);
+	Prune(node);
+}
+
+void ListingCache::InvalidatePrefix(const string &prefix) {
+	const concurrency::lock_guard<concurrency::mutex> lock(mu);
+	for (auto iter = lru.begin(); iter != lru.end();) {
+		auto *node = *iter++;
+		if (node->directory.compare(0, prefix.size(), prefix) == 0) {
+			DropListing(*node);
+			Prune(node);
+		}
+	}
+}
+
+idx_t ListingCache::GetCachedBytes() const {
+	const concurrency::lock_guard<concurrency::mutex> lock(mu);
+	return cached_bytes;
+}
+
+idx_t ListingCache::GetListingCount() const {
+	const concurrency::lock_guard<concurrency::mutex> lock(mu);
+	return lru.size();
+}
+
+void ListingCache::DropListing(Node &node) {
+	if (!node.has_listing) {
+		return;
+	}
+	cached_bytes -= node.estimated_bytes;
+	lru.erase(node.lru_pos);
+	node.has_listing = false;
+	node.estimated_bytes = 0;
+	Listing {}.swap(node.listing);
+	string {}.swap(node.directory);
+}
+
+void ListingCache::DropSubtree(Node &node) {
+	DropListing(node);
+	for (auto &cur_child : node.children) {
+		DropSubtree(*cur_child.second);
+	}
+	node.children.clear();
+}
+
+void ListingCache::Prune(Node *node) {
+	while (node != &root && !node->has_listing && node->children.empty()) {
+		auto *parent = node->parent;
+		// Copied since erasing destroys [node].
+		const auto name = node->name;
+		parent->children.erase(name);
+		node = parent;
+	}
+}
+
+void ListingCache::EvictToLimit() {
+	const auto limit = max_bytes.load(std::memory_order_relaxed);
+	while (cached_bytes > limit && !lru.empty()) {
+		auto *node = lru.back();
+		DropListing(*node);
+		Prune(node);
+	}
+}
+
+} // namespace duckdb
@@ -0,0 +1,241 @@
+#include "metadata_cache.hpp"
+
+#include "duckdb/common/numeric_utils.hpp"
+#include "hedged_request_config.hpp"
+
+#include <functional>
+
+namespace duckdb {
+
+namespace {
+
+// Rough per-entry overhead for list node, hash map node and the index key.
+constexpr idx_t ENTRY_OVERHEAD_BYTES = 128;
+
+} // namespace
+
+constexpr idx_t MetadataCache::SHARD_COUNT;
+
+MetadataCache::MetadataCache()
+    : enabled(DEFAULT_ENABLE_METADATA_CACHE), ttl_ms(DEFAULT_METADATA_CACHE_TTL_MS),
+      max_bytes(DEFAULT_METADATA_CACHE_MAX_BYTES) {
+}
+
+optional_idx MetadataCache::GetEstimatedCacheMemory() const {
+	// Metadata cache keeps its own memory bound, and holds settings which cannot be lost on eviction.
+	return optional_idx {};
+}
+
+void MetadataCache::SetEnabled(bool enable) {
+	enabled.store(enable, std::memory_order_relaxed);
+	if (!enable) {
+		InvalidatePrefix("");
+	}
+}
+
+void MetadataCache::SetTtl(std::chrono::milliseconds ttl_p) {
+	ttl_ms.store(ttl_p.count(), std::memory_order_relaxed);
+}
+
+void MetadataCache::SetMaxBytes(idx_t max_bytes_p) {
+	max_bytes.store(max_bytes_p, std::memory_order_relaxed);
+	for (auto &shard : shards) {
+		const concurrency::lock_guard<concurrency::mutex> lock(shard.mu);
+		EvictToLimit(shard);
+	}
+}
+
+MetadataCache::Shard &MetadataCache::GetShard(const string &path) {
+	return shards[std::hash<string> {}(path) % SHARD_COUNT];
+}
+
+idx_t MetadataCache::GetShardMaxBytes() const {
+	return max_bytes.load(std::memory_order_relaxed) / SHARD_COUNT;
+}
+
+template <typename T>
+bool MetadataCache::TryGetField(const string &path, CachedField<T> Entry::*field, T &value) {
+	if (!IsEnabled()) {
+		return false;
+	}
+	auto &shard = GetShard(path);
+	const concurrency::lock_guard<concurrency::mutex> lock(shard.mu);
+	auto iter = shard.index.find(path);
+	if (iter == shard.index.end()) {
+		return false;
+	}
+	auto &cached_field = (*iter->second).*field;
+	if (!cached_field.valid) {
+		return false;
+	}
+	if (cached_field.expire_at <= std::chrono::steady_clock::now()) {
+		cached_field.valid = false;
+		return false;
+	}
+	value = cached_field.value;
+	shard.lru.splice(shard.lru.begin(), shard.lru, iter->second);
+	return true;
+}
+
+template <typename T>
+void MetadataCache::PutField(const string &path, CachedField<T> Entry::*field, const T &value) {
+	if (!IsEnabled()) {
+		return;
+	}
+	const auto expire_at =
+	    std::chrono::steady_clock::now() + std::chrono::milliseconds(ttl_ms.load(std::memory_order_relaxed));
+	auto &shard = GetShard(path);
+	const concurrency::lock_guard<concurrency::mutex> lock(shard.mu);
+	auto iter = shard.index.find(path);
+	if (iter == shard.index.end()) {
+		shard.lru.emplace_front();
+		shard.lru.front().path = path;
+		iter = shard.index.emplace(path, shard.lru.begin()).first;
+	} else {
+		shard.lru.splice(shard.lru.begin(), shard.lru, iter->second);
+	}
+	auto &entry = *iter->second;
+	auto &cached_field = entry.*field;
+	cached_field.valid = true;
+	cached_field.value = value;
+	cached_field.expire_at = expire_at;
+	UpdateEstimatedBytes(shard, entry);
+	EvictToLimit(shard);
+}
+
+bool MetadataCache::TryGetFileExists(const string &path, bool &file_exists) {
+	return TryGetField(path, &Entry::file_exists, file_exists);
+}
+
+bool MetadataCache::TryGetFileSize(const string &path, int64_t &file_size) {
+	return TryGetField(path, &Entry::file_size, file_size);
+}
+
+bool MetadataCache::TryGetLastModifiedTime(const string &path, timestamp_t &last_modified_time) {
+	return TryGetField(path, &Entry::last_modified_time, last_modified_time);
+}
+
+bool MetadataCache::TryGetStats(const string &path, FileMetadata &stats) {
+	return TryGetField(path, &Entry::stats, stats);
+}
+
+void MetadataCache::PutFileExists(const string &path, bool file_exists) {
+	PutField(path, &Entry::file_exists, file_exists);
+}
+
+void MetadataCache::PutFileSize(const string &path, int64_t file_size) {
+	PutField(path, &Entry::file_size, file_size);
+}
+
+void MetadataCache::PutLastModifiedTime(const string &path, timestamp_t last_modified_time) {
+	PutField(path, &Entry::last_modified_time, last_modified_time);
+}
+
+void MetadataCache::PutStats(const string &path, const FileMetadata &stats) {
+	PutField(path, &Entry::stats, stats);
+}
+
+void MetadataCache::PutVersionTag(const string &path, const string &version_tag) {
+	if (!IsEnabled() || version_tag.empty()) {
+		return;
+	}
+	auto &shard = GetShard(path);
+	const concurrency::lock_guard<concurrency::mutex> lock(shard.mu);
+	auto iter = shard.index.find(path);
+	if (iter == shard.index.end()) {
+		return;
+	}
+	auto &entry = *iter->second;
+	if (entry.version_tag == version_tag) {
+		return;
+	}
+	// Object has been overwritten since metadata was cached, if version tag was known before.
+	if (!entry.version_tag.empty()) {
+		entry.file_exists.valid = false;
+		entry.file_size.valid = false;
+		entry.last_modified_time.valid = false;
+		entry.stats.valid = false;
+	}
+	entry.version_tag = version_tag;
+	UpdateEstimatedBytes(shard, entry);
+	EvictToLimit(shard);
+}
+
+bool MetadataCache::TryGetVersionTag(const string &path, string &version_tag) {
+	if (!IsEnabled()) {
+		return false;
+	}
+	auto &shard = GetShard(path);
+	const concurrency::lock_guard<concurrency::mutex> lock(shard.mu);
+	auto iter = shard.index.find(path);
+	if (iter == shard.index.end() || iter->second->version_tag.empty()) {
+		return false;
+	}
+	version_tag = iter->second->version_tag;
+	return true;
+}
+
+void MetadataCache::Invalidate(const string &path) {
+	auto &shard = GetShard(path);
+	const concurrency::lock_guard<concurrency::mutex> lock(shard.mu);
+	auto iter = shard.index.find(path);
+	if (iter != shard.index.end()) {
+		EraseEntry(shard, iter->second);
+	}
+}
+
+void MetadataCache::InvalidatePrefix(const string &prefix) {
+	for (auto &shard : shards) {
+		const concurrency::lock_guard<concurrency::mutex> lock(shard.mu);
+		for (auto iter = shard.lru.begin(); iter != shard.lru.end();) {
+			auto cur = iter++;
+			if (cur->path.compare(0, prefix.size(), prefix) == 0) {
+				EraseEntry(shard, cur);
+			}
+		}
+	}
+}
+
+idx_t MetadataCache::GetCachedBytes() const {
+	idx_t total_bytes = 0;
+	for (const auto &shard : shards) {
+		const concurrency::lock_guard<concurrency::mutex> lock(shard.mu);
+		total_bytes += shard.cached_bytes;
+	}
+	return total_bytes;
+}
+
+idx_t MetadataCache::GetEntryCount() const {
+	idx_t entry_count = 0;
+	for (const auto &shard : shards) {
+		const concurrency::lock_guard<concurrency::mutex> lock(shard.mu);
+		entry_count += shard.index.size();
+	}
+	return entry_count;
+}
+
+void MetadataCache::EraseEntry(Shard &shard, EntryList::iterator iter) {
+	shard.cached_bytes -= iter->estimated_bytes;
+	shard.index.erase(iter->path);
+	shard.lru.erase(iter);
+}
+
+void MetadataCache::UpdateEstimatedBytes(Shard &shard, Entry &entry) {
+	idx_t estimated_bytes = sizeof(Entry) + ENTRY_OVERHEAD_BYTES + 2 * entry.path.size() + entry.version_tag.size();
+	if (entry.stats.valid) {
+		for (const auto &cur_info : entry.stats.value.extended_info) {
+			estimated_bytes += ENTRY_OVERHEAD_BYTES + cur_info.first.size();
+		}
+	}
+	shard.cached_bytes = shard.cached_bytes - entry.estimated_bytes + estimated_bytes;
+	entry.estimated_bytes = estimated_bytes;
+}
+
+void MetadataCache::EvictToLimit(Shard &shard) {
+	const auto shard_max_bytes = GetShardMaxBytes();
+	while (shard.cached_bytes > shard_max_bytes && !shard.lru.empty()) {
+		EraseEntry(shard, std::prev(shard.lru.end()));
+	}
+}
+
+} // namespace duckdb
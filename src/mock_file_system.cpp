@@ -1,6 +1,8 @@
 #include "mock_file_system.hpp"
 
+#include "cancellation_token.hpp"
 #include "duckdb/common/exception.hpp"
+#include "duckdb/common/string_util.hpp"
 
 #include <thread>
 
@@ -19,80 +21,121 @@ void MockFileSystem::SetSkipSimulatedIoFailureCalls(int count) {
 	skip_simulated_io_failure_calls = count;
 }
 
+void MockFileSystem::SetTransientIoFailureCount(int count) {
+	const concurrency::lock_guard<concurrency::mutex> lock(delay_mutex);
+	transient_io_failure_count = count;
+}
+
 void MockFileSystem::SetDelay(std::chrono::milliseconds delay_p) {
 	const concurrency::lock_guard<concurrency::mutex> lock(delay_mutex);
 	delay = delay_p;
 }
 
+void MockFileSystem::SetLatencyDistribution(HedgedRequestOperation operation, LatencyDistribution distribution) {
+	const concurrency::lock_guard<concurrency::mutex> lock(delay_mutex);
+	latency_distributions[static_cast<idx_t>(operation)] = distribution;
+}
+
+void MockFileSystem::SetPathDelay(const string &path_prefix, std::chrono::milliseconds path_delay) {
+	const concurrency::lock_guard<concurrency::mutex> lock(delay_mutex);
+	for (auto &cur_path_delay : path_delays) {
+		if (cur_path_delay.first == path_prefix) {
+			cur_path_delay.second = path_delay;
+			return;
+		}
+	}
+	path_delays.emplace_back(path_prefix, path_delay);
+}
+
+void MockFileSystem::SetSeed(uint64_t seed) {
+	const concurrency::lock_guard<concurrency::mutex> lock(delay_mutex);
+	rng.seed(seed);
+}
+
+uint64_t MockFileSystem::GetIoOperationCount() const {
+	const concurrency::lock_guard<concurrency::mutex> lock(delay_mutex);
+	return io_operation_count;
+}
+
 string MockFileSystem::GetName() const {
 	return "MockFileSystem";
 }
 
 unique_ptr<FileHandle> MockFileSystem::OpenFile(const string &path, FileOpenFlags flags,
                                                 optional_ptr<FileOpener> opener) {
-	SimulateDelay();
+	SimulateDelay(HedgedRequestOperation::OPEN_FILE, path);
 	return LocalFileSystem::OpenFile(path, flags, opener);
 }
 
+void MockFileSystem::Read(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location) {
+	SimulateDelay(HedgedRequestOperation::READ);
+	LocalFileSystem::Read(handle, buffer, nr_bytes, location);
+}
+
+void MockFileSystem::Write(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location) {
+	SimulateDelay(HedgedRequestOperation::WRITE);
+	LocalFileSystem::Write(handle, buffer, nr_bytes, location);
+}
+
 int64_t MockFileSystem::GetFileSize(FileHandle &handle) {
-	SimulateDelay();
+	SimulateDelay(HedgedRequestOperation::GET_FILE_SIZE);
 	return LocalFileSystem::GetFileSize(handle);
 }
 
 timestamp_t MockFileSystem::GetLastModifiedTime(FileHandle &handle) {
-	SimulateDelay();
+	SimulateDelay(HedgedRequestOperation::GET_LAST_MODIFIED_TIME);
 	return LocalFileSystem::GetLastModifiedTime(handle);
 }
 
 string MockFileSystem::GetVersionTag(FileHandle &handle) {
-	SimulateDelay();
+	SimulateDelay(HedgedRequestOperation::GET_VERSION_TAG);
 	return LocalFileSystem::GetVersionTag(handle);
 }
 
 FileType MockFileSystem::GetFileType(FileHandle &handle) {
-	SimulateDelay();
+	SimulateDelay(HedgedRequestOperation::GET_FILE_TYPE);
 	return LocalFileSystem::GetFileType(handle);
 }
 
 bool MockFileSystem::DirectoryExists(const string &directory, optional_ptr<FileOpener> opener) {
-	SimulateDelay();
+	SimulateDelay(HedgedRequestOperation::DIRECTORY_EXISTS, directory);
 	return LocalFileSystem::DirectoryExists(directory, opener);
 }
 
 bool MockFileSystem::FileExists(const string &filename, optional_ptr<FileOpener> opener) {
-	SimulateDelay();
+	SimulateDelay(HedgedRequestOperation::FILE_EXISTS, filename);
 	return LocalFileSystem::FileExists(filename, opener);
 }
 
 void MockFileSystem::CreateDirectory(const string &directory, optional_ptr<FileOpener> opener) {
-	SimulateDelay();
+	SimulateDelay(HedgedRequestOperation::DIRECTORY_CREATE, directory);
 	LocalFileSystem::CreateDirectory(directory, opener);
 }
 
 void MockFileSystem::CreateDirectoriesRecursive(const string &path, optional_ptr<FileOpener> opener) {
-	SimulateDelay();
+	SimulateDelay(HedgedRequestOperation::DIRECTORY_CREATE, path);
 	LocalFileSystem::CreateDirectoriesRecursive(path, opener);
 }
 
 void MockFileSystem::RemoveFile(const string &filename, optional_ptr<FileOpener> opener) {
-	SimulateDelay();
+	SimulateDelay(HedgedRequestOperation::FILE_DELETE, filename);
 	LocalFileSystem::RemoveFile(filename, opener);
 }
 
 vector<OpenFileInfo> MockFileSystem::Glob(const string &path, FileOpener *opener) {
-	SimulateDelay();
+	SimulateDelay(HedgedRequestOperation::GLOB, path);
 	return LocalFileSystem::Glob(path, opener);
 }
 
 bool MockFileSystem::ListFiles(const string &directory, const std::function<void(const string &, bool)> &callback,
                                FileOpener *opener) {
-	SimulateDelay();
+	SimulateDelay(HedgedRequestOperation::LIST_FILES, directory);
 	return LocalFileSystem::ListFiles(directory, callback, opener);
 }
 
 unique_ptr<FileHandle> MockFileSystem::OpenFileExtended(const OpenFileInfo &info, FileOpenFlags flags,
                                                         optional_ptr<FileOpener> opener) {
-	SimulateDelay();
+	SimulateDelay(HedgedRequestOperation::OPEN_FILE, info.path);
 	return LocalFileSystem::OpenFile(info.path, flags, opener);
 }
 
@@ -102,7 +145,7 @@ bool MockFileSystem::SupportsOpenFileExtended() const {
 
 bool MockFileSystem::ListFilesExtended(const string &directory, const std::function<void(OpenFileInfo &info)> &callback,
                                        optional_ptr<FileOpener> opener) {
-	SimulateDelay();
+	SimulateDelay(HedgedRequestOperation::LIST_FILES, directory);
 	return LocalFileSystem::ListFilesExtended(directory, callback, opener);
 }
 
@@ -110,14 +153,29 @@ bool MockFileSystem::SupportsListFilesExtended() const {
 	return true;
 }
 
-void MockFileSystem::SimulateDelay() {
-	std::chrono::milliseconds current_delay;
+void MockFileSystem::SimulateDelay(HedgedRequestOperation operation, const string &path) {
+	std::chrono::microseconds current_delay;
 	{
 		const concurrency::lock_guard<concurrency::mutex> lock(delay_mutex);
-		current_delay = delay;
+		auto iter = latency_distributions.find(static_cast<idx_t>(operation));
+		// Sampled under lock, so a seed reproduces the same sequence of delays.
+		current_delay = iter == latency_distributions.end() ? delay : iter->second.Sample(rng);
+		for (const auto &cur_path_delay : path_delays) {
+			if (!path.empty() && StringUtil::StartsWith(path, cur_path_delay.first)) {
+				current_delay = cur_path_delay.second;
+				break;
+			}
+		}
+		++io_operation_count;
 	}
 	if (current_delay.count() > 0) {
-		std::this_thread::sleep_for(current_delay);
+		// Opt in to cooperative cancellation, so losing hedged attempts stop early.
+		auto cancellation = CancellationToken::GetCurrent();
+		if (cancellation == nullptr) {
+			std::this_thread::sleep_for(current_delay);
+		} else if (cancellation->WaitFor(current_delay)) {
+			throw IOException("MockFileSystem: simulated IO cancelled");
+		}
 	}
 	{
 		const concurrency::lock_guard<concurrency::mutex> lock(delay_mutex);
@@ -128,6 +186,10 @@ void MockFileSystem::SimulateDelay() {
 		if (simulate_io_failure) {
 			throw IOException("MockFileSystem: simulated IOException");
 		}
+		if (transient_io_failure_count > 0) {
+			transient_io_failure_count--;
+			throw IOException("MockFileSystem: simulated transient IOException");
+		}
 	}
 }
 
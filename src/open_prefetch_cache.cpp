@@ -0,0 +1,240 @@
+#include "open_prefetch_cache.hpp"
+
+#include "duckdb/common/string_util.hpp"
+#include "hedged_request_config.hpp"
+
+namespace duckdb {
+
+OpenPrefetchCache::OpenPrefetchCache(HedgeScheduler &scheduler_p)
+    : scheduler(scheduler_p), ttl_ms(DEFAULT_OPEN_PREFETCH_TTL_MS), max_bytes(DEFAULT_OPEN_PREFETCH_MAX_BYTES) {
+}
+
+OpenPrefetchCache::~OpenPrefetchCache() {
+	StopSweeping();
+	vector<unique_ptr<FileHandle>> evicted;
+	{
+		const concurrency::lock_guard<concurrency::mutex> lock(mu);
+		while (!handles.empty()) {
+			EraseHandle(handles.begin(), evicted);
+		}
+	}
+	CloseHandles(evicted);
+}
+
+void OpenPrefetchCache::StopSweeping() {
+	uint64_t timer_id = 0;
+	{
+		const concurrency::lock_guard<concurrency::mutex> lock(mu);
+		sweeping_stopped = true;
+		timer_id = sweep_timer_id;
+	}
+	// Cancel without lock, since it waits for a running sweep which takes the lock.
+	if (timer_id != 0) {
+		scheduler.Cancel(timer_id);
+	}
+}
+
+void OpenPrefetchCache::SetTtl(std::chrono::milliseconds ttl_p) {
+	ttl_ms.store(ttl_p.count(), std::memory_order_relaxed);
+}
+
+void OpenPrefetchCache::SetMaxBytes(idx_t max_bytes_p) {
+	max_bytes.store(max_bytes_p, std::memory_order_relaxed);
+	vector<unique_ptr<FileHandle>> evicted;
+	{
+		const concurrency::lock_guard<concurrency::mutex> lock(mu);
+		EvictForRoom(/*required_bytes=*/0, evicted);
+	}
+	CloseHandles(evicted);
+}
+
+idx_t OpenPrefetchCache::GetEstimatedBytes(const string &key) {
+	return key.size() + OPEN_PREFETCH_HANDLE_ESTIMATED_BYTES;
+}
+
+bool OpenPrefetchCache::TryStartPrefetch(const string &key) {
+	vector<unique_ptr<FileHandle>> evicted;
+	bool started = false;
+	{
+		const concurrency::lock_guard<concurrency::mutex> lock(mu);
+		EvictExpired(std::chrono::steady_clock::now(), evicted);
+		if (index.find(key) == index.end() && in_flight.find(key) == in_flight.end()) {
+			const auto estimated_bytes = GetEstimatedBytes(key);
+			// Fresh prefetches are more likely to be opened soon, so older handles make room for them.
+			if (EvictForRoom(estimated_bytes, evicted)) {
+				in_flight[key] = false;
+				cached_bytes += estimated_bytes;
+				tracked_count.fetch_add(1, std::memory_order_relaxed);
+				started = true;
+			}
+		}
+	}
+	CloseHandles(evicted);
+	return started;
+}
+
+void OpenPrefetchCache::FinishPrefetch(const string &key, unique_ptr<FileHandle> handle) {
+	vector<unique_ptr<FileHandle>> evicted;
+	{
+		const concurrency::lock_guard<concurrency::mutex> lock(mu);
+		auto iter = in_flight.find(key);
+		D_ASSERT(iter != in_flight.end());
+		const bool erased = iter->second;
+		in_flight.erase(iter);
+		if (handle == nullptr || erased) {
+			cached_bytes -= GetEstimatedBytes(key);
+			tracked_count.fetch_sub(1, std::memory_order_relaxed);
+			if (handle != nullptr) {
+				evicted.emplace_back(std::move(handle));
+			}
+		} else {
+			// Memory has been reserved when the prefetch started.
+			const auto ttl = std::chrono::milliseconds(ttl_ms.load(std::memory_order_relaxed));
+			handles.emplace_back(CachedHandle {key, std::move(handle), std::chrono::steady_clock::now() + ttl});
+			index[key] = std::prev(handles.end());
+			ArmSweepTimer();
+		}
+		prefetch_completion_cv.notify_all();
+	}
+	CloseHandles(evicted);
+}
+
+unique_ptr<FileHandle> OpenPrefetchCache::TryTake(const string &key) {
+	if (tracked_count.load(std::memory_order_relaxed) == 0) {
+		return nullptr;
+	}
+	vector<unique_ptr<FileHandle>> evicted;
+	unique_ptr<FileHandle> result;
+	{
+		concurrency::unique_lock<concurrency::mutex> lock(mu);
+		// The prefetch has been started earlier than the caller's own open could, so it's worth waiting for.
+		prefetch_completion_cv.wait(lock, [this, &key]() DUCKDB_REQUIRES(mu) {
+			auto iter = in_flight.find(key);
+			return iter == in_flight.end() || iter->second;
+		});
+		EvictExpired(std::chrono::steady_clock::now(), evicted);
+		auto iter = index.find(key);
+		if (iter != index.end()) {
+			result = std::move(iter->second->handle);
+			EraseHandle(iter->second, evicted);
+		}
+	}
+	CloseHandles(evicted);
+	return result;
+}
+
+void OpenPrefetchCache::Erase(const string &key) {
+	if (tracked_count.load(std::memory_order_relaxed) == 0) {
+		return;
+	}
+	vector<unique_ptr<FileHandle>> evicted;
+	{
+		const concurrency::lock_guard<concurrency::mutex> lock(mu);
+		auto in_flight_iter = in_flight.find(key);
+		if (in_flight_iter != in_flight.end()) {
+			in_flight_iter->second = true;
+		}
+		auto iter = index.find(key);
+		if (iter != index.end()) {
+			EraseHandle(iter->second, evicted);
+		}
+	}
+	CloseHandles(evicted);
+}
+
+void OpenPrefetchCache::ErasePrefix(const string &prefix) {
+	vector<unique_ptr<FileHandle>> evicted;
+	{
+		concurrency::unique_lock<concurrency::mutex> lock(mu);
+		auto has_in_flight = [this, &prefix]() DUCKDB_REQUIRES(mu) {
+			bool found = false;
+			for (auto &cur_prefetch : in_flight) {
+				if (StringUtil::StartsWith(cur_prefetch.first, prefix)) {
+					cur_prefetch.second = true;
+					found = true;
+				}
+			}
+			return found;
+		};
+		prefetch_completion_cv.wait(lock, [&has_in_flight]() DUCKDB_REQUIRES(mu) { return !has_in_flight(); });
+		for (auto iter = handles.begin(); iter != handles.end();) {
+			auto cur_iter = iter++;
+			if (StringUtil::StartsWith(cur_iter->key, prefix)) {
+				EraseHandle(cur_iter, evicted);
+			}
+		}
+	}
+	CloseHandles(evicted);
+}
+
+idx_t OpenPrefetchCache::GetHandleCount() const {
+	const concurrency::lock_guard<concurrency::mutex> lock(mu);
+	return handles.size();
+}
+
+idx_t OpenPrefetchCache::GetCachedBytes() const {
+	const concurrency::lock_guard<concurrency::mutex> lock(mu);
+	return cached_bytes;
+}
+
+void OpenPrefetchCache::EvictExpired(std::chrono::steady_clock::time_point now,
+                                     vector<unique_ptr<FileHandle>> &evicted) {
+	while (!handles.empty() && handles.front().expire_at <= now) {
+		EraseHandle(handles.begin(), evicted);
+	}
+}
+
+bool OpenPrefetchCache::EvictForRoom(idx_t required_bytes, vector<unique_ptr<FileHandle>> &evicted) {
+	const auto cur_max_bytes = max_bytes.load(std::memory_order_relaxed);
+	while (!handles.empty() && cached_bytes + required_bytes > cur_max_bytes) {
+		EraseHandle(handles.begin(), evicted);
+	}
+	return cached_bytes + required_bytes <= cur_max_bytes;
+}
+
+void OpenPrefetchCache::EraseHandle(HandleList::iterator iter, vector<unique_ptr<FileHandle>> &evicted) {
+	if (iter->handle != nullptr) {
+		evicted.emplace_back(std::move(iter->handle));
+	}
+	cached_bytes -= GetEstimatedBytes(iter->key);
+	tracked_count.fetch_sub(1, std::memory_order_relaxed);
+	index.erase(iter->key);
+	handles.erase(iter);
+}
+
+void OpenPrefetchCache::ArmSweepTimer() {
+	if (sweeping_stopped || sweep_timer_id != 0 || handles.empty()) {
+		return;
+	}
+	sweep_timer_id =
+	    scheduler.Schedule(handles.front().expire_at, [this](HedgeScheduler::Clock::time_point &next_deadline) {
+		    vector<unique_ptr<FileHandle>> evicted;
+		    bool rearm = false;
+		    {
+			    const concurrency::lock_guard<concurrency::mutex> lock(mu);
+			    EvictExpired(std::chrono::steady_clock::now(), evicted);
+			    if (handles.empty()) {
+				    sweep_timer_id = 0;
+			    } else {
+				    next_deadline = handles.front().expire_at;
+				    rearm = true;
+			    }
+		    }
+		    // Closing a read-only handle doesn't issue IO, so it doesn't hold up hedge deadlines.
+		    CloseHandles(evicted);
+		    return rearm;
+	    });
+}
+
+void OpenPrefetchCache::CloseHandles(vector<unique_ptr<FileHandle>> &handles_p) {
+	for (auto &cur_handle : handles_p) {
+		try {
+			cur_handle->Close();
+		} catch (...) {
+			// Unused handle, nobody cares about the failure.
+		}
+	}
+	handles_p.clear();
+}
+
+} // namespace duckdb
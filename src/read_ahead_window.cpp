@@ -0,0 +1,94 @@
+#include "read_ahead_window.hpp"
+
+#include "duckdb/common/helper.hpp"
+#include "duckdb/common/numeric_utils.hpp"
+
+#include <cstring>
+
+namespace duckdb {
+
+ReadAheadWindow::ReadAheadWindow(BlockFetcher fetcher_p, idx_t block_size_p, idx_t window_blocks_p)
+    : fetcher(std::move(fetcher_p)), block_size(MaxValue<idx_t>(block_size_p, 1)),
+      window_blocks(MaxValue<idx_t>(window_blocks_p, 1)) {
+}
+
+void ReadAheadWindow::Reset() {
+	blocks.clear();
+}
+
+void ReadAheadWindow::Fill(idx_t file_size) {
+	while (blocks.size() < window_blocks && next_block_location < file_size) {
+		auto block = make_shared_ptr<Block>();
+		block->location = next_block_location;
+		block->size = MinValue<idx_t>(block_size, file_size - next_block_location);
+		next_block_location += block->size;
+		blocks.emplace_back(block);
+
+		// Callback keeps the block alive, even if it's dropped from the window in the meantime.
+		BlockCallback on_fetched = [block](PooledReadBuffer buffer, std::exception_ptr eptr) {
+			const concurrency::lock_guard<concurrency::mutex> lock(block->mu);
+			if (block->done) {
+				return;
+			}
+			block->buffer = std::move(buffer);
+			block->eptr = std::move(eptr);
+			block->done = true;
+			block->cv.notify_all();
+		};
+		try {
+			fetcher(block->location, block->size, on_fetched);
+		} catch (...) {
+			// Fetch failed to start, which fails the block once it's read.
+			on_fetched(PooledReadBuffer(), std::current_exception());
+		}
+	}
+}
+
+void ReadAheadWindow::WaitForBlock(Block &block) {
+	concurrency::unique_lock<concurrency::mutex> lock(block.mu);
+	block.cv.wait(lock, [&block]() DUCKDB_REQUIRES(block.mu) { return block.done; });
+	if (block.eptr != nullptr) {
+		std::rethrow_exception(block.eptr);
+	}
+}
+
+idx_t ReadAheadWindow::Read(data_ptr_t buffer, idx_t nr_bytes, idx_t location, idx_t file_size) {
+	// Drop consumed blocks, and restart the window if the read isn't covered by it.
+	while (!blocks.empty() && blocks.front()->location + blocks.front()->size <= location) {
+		blocks.pop_front();
+	}
+	if (!blocks.empty() && blocks.front()->location > location) {
+		Reset();
+	}
+	if (blocks.empty()) {
+		next_block_location = location;
+	}
+
+	idx_t bytes_read = 0;
+	while (bytes_read < nr_bytes && location + bytes_read < file_size) {
+		Fill(file_size);
+		auto block = blocks.front();
+		try {
+			WaitForBlock(*block);
+		} catch (...) {
+			// Drop the failed block so the next read fetches it again.
+			Reset();
+			throw;
+		}
+
+		const auto block_offset = location + bytes_read - block->location;
+		const auto copy_bytes = MinValue<idx_t>(block->size - block_offset, nr_bytes - bytes_read);
+		{
+			const concurrency::lock_guard<concurrency::mutex> lock(block->mu);
+			std::memcpy(buffer + bytes_read, block->buffer.GetData() + block_offset, NumericCast<size_t>(copy_bytes));
+		}
+		bytes_read += copy_bytes;
+		if (block_offset + copy_bytes == block->size) {
+			blocks.pop_front();
+		}
+	}
+	Fill(file_size);
+	return bytes_read;
+}
+
+} // namespace duckdb
@@ -0,0 +1,118 @@
+#include "read_buffer_pool.hpp"
+
+#include "duckdb/common/helper.hpp"
+
+namespace duckdb {
+
+//===--------------------------------------------------------------------===//
+// PooledReadBuffer
+//===--------------------------------------------------------------------===//
+
+PooledReadBuffer::PooledReadBuffer(shared_ptr<ReadBufferPool> pool_p, unique_ptr<data_t[]> data_p, idx_t capacity_p)
+    : pool(std::move(pool_p)), data(std::move(data_p)), capacity(capacity_p) {
+}
+
+PooledReadBuffer::~PooledReadBuffer() {
+	Release();
+}
+
+PooledReadBuffer::PooledReadBuffer(PooledReadBuffer &&other) noexcept
+    : pool(std::move(other.pool)), data(std::move(other.data)), capacity(other.capacity) {
+	other.capacity = 0;
+}
+
+PooledReadBuffer &PooledReadBuffer::operator=(PooledReadBuffer &&other) noexcept {
+	if (this != &other) {
+		Release();
+		pool = std::move(other.pool);
+		data = std::move(other.data);
+		capacity = other.capacity;
+		other.capacity = 0;
+	}
+	return *this;
+}
+
+void PooledReadBuffer::Release() {
+	if (pool != nullptr && data != nullptr) {
+		pool->Return(std::move(data), capacity);
+	}
+	pool.reset();
+	data.reset();
+	capacity = 0;
+}
+
+//===--------------------------------------------------------------------===//
+// ReadBufferPool
+//===--------------------------------------------------------------------===//
+
+ReadBufferPool::ReadBufferPool(idx_t max_bytes_p) : max_bytes(max_bytes_p) {
+}
+
+idx_t ReadBufferPool::GetSizeClass(idx_t size) {
+	idx_t size_class = 0;
+	while (size_class < SIZE_CLASS_COUNT && GetSizeClassCapacity(size_class) < size) {
+		++size_class;
+	}
+	return size_class;
+}
+
+idx_t ReadBufferPool::GetSizeClassCapacity(idx_t size_class) {
+	return idx_t(1) << (MIN_SIZE_CLASS_SHIFT + size_class);
+}
+
+PooledReadBuffer ReadBufferPool::Acquire(idx_t size) {
+	const auto size_class = GetSizeClass(size);
+
+	// Oversized requests are served with a dedicated allocation, which is freed on release.
+	if (size_class == SIZE_CLASS_COUNT) {
+		return PooledReadBuffer(nullptr, make_uniq_array_uninitialized<data_t>(size), size);
+	}
+
+	const auto capacity = GetSizeClassCapacity(size_class);
+	{
+		const concurrency::lock_guard<concurrency::mutex> lock(mu);
+		auto &buffers = free_buffers[size_class];
+		if (!buffers.empty()) {
+			auto data = std::move(buffers.back());
+			buffers.pop_back();
+			cached_bytes -= capacity;
+			return PooledReadBuffer(shared_from_this(), std::move(data), capacity);
+		}
+	}
+	return PooledReadBuffer(shared_from_this(), make_uniq_array_uninitialized<data_t>(capacity), capacity);
+}
+
+void ReadBufferPool::Return(unique_ptr<data_t[]> data, idx_t capacity) {
+	const auto size_class = GetSizeClass(capacity);
+	const concurrency::lock_guard<concurrency::mutex> lock(mu);
+	if (cached_bytes + capacity > max_bytes) {
+		return;
+	}
+	free_buffers[size_class].emplace_back(std::move(data));
+	cached_bytes += capacity;
+}
+
+void ReadBufferPool::SetMaxBytes(idx_t max_bytes_p) {
+	const concurrency::lock_guard<concurrency::mutex> lock(mu);
+	max_bytes = max_bytes_p;
+	EvictToLimit();
+}
+
+idx_t ReadBufferPool::GetCachedBytes() const {
+	const concurrency::lock_guard<concurrency::mutex> lock(mu);
+	return cached_bytes;
+}
+
+void ReadBufferPool::EvictToLimit() DUCKDB_REQUIRES(mu) {
+	// Drop largest buffers first, which are the most expensive ones to keep around.
+	for (idx_t size_class = SIZE_CLASS_COUNT; size_class > 0 && cached_bytes > max_bytes; --size_class) {
+		auto &buffers = free_buffers[size_class - 1];
+		const auto capacity = GetSizeClassCapacity(size_class - 1);
+		while (!buffers.empty() && cached_bytes > max_bytes) {
+			buffers.pop_back();
+			cached_bytes -= capacity;
+		}
+	}
+}
+
+} // namespace duckdb
@@ -0,0 +1,183 @@
+#include "request_trace.hpp"
+
+#include "duckdb/common/error_data.hpp"
+#include "duckdb/common/numeric_utils.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+
+namespace duckdb {
+
+namespace {
+
+static_assert(std::is_trivially_copyable<RequestTraceEvent>::value, "trace events are copied as raw words");
+
+// Copy [src] into the fixed-size buffer [dst] of [dst_size] bytes, truncated and null-terminated.
+void CopyTruncated(char *dst, idx_t dst_size, const char *src, idx_t src_size) {
+	const auto copy_size = MinValue<idx_t>(src_size, dst_size - 1);
+	std::memcpy(dst, src, copy_size);
+	dst[copy_size] = '\0';
+}
+
+int64_t GetElapsedMicros(std::chrono::steady_clock::time_point start) {
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+//===--------------------------------------------------------------------===//
+// RequestTraceRing
+//===--------------------------------------------------------------------===//
+
+constexpr idx_t RequestTraceEvent::MAX_ATTEMPTS;
+constexpr idx_t RequestTraceEvent::PATH_PREFIX_BYTES;
+constexpr idx_t RequestTraceEvent::ERROR_BYTES;
+constexpr idx_t RequestTraceRing::CAPACITY;
+
+RequestTraceRing::RequestTraceRing() : last_request_id(0) {
+	for (auto &slot : slots) {
+		slot.sequence.store(0, std::memory_order_relaxed);
+	}
+}
+
+void RequestTraceRing::Publish(RequestTraceEvent event) {
+	const auto request_id = last_request_id.fetch_add(1, std::memory_order_relaxed) + 1;
+	event.request_id = request_id;
+	uint64_t words[WORD_COUNT] = {};
+	std::memcpy(words, &event, sizeof(event));
+
+	auto &slot = slots[(request_id - 1) % CAPACITY];
+	slot.sequence.store(2 * request_id - 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	for (idx_t idx = 0; idx < WORD_COUNT; ++idx) {
+		slot.words[idx].store(words[idx], std::memory_order_relaxed);
+	}
+	slot.sequence.store(2 * request_id, std::memory_order_release);
+}
+
+vector<RequestTraceEvent> RequestTraceRing::GetRecentEvents() const {
+	const auto last_id = last_request_id.load(std::memory_order_acquire);
+	const auto first_id = last_id > CAPACITY ? last_id - CAPACITY + 1 : 1;
+	vector<RequestTraceEvent> events;
+	for (auto request_id = first_id; request_id <= last_id; ++request_id) {
+		const auto &slot = slots[(request_id - 1) % CAPACITY];
+		// Events still being written are skipped, as are those already overwritten by newer ones.
+		const auto sequence = slot.sequence.load(std::memory_order_acquire);
+		if (sequence != 2 * request_id) {
+			continue;
+		}
+		uint64_t words[WORD_COUNT];
+		for (idx_t idx = 0; idx < WORD_COUNT; ++idx) {
+			words[idx] = slot.words[idx].load(std::memory_order_relaxed);
+		}
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (slot.sequence.load(std::memory_order_relaxed) != sequence) {
+			continue;
+		}
+		RequestTraceEvent event;
+		std::memcpy(&event, words, sizeof(event));
+		events.emplace_back(event);
+	}
+	return events;
+}
+
+//===--------------------------------------------------------------------===//
+// RequestTraceRecorder
+//===--------------------------------------------------------------------===//
+
+void RequestTraceRecorder::Begin(RequestTraceRing &ring_p, HedgedRequestOperation operation, const string &path) {
+	ring = &ring_p;
+	start = std::chrono::steady_clock::now();
+	std::memset(&event, 0, sizeof(event));
+	event.operation = operation;
+	event.path_hash = std::hash<string> {}(path);
+	CopyTruncated(event.path_prefix, RequestTraceEvent::PATH_PREFIX_BYTES, path.data(), path.size());
+	event.start_time_us =
+	    std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch())
+	        .count();
+	for (idx_t idx = 0; idx < RequestTraceEvent::MAX_ATTEMPTS; ++idx) {
+		submit_us[idx].store(-1, std::memory_order_relaxed);
+		start_us[idx].store(-1, std::memory_order_relaxed);
+		finish_us[idx].store(-1, std::memory_order_relaxed);
+		attempt_failed[idx].store(false, std::memory_order_relaxed);
+	}
+}
+
+void RequestTraceRecorder::OnAttemptSubmitted(size_t attempt_idx) {
+	if (attempt_idx < RequestTraceEvent::MAX_ATTEMPTS) {
+		submit_us[attempt_idx].store(GetElapsedMicros(start), std::memory_order_relaxed);
+	}
+}
+
+void RequestTraceRecorder::OnAttemptStarted(size_t attempt_idx) {
+	if (attempt_idx < RequestTraceEvent::MAX_ATTEMPTS) {
+		start_us[attempt_idx].store(GetElapsedMicros(start), std::memory_order_relaxed);
+	}
+}
+
+void RequestTraceRecorder::OnAttemptFinished(size_t attempt_idx, const std::exception_ptr &error) {
+	if (attempt_idx < RequestTraceEvent::MAX_ATTEMPTS) {
+		finish_us[attempt_idx].store(GetElapsedMicros(start), std::memory_order_relaxed);
+		attempt_failed[attempt_idx].store(error != nullptr, std::memory_order_relaxed);
+	}
+	if (error == nullptr || error_claimed.exchange(true, std::memory_order_relaxed)) {
+		return;
+	}
+	// Only failures pay for extracting the message.
+	try {
+		std::rethrow_exception(error);
+	} catch (const std::exception &ex) {
+		const auto message = ErrorData(ex).RawMessage();
+		CopyTruncated(error_message, RequestTraceEvent::ERROR_BYTES, message.data(), message.size());
+	} catch (...) {
+		const string message = "Unknown exception";
+		CopyTruncated(error_message, RequestTraceEvent::ERROR_BYTES, message.data(), message.size());
+	}
+	error_ready.store(true, std::memory_order_release);
+}
+
+void RequestTraceRecorder::OnAttemptWon(size_t attempt_idx) {
+	winner_attempt.store(NumericCast<int64_t>(attempt_idx), std::memory_order_relaxed);
+	Release();
+}
+
+void RequestTraceRecorder::OnRequestReturned(uint64_t attempt_count, bool decided_by_caller) {
+	event.latency_us = GetElapsedMicros(start);
+	event.attempt_count = attempt_count;
+	Release();
+	if (decided_by_caller) {
+		Release();
+	}
+}
+
+void RequestTraceRecorder::Release() {
+	// The last one to release observes writes of the other one.
+	if (pending_releases.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+		return;
+	}
+	for (idx_t idx = 0; idx < RequestTraceEvent::MAX_ATTEMPTS; ++idx) {
+		auto &attempt = event.attempts[idx];
+		attempt.submit_us = submit_us[idx].load(std::memory_order_relaxed);
+		attempt.start_us = start_us[idx].load(std::memory_order_relaxed);
+		attempt.finish_us = finish_us[idx].load(std::memory_order_relaxed);
+		attempt.failed = attempt_failed[idx].load(std::memory_order_relaxed);
+	}
+	event.winner_attempt = winner_attempt.load(std::memory_order_relaxed);
+	const bool has_error = error_ready.load(std::memory_order_acquire);
+	if (has_error) {
+		std::memcpy(event.error, error_message, RequestTraceEvent::ERROR_BYTES);
+	}
+	if (event.winner_attempt < 0) {
+		// Decided by the caller with the latest failure.
+		event.failed = true;
+	} else if (event.winner_attempt < NumericCast<int64_t>(RequestTraceEvent::MAX_ATTEMPTS)) {
+		event.failed = event.attempts[event.winner_attempt].failed;
+	} else {
+		event.failed = has_error;
+	}
+	ring->Publish(event);
+}
+
+} // namespace duckdb
@@ -0,0 +1,50 @@
+#include "single_flight.hpp"
+
+#include "duckdb/common/assert.hpp"
+
+namespace duckdb {
+
+std::shared_ptr<SingleFlight::Flight> SingleFlight::Join(const string &key, bool &is_leader) {
+	const concurrency::lock_guard<concurrency::mutex> lock(mu);
+	auto &state = flights[key];
+	if (state.flight == nullptr) {
+		state.flight = std::make_shared<Flight>();
+		is_leader = true;
+	} else {
+		++state.follower_count;
+		is_leader = false;
+	}
+	return state.flight;
+}
+
+idx_t SingleFlight::Leave(const string &key) {
+	const concurrency::lock_guard<concurrency::mutex> lock(mu);
+	auto iter = flights.find(key);
+	ALWAYS_ASSERT(iter != flights.end());
+	const auto follower_count = iter->second.follower_count;
+	flights.erase(iter);
+	return follower_count;
+}
+
+void SingleFlight::Complete(Flight &flight, std::shared_ptr<void> value, std::exception_ptr eptr) {
+	const concurrency::lock_guard<concurrency::mutex> lock(flight.mu);
+	flight.value = std::move(value);
+	flight.eptr = std::move(eptr);
+	flight.completed = true;
+	flight.cv.notify_all();
+}
+
+void SingleFlight::Wait(Flight &flight) {
+	concurrency::unique_lock<concurrency::mutex> lock(flight.mu);
+	flight.cv.wait(lock, [&flight]() DUCKDB_REQUIRES(flight.mu) { return flight.completed; });
+	if (flight.eptr != nullptr) {
+		std::rethrow_exception(flight.eptr);
+	}
+}
+
+idx_t SingleFlight::GetInFlightCount() const {
+	const concurrency::lock_guard<concurrency::mutex> lock(mu);
+	return flights.size();
+}
+
+} // namespace duckdb
@@ -1,6 +1,9 @@
 #include "thread_pool.hpp"
 
 #include "duckdb/common/assert.hpp"
+#include "duckdb/common/helper.hpp"
+
+#include <algorithm>
 
 namespace duckdb {
 
@@ -11,39 +14,287 @@ size_t DefaultThreadCount() {
 	return n == 0 ? 4 : static_cast<size_t>(n);
 }
 
+size_t ClampThreadCount(size_t thread_num) {
+	return std::min<size_t>(std::max<size_t>(thread_num, 1), ThreadPool::MAX_THREAD_COUNT);
+}
+
+// Worker identity of the current thread, used to submit to its own deque.
+thread_local const ThreadPool *current_pool = nullptr;
+thread_local size_t current_slot = 0;
+
 } // namespace
 
+const char *GetJobPriorityName(JobPriority priority) {
+	switch (priority) {
+	case JobPriority::PRIMARY:
+		return "primary";
+	case JobPriority::HEDGE:
+		return "hedge";
+	case JobPriority::HOUSEKEEPING:
+		return "housekeeping";
+	default:
+		return "unknown";
+	}
+}
+
+bool JobTie::TryStart(uint64_t ordinal) {
+	auto cur_started_before = started_before.load(std::memory_order_acquire);
+	for (;;) {
+		if (cur_started_before > ordinal) {
+			skipped.fetch_add(1, std::memory_order_acq_rel);
+			return false;
+		}
+		// All siblings submitted so far are queued alongside this one, so they're redundant once it starts.
+		const auto submitted_count = submitted.load(std::memory_order_acquire);
+		if (started_before.compare_exchange_weak(cur_started_before, submitted_count, std::memory_order_acq_rel)) {
+			started.fetch_add(1, std::memory_order_acq_rel);
+			return true;
+		}
+	}
+}
+
+constexpr size_t ThreadPool::MAX_THREAD_COUNT;
+constexpr size_t ThreadPool::PRIORITY_COUNT;
+constexpr std::chrono::milliseconds ThreadPool::DEFAULT_IDLE_TIMEOUT;
+
 ThreadPool::ThreadPool() : ThreadPool(DefaultThreadCount()) {
 }
 
-ThreadPool::ThreadPool(size_t thread_num) : idle_num_(thread_num) {
-	workers_.reserve(thread_num);
-	for (size_t ii = 0; ii < thread_num; ii++) {
-		workers_.emplace_back([this]() {
-			for (;;) {
-				Job cur_job;
-				{
-					concurrency::unique_lock<concurrency::mutex> lck(mutex_);
-					new_job_cv_.wait(lck, [this]() DUCKDB_REQUIRES(mutex_) { return !jobs_.empty() || stopped_; });
-					if (stopped_) {
-						return;
-					}
-					cur_job = std::move(jobs_.front());
-					jobs_.pop();
-					ALWAYS_ASSERT(idle_num_ > 0);
-					idle_num_--;
-				}
-
-				cur_job();
-
-				{
-					concurrency::unique_lock<concurrency::mutex> lck(mutex_);
-					idle_num_++;
-					job_completion_cv_.notify_one();
-				}
-			}
+ThreadPool::ThreadPool(size_t thread_num) : ThreadPool(thread_num, thread_num) {
+}
+
+ThreadPool::ThreadPool(size_t min_thread_num, size_t max_thread_num, std::chrono::milliseconds idle_timeout)
+    : idle_timeout_(idle_timeout), min_thread_num_(ClampThreadCount(min_thread_num)),
+      max_thread_num_(std::max(ClampThreadCount(min_thread_num), ClampThreadCount(max_thread_num))) {
+	const concurrency::lock_guard<concurrency::mutex> lck(mutex_);
+	for (size_t ii = 0; ii < min_thread_num_.load(); ii++) {
+		SpawnWorker();
+	}
+}
+
+void ThreadPool::Submit(Job job, JobPriority priority) {
+	QueuedJob queued_job;
+	queued_job.job = std::move(job);
+	queued_job.priority = priority;
+	Enqueue(std::move(queued_job));
+}
+
+void ThreadPool::Submit(Job job, JobPriority priority, shared_ptr<JobTie> tie, Job on_skipped) {
+	QueuedJob queued_job;
+	queued_job.job = std::move(job);
+	queued_job.priority = priority;
+	queued_job.tie_ordinal = tie->Enqueue();
+	queued_job.tie = std::move(tie);
+	queued_job.on_skipped = std::move(on_skipped);
+	Enqueue(std::move(queued_job));
+}
+
+bool ThreadPool::IsSaturated() const {
+	return queued_jobs_.load() > 0 && idle_num_.load() == 0 && thread_num_.load() >= max_thread_num_.load();
+}
+
+size_t ThreadPool::GetQueuedJobCount() const {
+	return queued_jobs_.load();
+}
+
+JobQueueStats ThreadPool::GetQueueStats(JobPriority priority) const {
+	const auto &counters = priority_counters_[static_cast<size_t>(priority)];
+	JobQueueStats stats;
+	stats.queued_jobs = counters.queued_jobs.load(std::memory_order_relaxed);
+	stats.dequeued_jobs = counters.dequeued_jobs.load(std::memory_order_relaxed);
+	stats.total_wait_us = counters.total_wait_us.load(std::memory_order_relaxed);
+	stats.recent_wait_us = counters.recent_wait_us.load(std::memory_order_relaxed);
+	return stats;
+}
+
+void ThreadPool::Enqueue(QueuedJob job) {
+	unfinished_jobs_.fetch_add(1);
+	// Workers are leaving, so the job would never be taken from a deque.
+	if (stopped_.load()) {
+		RunJob(job);
+		return;
+	}
+	job.enqueue_time = std::chrono::steady_clock::now();
+	// Counted before the job is visible, so the per-class count never drops below zero.
+	auto &queued_jobs = priority_counters_[static_cast<size_t>(job.priority)].queued_jobs;
+	queued_jobs.fetch_add(1, std::memory_order_relaxed);
+
+	// Jobs submitted from a worker go to its own deque, others are spread over all deques.
+	const auto slot_num = slot_num_.load(std::memory_order_acquire);
+	ALWAYS_ASSERT(slot_num > 0);
+	const auto slot_idx = current_pool == this ? current_slot : next_slot_.fetch_add(1) % slot_num;
+	{
+		auto &slot = *slots_[slot_idx];
+		const concurrency::lock_guard<concurrency::mutex> slot_lck(slot.mu);
+		slot.jobs[static_cast<size_t>(job.priority)].emplace_back(std::move(job));
+	}
+
+	// Sequentially consistent increment and load pair with workers going idle, which increment [idle_num_] before
+	// re-checking [queued_jobs_]; so either the worker sees the job, or we see the idle worker and wake it up.
+	queued_jobs_.fetch_add(1);
+	if (idle_num_.load() > 0) {
+		const concurrency::lock_guard<concurrency::mutex> lck(mutex_);
+		new_job_cv_.notify_one();
+		return;
+	}
+	MaybeSpawnWorker();
+}
+
+void ThreadPool::MaybeSpawnWorker() {
+	if (thread_num_.load() >= max_thread_num_.load()) {
+		return;
+	}
+	const concurrency::lock_guard<concurrency::mutex> lck(mutex_);
+	if (stopped_ || idle_num_.load() > 0 || thread_num_.load() >= max_thread_num_.load()) {
+		return;
+	}
+	SpawnWorker();
+}
+
+void ThreadPool::SpawnWorker() DUCKDB_REQUIRES(mutex_) {
+	const auto slot_num = slot_num_.load(std::memory_order_relaxed);
+	size_t slot_idx = 0;
+	for (; slot_idx < slot_num; ++slot_idx) {
+		if (!slots_[slot_idx]->running) {
+			break;
+		}
+	}
+	if (slot_idx == slot_num) {
+		ALWAYS_ASSERT(slot_num < MAX_THREAD_COUNT);
+		slots_[slot_idx] = make_uniq<WorkerSlot>();
+		slot_num_.store(slot_num + 1, std::memory_order_release);
+	}
+
+	auto &slot = *slots_[slot_idx];
+	// Retired worker has already left the loop, joining only waits for the thread to exit.
+	if (slot.thread.joinable()) {
+		slot.thread.join();
+	}
+	slot.running = true;
+	thread_num_.fetch_add(1);
+	slot.thread = std::thread([this, slot_idx]() { WorkerLoop(slot_idx); });
+}
+
+bool ThreadPool::TryPopJob(size_t slot_idx, QueuedJob &job) {
+	for (size_t priority_idx = 0; priority_idx < PRIORITY_COUNT; ++priority_idx) {
+		// Skip empty classes without taking deque locks.
+		if (priority_counters_[priority_idx].queued_jobs.load(std::memory_order_relaxed) == 0) {
+			continue;
+		}
+		if (TryPopJob(slot_idx, static_cast<JobPriority>(priority_idx), job)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool ThreadPool::TryPopJob(size_t slot_idx, JobPriority priority, QueuedJob &job) {
+	const auto priority_idx = static_cast<size_t>(priority);
+	// Own deque is consumed in FIFO order, so earlier requests are served first.
+	{
+		auto &slot = *slots_[slot_idx];
+		const concurrency::lock_guard<concurrency::mutex> slot_lck(slot.mu);
+		auto &jobs = slot.jobs[priority_idx];
+		if (!jobs.empty()) {
+			job = std::move(jobs.front());
+			jobs.pop_front();
+			return true;
+		}
+	}
+
+	// Steal from the back of other deques.
+	const auto slot_num = slot_num_.load(std::memory_order_acquire);
+	for (size_t offset = 1; offset < slot_num; ++offset) {
+		auto &victim = *slots_[(slot_idx + offset) % slot_num];
+		const concurrency::lock_guard<concurrency::mutex> slot_lck(victim.mu);
+		auto &jobs = victim.jobs[priority_idx];
+		if (!jobs.empty()) {
+			job = std::move(jobs.back());
+			jobs.pop_back();
+			return true;
+		}
+	}
+	return false;
+}
+
+void ThreadPool::RecordDequeue(const QueuedJob &job) {
+	auto &counters = priority_counters_[static_cast<size_t>(job.priority)];
+	counters.queued_jobs.fetch_sub(1, std::memory_order_relaxed);
+	const auto wait_us = static_cast<uint64_t>(
+	    std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - job.enqueue_time)
+	        .count());
+	counters.dequeued_jobs.fetch_add(1, std::memory_order_relaxed);
+	counters.total_wait_us.fetch_add(wait_us, std::memory_order_relaxed);
+	// Racy read-modify-write is fine for a moving average, a lost update only drops one sample.
+	const auto recent_wait_us = counters.recent_wait_us.load(std::memory_order_relaxed);
+	counters.recent_wait_us.store((recent_wait_us * 7 + wait_us) / 8, std::memory_order_relaxed);
+}
+
+void ThreadPool::RunJob(QueuedJob &job) {
+	const bool skipped = job.tie != nullptr && !job.tie->TryStart(job.tie_ordinal);
+	try {
+		if (!skipped) {
+			job.job();
+		} else if (job.on_skipped) {
+			job.on_skipped();
+		}
+	} catch (...) {
+		// Fire-and-forget jobs have nowhere to report failure.
+	}
+	job = QueuedJob {};
+	if (unfinished_jobs_.fetch_sub(1) == 1) {
+		const concurrency::lock_guard<concurrency::mutex> lck(mutex_);
+		job_completion_cv_.notify_all();
+	}
+}
+
+void ThreadPool::WorkerLoop(size_t slot_idx) {
+	current_pool = this;
+	current_slot = slot_idx;
+
+	for (;;) {
+		QueuedJob cur_job;
+		if (TryPopJob(slot_idx, cur_job)) {
+			queued_jobs_.fetch_sub(1);
+			RecordDequeue(cur_job);
+			RunJob(cur_job);
+			continue;
+		}
+
+		concurrency::unique_lock<concurrency::mutex> lck(mutex_);
+		if (stopped_) {
+			break;
+		}
+		idle_num_.fetch_add(1);
+		const bool notified = new_job_cv_.wait_for(lck, idle_timeout_, [this]() DUCKDB_REQUIRES(mutex_) {
+			return stopped_ || queued_jobs_.load() > 0 || thread_num_.load() > max_thread_num_.load();
 		});
+		idle_num_.fetch_sub(1);
+		if (stopped_) {
+			break;
+		}
+		if (queued_jobs_.load() > 0) {
+			continue;
+		}
+		// Retire on idle timeout, or when max thread count has been lowered.
+		const auto thread_num = thread_num_.load();
+		const bool over_max = thread_num > max_thread_num_.load();
+		if ((!notified && thread_num > min_thread_num_.load()) || over_max) {
+			// Submitters skip spawning while the thread count is at max, so a job queued since the check above would
+			// be stranded. Sequentially consistent decrement and re-check pair with submitters incrementing
+			// [queued_jobs_] before loading [thread_num_]: either the submitter spawns a worker once the lock is
+			// released, or this worker stays for the job.
+			thread_num_.fetch_sub(1);
+			if (queued_jobs_.load() > 0) {
+				thread_num_.fetch_add(1);
+				continue;
+			}
+			slots_[slot_idx]->running = false;
+			break;
+		}
 	}
+
+	current_pool = nullptr;
 }
 
 void ThreadPool::Wait() {
@@ -52,22 +303,62 @@ void ThreadPool::Wait() {
 		if (stopped_) {
 			return true;
 		}
-		if (idle_num_ == workers_.size() && jobs_.empty()) {
-			return true;
-		}
-		return false;
+		return unfinished_jobs_.load() == 0;
 	});
 }
 
+void ThreadPool::SetThreadLimits(size_t min_thread_num, size_t max_thread_num) {
+	const concurrency::lock_guard<concurrency::mutex> lck(mutex_);
+	const auto new_min = ClampThreadCount(min_thread_num);
+	min_thread_num_.store(new_min);
+	max_thread_num_.store(std::max(new_min, ClampThreadCount(max_thread_num)));
+	while (!stopped_ && thread_num_.load() < new_min) {
+		SpawnWorker();
+	}
+	// Wake up idle workers, so those beyond the new max count could retire.
+	new_job_cv_.notify_all();
+}
+
+size_t ThreadPool::GetMinThreadCount() const {
+	return min_thread_num_.load();
+}
+
+size_t ThreadPool::GetMaxThreadCount() const {
+	return max_thread_num_.load();
+}
+
+size_t ThreadPool::GetThreadCount() const {
+	return thread_num_.load();
+}
+
+size_t ThreadPool::GetIdleThreadCount() const {
+	return idle_num_.load();
+}
+
+bool ThreadPool::IsWorkerThread() const {
+	return current_pool == this;
+}
+
 ThreadPool::~ThreadPool() noexcept {
 	{
 		const concurrency::lock_guard<concurrency::mutex> lck(mutex_);
 		stopped_ = true;
 		new_job_cv_.notify_all();
+		job_completion_cv_.notify_all();
+	}
+	const auto slot_num = slot_num_.load(std::memory_order_acquire);
+	for (size_t ii = 0; ii < slot_num; ++ii) {
+		auto &cur_worker = slots_[ii]->thread;
+		if (cur_worker.joinable()) {
+			cur_worker.join();
+		}
 	}
-	for (auto &cur_worker : workers_) {
-		ALWAYS_ASSERT(cur_worker.joinable());
-		cur_worker.join();
+	// Jobs queued by running jobs after workers last checked their deques run here, so none is lost.
+	QueuedJob cur_job;
+	while (slot_num > 0 && TryPopJob(/*slot_idx=*/0, cur_job)) {
+		queued_jobs_.fetch_sub(1);
+		RecordDequeue(cur_job);
+		RunJob(cur_job);
 	}
 }
 
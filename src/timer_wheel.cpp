@@ -0,0 +1,100 @@
+#include "timer_wheel.hpp"
+
+#include "duckdb/common/assert.hpp"
+
+namespace duckdb {
+
+constexpr idx_t TimerWheel::SLOT_BITS;
+constexpr idx_t TimerWheel::SLOT_COUNT;
+constexpr idx_t TimerWheel::LEVEL_COUNT;
+constexpr uint64_t TimerWheel::SLOT_MASK;
+
+TimerWheel::TimerWheel(uint64_t start_tick) : current_tick(start_tick) {
+}
+
+void TimerWheel::Add(uint64_t timer_id, uint64_t expire_tick) {
+	D_ASSERT(timers.find(timer_id) == timers.end());
+	auto &location = timers[timer_id];
+	location.expire_tick = expire_tick > current_tick ? expire_tick : current_tick + 1;
+	Place(timer_id, location);
+}
+
+bool TimerWheel::Remove(uint64_t timer_id) {
+	auto iter = timers.find(timer_id);
+	if (iter == timers.end()) {
+		return false;
+	}
+	auto &location = iter->second;
+	slots[location.level][location.slot].erase(location.position);
+	timers.erase(iter);
+	return true;
+}
+
+void TimerWheel::Place(uint64_t timer_id, TimerLocation &location) {
+	const auto delta = location.expire_tick - current_tick;
+	idx_t level = 0;
+	while (level + 1 < LEVEL_COUNT && delta >= (uint64_t(1) << (SLOT_BITS * (level + 1)))) {
+		++level;
+	}
+	// Park timers beyond the top level range at its last covered tick, they're placed again once they come down.
+	auto placed_tick = location.expire_tick;
+	const auto max_delta = (uint64_t(1) << (SLOT_BITS * LEVEL_COUNT)) - 1;
+	if (delta > max_delta) {
+		placed_tick = current_tick + max_delta;
+	}
+	location.level = level;
+	location.slot = (placed_tick >> (SLOT_BITS * level)) & SLOT_MASK;
+	auto &slot = slots[level][location.slot];
+	location.position = slot.insert(slot.end(), timer_id);
+}
+
+void TimerWheel::Cascade(idx_t level, idx_t slot) {
+	std::list<uint64_t> cascaded;
+	cascaded.swap(slots[level][slot]);
+	for (const auto timer_id : cascaded) {
+		Place(timer_id, timers[timer_id]);
+	}
+}
+
+void TimerWheel::Advance(uint64_t now_tick, vector<uint64_t> &expired) {
+	while (current_tick < now_tick) {
+		// Nothing to expire, jump directly.
+		if (timers.empty()) {
+			current_tick = now_tick;
+			return;
+		}
+
+		++current_tick;
+		// Cascade from higher levels whenever the level below wraps around.
+		for (idx_t level = 1; level < LEVEL_COUNT; ++level) {
+			if ((current_tick & ((uint64_t(1) << (SLOT_BITS * level)) - 1)) != 0) {
+				break;
+			}
+			Cascade(level, (current_tick >> (SLOT_BITS * level)) & SLOT_MASK);
+		}
+
+		std::list<uint64_t> due;
+		due.swap(slots[0][current_tick & SLOT_MASK]);
+		for (const auto timer_id : due) {
+			auto &location = timers[timer_id];
+			// Parked timer which hasn't expired yet.
+			if (location.expire_tick > current_tick) {
+				Place(timer_id, location);
+				continue;
+			}
+			timers.erase(timer_id);
+			expired.emplace_back(timer_id);
+		}
+	}
+}
+
+uint64_t TimerWheel::GetNextWakeupTick() const {
+	for (uint64_t tick = current_tick + 1; tick <= current_tick + SLOT_COUNT; ++tick) {
+		if ((tick & SLOT_MASK) == 0 || !slots[0][tick & SLOT_MASK].empty()) {
+			return tick;
+		}
+	}
+	return current_tick + SLOT_COUNT;
+}
+
+} // namespace duckdb
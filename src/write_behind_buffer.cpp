@@ -0,0 +1,148 @@
+#include "write_behind_buffer.hpp"
+
+#include "duckdb/common/helper.hpp"
+#include "duckdb/common/numeric_utils.hpp"
+
+#include <cstring>
+
+namespace duckdb {
+
+WriteBehindBuffer::WriteBehindBuffer(PartWriter writer_p, shared_ptr<ReadBufferPool> buffer_pool_p, idx_t part_size_p,
+                                     idx_t max_outstanding_parts_p)
+    : buffer_pool(std::move(buffer_pool_p)), part_size(MaxValue<idx_t>(part_size_p, 1)),
+      max_outstanding_parts(MaxValue<idx_t>(max_outstanding_parts_p, 1)),
+      state(make_shared_ptr<PartState>(std::move(writer_p))) {
+}
+
+WriteBehindBuffer::~WriteBehindBuffer() {
+	// Part writes reference the wrapped handle, which must not be written after the owner goes away.
+	WaitForOutstandingParts(0);
+}
+
+void WriteBehindBuffer::Write(const_data_ptr_t buffer, idx_t nr_bytes, idx_t location) {
+	ThrowIfFailed();
+	idx_t bytes_written = 0;
+	while (bytes_written < nr_bytes) {
+		const auto cur_location = location + bytes_written;
+		if (current_size > 0 && current_location + current_size != cur_location) {
+			SubmitCurrentPart();
+		}
+		if (current_size == 0) {
+			current_part = buffer_pool->Acquire(part_size);
+			current_location = cur_location;
+		}
+		const auto copy_bytes = MinValue<idx_t>(part_size - current_size, nr_bytes - bytes_written);
+		std::memcpy(current_part.GetData() + current_size, buffer + bytes_written, NumericCast<size_t>(copy_bytes));
+		current_size += copy_bytes;
+		bytes_written += copy_bytes;
+		if (current_size == part_size) {
+			SubmitCurrentPart();
+		}
+	}
+}
+
+void WriteBehindBuffer::Flush() {
+	SubmitCurrentPart();
+	WaitForOutstandingParts(0);
+	ThrowIfFailed();
+}
+
+idx_t WriteBehindBuffer::GetOutstandingPartCount() const {
+	const concurrency::lock_guard<concurrency::mutex> lock(state->mu);
+	return state->outstanding_parts;
+}
+
+void WriteBehindBuffer::SubmitCurrentPart() {
+	if (current_size == 0) {
+		return;
+	}
+	// Backpressure, so a fast writer doesn't buffer unbounded data ahead of a slow storage.
+	WaitForOutstandingParts(max_outstanding_parts - 1);
+	ThrowIfFailed();
+
+	// The part counts as outstanding until its last reference is released, which includes references held by
+	// background attempts still writing it.
+	{
+		const concurrency::lock_guard<concurrency::mutex> lock(state->mu);
+		++state->outstanding_parts;
+	}
+	auto part_state = state;
+	shared_ptr<PooledReadBuffer> part(new PooledReadBuffer(std::move(current_part)),
+	                                  [part_state](PooledReadBuffer *buffer) {
+		                                  delete buffer;
+		                                  const concurrency::lock_guard<concurrency::mutex> lock(part_state->mu);
+		                                  --part_state->outstanding_parts;
+		                                  part_state->cv.notify_all();
+	                                  });
+	PendingPart pending {std::move(part), current_size, current_location};
+	current_size = 0;
+
+	bool start_part = false;
+	{
+		const concurrency::lock_guard<concurrency::mutex> lock(state->mu);
+		// Parts after the first failure are dropped outside of the lock, the file is broken anyway; the failure is
+		// reported by the next call.
+		if (state->eptr == nullptr) {
+			start_part = !state->writing;
+			state->writing = true;
+			if (!start_part) {
+				state->pending_parts.emplace_back(std::move(pending));
+			}
+		}
+	}
+	if (start_part) {
+		StartPart(state, std::move(pending));
+	}
+}
+
+void WriteBehindBuffer::StartPart(const shared_ptr<PartState> &state, PendingPart part) {
+	try {
+		state->writer(std::move(part.part), part.nr_bytes, part.location,
+		              [state](std::exception_ptr eptr) { OnPartWritten(state, std::move(eptr)); });
+	} catch (...) {
+		OnPartWritten(state, std::current_exception());
+	}
+}
+
+void WriteBehindBuffer::OnPartWritten(const shared_ptr<PartState> &state, std::exception_ptr eptr) {
+	PendingPart next;
+	// Released outside of the lock, since a part release takes it.
+	deque<PendingPart> dropped_parts;
+	{
+		const concurrency::lock_guard<concurrency::mutex> lock(state->mu);
+		if (eptr != nullptr && state->eptr == nullptr) {
+			state->eptr = std::move(eptr);
+		}
+		if (state->eptr != nullptr) {
+			dropped_parts = std::move(state->pending_parts);
+			state->pending_parts.clear();
+		}
+		if (state->pending_parts.empty()) {
+			state->writing = false;
+			return;
+		}
+		next = std::move(state->pending_parts.front());
+		state->pending_parts.pop_front();
+	}
+	StartPart(state, std::move(next));
+}
+
+void WriteBehindBuffer::WaitForOutstandingParts(idx_t max_parts) {
+	concurrency::unique_lock<concurrency::mutex> lock(state->mu);
+	state->cv.wait(lock, [this, max_parts]() DUCKDB_REQUIRES(state->mu) {
+		return state->outstanding_parts <= max_parts;
+	});
+}
+
+void WriteBehindBuffer::ThrowIfFailed() {
+	std::exception_ptr eptr;
+	{
+		const concurrency::lock_guard<concurrency::mutex> lock(state->mu);
+		eptr = state->eptr;
+	}
+	if (eptr != nullptr) {
+		std::rethrow_exception(eptr);
+	}
+}
+
+} // namespace duckdb
@@ -0,0 +1,335 @@
+// Tail latency benchmark, which replays concurrent open-and-read workloads through HedgedFileSystem over a
+// MockFileSystem with simulated latency distributions, and reports latency percentiles, hedge overhead and thread
+// pool occupancy for each hedging configuration. A microbenchmark then reports heap allocations per hedged request
+// on the fast path, where the primary attempt completes before any hedge is due.
+//
+// Usage: benchmark_hedged_fs [--threads=N] [--requests=N] [--seed=N] [--file=PATH]
+
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/local_file_system.hpp"
+#include "duckdb/common/printer.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "hedged_file_system.hpp"
+#include "hedged_request_fs_entry.hpp"
+#include "latency_distribution.hpp"
+#include "mock_file_system.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <string>
+#include <thread>
+
+using namespace duckdb; // NOLINT
+
+namespace {
+
+constexpr idx_t READ_BYTES = 4096;
+// Number of requests issued for each allocation measurement, after the same number of warm-up requests.
+constexpr idx_t ALLOCATION_BENCHMARK_REQUESTS = 10000;
+
+// Heap allocations of the whole process, counted by the global allocation functions below.
+std::atomic<uint64_t> allocation_count {0};
+
+} // namespace
+
+void *operator new(std::size_t size) {
+	allocation_count.fetch_add(1, std::memory_order_relaxed);
+	void *ptr = std::malloc(size == 0 ? 1 : size);
+	if (ptr == nullptr) {
+		throw std::bad_alloc();
+	}
+	return ptr;
+}
+void *operator new[](std::size_t size) {
+	return operator new(size);
+}
+void operator delete(void *ptr) noexcept {
+	std::free(ptr);
+}
+void operator delete[](void *ptr) noexcept {
+	std::free(ptr);
+}
+void operator delete(void *ptr, std::size_t) noexcept {
+	std::free(ptr);
+}
+void operator delete[](void *ptr, std::size_t) noexcept {
+	std::free(ptr);
+}
+
+namespace {
+
+struct BenchmarkOptions {
+	idx_t thread_count = 16;
+	idx_t requests_per_thread = 200;
+	uint64_t seed = 42;
+	string file_path = "hedged_fs_benchmark.tmp";
+};
+
+// Latency of the simulated storage, applied to both opens and reads.
+struct Workload {
+	string name;
+	LatencyDistribution distribution;
+};
+
+struct HedgingSetup {
+	string name;
+	std::function<void(HedgedRequestFsEntry &)> configure;
+};
+
+struct BenchmarkResult {
+	double p50_ms = 0;
+	double p99_ms = 0;
+	double p999_ms = 0;
+	// Hedged requests per primary request.
+	double hedge_overhead = 0;
+	// Average fraction of live thread pool workers busy running attempts.
+	double pool_occupancy = 0;
+	double average_pool_threads = 0;
+};
+
+// Parse "--name=value" into [value], return false if [arg] is not the option.
+bool ParseOption(const string &arg, const string &name, string &value) {
+	const auto prefix = "--" + name + "=";
+	if (!StringUtil::StartsWith(arg, prefix)) {
+		return false;
+	}
+	value = arg.substr(prefix.size());
+	return true;
+}
+
+BenchmarkOptions ParseOptions(int argc, char **argv) {
+	BenchmarkOptions options;
+	for (int idx = 1; idx < argc; ++idx) {
+		const string arg = argv[idx];
+		string value;
+		if (ParseOption(arg, "threads", value)) {
+			options.thread_count = std::stoull(value);
+		} else if (ParseOption(arg, "requests", value)) {
+			options.requests_per_thread = std::stoull(value);
+		} else if (ParseOption(arg, "seed", value)) {
+			options.seed = std::stoull(value);
+		} else if (ParseOption(arg, "file", value)) {
+			options.file_path = value;
+		} else {
+			throw InvalidInputException("Unknown option %s", arg);
+		}
+	}
+	if (options.thread_count == 0 || options.requests_per_thread == 0) {
+		throw InvalidInputException("Thread count and requests per thread must be positive");
+	}
+	return options;
+}
+
+void CreateBenchmarkFile(const string &path) {
+	LocalFileSystem local_fs;
+	auto handle = local_fs.OpenFile(path, FileFlags::FILE_FLAGS_WRITE | FileFlags::FILE_FLAGS_FILE_CREATE_NEW);
+	string content(READ_BYTES, 'x');
+	local_fs.Write(*handle, &content[0], NumericCast<int64_t>(content.size()), /*location=*/0);
+	handle->Close();
+}
+
+// Nearest-rank percentile of sorted latencies.
+double GetPercentileMs(const vector<int64_t> &sorted_latencies_us, double percentile) {
+	const auto rank = static_cast<idx_t>(percentile / 100.0 * static_cast<double>(sorted_latencies_us.size()));
+	const auto idx = MinValue<idx_t>(rank, sorted_latencies_us.size() - 1);
+	return static_cast<double>(sorted_latencies_us[idx]) / 1000.0;
+}
+
+BenchmarkResult RunBenchmark(const BenchmarkOptions &options, const Workload &workload, const HedgingSetup &setup) {
+	auto mock_fs = make_uniq<MockFileSystem>();
+	mock_fs->SetSeed(options.seed);
+	mock_fs->SetLatencyDistribution(HedgedRequestOperation::OPEN_FILE, workload.distribution);
+	mock_fs->SetLatencyDistribution(HedgedRequestOperation::READ, workload.distribution);
+	auto entry = make_shared_ptr<HedgedRequestFsEntry>();
+	entry->UpdateEnableReadHedging(true);
+	// Every request goes to the storage, so configurations are compared on the same number of round trips.
+	entry->UpdateEnableRequestCoalescing(false);
+	setup.configure(*entry);
+	HedgedFileSystem hedged_fs(std::move(mock_fs), entry);
+
+	// Sample thread pool occupancy while the workload runs.
+	std::atomic<bool> finished(false);
+	double busy_thread_sum = 0;
+	double live_thread_sum = 0;
+	idx_t sample_count = 0;
+	std::thread sampler([&]() {
+		auto &thread_pool = entry->GetThreadPool();
+		while (!finished.load()) {
+			const auto live_threads = thread_pool.GetThreadCount();
+			const auto idle_threads = MinValue<size_t>(thread_pool.GetIdleThreadCount(), live_threads);
+			busy_thread_sum += static_cast<double>(live_threads - idle_threads);
+			live_thread_sum += static_cast<double>(live_threads);
+			++sample_count;
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	});
+
+	vector<vector<int64_t>> thread_latencies_us(options.thread_count);
+	vector<std::thread> workers;
+	for (idx_t thread_idx = 0; thread_idx < options.thread_count; ++thread_idx) {
+		workers.emplace_back([&, thread_idx]() {
+			auto &latencies_us = thread_latencies_us[thread_idx];
+			latencies_us.reserve(options.requests_per_thread);
+			string buffer(READ_BYTES, '\0');
+			for (idx_t request_idx = 0; request_idx < options.requests_per_thread; ++request_idx) {
+				const auto start = std::chrono::steady_clock::now();
+				auto handle = hedged_fs.OpenFile(options.file_path,
+				                                 FileFlags::FILE_FLAGS_READ | FileFlags::FILE_FLAGS_PARALLEL_ACCESS);
+				hedged_fs.Read(*handle, &buffer[0], NumericCast<int64_t>(READ_BYTES), /*location=*/0);
+				const auto elapsed = std::chrono::steady_clock::now() - start;
+				latencies_us.emplace_back(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+			}
+		});
+	}
+	for (auto &cur_worker : workers) {
+		cur_worker.join();
+	}
+	finished.store(true);
+	sampler.join();
+	entry->WaitAll();
+
+	vector<int64_t> latencies_us;
+	for (auto &cur_latencies : thread_latencies_us) {
+		latencies_us.insert(latencies_us.end(), cur_latencies.begin(), cur_latencies.end());
+	}
+	std::sort(latencies_us.begin(), latencies_us.end());
+
+	BenchmarkResult result;
+	result.p50_ms = GetPercentileMs(latencies_us, 50);
+	result.p99_ms = GetPercentileMs(latencies_us, 99);
+	result.p999_ms = GetPercentileMs(latencies_us, 99.9);
+	uint64_t primary_requests = 0;
+	uint64_t hedged_requests = 0;
+	for (auto operation : {HedgedRequestOperation::OPEN_FILE, HedgedRequestOperation::READ}) {
+		const auto stats = entry->GetStats()->GetStats(operation);
+		primary_requests += stats.primary_requests;
+		hedged_requests += stats.hedged_requests;
+	}
+	result.hedge_overhead =
+	    primary_requests == 0 ? 0 : static_cast<double>(hedged_requests) / static_cast<double>(primary_requests);
+	result.pool_occupancy = live_thread_sum == 0 ? 0 : busy_thread_sum / live_thread_sum;
+	result.average_pool_threads = sample_count == 0 ? 0 : live_thread_sum / static_cast<double>(sample_count);
+	return result;
+}
+
+vector<Workload> GetWorkloads() {
+	using std::chrono::milliseconds;
+	return {
+	    {"lognormal", LatencyDistribution::LogNormal(milliseconds(10), /*sigma=*/0.5)},
+	    {"slow_replica", LatencyDistribution::Bimodal(milliseconds(5), milliseconds(200), /*slow_probability=*/0.05,
+	                                                  /*sigma=*/0.25)},
+	    {"pareto", LatencyDistribution::Pareto(milliseconds(5), /*shape=*/1.5, milliseconds(2000))},
+	};
+}
+
+void SetFixedDelay(HedgedRequestFsEntry &entry, std::chrono::milliseconds delay) {
+	entry.UpdateConfig(HedgedRequestOperation::OPEN_FILE, delay);
+	entry.UpdateConfig(HedgedRequestOperation::READ, delay);
+}
+
+vector<HedgingSetup> GetHedgingSetups() {
+	using std::chrono::milliseconds;
+	return {
+	    {"no_hedging", [](HedgedRequestFsEntry &entry) { entry.UpdateMaxHedgedRequestCount(1); }},
+	    {"fixed_50ms", [](HedgedRequestFsEntry &entry) { SetFixedDelay(entry, milliseconds(50)); }},
+	    {"fixed_20ms", [](HedgedRequestFsEntry &entry) { SetFixedDelay(entry, milliseconds(20)); }},
+	    {"adaptive_p95",
+	     [](HedgedRequestFsEntry &entry) {
+		     entry.UpdateEnableAdaptiveDelay(true);
+		     entry.UpdateAdaptiveDelayPercentile(95);
+		     entry.UpdateAdaptiveDelayMin(milliseconds(1));
+	     }},
+	    {"adaptive_p95_budget_10",
+	     [](HedgedRequestFsEntry &entry) {
+		     entry.UpdateEnableAdaptiveDelay(true);
+		     entry.UpdateAdaptiveDelayPercentile(95);
+		     entry.UpdateAdaptiveDelayMin(milliseconds(1));
+		     entry.UpdateEnableHedgeBudget(true);
+		     entry.UpdateHedgeBudgetPercent(10);
+	     }},
+	};
+}
+
+struct AllocationSetup {
+	string name;
+	std::function<void(HedgedRequestFsEntry &)> configure;
+};
+
+vector<AllocationSetup> GetAllocationSetups() {
+	return {
+	    {"no_hedging", [](HedgedRequestFsEntry &entry) { entry.UpdateMaxHedgedRequestCount(1); }},
+	    // Hedge timer is armed and cancelled on every request, but never fires.
+	    {"hedging", [](HedgedRequestFsEntry &) {}},
+	    {"hedging_coalescing", [](HedgedRequestFsEntry &entry) { entry.UpdateEnableRequestCoalescing(true); }},
+	};
+}
+
+// Get the average number of heap allocations of the whole process per invocation of [request], which includes
+// allocations of the wrapped filesystem and of thread pool workers running the attempts.
+double MeasureAllocationsPerRequest(HedgedRequestFsEntry &entry, const std::function<void()> &request) {
+	for (idx_t idx = 0; idx < ALLOCATION_BENCHMARK_REQUESTS; ++idx) {
+		request();
+	}
+	entry.WaitAll();
+	const auto start_count = allocation_count.load();
+	for (idx_t idx = 0; idx < ALLOCATION_BENCHMARK_REQUESTS; ++idx) {
+		request();
+	}
+	entry.WaitAll();
+	const auto allocations = allocation_count.load() - start_count;
+	return static_cast<double>(allocations) / static_cast<double>(ALLOCATION_BENCHMARK_REQUESTS);
+}
+
+// Report heap allocations per request on the fast path, with a wrapped filesystem which responds right away.
+void RunAllocationBenchmark(const BenchmarkOptions &options) {
+	Printer::Print(StringUtil::Format("%-14s %-24s %14s", "operation", "config", "allocs_per_op"));
+	for (auto &cur_setup : GetAllocationSetups()) {
+		auto entry = make_shared_ptr<HedgedRequestFsEntry>();
+		entry->UpdateEnableRequestCoalescing(false);
+		// Hedges are never due, so every request only runs its primary attempt.
+		entry->UpdateConfig(HedgedRequestOperation::FILE_EXISTS, std::chrono::milliseconds(10000));
+		entry->UpdateConfig(HedgedRequestOperation::GET_FILE_SIZE, std::chrono::milliseconds(10000));
+		cur_setup.configure(*entry);
+		HedgedFileSystem hedged_fs(make_uniq<MockFileSystem>(), entry);
+		auto handle = hedged_fs.OpenFile(options.file_path, FileFlags::FILE_FLAGS_READ);
+
+		const auto file_exists_allocations =
+		    MeasureAllocationsPerRequest(*entry, [&]() { hedged_fs.FileExists(options.file_path); });
+		Printer::Print(
+		    StringUtil::Format("%-14s %-24s %14.2f", "file_exists", cur_setup.name, file_exists_allocations));
+		const auto file_size_allocations =
+		    MeasureAllocationsPerRequest(*entry, [&]() { hedged_fs.GetFileSize(*handle); });
+		Printer::Print(
+		    StringUtil::Format("%-14s %-24s %14.2f", "get_file_size", cur_setup.name, file_size_allocations));
+	}
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	const auto options = ParseOptions(argc, argv);
+	CreateBenchmarkFile(options.file_path);
+
+	Printer::Print(StringUtil::Format("threads=%llu requests_per_thread=%llu seed=%llu", options.thread_count,
+	                                  options.requests_per_thread, options.seed));
+	Printer::Print(StringUtil::Format("%-14s %-24s %9s %9s %9s %12s %14s %12s", "workload", "config", "p50_ms",
+	                                  "p99_ms", "p999_ms", "hedge_ratio", "pool_occupancy", "pool_threads"));
+	for (auto &cur_workload : GetWorkloads()) {
+		for (auto &cur_setup : GetHedgingSetups()) {
+			const auto result = RunBenchmark(options, cur_workload, cur_setup);
+			Printer::Print(StringUtil::Format("%-14s %-24s %9.2f %9.2f %9.2f %12.3f %14.3f %12.1f", cur_workload.name,
+			                                  cur_setup.name, result.p50_ms, result.p99_ms, result.p999_ms,
+			                                  result.hedge_overhead, result.pool_occupancy,
+			                                  result.average_pool_threads));
+		}
+	}
+	RunAllocationBenchmark(options);
+
+	LocalFileSystem local_fs;
+	local_fs.TryRemoveFile(options.file_path);
+	return 0;
+}
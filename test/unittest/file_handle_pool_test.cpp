@@ -0,0 +1,130 @@
+#include "catch/catch.hpp"
+
+#include "duckdb/common/local_file_system.hpp"
+#include "file_handle_pool.hpp"
+#include "test_helpers.hpp"
+#include "test_utils.hpp"
+
+#include <chrono>
+#include <thread>
+
+using namespace duckdb; // NOLINT
+
+namespace {
+shared_ptr<FileHandle> OpenTestHandle(FileSystem &fs, const string &path) {
+	return MakeSharedFileHandle(fs.OpenFile(path, FileFlags::FILE_FLAGS_READ));
+}
+
+bool AlwaysCurrent(const PooledHandleVersion &) {
+	return true;
+}
+
+PooledHandleVersion MakeVersion(const string &version_tag) {
+	PooledHandleVersion version;
+	version.version_tag = version_tag;
+	return version;
+}
+} // namespace
+
+TEST_CASE("FileHandlePool disabled by default", "[file_handle_pool]") {
+	string test_file = TestCreatePath("handle_pool_disabled.txt");
+	CreateTestFile(test_file, "content");
+	LocalFileSystem local_fs;
+	FileHandlePool pool;
+	REQUIRE(!pool.IsEnabled());
+	pool.Put(test_file, /*flags=*/1, OpenTestHandle(local_fs, test_file), MakeVersion("v1"));
+	REQUIRE(pool.GetHandleCount() == 0);
+}
+
+TEST_CASE("FileHandlePool hands out handles by key and flags", "[file_handle_pool]") {
+	string test_file = TestCreatePath("handle_pool_take.txt");
+	CreateTestFile(test_file, "content");
+	LocalFileSystem local_fs;
+	FileHandlePool pool;
+	pool.SetMaxHandles(4);
+
+	auto handle = OpenTestHandle(local_fs, test_file);
+	auto *handle_ptr = handle.get();
+	pool.Put(test_file, /*flags=*/1, std::move(handle), MakeVersion("v1"));
+	REQUIRE(pool.GetHandleCount() == 1);
+
+	// Other flags or keys don't match.
+	REQUIRE(pool.TryTake(test_file, /*flags=*/3, AlwaysCurrent) == nullptr);
+	REQUIRE(pool.TryTake(test_file + ".other", /*flags=*/1, AlwaysCurrent) == nullptr);
+
+	auto taken = pool.TryTake(test_file, /*flags=*/1, AlwaysCurrent);
+	REQUIRE(taken.get() == handle_ptr);
+	REQUIRE(pool.TryTake(test_file, /*flags=*/1, AlwaysCurrent) == nullptr);
+	REQUIRE(pool.GetHandleCount() == 0);
+}
+
+TEST_CASE("FileHandlePool drops stale handles", "[file_handle_pool]") {
+	string test_file = TestCreatePath("handle_pool_stale.txt");
+	CreateTestFile(test_file, "content");
+	LocalFileSystem local_fs;
+	FileHandlePool pool;
+	pool.SetMaxHandles(4);
+
+	pool.Put(test_file, /*flags=*/1, OpenTestHandle(local_fs, test_file), MakeVersion("v1"));
+	pool.Put(test_file, /*flags=*/1, OpenTestHandle(local_fs, test_file), MakeVersion("v2"));
+	auto is_v1 = [](const PooledHandleVersion &version) {
+		return version.version_tag == "v1";
+	};
+	// The newer handle is stale and closed, the older one is still current.
+	REQUIRE(pool.TryTake(test_file, /*flags=*/1, is_v1) != nullptr);
+	REQUIRE(pool.GetHandleCount() == 0);
+}
+
+TEST_CASE("FileHandlePool expires idle handles", "[file_handle_pool]") {
+	string test_file = TestCreatePath("handle_pool_ttl.txt");
+	CreateTestFile(test_file, "content");
+	LocalFileSystem local_fs;
+	FileHandlePool pool;
+	pool.SetMaxHandles(4);
+	pool.SetTtl(std::chrono::milliseconds(20));
+
+	pool.Put(test_file, /*flags=*/1, OpenTestHandle(local_fs, test_file), MakeVersion("v1"));
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	REQUIRE(pool.TryTake(test_file, /*flags=*/1, AlwaysCurrent) == nullptr);
+	REQUIRE(pool.GetHandleCount() == 0);
+}
+
+TEST_CASE("FileHandlePool evicts oldest handles beyond bound", "[file_handle_pool]") {
+	string test_file1 = TestCreatePath("handle_pool_bound1.txt");
+	string test_file2 = TestCreatePath("handle_pool_bound2.txt");
+	CreateTestFile(test_file1, "content1");
+	CreateTestFile(test_file2, "content2");
+	LocalFileSystem local_fs;
+	FileHandlePool pool;
+	pool.SetMaxHandles(1);
+
+	pool.Put(test_file1, /*flags=*/1, OpenTestHandle(local_fs, test_file1), MakeVersion(""));
+	pool.Put(test_file2, /*flags=*/1, OpenTestHandle(local_fs, test_file2), MakeVersion(""));
+	REQUIRE(pool.GetHandleCount() == 1);
+	REQUIRE(pool.TryTake(test_file1, /*flags=*/1, AlwaysCurrent) == nullptr);
+	REQUIRE(pool.TryTake(test_file2, /*flags=*/1, AlwaysCurrent) != nullptr);
+
+	// Shrinking the bound closes pooled handles.
+	pool.Put(test_file1, /*flags=*/1, OpenTestHandle(local_fs, test_file1), MakeVersion(""));
+	pool.SetMaxHandles(0);
+	REQUIRE(pool.GetHandleCount() == 0);
+}
+
+TEST_CASE("FileHandlePool erases handles by key and prefix", "[file_handle_pool]") {
+	string test_file = TestCreatePath("handle_pool_erase.txt");
+	CreateTestFile(test_file, "content");
+	LocalFileSystem local_fs;
+	FileHandlePool pool;
+	pool.SetMaxHandles(8);
+
+	pool.Put("a|" + test_file, /*flags=*/1, OpenTestHandle(local_fs, test_file), MakeVersion(""));
+	pool.Put("a|" + test_file, /*flags=*/3, OpenTestHandle(local_fs, test_file), MakeVersion(""));
+	pool.Put("b|" + test_file, /*flags=*/1, OpenTestHandle(local_fs, test_file), MakeVersion(""));
+	pool.Erase("a|" + test_file);
+	REQUIRE(pool.GetHandleCount() == 1);
+
+	pool.Put("a|" + test_file, /*flags=*/1, OpenTestHandle(local_fs, test_file), MakeVersion(""));
+	pool.ErasePrefix("b|");
+	REQUIRE(pool.GetHandleCount() == 1);
+	REQUIRE(pool.TryTake("a|" + test_file, /*flags=*/1, AlwaysCurrent) != nullptr);
+}
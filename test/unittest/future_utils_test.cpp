@@ -35,6 +35,32 @@ TEST_CASE("RunHedgedVoidJob exception propagation", "[future_utils]") {
 	REQUIRE_THROWS_AS(WaitForHedgedOutcome(token), std::runtime_error);
 }
 
+TEST_CASE("RunHedgedJob records failures in first-success mode", "[future_utils]") {
+	auto token = make_shared_ptr<HedgedOutcomeToken<int>>();
+	token->first_success_wins = true;
+	REQUIRE_FALSE(RunHedgedJob(std::function<int()>([]() -> int { throw std::runtime_error("test error"); }), token));
+	const auto settled = WaitForSettledAttempts(*token, HedgedSettledAttempts());
+	REQUIRE(settled.failed == 1);
+	REQUIRE(settled.last_failure != nullptr);
+	REQUIRE_FALSE(token->cancellation.IsCancelled());
+
+	// A later success still decides the outcome.
+	REQUIRE(RunHedgedJob(std::function<int()>([]() { return 42; }), token));
+	REQUIRE(WaitForHedgedOutcome(token) == 42);
+}
+
+TEST_CASE("FailHedgedOutcome returns the latest failure", "[future_utils]") {
+	auto token = make_shared_ptr<HedgedOutcomeToken<void>>();
+	token->first_success_wins = true;
+	RunHedgedVoidJob(std::function<void()>([]() { throw std::runtime_error("test error"); }), token);
+	RecordHedgedSkip(*token);
+	const auto settled = WaitForSettledAttempts(*token, HedgedSettledAttempts());
+	REQUIRE(settled.GetCount() == 2);
+	REQUIRE(FailHedgedOutcome(*token));
+	REQUIRE(token->cancellation.IsCancelled());
+	REQUIRE_THROWS_AS(WaitForHedgedOutcome(token), std::runtime_error);
+}
+
 TEST_CASE("HedgedOutcomeToken via thread pool", "[future_utils]") {
 	auto token = make_shared_ptr<HedgedOutcomeToken<int>>();
 	ThreadPool pool;
@@ -56,3 +82,50 @@ TEST_CASE("HedgedOutcomeToken first completion wins", "[future_utils]") {
 	int v = WaitForHedgedOutcome(token);
 	REQUIRE((v == 1 || v == 2));
 }
+
+TEST_CASE("RunHedgedJob later completion is discarded", "[future_utils]") {
+	auto token = make_shared_ptr<HedgedOutcomeToken<int>>();
+	RunHedgedJob(std::function<int()>([]() { return 1; }), token);
+	REQUIRE(token->cancellation.IsCancelled());
+
+	// Queued attempt is dropped without running.
+	std::atomic<bool> executed(false);
+	RunHedgedJob(std::function<int()>([&executed]() {
+		             executed.store(true);
+		             return 2;
+	             }),
+	             token);
+	REQUIRE(!executed.load());
+	REQUIRE(WaitForHedgedOutcome(token) == 1);
+}
+
+TEST_CASE("RunHedgedJob exposes cancellation token to attempt", "[future_utils]") {
+	auto token = make_shared_ptr<HedgedOutcomeToken<int>>();
+	REQUIRE(CancellationToken::GetCurrent() == nullptr);
+	RunHedgedJob(std::function<int()>([&token]() {
+		             REQUIRE(CancellationToken::GetCurrent().get() == &token->cancellation);
+		             return 3;
+	             }),
+	             token);
+	REQUIRE(CancellationToken::GetCurrent() == nullptr);
+	REQUIRE(WaitForHedgedOutcome(token) == 3);
+}
+
+TEST_CASE("CancellationToken callbacks", "[future_utils]") {
+	CancellationToken token;
+	std::atomic<int> invoked(0);
+	token.AddCallback([&invoked]() { invoked.fetch_add(1); });
+	auto removed_id = token.AddCallback([&invoked]() { invoked.fetch_add(10); });
+	token.RemoveCallback(removed_id);
+	REQUIRE(!token.WaitFor(std::chrono::milliseconds(1)));
+
+	token.Cancel();
+	token.Cancel();
+	REQUIRE(token.IsCancelled());
+	REQUIRE(invoked.load() == 1);
+	REQUIRE(token.WaitFor(std::chrono::milliseconds(1)));
+
+	// Callbacks registered after cancellation are invoked inline.
+	token.AddCallback([&invoked]() { invoked.fetch_add(1); });
+	REQUIRE(invoked.load() == 2);
+}
@@ -0,0 +1,70 @@
+#include "catch/catch.hpp"
+
+#include "glob_partition.hpp"
+
+using namespace duckdb; // NOLINT
+
+TEST_CASE("SplitGlobPattern splits at first wildcard level", "[glob_partition]") {
+	GlobPartitioning partitioning;
+	REQUIRE(SplitGlobPattern("s3://bucket/events/*/*.parquet", partitioning));
+	REQUIRE(partitioning.base == "s3://bucket/events/");
+	REQUIRE(partitioning.segment == "*");
+	REQUIRE(partitioning.suffix == "/*.parquet");
+	REQUIRE(partitioning.GetPartitionPattern("2024") == "s3://bucket/events/2024/*.parquet");
+
+	REQUIRE(SplitGlobPattern("/data/year=202?/month=*/file.csv", partitioning));
+	REQUIRE(partitioning.base == "/data/");
+	REQUIRE(partitioning.segment == "year=202?");
+	REQUIRE(partitioning.suffix == "/month=*/file.csv");
+}
+
+TEST_CASE("SplitGlobPattern rejects patterns which cannot be partitioned", "[glob_partition]") {
+	GlobPartitioning partitioning;
+	// No wildcard.
+	REQUIRE(!SplitGlobPattern("s3://bucket/events/file.parquet", partitioning));
+	// Wildcard only in the last segment.
+	REQUIRE(!SplitGlobPattern("s3://bucket/events/*.parquet", partitioning));
+	// Wildcard in the bucket name.
+	REQUIRE(!SplitGlobPattern("s3://bucket-*/events/file.parquet", partitioning));
+	// Recursive glob.
+	REQUIRE(!SplitGlobPattern("s3://bucket/**/file.parquet", partitioning));
+}
+
+TEST_CASE("GetPartitionDirectoryName normalizes listed names", "[glob_partition]") {
+	REQUIRE(GetPartitionDirectoryName("s3://bucket/events/", "2024") == "2024");
+	REQUIRE(GetPartitionDirectoryName("s3://bucket/events/", "2024/") == "2024");
+	REQUIRE(GetPartitionDirectoryName("s3://bucket/events/", "s3://bucket/events/2024/") == "2024");
+	REQUIRE(GetPartitionDirectoryName("s3://bucket/events/", "2024/01") == "");
+}
+
+TEST_CASE("ListsDirectoryLevels only accepts filesystems listing one level", "[glob_partition]") {
+	REQUIRE(ListsDirectoryLevels("LocalFileSystem"));
+	REQUIRE(ListsDirectoryLevels("MockFileSystem"));
+	REQUIRE(!ListsDirectoryLevels("S3FileSystem"));
+	REQUIRE(!ListsDirectoryLevels("HTTPFileSystem"));
+}
+
+TEST_CASE("SplitGlobLevels splits into directory levels", "[glob_partition]") {
+	GlobLevels levels;
+	REQUIRE(SplitGlobLevels("s3://bucket/events/date=*/hour=*/*.parquet", levels));
+	REQUIRE(levels.base == "s3://bucket/events/");
+	const vector<string> expected_segments {"date=*", "hour=*", "*.parquet"};
+	REQUIRE(levels.segments == expected_segments);
+
+	// Wildcard only in the last segment, and literal levels below the first wildcard.
+	REQUIRE(SplitGlobLevels("/data/*.csv", levels));
+	REQUIRE(levels.base == "/data/");
+	REQUIRE(levels.segments == vector<string> {"*.csv"});
+	REQUIRE(SplitGlobLevels("/data/year=*/raw/file.csv", levels));
+	const vector<string> expected_literal_segments {"year=*", "raw", "file.csv"};
+	REQUIRE(levels.segments == expected_literal_segments);
+	REQUIRE(HasGlobWildcard("year=*"));
+	REQUIRE(!HasGlobWildcard("raw"));
+
+	// No wildcard, wildcard in the bucket name, recursive glob, or empty segment.
+	REQUIRE(!SplitGlobLevels("s3://bucket/events/file.parquet", levels));
+	REQUIRE(!SplitGlobLevels("s3://bucket-*/events/file.parquet", levels));
+	REQUIRE(!SplitGlobLevels("s3://bucket/events/**/*.parquet", levels));
+	REQUIRE(!SplitGlobLevels("s3://bucket/events/*//file.parquet", levels));
+	REQUIRE(!SplitGlobLevels("s3://bucket/events/*/", levels));
+}
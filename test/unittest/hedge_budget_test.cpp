@@ -0,0 +1,41 @@
+#include "catch/catch.hpp"
+
+#include "hedge_budget.hpp"
+
+using namespace duckdb; // NOLINT
+
+TEST_CASE("HedgeBudget starts with full burst", "[hedge_budget]") {
+	HedgeBudget budget;
+	budget.Configure(/*ratio=*/0.1, /*burst=*/2);
+	REQUIRE(budget.TryAcquire());
+	REQUIRE(budget.TryAcquire());
+	REQUIRE(!budget.TryAcquire());
+}
+
+TEST_CASE("HedgeBudget refills with primary requests", "[hedge_budget]") {
+	HedgeBudget budget;
+	budget.Configure(/*ratio=*/0.25, /*burst=*/1);
+	REQUIRE(budget.TryAcquire());
+	REQUIRE(!budget.TryAcquire());
+
+	// Four primary requests earn one hedged request.
+	for (int idx = 0; idx < 3; ++idx) {
+		budget.OnPrimaryRequest();
+		REQUIRE(!budget.TryAcquire());
+	}
+	budget.OnPrimaryRequest();
+	REQUIRE(budget.TryAcquire());
+}
+
+TEST_CASE("HedgeBudget is capped by burst", "[hedge_budget]") {
+	HedgeBudget budget;
+	budget.Configure(/*ratio=*/1.0, /*burst=*/3);
+	for (int idx = 0; idx < 100; ++idx) {
+		budget.OnPrimaryRequest();
+	}
+	REQUIRE(budget.GetAvailableTokens() == 3.0);
+
+	// Shrinking the burst clamps available tokens.
+	budget.Configure(/*ratio=*/1.0, /*burst=*/1);
+	REQUIRE(budget.GetAvailableTokens() == 1.0);
+}
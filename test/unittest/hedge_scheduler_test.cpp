@@ -0,0 +1,77 @@
+#include "catch/catch.hpp"
+
+#include "hedge_scheduler.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace duckdb; // NOLINT
+
+TEST_CASE("HedgeScheduler fires timers at deadline", "[hedge_scheduler]") {
+	HedgeScheduler scheduler;
+	std::atomic<bool> fired(false);
+	std::atomic<bool> fired_early(false);
+	const auto deadline = HedgeScheduler::Clock::now() + std::chrono::milliseconds(50);
+	scheduler.Schedule(deadline, [&](HedgeScheduler::Clock::time_point &) {
+		fired_early.store(HedgeScheduler::Clock::now() < deadline);
+		fired.store(true);
+		return false;
+	});
+	while (!fired.load()) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	REQUIRE(!fired_early.load());
+	REQUIRE(scheduler.GetPendingTimerCount() == 0);
+	// A single timer doesn't cause wakeups on every tick.
+	REQUIRE(scheduler.GetWakeupCount() < 10);
+}
+
+TEST_CASE("HedgeScheduler re-arms timers", "[hedge_scheduler]") {
+	HedgeScheduler scheduler;
+	std::atomic<int> fire_count(0);
+	scheduler.Schedule(HedgeScheduler::Clock::now() + std::chrono::milliseconds(5),
+	                   [&](HedgeScheduler::Clock::time_point &next_deadline) {
+		                   next_deadline = HedgeScheduler::Clock::now() + std::chrono::milliseconds(5);
+		                   return fire_count.fetch_add(1) + 1 < 3;
+	                   });
+	while (fire_count.load() < 3) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	REQUIRE(fire_count.load() == 3);
+	REQUIRE(scheduler.GetPendingTimerCount() == 0);
+}
+
+TEST_CASE("HedgeScheduler cancels timers", "[hedge_scheduler]") {
+	HedgeScheduler scheduler;
+	std::atomic<bool> fired(false);
+	const auto timer_id = scheduler.Schedule(HedgeScheduler::Clock::now() + std::chrono::milliseconds(50),
+	                                         [&](HedgeScheduler::Clock::time_point &) {
+		                                         fired.store(true);
+		                                         return false;
+	                                         });
+	REQUIRE(scheduler.Cancel(timer_id));
+	REQUIRE(!scheduler.Cancel(timer_id));
+	std::this_thread::sleep_for(std::chrono::milliseconds(100));
+	REQUIRE(!fired.load());
+}
+
+TEST_CASE("HedgeScheduler cancel waits for running callback", "[hedge_scheduler]") {
+	HedgeScheduler scheduler;
+	std::atomic<bool> started(false);
+	std::atomic<bool> finished(false);
+	const auto timer_id = scheduler.Schedule(HedgeScheduler::Clock::now(), [&](HedgeScheduler::Clock::time_point &) {
+		started.store(true);
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		finished.store(true);
+		return true;
+	});
+	while (!started.load()) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	REQUIRE(scheduler.Cancel(timer_id));
+	REQUIRE(finished.load());
+	// Cancelled timer isn't re-armed even though its callback asks for it.
+	REQUIRE(scheduler.GetPendingTimerCount() == 0);
+}
@@ -4,18 +4,25 @@
 #include "duckdb/common/exception.hpp"
 #include "duckdb/common/file_system.hpp"
 #include "duckdb/common/local_file_system.hpp"
+#include "duckdb/common/multi_file/multi_file_list.hpp"
+#include "duckdb/common/string_util.hpp"
 #include "duckdb/common/virtual_file_system.hpp"
 #include "duckdb/main/client_context.hpp"
 #include "duckdb/main/client_data.hpp"
 #include "duckdb/main/connection.hpp"
 #include "duckdb/main/database.hpp"
 #include "duckdb/main/config.hpp"
+#include "cancellation_token.hpp"
 #include "hedged_file_system.hpp"
 #include "hedged_request_fs_entry.hpp"
 #include "mock_file_system.hpp"
 #include "test_helpers.hpp"
 #include "test_utils.hpp"
 
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
 using namespace duckdb; // NOLINT
 
 namespace {
@@ -23,6 +30,14 @@ const string TEST_CONTENT =
     "Hello, HedgedFileSystem! This is a test file for hedged reads.\nThe quick brown fox jumps over the lazy dog.\n";
 const string FAST_TEST_CONTENT = "Fast test file\n";
 const string DB_TEST_CONTENT = "Database test file\n";
+
+// Named like httpfs's S3 filesystem, whose ListFiles lists every key under a prefix instead of one directory level.
+class ObjectStoreMockFileSystem : public MockFileSystem {
+public:
+	string GetName() const override {
+		return "S3FileSystem";
+	}
+};
 } // namespace
 
 TEST_CASE("HedgedFileSystem with slow open", "[hedged_file_system]") {
@@ -535,3 +550,1461 @@ TEST_CASE("HedgedFileSystem multiple hedged requests at threshold intervals", "[
 	file_handle->Close();
 	entry->WaitAll();
 }
+
+TEST_CASE("HedgedFileSystem hedged positional read with slow operation", "[hedged_file_system]") {
+	string test_file = TestCreatePath("hedged_test_read.txt");
+	CreateTestFile(test_file, TEST_CONTENT);
+
+	auto mock_fs = make_uniq<MockFileSystem>();
+	auto *mock_fs_ptr = mock_fs.get();
+
+	auto entry = make_shared_ptr<HedgedRequestFsEntry>();
+	auto hedged_fs = make_uniq<HedgedFileSystem>(std::move(mock_fs), entry);
+
+	entry->UpdateEnableReadHedging(true);
+	entry->UpdateConfig(HedgedRequestOperation::READ, std::chrono::milliseconds(50));
+
+	// Only handles opened for parallel access are read concurrently by hedged attempts.
+	auto sequential_handle = hedged_fs->OpenFile(test_file, FileFlags::FILE_FLAGS_READ, /*opener=*/nullptr);
+	REQUIRE(sequential_handle != nullptr);
+	array<char, 256> sequential_buffer {};
+	hedged_fs->Read(*sequential_handle, sequential_buffer.data(), NumericCast<int64_t>(TEST_CONTENT.size()),
+	                /*location=*/0);
+	REQUIRE(string(sequential_buffer.data(), TEST_CONTENT.size()) == TEST_CONTENT);
+	REQUIRE(entry->GetStats()->GetStats(HedgedRequestOperation::READ).primary_requests == 0);
+	sequential_handle->Close();
+
+	auto file_handle = hedged_fs->OpenFile(
+	    test_file, FileFlags::FILE_FLAGS_READ | FileFlags::FILE_FLAGS_PARALLEL_ACCESS, /*opener=*/nullptr);
+	REQUIRE(file_handle != nullptr);
+
+	// Slow down reads after open, so multiple hedged reads are spawned.
+	mock_fs_ptr->SetDelay(std::chrono::milliseconds(200));
+
+	array<char, 256> buffer {};
+	hedged_fs->Read(*file_handle, buffer.data(), NumericCast<int64_t>(TEST_CONTENT.size()), /*location=*/0);
+	REQUIRE(string(buffer.data(), TEST_CONTENT.size()) == TEST_CONTENT);
+
+	// Read at an offset.
+	const idx_t offset = 7;
+	const idx_t length = 15;
+	array<char, 256> partial_buffer {};
+	hedged_fs->Read(*file_handle, partial_buffer.data(), NumericCast<int64_t>(length), offset);
+	REQUIRE(string(partial_buffer.data(), length) == TEST_CONTENT.substr(offset, length));
+
+	file_handle->Close();
+	entry->WaitAll();
+
+	// Scratch buffers of losing attempts are returned to the pool after completion.
+	REQUIRE(entry->GetReadBufferPool()->GetCachedBytes() > 0);
+}
+
+TEST_CASE("HedgedFileSystem positional read without read hedging", "[hedged_file_system]") {
+	string test_file = TestCreatePath("hedged_test_read_passthrough.txt");
+	CreateTestFile(test_file, TEST_CONTENT);
+
+	auto mock_fs = make_uniq<MockFileSystem>();
+	auto entry = make_shared_ptr<HedgedRequestFsEntry>();
+	auto hedged_fs = make_uniq<HedgedFileSystem>(std::move(mock_fs), entry);
+
+	auto file_handle = hedged_fs->OpenFile(test_file, FileFlags::FILE_FLAGS_READ, /*opener=*/nullptr);
+	REQUIRE(file_handle != nullptr);
+
+	array<char, 256> buffer {};
+	hedged_fs->Read(*file_handle, buffer.data(), NumericCast<int64_t>(TEST_CONTENT.size()), /*location=*/0);
+	REQUIRE(string(buffer.data(), TEST_CONTENT.size()) == TEST_CONTENT);
+
+	// No scratch buffer is involved when read hedging is disabled.
+	REQUIRE(entry->GetReadBufferPool()->GetCachedBytes() == 0);
+
+	file_handle->Close();
+	entry->WaitAll();
+}
+
+TEST_CASE("HedgedFileSystem adaptive hedging delay", "[hedged_file_system]") {
+	string test_file = TestCreatePath("hedged_test_adaptive_delay.txt");
+	CreateTestFile(test_file, TEST_CONTENT);
+
+	auto mock_fs = make_uniq<MockFileSystem>();
+	auto entry = make_shared_ptr<HedgedRequestFsEntry>();
+	auto hedged_fs = make_uniq<HedgedFileSystem>(std::move(mock_fs), entry);
+
+	entry->UpdateEnableAdaptiveDelay(true);
+	entry->UpdateAdaptiveDelayMin(std::chrono::milliseconds(20));
+	entry->UpdateAdaptiveDelayMax(std::chrono::milliseconds(1000));
+
+	// Static delay is used before enough samples are collected.
+	const auto static_delay =
+	    std::chrono::milliseconds(DEFAULT_HEDGING_DELAYS_MS[NumericCast<size_t>(HedgedRequestOperation::FILE_EXISTS)]);
+	REQUIRE(entry->GetHedgingDelay(entry->GetConfig(), HedgedRequestOperation::FILE_EXISTS) == static_delay);
+
+	for (uint64_t idx = 0; idx < ADAPTIVE_DELAY_MIN_SAMPLE_COUNT; ++idx) {
+		REQUIRE(hedged_fs->FileExists(test_file, /*opener=*/nullptr));
+	}
+	entry->WaitAll();
+
+	// Local operations are fast, so adaptive delay is clamped to the lower bound.
+	REQUIRE(entry->GetHedgingDelay(entry->GetConfig(), HedgedRequestOperation::FILE_EXISTS) ==
+	        std::chrono::milliseconds(20));
+
+	// Other operations are not affected.
+	REQUIRE(entry->GetHedgingDelay(entry->GetConfig(), HedgedRequestOperation::GLOB) ==
+	        std::chrono::milliseconds(DEFAULT_HEDGING_DELAYS_MS[NumericCast<size_t>(HedgedRequestOperation::GLOB)]));
+
+	// Slow operations push the adaptive delay up to the upper bound.
+	auto latency_tracker = entry->GetLatencyTracker();
+	for (uint64_t idx = 0; idx < ADAPTIVE_DELAY_MIN_SAMPLE_COUNT * 100; ++idx) {
+		latency_tracker->Record(HedgedRequestOperation::FILE_EXISTS, std::chrono::seconds(5));
+	}
+	REQUIRE(entry->GetHedgingDelay(entry->GetConfig(), HedgedRequestOperation::FILE_EXISTS) ==
+	        std::chrono::milliseconds(1000));
+}
+
+TEST_CASE("HedgedRequestFsEntry decides inline execution from observed latency", "[hedged_file_system]") {
+	auto entry = make_shared_ptr<HedgedRequestFsEntry>();
+	auto latency_tracker = entry->GetLatencyTracker();
+	const auto operation = HedgedRequestOperation::FILE_EXISTS;
+	entry->UpdateInlineSamplePercent(0.0);
+
+	// Disabled by default, however fast the operation is.
+	for (uint64_t idx = 0; idx < INLINE_EXECUTION_MIN_SAMPLE_COUNT; ++idx) {
+		latency_tracker->Record(operation, std::chrono::milliseconds(1));
+	}
+	REQUIRE_FALSE(entry->ShouldRunInline(entry->GetConfig(), operation));
+
+	entry->UpdateEnableInlineExecution(true);
+	REQUIRE(entry->ShouldRunInline(entry->GetConfig(), operation));
+	// Operations without enough samples keep hedging.
+	REQUIRE_FALSE(entry->ShouldRunInline(entry->GetConfig(), HedgedRequestOperation::GLOB));
+
+	// Every other call is sampled through the hedged path, starting from the first one.
+	entry->UpdateInlineSamplePercent(50.0);
+	REQUIRE_FALSE(entry->ShouldRunInline(entry->GetConfig(), operation));
+	REQUIRE(entry->ShouldRunInline(entry->GetConfig(), operation));
+	REQUIRE_FALSE(entry->ShouldRunInline(entry->GetConfig(), operation));
+	REQUIRE_THROWS_AS(entry->UpdateInlineSamplePercent(101.0), InvalidInputException);
+
+	// Tail latency approaching the hedging delay switches back to hedging.
+	entry->UpdateInlineSamplePercent(0.0);
+	entry->UpdateConfig(operation, std::chrono::milliseconds(2));
+	REQUIRE_FALSE(entry->ShouldRunInline(entry->GetConfig(), operation));
+	entry->UpdateConfig(operation, std::chrono::milliseconds(100));
+	REQUIRE(entry->ShouldRunInline(entry->GetConfig(), operation));
+	for (uint64_t idx = 0; idx < INLINE_EXECUTION_MIN_SAMPLE_COUNT / 10; ++idx) {
+		latency_tracker->Record(operation, std::chrono::milliseconds(80));
+	}
+	REQUIRE_FALSE(entry->ShouldRunInline(entry->GetConfig(), operation));
+
+	// Prefix policy scopes inline execution to the paths under it.
+	entry->UpdateEnableInlineExecution(false);
+	entry->UpdateConfig(operation, std::chrono::milliseconds(1000));
+	entry->SetPolicy(HedgingPolicyScope::PREFIX, "s3://fast-bucket/", "enable_inline_execution", 1);
+	REQUIRE(entry->ShouldRunInline(entry->GetConfig("S3FileSystem", "s3://fast-bucket/file"), operation));
+	REQUIRE_FALSE(entry->ShouldRunInline(entry->GetConfig("S3FileSystem", "s3://slow-bucket/file"), operation));
+}
+
+TEST_CASE("HedgedFileSystem runs calls inline while latency stays below the hedging delay", "[hedged_file_system]") {
+	string test_file = TestCreatePath("hedged_test_inline_execution.txt");
+	CreateTestFile(test_file, TEST_CONTENT);
+
+	auto mock_fs = make_uniq<MockFileSystem>();
+	auto *mock_fs_ptr = mock_fs.get();
+	auto entry = make_shared_ptr<HedgedRequestFsEntry>();
+	auto hedged_fs = make_uniq<HedgedFileSystem>(std::move(mock_fs), entry);
+	entry->UpdateEnableInlineExecution(true);
+	entry->UpdateInlineSamplePercent(25.0);
+
+	// Calls are hedged until enough samples are collected.
+	for (uint64_t idx = 0; idx < INLINE_EXECUTION_MIN_SAMPLE_COUNT; ++idx) {
+		REQUIRE(hedged_fs->FileExists(test_file, /*opener=*/nullptr));
+	}
+	entry->WaitAll();
+	auto stats = entry->GetStats()->GetStats(HedgedRequestOperation::FILE_EXISTS);
+	REQUIRE(stats.inline_requests == 0);
+
+	// Local operations never get near the hedging delay, so all calls but sampled ones run inline.
+	entry->GetStats()->Reset();
+	for (idx_t idx = 0; idx < 8; ++idx) {
+		REQUIRE(hedged_fs->FileExists(test_file, /*opener=*/nullptr));
+	}
+	entry->WaitAll();
+	stats = entry->GetStats()->GetStats(HedgedRequestOperation::FILE_EXISTS);
+	REQUIRE(stats.primary_requests == 8);
+	REQUIRE(stats.inline_requests == 6);
+	REQUIRE(stats.pending_attempts == 0);
+
+	// Regressed backend raises the tail latency, so calls go back to the hedged path.
+	entry->UpdateConfig(HedgedRequestOperation::FILE_EXISTS, std::chrono::milliseconds(20));
+	mock_fs_ptr->SetDelay(std::chrono::milliseconds(30));
+	entry->UpdateInlineSamplePercent(100.0);
+	for (uint64_t idx = 0; idx < INLINE_EXECUTION_MIN_SAMPLE_COUNT / 100; ++idx) {
+		REQUIRE(hedged_fs->FileExists(test_file, /*opener=*/nullptr));
+	}
+	entry->WaitAll();
+	entry->UpdateInlineSamplePercent(0.0);
+	entry->GetStats()->Reset();
+	REQUIRE(hedged_fs->FileExists(test_file, /*opener=*/nullptr));
+	entry->WaitAll();
+	stats = entry->GetStats()->GetStats(HedgedRequestOperation::FILE_EXISTS);
+	REQUIRE(stats.inline_requests == 0);
+	REQUIRE(stats.hedged_requests >= 1);
+}
+
+TEST_CASE("HedgedFileSystem hedge budget bounds hedged requests", "[hedged_file_system]") {
+	string test_file = TestCreatePath("hedged_test_hedge_budget.txt");
+	CreateTestFile(test_file, TEST_CONTENT);
+
+	auto mock_fs = make_uniq<MockFileSystem>();
+	auto *mock_fs_ptr = mock_fs.get();
+	auto entry = make_shared_ptr<HedgedRequestFsEntry>();
+	auto hedged_fs = make_uniq<HedgedFileSystem>(std::move(mock_fs), entry);
+
+	entry->UpdateConfig(HedgedRequestOperation::FILE_EXISTS, std::chrono::milliseconds(20));
+	entry->UpdateEnableHedgeBudget(true);
+	entry->UpdateHedgeBudgetPercent(0.0);
+	entry->UpdateHedgeBudgetBurst(1);
+	mock_fs_ptr->SetDelay(std::chrono::milliseconds(200));
+
+	// Only one hedged request is allowed by the burst.
+	REQUIRE(hedged_fs->FileExists(test_file, /*opener=*/nullptr));
+	entry->WaitAll();
+	REQUIRE(mock_fs_ptr->GetIoOperationCount() == 2);
+
+	// Budget is exhausted, so no hedged request is spawned.
+	REQUIRE(hedged_fs->FileExists(test_file, /*opener=*/nullptr));
+	entry->WaitAll();
+	REQUIRE(mock_fs_ptr->GetIoOperationCount() == 3);
+}
+
+TEST_CASE("HedgedFileSystem cancels losing attempts", "[hedged_file_system]") {
+	string test_file = TestCreatePath("hedged_test_cancellation.txt");
+	CreateTestFile(test_file, TEST_CONTENT);
+
+	auto mock_fs = make_uniq<MockFileSystem>();
+	mock_fs->SetDelay(std::chrono::milliseconds(1000));
+	auto entry = make_shared_ptr<HedgedRequestFsEntry>();
+	auto hedged_fs = make_uniq<HedgedFileSystem>(std::move(mock_fs), entry);
+	entry->UpdateConfig(HedgedRequestOperation::FILE_EXISTS, std::chrono::milliseconds(200));
+
+	// Hedged attempts are aborted once the primary completes, instead of sleeping for the whole delay.
+	const auto start = std::chrono::steady_clock::now();
+	REQUIRE(hedged_fs->FileExists(test_file, /*opener=*/nullptr));
+	entry->WaitAll();
+	const auto elapsed = std::chrono::steady_clock::now() - start;
+	REQUIRE(elapsed < std::chrono::milliseconds(1150));
+}
+
+TEST_CASE("HedgedRequestFsEntry tracks in-flight attempts", "[hedged_file_system]") {
+	auto entry = make_shared_ptr<HedgedRequestFsEntry>();
+	std::atomic<int> finished(0);
+	for (int idx = 0; idx < 8; ++idx) {
+		entry->SubmitAttempt([&finished]() {
+			std::this_thread::sleep_for(std::chrono::milliseconds(50));
+			finished.fetch_add(1);
+		});
+	}
+	entry->SubmitAttempt([]() { throw std::runtime_error("attempt failure"); });
+	REQUIRE(entry->GetInFlightAttemptCount() > 0);
+
+	// Attempts deregister themselves, including the failed one.
+	entry->WaitAll();
+	REQUIRE(entry->GetInFlightAttemptCount() == 0);
+	REQUIRE(finished.load() == 8);
+}
+
+TEST_CASE("HedgedRequestFsEntry shutdown drops queued attempts", "[hedged_file_system]") {
+	auto entry = make_shared_ptr<HedgedRequestFsEntry>();
+	entry->UpdateThreadPoolMinThreads(1);
+	entry->UpdateThreadPoolMaxThreads(1);
+	// Workers beyond the max count retire asynchronously.
+	while (entry->GetThreadPool().GetThreadCount() > 1) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	std::atomic<bool> release(false);
+	std::atomic<bool> cancelled(false);
+	std::atomic<int> started(0);
+	// Hung attempt which ignores cancellation, and only observes it.
+	entry->SubmitAttempt([&]() {
+		started.fetch_add(1);
+		while (!release.load()) {
+			auto token = CancellationToken::GetCurrent();
+			if (token && token->IsCancelled()) {
+				cancelled.store(true);
+			}
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	});
+	// Queued behind the hung attempt on the only worker.
+	entry->SubmitAttempt([&started]() { started.fetch_add(1); });
+	while (started.load() == 0) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	const auto start = std::chrono::steady_clock::now();
+	REQUIRE_FALSE(entry->Shutdown(std::chrono::milliseconds(50)));
+	REQUIRE(std::chrono::steady_clock::now() - start < std::chrono::milliseconds(1000));
+	REQUIRE(cancelled.load());
+	// Attempts submitted after shutdown are dropped as well.
+	entry->SubmitAttempt([&started]() { started.fetch_add(1); });
+
+	release.store(true);
+	REQUIRE(entry->Shutdown(std::chrono::milliseconds(5000)));
+	REQUIRE(entry->GetInFlightAttemptCount() == 0);
+	REQUIRE(started.load() == 1);
+}
+
+TEST_CASE("HedgedRequestFsEntry abandons straggling attempts on destruction", "[hedged_file_system]") {
+	string test_file = TestCreatePath("hedged_test_abandon.txt");
+	CreateTestFile(test_file, TEST_CONTENT);
+	auto entry = make_shared_ptr<HedgedRequestFsEntry>();
+	entry->UpdateShutdownTimeout(std::chrono::milliseconds(50));
+	entry->UpdateHandlePoolMaxHandles(4);
+	// Shared with the attempt, which outlives the test's stack frame otherwise.
+	auto release = make_shared_ptr<std::atomic<bool>>(false);
+	auto started = make_shared_ptr<std::atomic<bool>>(false);
+	auto finished = make_shared_ptr<std::atomic<bool>>(false);
+	auto local_fs = make_shared_ptr<LocalFileSystem>();
+	// Late attempts may still pool the handles they opened, after the entry is gone.
+	auto *pool = &entry->GetFileHandlePool();
+	entry->SubmitAttempt([release, started, finished, local_fs, pool, test_file]() {
+		started->store(true);
+		while (!release->load()) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+		auto handle = MakeSharedFileHandle(local_fs->OpenFile(test_file, FileFlags::FILE_FLAGS_READ));
+		pool->Put(test_file, FileFlags::FILE_FLAGS_READ.GetFlagsInternal(), std::move(handle), PooledHandleVersion {});
+		finished->store(true);
+	});
+	// Attempts which haven't started by shutdown are dropped.
+	while (!started->load()) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	// Destruction returns once the timeout passes, instead of blocking on the hung attempt.
+	const auto start = std::chrono::steady_clock::now();
+	entry.reset();
+	REQUIRE(std::chrono::steady_clock::now() - start < std::chrono::milliseconds(1000));
+	REQUIRE_FALSE(finished->load());
+
+	// The abandoned attempt still runs to completion on the thread pool kept alive in background.
+	release->store(true);
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+	while (!finished->load() && std::chrono::steady_clock::now() < deadline) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	REQUIRE(finished->load());
+}
+
+TEST_CASE("HedgedFileSystem prefix policy", "[hedged_file_system]") {
+	string hot_file = TestCreatePath("hedged_test_policy_hot.txt");
+	CreateTestFile(hot_file, TEST_CONTENT);
+
+	auto mock_fs = make_uniq<MockFileSystem>();
+	auto *mock_fs_ptr = mock_fs.get();
+	auto entry = make_shared_ptr<HedgedRequestFsEntry>();
+	auto hedged_fs = make_uniq<HedgedFileSystem>(std::move(mock_fs), entry);
+
+	// Globally hedging never kicks in, while the hot file gets hedged quickly.
+	entry->UpdateConfig(HedgedRequestOperation::FILE_EXISTS, std::chrono::milliseconds(100000));
+	entry->SetPolicy(HedgingPolicyScope::PREFIX, hot_file, "file_exists_delay_ms", 20);
+	entry->SetPolicy(HedgingPolicyScope::PREFIX, hot_file, "max_hedged_request_count", 2);
+	mock_fs_ptr->SetDelay(std::chrono::milliseconds(200));
+
+	REQUIRE(hedged_fs->FileExists(hot_file, /*opener=*/nullptr));
+	entry->WaitAll();
+	REQUIRE(mock_fs_ptr->GetIoOperationCount() == 2);
+
+	// Policy for another filesystem doesn't apply.
+	entry->ClearPolicies();
+	entry->SetPolicy(HedgingPolicyScope::FILESYSTEM, "S3FileSystem", "file_exists_delay_ms", 20);
+	REQUIRE(hedged_fs->FileExists(hot_file, /*opener=*/nullptr));
+	entry->WaitAll();
+	REQUIRE(mock_fs_ptr->GetIoOperationCount() == 3);
+}
+
+TEST_CASE("HedgedFileSystem records hedged request stats", "[hedged_file_system]") {
+	string test_file = TestCreatePath("hedged_test_stats.txt");
+	CreateTestFile(test_file, TEST_CONTENT);
+
+	auto mock_fs = make_uniq<MockFileSystem>();
+	auto *mock_fs_ptr = mock_fs.get();
+	auto entry = make_shared_ptr<HedgedRequestFsEntry>();
+	auto hedged_fs = make_uniq<HedgedFileSystem>(std::move(mock_fs), entry);
+	entry->UpdateConfig(HedgedRequestOperation::FILE_EXISTS, std::chrono::milliseconds(100));
+	entry->UpdateMaxHedgedRequestCount(2);
+
+	// Fast call completes without hedging.
+	REQUIRE(hedged_fs->FileExists(test_file, /*opener=*/nullptr));
+	entry->WaitAll();
+	auto stats = entry->GetStats()->GetStats(HedgedRequestOperation::FILE_EXISTS);
+	REQUIRE(stats.primary_requests == 1);
+	REQUIRE(stats.hedged_requests == 0);
+	REQUIRE(stats.pending_attempts == 0);
+
+	// Primary request is slow, while the hedged request issued afterwards completes immediately and wins.
+	mock_fs_ptr->SetDelay(std::chrono::milliseconds(1000));
+	std::thread speed_up([mock_fs_ptr]() {
+		std::this_thread::sleep_for(std::chrono::milliseconds(30));
+		mock_fs_ptr->SetDelay(std::chrono::milliseconds(0));
+	});
+	REQUIRE(hedged_fs->FileExists(test_file, /*opener=*/nullptr));
+	speed_up.join();
+	entry->WaitAll();
+
+	stats = entry->GetStats()->GetStats(HedgedRequestOperation::FILE_EXISTS);
+	REQUIRE(stats.primary_requests == 2);
+	REQUIRE(stats.hedged_requests == 1);
+	REQUIRE(stats.hedge_wins == 1);
+	// Cancelled primary is not accounted as failure.
+	REQUIRE(stats.failed_attempts == 0);
+	REQUIRE(stats.pending_attempts == 0);
+	uint64_t latency_samples = 0;
+	for (auto count : stats.latency_histogram) {
+		latency_samples += count;
+	}
+	REQUIRE(latency_samples == 2);
+
+	entry->GetStats()->Reset();
+	stats = entry->GetStats()->GetStats(HedgedRequestOperation::FILE_EXISTS);
+	REQUIRE(stats.primary_requests == 0);
+	REQUIRE(stats.hedge_wins == 0);
+}
+
+TEST_CASE("HedgedFileSystem serves metadata from cache", "[hedged_file_system]") {
+	string test_file = TestCreatePath("hedged_test_metadata_cache.txt");
+	CreateTestFile(test_file, TEST_CONTENT);
+
+	auto mock_fs = make_uniq<MockFileSystem>();
+	auto *mock_fs_ptr = mock_fs.get();
+	auto entry = make_shared_ptr<HedgedRequestFsEntry>();
+	auto metadata_cache = make_shared_ptr<MetadataCache>();
+	metadata_cache->SetEnabled(true);
+	auto hedged_fs = make_uniq<HedgedFileSystem>(std::move(mock_fs), entry, metadata_cache);
+
+	REQUIRE(hedged_fs->FileExists(test_file, /*opener=*/nullptr));
+	REQUIRE(hedged_fs->FileExists(test_file, /*opener=*/nullptr));
+	entry->WaitAll();
+	REQUIRE(mock_fs_ptr->GetIoOperationCount() == 1);
+
+	{
+		auto handle = hedged_fs->OpenFile(test_file, FileFlags::FILE_FLAGS_READ, /*opener=*/nullptr);
+		entry->WaitAll();
+		const auto io_count = mock_fs_ptr->GetIoOperationCount();
+		REQUIRE(hedged_fs->GetFileSize(*handle) == static_cast<int64_t>(TEST_CONTENT.size()));
+		REQUIRE(hedged_fs->GetFileSize(*handle) == static_cast<int64_t>(TEST_CONTENT.size()));
+		entry->WaitAll();
+		REQUIRE(mock_fs_ptr->GetIoOperationCount() == io_count + 1);
+	}
+
+	// Removing the file through the wrapper invalidates cached metadata.
+	hedged_fs->RemoveFile(test_file);
+	REQUIRE(!hedged_fs->FileExists(test_file, /*opener=*/nullptr));
+}
+
+TEST_CASE("HedgedFileSystem coalesces concurrent identical requests", "[hedged_file_system]") {
+	string test_file = TestCreatePath("hedged_test_coalescing.txt");
+	CreateTestFile(test_file, TEST_CONTENT);
+
+	auto mock_fs = make_uniq<MockFileSystem>();
+	auto *mock_fs_ptr = mock_fs.get();
+	auto entry = make_shared_ptr<HedgedRequestFsEntry>();
+	auto hedged_fs = make_uniq<HedgedFileSystem>(std::move(mock_fs), entry);
+	mock_fs_ptr->SetDelay(std::chrono::milliseconds(300));
+	entry->UpdateEnableRequestCoalescing(true);
+
+	// All callers join while the first request is in flight, so only one request reaches the wrapped filesystem.
+	constexpr int CALLER_COUNT = 4;
+	vector<std::thread> threads;
+	std::atomic<int> exists_count(0);
+	for (int idx = 0; idx < CALLER_COUNT; ++idx) {
+		threads.emplace_back([&]() {
+			if (hedged_fs->FileExists(test_file, /*opener=*/nullptr)) {
+				exists_count.fetch_add(1);
+			}
+		});
+	}
+	for (auto &cur_thread : threads) {
+		cur_thread.join();
+	}
+	entry->WaitAll();
+	REQUIRE(exists_count.load() == CALLER_COUNT);
+	REQUIRE(mock_fs_ptr->GetIoOperationCount() == 1);
+
+	// Every caller gets its own file handle.
+	vector<unique_ptr<FileHandle>> handles(CALLER_COUNT);
+	threads.clear();
+	for (int idx = 0; idx < CALLER_COUNT; ++idx) {
+		threads.emplace_back([&, idx]() {
+			handles[idx] = hedged_fs->OpenFile(test_file, FileFlags::FILE_FLAGS_READ, /*opener=*/nullptr);
+		});
+	}
+	for (auto &cur_thread : threads) {
+		cur_thread.join();
+	}
+	for (auto &cur_handle : handles) {
+		REQUIRE(cur_handle != nullptr);
+	}
+
+	// Coalescing could be disabled.
+	entry->UpdateEnableRequestCoalescing(false);
+	const auto io_count = mock_fs_ptr->GetIoOperationCount();
+	threads.clear();
+	for (int idx = 0; idx < CALLER_COUNT; ++idx) {
+		threads.emplace_back([&]() { hedged_fs->FileExists(test_file, /*opener=*/nullptr); });
+	}
+	for (auto &cur_thread : threads) {
+		cur_thread.join();
+	}
+	entry->WaitAll();
+	REQUIRE(mock_fs_ptr->GetIoOperationCount() == io_count + CALLER_COUNT);
+}
+
+TEST_CASE("HedgedFileSystem doesn't coalesce requests of different clients", "[hedged_file_system]") {
+	string test_file = TestCreatePath("hedged_test_coalescing_openers.txt");
+	CreateTestFile(test_file, TEST_CONTENT);
+
+	DuckDB db;
+	Connection con1(db);
+	Connection con2(db);
+	auto *opener1 = ClientData::Get(*con1.context).file_opener.get();
+	auto *opener2 = ClientData::Get(*con2.context).file_opener.get();
+
+	auto mock_fs = make_uniq<MockFileSystem>();
+	auto *mock_fs_ptr = mock_fs.get();
+	auto entry = make_shared_ptr<HedgedRequestFsEntry>();
+	auto hedged_fs = make_uniq<HedgedFileSystem>(std::move(mock_fs), entry);
+	mock_fs_ptr->SetDelay(std::chrono::milliseconds(300));
+	entry->UpdateEnableRequestCoalescing(true);
+
+	// Both requests are in flight at once, but the wrapped filesystem resolves settings and secrets through each
+	// opener, so each client issues its own request.
+	bool other_exists = false;
+	std::thread other_client([&]() { other_exists = hedged_fs->FileExists(test_file, opener2); });
+	REQUIRE(hedged_fs->FileExists(test_file, opener1));
+	other_client.join();
+	REQUIRE(other_exists);
+	entry->WaitAll();
+	REQUIRE(mock_fs_ptr->GetIoOperationCount() == 2);
+
+	// Requests on handles are coalesced within the client which opened the handle.
+	auto handle1 = hedged_fs->OpenFile(test_file, FileFlags::FILE_FLAGS_READ, opener1);
+	auto handle2 = hedged_fs->OpenFile(test_file, FileFlags::FILE_FLAGS_READ, opener2);
+	const auto io_count = mock_fs_ptr->GetIoOperationCount();
+	int64_t other_file_size = 0;
+	other_client = std::thread([&]() { other_file_size = hedged_fs->GetFileSize(*handle2); });
+	REQUIRE(hedged_fs->GetFileSize(*handle1) == NumericCast<int64_t>(TEST_CONTENT.size()));
+	other_client.join();
+	REQUIRE(other_file_size == NumericCast<int64_t>(TEST_CONTENT.size()));
+	entry->WaitAll();
+	REQUIRE(mock_fs_ptr->GetIoOperationCount() == io_count + 2);
+}
+
+TEST_CASE("HedgedFileSystem streams listing pages from the winning attempt", "[hedged_file_system]") {
+	constexpr int FILE_COUNT = 5;
+	string test_dir = TestCreatePath("hedged_test_streaming_list_dir");
+	auto local_fs = FileSystem::CreateLocal();
+	local_fs->CreateDirectory(test_dir);
+	for (int idx = 0; idx < FILE_COUNT; ++idx) {
+		CreateTestFile(local_fs->JoinPath(test_dir, StringUtil::Format("file%d.txt", idx)), TEST_CONTENT);
+	}
+
+	auto mock_fs = make_uniq<MockFileSystem>();
+	mock_fs->SetDelay(std::chrono::milliseconds(100));
+	auto entry = make_shared_ptr<HedgedRequestFsEntry>();
+	entry->UpdateEnableStreamingListing(true);
+	entry->UpdateListingPageSize(2);
+	entry->UpdateConfig(HedgedRequestOperation::LIST_FILES, std::chrono::milliseconds(10));
+	entry->UpdateConfig(HedgedRequestOperation::GLOB, std::chrono::milliseconds(10));
+	auto hedged_fs = make_uniq<HedgedFileSystem>(std::move(mock_fs), entry);
+
+	// Only the winning attempt is forwarded, so no entry is duplicated even though hedged attempts list as well.
+	vector<string> files;
+	bool success = hedged_fs->ListFiles(
+	    test_dir, [&files](const string &name, bool is_dir) { files.push_back(name); }, /*opener=*/nullptr);
+	REQUIRE(success);
+	REQUIRE(files.size() == FILE_COUNT);
+
+	// Glob expands lazily from the stream.
+	FileSystem &fs = *hedged_fs;
+	auto file_list =
+	    fs.Glob(local_fs->JoinPath(test_dir, "file*.txt"), FileGlobOptions::ALLOW_EMPTY, /*opener=*/nullptr);
+	REQUIRE(file_list->GetAllFiles().size() == FILE_COUNT);
+
+	// Caller stops consuming early, and remaining attempts are stopped.
+	entry->UpdateListingPageSize(1);
+	REQUIRE_THROWS_AS(hedged_fs->ListFiles(
+	                      test_dir, [](const string &name, bool is_dir) { throw IOException("stop listing"); },
+	                      /*opener=*/nullptr),
+	                  IOException);
+
+	// Materialized listing is still supported.
+	entry->UpdateEnableStreamingListing(false);
+	files.clear();
+	success = hedged_fs->ListFiles(
+	    test_dir, [&files](const string &name, bool is_dir) { files.push_back(name); }, /*opener=*/nullptr);
+	REQUIRE(success);
+	REQUIRE(files.size() == FILE_COUNT);
+	entry->WaitAll();
+}
+
+TEST_CASE("HedgedFileSystem parallel glob across partitions", "[hedged_file_system]") {
+	constexpr int PARTITION_COUNT = 4;
+	string test_dir = TestCreatePath("hedged_test_parallel_glob_dir");
+	auto local_fs = FileSystem::CreateLocal();
+	local_fs->CreateDirectory(test_dir);
+	for (int idx = 0; idx < PARTITION_COUNT; ++idx) {
+		const auto partition_dir = local_fs->JoinPath(test_dir, StringUtil::Format("part%d", idx));
+		local_fs->CreateDirectory(partition_dir);
+		CreateTestFile(local_fs->JoinPath(partition_dir, "file.txt"), TEST_CONTENT);
+		CreateTestFile(local_fs->JoinPath(partition_dir, "file.csv"), TEST_CONTENT);
+	}
+
+	auto mock_fs = make_uniq<MockFileSystem>();
+	mock_fs->SetDelay(std::chrono::milliseconds(100));
+	auto entry = make_shared_ptr<HedgedRequestFsEntry>();
+	auto hedged_fs = make_uniq<HedgedFileSystem>(std::move(mock_fs), entry);
+	const auto pattern = local_fs->JoinPath(local_fs->JoinPath(test_dir, "part*"), "*.txt");
+
+	auto sequential_files = hedged_fs->Glob(pattern, /*opener=*/nullptr);
+	REQUIRE(sequential_files.size() == PARTITION_COUNT);
+
+	// Partitions are listed concurrently, and merged in partition order.
+	entry->UpdateGlobParallelism(PARTITION_COUNT);
+	const auto start = std::chrono::steady_clock::now();
+	auto parallel_files = hedged_fs->Glob(pattern, /*opener=*/nullptr);
+	const auto elapsed = std::chrono::steady_clock::now() - start;
+	REQUIRE(parallel_files.size() == PARTITION_COUNT);
+	for (int idx = 0; idx < PARTITION_COUNT; ++idx) {
+		REQUIRE(StringUtil::Contains(parallel_files[idx].path, StringUtil::Format("part%d", idx)));
+	}
+	// One listing to discover partitions, and one round of concurrent partition listings.
+	REQUIRE(elapsed < std::chrono::milliseconds(100 * PARTITION_COUNT));
+
+	FileSystem &fs = *hedged_fs;
+	auto file_list = fs.Glob(pattern, FileGlobOptions::ALLOW_EMPTY, /*opener=*/nullptr);
+	REQUIRE(file_list->GetAllFiles().size() == PARTITION_COUNT);
+	entry->WaitAll();
+}
+
+TEST_CASE("HedgedFileSystem parallel glob with more partitions than threads", "[hedged_file_system]") {
+	constexpr int PARTITION_COUNT = 4;
+	string test_dir = TestCreatePath("hedged_test_parallel_glob_small_pool_dir");
+	auto local_fs = FileSystem::CreateLocal();
+	local_fs->CreateDirectory(test_dir);
+	for (int idx = 0; idx < PARTITION_COUNT; ++idx) {
+		const auto partition_dir = local_fs->JoinPath(test_dir, StringUtil::Format("part%d", idx));
+		local_fs->CreateDirectory(partition_dir);
+		CreateTestFile(local_fs->JoinPath(partition_dir, "file.txt"), TEST_CONTENT);
+	}
+
+	auto mock_fs = make_uniq<MockFileSystem>();
+	mock_fs->SetDelay(std::chrono::milliseconds(20));
+	auto entry = make_shared_ptr<HedgedRequestFsEntry>();
+	auto hedged_fs = make_uniq<HedgedFileSystem>(std::move(mock_fs), entry);
+	entry->UpdateThreadPoolMinThreads(1);
+	entry->UpdateThreadPoolMaxThreads(1);
+	entry->UpdateConfig(HedgedRequestOperation::GLOB, std::chrono::milliseconds(10));
+	entry->UpdateGlobParallelism(PARTITION_COUNT);
+
+	// Partition globs are started from the caller, so their attempts never wait behind them on the only worker.
+	const auto pattern = local_fs->JoinPath(local_fs->JoinPath(test_dir, "part*"), "*.txt");
+	auto files = hedged_fs->Glob(pattern, /*opener=*/nullptr);
+	REQUIRE(files.size() == PARTITION_COUNT);
+	for (int idx = 0; idx < PARTITION_COUNT; ++idx) {
+		REQUIRE(StringUtil::Contains(files[idx].path, StringUtil::Format("part%d", idx)));
+	}
+	REQUIRE(entry->GetThreadPool().GetThreadCount() <= 1);
+	entry->WaitAll();
+}
+
+TEST_CASE("HedgedFileSystem doesn't partition globs without delimiter listing", "[hedged_file_system]") {
+	constexpr int PARTITION_COUNT = 4;
+	string test_dir = TestCreatePath("hedged_test_object_store_glob_dir");
+	auto local_fs = FileSystem::CreateLocal();
+	local_fs->CreateDirectory(test_dir);
+	for (int idx = 0; idx < PARTITION_COUNT; ++idx) {
+		const auto partition_dir = local_fs->JoinPath(test_dir, StringUtil::Format("part%d", idx));
+		local_fs->CreateDirectory(partition_dir);
+		CreateTestFile(local_fs->JoinPath(partition_dir, "file.txt"), TEST_CONTENT);
+	}
+
+	auto entry = make_shared_ptr<HedgedRequestFsEntry>();
+	auto hedged_fs = make_uniq<HedgedFileSystem>(make_uniq<ObjectStoreMockFileSystem>(), entry);
+	entry->UpdateGlobParallelism(PARTITION_COUNT);
+
+	// Discovering partitions would be a full recursive listing, so the pattern goes to the wrapped glob as a whole.
+	const auto pattern = local_fs->JoinPath(local_fs->JoinPath(test_dir, "part*"), "*.txt");
+	auto files = hedged_fs->Glob(pattern, /*opener=*/nullptr);
+	REQUIRE(files.size() == PARTITION_COUNT);
+	auto stats = entry->GetStats();
+	REQUIRE(stats->GetStats(HedgedRequestOperation::GLOB).primary_requests == 1);
+	REQUIRE(stats->GetStats(HedgedRequestOperation::LIST_FILES).primary_requests == 0);
+	entry->WaitAll();
+}
+
+TEST_CASE("HedgedFileSystem expands globs from cached listings", "[hedged_file_system]") {
+	constexpr int PARTITION_COUNT = 3;
+	string test_dir = TestCreatePath("hedged_test_listing_cache_dir");
+	auto local_fs = FileSystem::CreateLocal();
+	local_fs->CreateDirectory(test_dir);
+	auto get_partition_dir = [&](int idx) {
+		return local_fs->JoinPath(local_fs->JoinPath(test_dir, StringUtil::Format("date=%d", idx)), "hour=0");
+	};
+	for (int idx = 0; idx < PARTITION_COUNT; ++idx) {
+		local_fs->CreateDirectory(local_fs->JoinPath(test_dir, StringUtil::Format("date=%d", idx)));
+		local_fs->CreateDirectory(get_partition_dir(idx));
+		CreateTestFile(local_fs->JoinPath(get_partition_dir(idx), "file.parquet"), TEST_CONTENT);
+		CreateTestFile(local_fs->JoinPath(get_partition_dir(idx), "file.csv"), TEST_CONTENT);
+	}
+
+	auto mock_fs = make_uniq<MockFileSystem>();
+	auto *mock_fs_ptr = mock_fs.get();
+	auto entry = make_shared_ptr<HedgedRequestFsEntry>();
+	auto listing_cache = make_shared_ptr<ListingCache>();
+	listing_cache->SetEnabled(true);
+	auto hedged_fs =
+	    make_uniq<HedgedFileSystem>(std::move(mock_fs), entry, /*metadata_cache_p=*/nullptr, listing_cache);
+	const auto pattern = test_dir + "/date=*/hour=*/*.parquet";
+
+	auto cold_files = hedged_fs->Glob(pattern, /*opener=*/nullptr);
+	REQUIRE(cold_files.size() == PARTITION_COUNT);
+	for (int idx = 0; idx < PARTITION_COUNT; ++idx) {
+		REQUIRE(cold_files[idx].path == local_fs->JoinPath(get_partition_dir(idx), "file.parquet"));
+	}
+	entry->WaitAll();
+
+	// Warm globs are served from cached listings, without reaching the wrapped filesystem.
+	const auto io_operation_count = mock_fs_ptr->GetIoOperationCount();
+	auto warm_files = hedged_fs->Glob(pattern, /*opener=*/nullptr);
+	REQUIRE(warm_files.size() == PARTITION_COUNT);
+	FileSystem &fs = *hedged_fs;
+	REQUIRE(fs.Glob(pattern, FileGlobOptions::ALLOW_EMPTY, /*opener=*/nullptr)->GetAllFiles().size() ==
+	        PARTITION_COUNT);
+	vector<string> names;
+	REQUIRE(hedged_fs->ListFiles(
+	    test_dir, [&names](const string &name, bool is_dir) { names.push_back(name); }, /*opener=*/nullptr));
+	REQUIRE(names.size() == PARTITION_COUNT);
+	REQUIRE(mock_fs_ptr->GetIoOperationCount() == io_operation_count);
+
+	// Removing a file through the hedged filesystem drops listings of its ancestors.
+	hedged_fs->RemoveFile(local_fs->JoinPath(get_partition_dir(1), "file.parquet"));
+	REQUIRE(hedged_fs->Glob(pattern, /*opener=*/nullptr).size() == PARTITION_COUNT - 1);
+
+	// So do creating a directory and a file.
+	hedged_fs->CreateDirectory(local_fs->JoinPath(test_dir, StringUtil::Format("date=%d", PARTITION_COUNT)));
+	hedged_fs->CreateDirectory(get_partition_dir(PARTITION_COUNT));
+	auto handle = hedged_fs->OpenFile(local_fs->JoinPath(get_partition_dir(PARTITION_COUNT), "file.parquet"),
+	                                  FileFlags::FILE_FLAGS_WRITE | FileFlags::FILE_FLAGS_FILE_CREATE,
+	                                  /*opener=*/nullptr);
+	handle->Close();
+	REQUIRE(hedged_fs->Glob(pattern, /*opener=*/nullptr).size() == PARTITION_COUNT);
+	entry->WaitAll();
+}
+
+TEST_CASE("HedgedFileSystem doesn't expand globs from listings without delimiter listing", "[hedged_file_system]") {
+	string test_dir = TestCreatePath("hedged_test_object_store_listing_dir");
+	auto local_fs = FileSystem::CreateLocal();
+	local_fs->CreateDirectory(test_dir);
+	local_fs->CreateDirectory(local_fs->JoinPath(test_dir, "date=0"));
+	CreateTestFile(local_fs->JoinPath(local_fs->JoinPath(test_dir, "date=0"), "file.parquet"), TEST_CONTENT);
+
+	auto mock_fs = make_uniq<ObjectStoreMockFileSystem>();
+	auto *mock_fs_ptr = mock_fs.get();
+	auto entry = make_shared_ptr<HedgedRequestFsEntry>();
+	auto listing_cache = make_shared_ptr<ListingCache>();
+	listing_cache->SetEnabled(true);
+	auto hedged_fs =
+	    make_uniq<HedgedFileSystem>(std::move(mock_fs), entry, /*metadata_cache_p=*/nullptr, listing_cache);
+	const auto pattern = test_dir + "/date=*/*.parquet";
+
+	// A listing there covers every key under the prefix instead of one level, so warm globs still reach the wrapped
+	// filesystem.
+	REQUIRE(hedged_fs->Glob(pattern, /*opener=*/nullptr).size() == 1);
+	const auto io_operation_count = mock_fs_ptr->GetIoOperationCount();
+	REQUIRE(hedged_fs->Glob(pattern, /*opener=*/nullptr).size() == 1);
+	REQUIRE(mock_fs_ptr->GetIoOperationCount() > io_operation_count);
+	REQUIRE(entry->GetStats()->GetStats(HedgedRequestOperation::GLOB).primary_requests == 2);
+
+	// ListFiles results are still cached.
+	idx_t listed_count = 0;
+	auto list = [&]() {
+		return hedged_fs->ListFiles(
+		    test_dir, [&listed_count](const string &, bool) { ++listed_count; }, /*opener=*/nullptr);
+	};
+	REQUIRE(list());
+	const auto listed_io_operation_count = mock_fs_ptr->GetIoOperationCount();
+	REQUIRE(list());
+	REQUIRE(mock_fs_ptr->GetIoOperationCount() == listed_io_operation_count);
+	REQUIRE(listed_count == 2);
+	entry->WaitAll();
+}
+
+TEST_CASE("HedgedFileSystem lists cold glob levels on a single IO thread", "[hedged_file_system]") {
+	constexpr int PARTITION_COUNT = 3;
+	string test_dir = TestCreatePath("hedged_test_listing_cache_small_pool_dir");
+	auto local_fs = FileSystem::CreateLocal();
+	local_fs->CreateDirectory(test_dir);
+	for (int idx = 0; idx < PARTITION_COUNT; ++idx) {
+		const auto partition_dir = local_fs->JoinPath(test_dir, StringUtil::Format("date=%d", idx));
+		local_fs->CreateDirectory(partition_dir);
+		CreateTestFile(local_fs->JoinPath(partition_dir, "file.parquet"), TEST_CONTENT);
+	}
+
+	auto mock_fs = make_uniq<MockFileSystem>();
+	mock_fs->SetDelay(std::chrono::milliseconds(20));
+	auto entry = make_shared_ptr<HedgedRequestFsEntry>();
+	entry->UpdateThreadPoolMinThreads(1);
+	entry->UpdateThreadPoolMaxThreads(1);
+	entry->UpdateConfig(HedgedRequestOperation::LIST_FILES, std::chrono::milliseconds(10));
+	entry->UpdateGlobParallelism(PARTITION_COUNT);
+	auto listing_cache = make_shared_ptr<ListingCache>();
+	listing_cache->SetEnabled(true);
+	auto hedged_fs =
+	    make_uniq<HedgedFileSystem>(std::move(mock_fs), entry, /*metadata_cache_p=*/nullptr, listing_cache);
+
+	// Directories of the last level are listed by hedged listings started from the caller, so their attempts never
+	// wait behind them on the only worker.
+	auto files = hedged_fs->Glob(test_dir + "/date=*/*.parquet", /*opener=*/nullptr);
+	REQUIRE(files.size() == PARTITION_COUNT);
+	REQUIRE(entry->GetThreadPool().GetThreadCount() <= 1);
+	entry->WaitAll();
+}
+
+TEST_CASE("HedgedFileSystem chunked positional read", "[hedged_file_system]") {
+	string test_file = TestCreatePath("hedged_test_chunked_read.txt");
+	CreateTestFile(test_file, TEST_CONTENT);
+
+	auto mock_fs = make_uniq<MockFileSystem>();
+	auto *mock_fs_ptr = mock_fs.get();
+	auto entry = make_shared_ptr<HedgedRequestFsEntry>();
+	auto hedged_fs = make_uniq<HedgedFileSystem>(std::move(mock_fs), entry);
+
+	// Chunk size doesn't divide read size, so the last chunk is partial.
+	entry->UpdateEnableChunkedRead(true);
+	entry->UpdateChunkedReadThreshold(16);
+	entry->UpdateChunkedReadChunkSize(7);
+
+	// Reads of handles not opened for parallel access are never split.
+	auto sequential_handle = hedged_fs->OpenFile(test_file, FileFlags::FILE_FLAGS_READ, /*opener=*/nullptr);
+	REQUIRE(sequential_handle != nullptr);
+	auto read_count = mock_fs_ptr->GetIoOperationCount();
+	array<char, 256> sequential_buffer {};
+	hedged_fs->Read(*sequential_handle, sequential_buffer.data(), NumericCast<int64_t>(TEST_CONTENT.size()),
+	                /*location=*/0);
+	REQUIRE(string(sequential_buffer.data(), TEST_CONTENT.size()) == TEST_CONTENT);
+	REQUIRE(mock_fs_ptr->GetIoOperationCount() == read_count + 1);
+	sequential_handle->Close();
+
+	auto file_handle = hedged_fs->OpenFile(
+	    test_file, FileFlags::FILE_FLAGS_READ | FileFlags::FILE_FLAGS_PARALLEL_ACCESS, /*opener=*/nullptr);
+	REQUIRE(file_handle != nullptr);
+	read_count = mock_fs_ptr->GetIoOperationCount();
+
+	array<char, 256> buffer {};
+	hedged_fs->Read(*file_handle, buffer.data(), NumericCast<int64_t>(TEST_CONTENT.size()), /*location=*/0);
+	REQUIRE(string(buffer.data(), TEST_CONTENT.size()) == TEST_CONTENT);
+	REQUIRE(mock_fs_ptr->GetIoOperationCount() == read_count + (TEST_CONTENT.size() + 6) / 7);
+
+	// Reads no larger than the threshold are issued as one request.
+	const idx_t offset = 5;
+	const idx_t length = 16;
+	array<char, 256> small_buffer {};
+	hedged_fs->Read(*file_handle, small_buffer.data(), NumericCast<int64_t>(length), offset);
+	REQUIRE(string(small_buffer.data(), length) == TEST_CONTENT.substr(offset, length));
+
+	// Every chunk is hedged on its own with read hedging.
+	entry->UpdateEnableReadHedging(true);
+	entry->UpdateConfig(HedgedRequestOperation::READ, std::chrono::milliseconds(50));
+	mock_fs_ptr->SetDelay(std::chrono::milliseconds(100));
+	array<char, 256> hedged_buffer {};
+	const idx_t hedged_length = TEST_CONTENT.size() - offset;
+	hedged_fs->Read(*file_handle, hedged_buffer.data(), NumericCast<int64_t>(hedged_length), offset);
+	REQUIRE(string(hedged_buffer.data(), hedged_length) == TEST_CONTENT.substr(offset));
+
+	file_handle->Close();
+	entry->WaitAll();
+}
+
+TEST_CASE("HedgedFileSystem chunked hedged read with more chunks than threads", "[hedged_file_system]") {
+	string test_file = TestCreatePath("hedged_test_chunked_read_small_pool.txt");
+	CreateTestFile(test_file, TEST_CONTENT);
+
+	auto mock_fs = make_uniq<MockFileSystem>();
+	mock_fs->SetDelay(std::chrono::milliseconds(20));
+	auto entry = make_shared_ptr<HedgedRequestFsEntry>();
+	auto hedged_fs = make_uniq<HedgedFileSystem>(std::move(mock_fs), entry);
+	entry->UpdateThreadPoolMinThreads(1);
+	entry->UpdateThreadPoolMaxThreads(2);
+	entry->UpdateEnableReadHedging(true);
+	entry->UpdateConfig(HedgedRequestOperation::READ, std::chrono::milliseconds(10));
+	entry->UpdateEnableChunkedRead(true);
+	entry->UpdateChunkedReadThreshold(8);
+	entry->UpdateChunkedReadChunkSize(8);
+
+	auto file_handle = hedged_fs->OpenFile(
+	    test_file, FileFlags::FILE_FLAGS_READ | FileFlags::FILE_FLAGS_PARALLEL_ACCESS, /*opener=*/nullptr);
+	REQUIRE(file_handle != nullptr);
+
+	// Hedged chunks outnumber workers, but no worker waits on attempts queued behind it, so the read completes.
+	array<char, 256> buffer {};
+	hedged_fs->Read(*file_handle, buffer.data(), NumericCast<int64_t>(TEST_CONTENT.size()), /*location=*/0);
+	REQUIRE(string(buffer.data(), TEST_CONTENT.size()) == TEST_CONTENT);
+	REQUIRE(entry->GetThreadPool().GetThreadCount() <= 2);
+
+	file_handle->Close();
+	entry->WaitAll();
+}
+
+TEST_CASE("HedgedFileSystem read-ahead for sequential reads", "[hedged_file_system]") {
+	string test_file = TestCreatePath("hedged_test_read_ahead.txt");
+	CreateTestFile(test_file, TEST_CONTENT);
+
+	auto mock_fs = make_uniq<MockFileSystem>();
+	auto entry = make_shared_ptr<HedgedRequestFsEntry>();
+	auto hedged_fs = make_uniq<HedgedFileSystem>(std::move(mock_fs), entry);
+	entry->UpdateEnableReadAhead(true);
+	entry->UpdateReadAheadBlockSize(8);
+	entry->UpdateReadAheadWindowBlocks(4);
+
+	// Handles not opened for parallel access are read directly, since block fetches would read them concurrently.
+	array<char, 5> buffer {};
+	auto sequential_handle = hedged_fs->OpenFile(test_file, FileFlags::FILE_FLAGS_READ, /*opener=*/nullptr);
+	REQUIRE(sequential_handle != nullptr);
+	for (int idx = 0; idx < 4; ++idx) {
+		hedged_fs->Read(*sequential_handle, buffer.data(), NumericCast<int64_t>(buffer.size()));
+	}
+	REQUIRE(sequential_handle->Cast<HedgedFileHandle>().GetSequentialReadState().window == nullptr);
+	sequential_handle->Close();
+
+	auto file_handle = hedged_fs->OpenFile(
+	    test_file, FileFlags::FILE_FLAGS_READ | FileFlags::FILE_FLAGS_PARALLEL_ACCESS, /*opener=*/nullptr);
+	REQUIRE(file_handle != nullptr);
+
+	// Read front to back in small pieces, read-ahead takes over once sequential reads are detected.
+	string result;
+	while (true) {
+		const auto bytes_read = hedged_fs->Read(*file_handle, buffer.data(), NumericCast<int64_t>(buffer.size()));
+		if (bytes_read == 0) {
+			break;
+		}
+		result.append(buffer.data(), NumericCast<size_t>(bytes_read));
+		REQUIRE(hedged_fs->SeekPosition(*file_handle) == result.size());
+	}
+	REQUIRE(result == TEST_CONTENT);
+	auto &state = file_handle->Cast<HedgedFileHandle>().GetSequentialReadState();
+	REQUIRE(state.window != nullptr);
+
+	// Seek stops read-ahead, and reads continue from the new position.
+	hedged_fs->Seek(*file_handle, 10);
+	REQUIRE(state.window == nullptr);
+	REQUIRE(hedged_fs->Read(*file_handle, buffer.data(), NumericCast<int64_t>(buffer.size())) ==
+	        NumericCast<int64_t>(buffer.size()));
+	REQUIRE(string(buffer.data(), buffer.size()) == TEST_CONTENT.substr(10, buffer.size()));
+
+	// Disabling read-ahead hands the position back to the wrapped handle.
+	hedged_fs->Read(*file_handle, buffer.data(), NumericCast<int64_t>(buffer.size()));
+	REQUIRE(state.window != nullptr);
+	entry->UpdateEnableReadAhead(false);
+	REQUIRE(hedged_fs->Read(*file_handle, buffer.data(), NumericCast<int64_t>(buffer.size())) ==
+	        NumericCast<int64_t>(buffer.size()));
+	REQUIRE(string(buffer.data(), buffer.size()) == TEST_CONTENT.substr(20, buffer.size()));
+	REQUIRE(state.window == nullptr);
+
+	file_handle->Close();
+	entry->WaitAll();
+}
+
+TEST_CASE("HedgedFileSystem hedges from the scheduler", "[hedged_file_system]") {
+	string test_file = TestCreatePath("hedged_test_scheduler.txt");
+	CreateTestFile(test_file, TEST_CONTENT);
+
+	auto mock_fs = make_uniq<MockFileSystem>();
+	mock_fs->SetDelay(std::chrono::milliseconds(200));
+	auto entry = make_shared_ptr<HedgedRequestFsEntry>();
+	entry->UpdateConfig(HedgedRequestOperation::FILE_EXISTS, std::chrono::milliseconds(20));
+	entry->UpdateMaxHedgedRequestCount(2);
+	auto hedged_fs = make_uniq<HedgedFileSystem>(std::move(mock_fs), entry);
+
+	const auto wakeup_count = entry->GetHedgeScheduler().GetWakeupCount();
+	REQUIRE(hedged_fs->FileExists(test_file, /*opener=*/nullptr));
+	// Timer is dropped once max hedged request count is reached, instead of waking up every hedging delay.
+	REQUIRE(entry->GetHedgeScheduler().GetPendingTimerCount() == 0);
+	REQUIRE(entry->GetHedgeScheduler().GetWakeupCount() - wakeup_count < 10);
+	REQUIRE(entry->GetStats()->GetStats(HedgedRequestOperation::FILE_EXISTS).hedged_requests == 1);
+	entry->WaitAll();
+}
+
+TEST_CASE("HedgedFileSystem write-behind", "[hedged_file_system]") {
+	string test_file = TestCreatePath("hedged_test_write_behind.txt");
+
+	auto mock_fs = make_uniq<MockFileSystem>();
+	mock_fs->SetDelay(std::chrono::milliseconds(20));
+	auto entry = make_shared_ptr<HedgedRequestFsEntry>();
+	auto hedged_fs = make_uniq<HedgedFileSystem>(std::move(mock_fs), entry);
+	entry->UpdateEnableWriteBehind(true);
+	entry->UpdateWriteBehindPartSize(8);
+	entry->UpdateWriteBehindMaxOutstandingParts(2);
+
+	auto file_handle = hedged_fs->OpenFile(
+	    test_file, FileFlags::FILE_FLAGS_WRITE | FileFlags::FILE_FLAGS_FILE_CREATE_NEW, /*opener=*/nullptr);
+	REQUIRE(file_handle != nullptr);
+
+	// Non-positional writes are buffered, and the logical position moves forward.
+	string content = TEST_CONTENT;
+	for (idx_t offset = 0; offset < content.size(); offset += 5) {
+		const auto nr_bytes = MinValue<idx_t>(5, content.size() - offset);
+		REQUIRE(hedged_fs->Write(*file_handle, &content[offset], NumericCast<int64_t>(nr_bytes)) ==
+		        NumericCast<int64_t>(nr_bytes));
+		REQUIRE(hedged_fs->SeekPosition(*file_handle) == offset + nr_bytes);
+	}
+	auto &state = file_handle->Cast<HedgedFileHandle>().GetWriteBehindState();
+	REQUIRE(state.buffer != nullptr);
+
+	// Sync waits for all parts, and hands the position back to the wrapped handle.
+	hedged_fs->FileSync(*file_handle);
+	REQUIRE(state.buffer == nullptr);
+	REQUIRE(hedged_fs->SeekPosition(*file_handle) == content.size());
+	REQUIRE(hedged_fs->GetFileSize(*file_handle) == NumericCast<int64_t>(content.size()));
+
+	// Positional writes are buffered as well, and awaited by metadata calls and on close.
+	hedged_fs->Write(*file_handle, &content[0], /*nr_bytes=*/4, /*location=*/NumericCast<idx_t>(content.size()));
+	REQUIRE(state.buffer != nullptr);
+	hedged_fs->GetLastModifiedTime(*file_handle);
+	REQUIRE(state.buffer == nullptr);
+	hedged_fs->Write(*file_handle, &content[0], /*nr_bytes=*/4, /*location=*/NumericCast<idx_t>(content.size()));
+	file_handle->Close();
+	file_handle.reset();
+
+	auto local_fs = FileSystem::CreateLocal();
+	auto read_handle = local_fs->OpenFile(test_file, FileFlags::FILE_FLAGS_READ);
+	string result(content.size() + 4, '\0');
+	local_fs->Read(*read_handle, &result[0], NumericCast<int64_t>(result.size()), /*location=*/0);
+	REQUIRE(result == content + content.substr(0, 4));
+}
+
+TEST_CASE("HedgedFileSystem hedges part writes", "[hedged_file_system]") {
+	string test_file = TestCreatePath("hedged_test_write_hedging.txt");
+
+	auto mock_fs = make_uniq<MockFileSystem>();
+	mock_fs->SetDelay(std::chrono::milliseconds(100));
+	auto entry = make_shared_ptr<HedgedRequestFsEntry>();
+	auto hedged_fs = make_uniq<HedgedFileSystem>(std::move(mock_fs), entry);
+	entry->UpdateEnableWriteBehind(true);
+	entry->UpdateWriteBehindPartSize(8);
+	entry->UpdateConfig(HedgedRequestOperation::WRITE, std::chrono::milliseconds(20));
+	// Positional writes of local files are idempotent.
+	entry->SetPolicy(HedgingPolicyScope::FILESYSTEM, "MockFileSystem", "enable_write_hedging", 1);
+
+	auto file_handle = hedged_fs->OpenFile(
+	    test_file, FileFlags::FILE_FLAGS_WRITE | FileFlags::FILE_FLAGS_FILE_CREATE_NEW, /*opener=*/nullptr);
+	REQUIRE(file_handle != nullptr);
+	string content = TEST_CONTENT;
+	hedged_fs->Write(*file_handle, &content[0], /*nr_bytes=*/8, /*location=*/0);
+	hedged_fs->FileSync(*file_handle);
+	REQUIRE(entry->GetStats()->GetStats(HedgedRequestOperation::WRITE).hedged_requests >= 1);
+	file_handle->Close();
+	file_handle.reset();
+	entry->WaitAll();
+
+	auto local_fs = FileSystem::CreateLocal();
+	auto read_handle = local_fs->OpenFile(test_file, FileFlags::FILE_FLAGS_READ);
+	string result(8, '\0');
+	local_fs->Read(*read_handle, &result[0], NumericCast<int64_t>(result.size()), /*location=*/0);
+	REQUIRE(result == content.substr(0, 8));
+}
+
+TEST_CASE("HedgedFileSystem hedged write-behind on a single IO thread", "[hedged_file_system]") {
+	string test_file = TestCreatePath("hedged_test_write_hedging_small_pool.txt");
+
+	auto mock_fs = make_uniq<MockFileSystem>();
+	mock_fs->SetDelay(std::chrono::milliseconds(20));
+	auto entry = make_shared_ptr<HedgedRequestFsEntry>();
+	auto hedged_fs = make_uniq<HedgedFileSystem>(std::move(mock_fs), entry);
+	entry->UpdateThreadPoolMinThreads(1);
+	entry->UpdateThreadPoolMaxThreads(1);
+	entry->UpdateEnableWriteBehind(true);
+	entry->UpdateWriteBehindPartSize(8);
+	entry->UpdateWriteBehindMaxOutstandingParts(2);
+	entry->UpdateConfig(HedgedRequestOperation::WRITE, std::chrono::milliseconds(10));
+	entry->SetPolicy(HedgingPolicyScope::FILESYSTEM, "MockFileSystem", "enable_write_hedging", 1);
+
+	auto file_handle = hedged_fs->OpenFile(
+	    test_file, FileFlags::FILE_FLAGS_WRITE | FileFlags::FILE_FLAGS_FILE_CREATE_NEW, /*opener=*/nullptr);
+	REQUIRE(file_handle != nullptr);
+
+	// Parts outnumber workers, but part writes never wait on attempts queued behind them, so the flush completes.
+	string content = TEST_CONTENT;
+	hedged_fs->Write(*file_handle, &content[0], NumericCast<int64_t>(content.size()), /*location=*/0);
+	hedged_fs->FileSync(*file_handle);
+	REQUIRE(entry->GetThreadPool().GetThreadCount() <= 1);
+	file_handle->Close();
+	file_handle.reset();
+	entry->WaitAll();
+
+	auto local_fs = FileSystem::CreateLocal();
+	auto read_handle = local_fs->OpenFile(test_file, FileFlags::FILE_FLAGS_READ);
+	string result(content.size(), '\0');
+	local_fs->Read(*read_handle, &result[0], NumericCast<int64_t>(result.size()), /*location=*/0);
+	REQUIRE(result == content);
+}
+
+TEST_CASE("HedgedFileSystem prefetches files returned by glob", "[hedged_file_system]") {
+	string test_file1 = TestCreatePath("hedged_open_prefetch1.txt");
+	string test_file2 = TestCreatePath("hedged_open_prefetch2.txt");
+	CreateTestFile(test_file1, TEST_CONTENT);
+	CreateTestFile(test_file2, TEST_CONTENT);
+
+	auto mock_fs = make_uniq<MockFileSystem>();
+	mock_fs->SetDelay(std::chrono::milliseconds(20));
+	auto *mock_fs_ptr = mock_fs.get();
+	auto entry = make_shared_ptr<HedgedRequestFsEntry>();
+	auto hedged_fs = make_uniq<HedgedFileSystem>(std::move(mock_fs), entry);
+	entry->UpdateOpenPrefetchFileCount(1);
+	auto &prefetch_cache = entry->GetOpenPrefetchCache();
+
+	const string glob_pattern = TestCreatePath("hedged_open_prefetch*.txt");
+	auto files = hedged_fs->Glob(glob_pattern, /*opener=*/nullptr);
+	REQUIRE(files.size() == 2);
+	entry->WaitAll();
+	// Only the first file is prefetched.
+	REQUIRE(prefetch_cache.GetHandleCount() == 1);
+
+	// The open takes the prefetched handle, without any IO.
+	const auto io_count = mock_fs_ptr->GetIoOperationCount();
+	auto file_handle = hedged_fs->OpenFile(files[0].path, FileFlags::FILE_FLAGS_READ, /*opener=*/nullptr);
+	REQUIRE(file_handle != nullptr);
+	REQUIRE(mock_fs_ptr->GetIoOperationCount() == io_count);
+	REQUIRE(prefetch_cache.GetHandleCount() == 0);
+	array<char, 256> buffer {};
+	hedged_fs->Read(*file_handle, buffer.data(), NumericCast<int64_t>(TEST_CONTENT.size()), /*location=*/0);
+	REQUIRE(string(buffer.data(), TEST_CONTENT.size()) == TEST_CONTENT);
+	file_handle->Close();
+
+	// Opening for write drops the prefetched handle.
+	files = hedged_fs->Glob(glob_pattern, /*opener=*/nullptr);
+	auto write_handle = hedged_fs->OpenFile(files[0].path, FileFlags::FILE_FLAGS_WRITE, /*opener=*/nullptr);
+	entry->WaitAll();
+	REQUIRE(prefetch_cache.GetHandleCount() == 0);
+	write_handle->Close();
+	entry->WaitAll();
+}
+
+TEST_CASE("HedgedFileSystem prefetches files on a single IO thread", "[hedged_file_system]") {
+	string test_file1 = TestCreatePath("hedged_open_prefetch_small_pool1.txt");
+	string test_file2 = TestCreatePath("hedged_open_prefetch_small_pool2.txt");
+	CreateTestFile(test_file1, TEST_CONTENT);
+	CreateTestFile(test_file2, TEST_CONTENT);
+
+	auto mock_fs = make_uniq<MockFileSystem>();
+	mock_fs->SetDelay(std::chrono::milliseconds(20));
+	auto entry = make_shared_ptr<HedgedRequestFsEntry>();
+	auto hedged_fs = make_uniq<HedgedFileSystem>(std::move(mock_fs), entry);
+	entry->UpdateThreadPoolMinThreads(1);
+	entry->UpdateThreadPoolMaxThreads(1);
+	entry->UpdateConfig(HedgedRequestOperation::OPEN_FILE, std::chrono::milliseconds(5));
+	entry->UpdateOpenPrefetchFileCount(2);
+
+	// The prefetched open is started without blocking, so no worker waits on its attempts queued behind it.
+	auto files = hedged_fs->Glob(TestCreatePath("hedged_open_prefetch_small_pool*.txt"), /*opener=*/nullptr);
+	REQUIRE(files.size() == 2);
+	entry->WaitAll();
+	REQUIRE(entry->GetOpenPrefetchCache().GetHandleCount() == 2);
+	REQUIRE(entry->GetThreadPool().GetThreadCount() <= 1);
+}
+
+TEST_CASE("HedgedFileSystem pools handles of losing opens", "[hedged_file_system]") {
+	string test_file = TestCreatePath("hedged_handle_pool.txt");
+	CreateTestFile(test_file, TEST_CONTENT);
+
+	auto mock_fs = make_uniq<MockFileSystem>();
+	mock_fs->SetDelay(std::chrono::milliseconds(100));
+	auto *mock_fs_ptr = mock_fs.get();
+	auto entry = make_shared_ptr<HedgedRequestFsEntry>();
+	entry->UpdateConfig(HedgedRequestOperation::OPEN_FILE, std::chrono::milliseconds(20));
+	entry->UpdateMaxHedgedRequestCount(2);
+	entry->UpdateHandlePoolMaxHandles(4);
+	auto metadata_cache = make_shared_ptr<MetadataCache>();
+	metadata_cache->SetEnabled(true);
+	auto hedged_fs = make_uniq<HedgedFileSystem>(std::move(mock_fs), entry, metadata_cache);
+	auto &pool = entry->GetFileHandlePool();
+
+	// The hedged open loses the race, and its handle goes into the pool.
+	auto file_handle = hedged_fs->OpenFile(test_file, FileFlags::FILE_FLAGS_READ, /*opener=*/nullptr);
+	REQUIRE(file_handle != nullptr);
+	entry->WaitAll();
+	REQUIRE(entry->GetStats()->GetStats(HedgedRequestOperation::OPEN_FILE).hedged_requests == 1);
+	REQUIRE(pool.GetHandleCount() == 1);
+
+	// Without a cached file version the pooled handle could be stale, so it's closed instead of reused.
+	auto unpooled_handle = hedged_fs->OpenFile(test_file, FileFlags::FILE_FLAGS_READ, /*opener=*/nullptr);
+	entry->WaitAll();
+	REQUIRE(entry->GetStats()->GetStats(HedgedRequestOperation::OPEN_FILE).hedged_requests == 2);
+	REQUIRE(pool.GetHandleCount() == 1);
+	unpooled_handle.reset();
+	REQUIRE(pool.GetHandleCount() == 2);
+
+	// The next open takes the pooled handle without any IO, once the file version is cached.
+	hedged_fs->GetLastModifiedTime(*file_handle);
+	const auto io_count = mock_fs_ptr->GetIoOperationCount();
+	auto pooled_handle = hedged_fs->OpenFile(test_file, FileFlags::FILE_FLAGS_READ, /*opener=*/nullptr);
+	REQUIRE(pooled_handle != nullptr);
+	REQUIRE(mock_fs_ptr->GetIoOperationCount() == io_count);
+	REQUIRE(pool.GetHandleCount() == 1);
+
+	// Destroyed handles go back into the pool, rewound for the next owner.
+	array<char, 8> buffer {};
+	REQUIRE(hedged_fs->Read(*pooled_handle, buffer.data(), 5) == 5);
+	pooled_handle.reset();
+	file_handle.reset();
+	REQUIRE(pool.GetHandleCount() == 3);
+	pooled_handle = hedged_fs->OpenFile(test_file, FileFlags::FILE_FLAGS_READ, /*opener=*/nullptr);
+	REQUIRE(hedged_fs->Read(*pooled_handle, buffer.data(), 5) == 5);
+	REQUIRE(string(buffer.data(), 5) == TEST_CONTENT.substr(0, 5));
+
+	// Writing the file drops its pooled handles.
+	auto write_handle = hedged_fs->OpenFile(test_file, FileFlags::FILE_FLAGS_WRITE, /*opener=*/nullptr);
+	REQUIRE(pool.GetHandleCount() == 0);
+	write_handle.reset();
+	pooled_handle.reset();
+	entry->WaitAll();
+}
+
+TEST_CASE("HedgedFileSystem drops pooled handles under a removed directory", "[hedged_file_system]") {
+	string test_dir = TestCreatePath("hedged_handle_pool_dir");
+	auto local_fs = FileSystem::CreateLocal();
+	local_fs->CreateDirectory(test_dir);
+	const auto test_file = local_fs->JoinPath(test_dir, "file.txt");
+	CreateTestFile(test_file, TEST_CONTENT);
+
+	auto mock_fs = make_uniq<MockFileSystem>();
+	mock_fs->SetDelay(std::chrono::milliseconds(100));
+	auto entry = make_shared_ptr<HedgedRequestFsEntry>();
+	entry->UpdateConfig(HedgedRequestOperation::OPEN_FILE, std::chrono::milliseconds(20));
+	entry->UpdateMaxHedgedRequestCount(2);
+	entry->UpdateHandlePoolMaxHandles(4);
+	auto metadata_cache = make_shared_ptr<MetadataCache>();
+	metadata_cache->SetEnabled(true);
+	auto hedged_fs = make_uniq<HedgedFileSystem>(std::move(mock_fs), entry, metadata_cache);
+	auto &pool = entry->GetFileHandlePool();
+
+	auto file_handle = hedged_fs->OpenFile(test_file, FileFlags::FILE_FLAGS_READ, /*opener=*/nullptr);
+	REQUIRE(file_handle != nullptr);
+	entry->WaitAll();
+	file_handle.reset();
+	REQUIRE(pool.GetHandleCount() == 2);
+
+	// Files under the directory are removed along with it, so are their handles.
+	hedged_fs->RemoveDirectory(test_dir, /*opener=*/nullptr);
+	REQUIRE(pool.GetHandleCount() == 0);
+	REQUIRE_FALSE(local_fs->FileExists(test_file));
+}
+
+TEST_CASE("HedgedFileSystem closes wrapped handles which aren't pooled", "[hedged_file_system]") {
+	string test_file = TestCreatePath("hedged_handle_close.txt");
+	CreateTestFile(test_file, TEST_CONTENT);
+
+	auto mock_fs = make_uniq<MockFileSystem>();
+	mock_fs->SetDelay(std::chrono::milliseconds(100));
+	auto entry = make_shared_ptr<HedgedRequestFsEntry>();
+	entry->UpdateConfig(HedgedRequestOperation::OPEN_FILE, std::chrono::milliseconds(20));
+	entry->UpdateMaxHedgedRequestCount(2);
+	entry->UpdateHandlePoolMaxHandles(4);
+	auto hedged_fs = make_uniq<HedgedFileSystem>(std::move(mock_fs), entry);
+	auto &pool = entry->GetFileHandlePool();
+
+	// Without the metadata cache handles aren't pooled, neither those of losing opens nor closed ones.
+	auto file_handle = hedged_fs->OpenFile(test_file, FileFlags::FILE_FLAGS_READ, /*opener=*/nullptr);
+	REQUIRE(file_handle != nullptr);
+	entry->WaitAll();
+	REQUIRE(entry->GetStats()->GetStats(HedgedRequestOperation::OPEN_FILE).hedged_requests == 1);
+	REQUIRE(pool.GetHandleCount() == 0);
+
+	// Closing the hedged handle closes the wrapped one right away.
+	weak_ptr<FileHandle> wrapped_handle = file_handle->Cast<HedgedFileHandle>().GetWrappedHandlePtr();
+	file_handle->Close();
+	REQUIRE(wrapped_handle.expired());
+	REQUIRE(pool.GetHandleCount() == 0);
+	array<char, 8> buffer {};
+	REQUIRE_THROWS_AS(hedged_fs->Read(*file_handle, buffer.data(), 5), IOException);
+	file_handle.reset();
+}
+
+TEST_CASE("HedgedFileSystem sends hedged attempts to replicas", "[hedged_file_system]") {
+	const string primary_prefix = TestCreatePath("hedged_replica_primary_");
+	const string mirror_prefix = TestCreatePath("hedged_replica_mirror_");
+	CreateTestFile(primary_prefix + "data.txt", TEST_CONTENT);
+	CreateTestFile(mirror_prefix + "data.txt", FAST_TEST_CONTENT);
+	// Only exists on the mirror, so existence checks served by the primary return false.
+	CreateTestFile(mirror_prefix + "mirror_only.txt", FAST_TEST_CONTENT);
+
+	auto mock_fs = make_uniq<MockFileSystem>();
+	mock_fs->SetPathDelay(primary_prefix, std::chrono::milliseconds(2000));
+	auto *mock_fs_ptr = mock_fs.get();
+	auto entry = make_shared_ptr<HedgedRequestFsEntry>();
+	entry->UpdateConfig(HedgedRequestOperation::OPEN_FILE, std::chrono::milliseconds(20));
+	entry->UpdateConfig(HedgedRequestOperation::FILE_EXISTS, std::chrono::milliseconds(20));
+	entry->UpdateMaxHedgedRequestCount(2);
+	entry->AddReplica(primary_prefix, mirror_prefix);
+	auto hedged_fs = make_uniq<HedgedFileSystem>(std::move(mock_fs), entry);
+
+	// The primary attempt is stuck on its original path, while the hedged attempt is served by the mirror.
+	const auto start = std::chrono::steady_clock::now();
+	auto file_handle = hedged_fs->OpenFile(primary_prefix + "data.txt", FileFlags::FILE_FLAGS_READ,
+	                                       /*opener=*/nullptr);
+	REQUIRE(file_handle != nullptr);
+	REQUIRE(std::chrono::steady_clock::now() - start < std::chrono::milliseconds(1000));
+	array<char, 256> buffer {};
+	const auto bytes_read =
+	    hedged_fs->Read(*file_handle, buffer.data(), NumericCast<int64_t>(FAST_TEST_CONTENT.size()));
+	REQUIRE(string(buffer.data(), NumericCast<size_t>(bytes_read)) == FAST_TEST_CONTENT);
+	REQUIRE(hedged_fs->FileExists(primary_prefix + "mirror_only.txt", /*opener=*/nullptr));
+	file_handle.reset();
+	entry->WaitAll();
+
+	// A failed replica attempt falls back to the original path, instead of failing the request.
+	entry->ClearReplicas();
+	entry->AddReplica(primary_prefix, TestCreatePath("hedged_replica_missing_"));
+	mock_fs_ptr->SetPathDelay(primary_prefix, std::chrono::milliseconds(300));
+	const auto io_count = mock_fs_ptr->GetIoOperationCount();
+	file_handle = hedged_fs->OpenFile(primary_prefix + "data.txt", FileFlags::FILE_FLAGS_READ, /*opener=*/nullptr);
+	REQUIRE(file_handle != nullptr);
+	entry->WaitAll();
+	REQUIRE(mock_fs_ptr->GetIoOperationCount() == io_count + 3);
+	file_handle.reset();
+}
+
+TEST_CASE("HedgedFileSystem ties attempts queued in a saturated thread pool", "[hedged_file_system]") {
+	string test_file = TestCreatePath("hedged_tied_requests.txt");
+	CreateTestFile(test_file, TEST_CONTENT);
+
+	auto mock_fs = make_uniq<MockFileSystem>();
+	auto *mock_fs_ptr = mock_fs.get();
+	auto entry = make_shared_ptr<HedgedRequestFsEntry>();
+	entry->UpdateConfig(HedgedRequestOperation::FILE_EXISTS, std::chrono::milliseconds(100000));
+	entry->UpdateMaxHedgedRequestCount(2);
+	auto &thread_pool = entry->GetThreadPool();
+	thread_pool.SetThreadLimits(/*min_thread_num=*/1, /*max_thread_num=*/1);
+	auto hedged_fs = make_uniq<HedgedFileSystem>(std::move(mock_fs), entry);
+	auto wait_until = [](const std::function<bool()> &predicate) {
+		const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+		while (!predicate() && std::chrono::steady_clock::now() < deadline) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+		return predicate();
+	};
+	REQUIRE(wait_until([&thread_pool]() { return thread_pool.GetThreadCount() == 1; }));
+
+	// Block the only worker, so the primary request queues up and a tied hedge is submitted right away.
+	std::atomic<bool> started(false);
+	std::atomic<bool> release(false);
+	entry->SubmitAttempt([&started, &release]() {
+		started.store(true);
+		while (!release.load()) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	});
+	REQUIRE(wait_until([&started]() { return started.load(); }));
+	std::atomic<bool> file_exists(false);
+	std::thread caller([&]() { file_exists.store(hedged_fs->FileExists(test_file, /*opener=*/nullptr)); });
+	const bool hedged = wait_until(
+	    [&entry]() { return entry->GetStats()->GetStats(HedgedRequestOperation::FILE_EXISTS).hedged_requests > 0; });
+	release.store(true);
+	caller.join();
+	REQUIRE(hedged);
+	entry->WaitAll();
+
+	// Only one of the tied attempts reaches the wrapped filesystem.
+	REQUIRE(file_exists.load());
+	REQUIRE(mock_fs_ptr->GetIoOperationCount() == 1);
+	auto stats = entry->GetStats()->GetStats(HedgedRequestOperation::FILE_EXISTS);
+	REQUIRE(stats.hedged_requests == 1);
+	REQUIRE(stats.skipped_attempts == 1);
+	REQUIRE(stats.pending_attempts == 0);
+}
+
+TEST_CASE("HedgedFileSystem suppresses hedges while the thread pool is backed up", "[hedged_file_system]") {
+	string test_file = TestCreatePath("hedged_suppressed_hedges.txt");
+	CreateTestFile(test_file, TEST_CONTENT);
+
+	auto mock_fs = make_uniq<MockFileSystem>();
+	auto entry = make_shared_ptr<HedgedRequestFsEntry>();
+	entry->UpdateConfig(HedgedRequestOperation::FILE_EXISTS, std::chrono::milliseconds(5));
+	entry->UpdateMaxHedgedRequestCount(3);
+	entry->UpdateEnableTiedRequests(false);
+	entry->UpdateHedgeMaxQueueDepth(1);
+	auto &thread_pool = entry->GetThreadPool();
+	thread_pool.SetThreadLimits(/*min_thread_num=*/1, /*max_thread_num=*/1);
+	auto hedged_fs = make_uniq<HedgedFileSystem>(std::move(mock_fs), entry);
+	auto wait_until = [](const std::function<bool()> &predicate) {
+		const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+		while (!predicate() && std::chrono::steady_clock::now() < deadline) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+		return predicate();
+	};
+	REQUIRE(wait_until([&thread_pool]() { return thread_pool.GetThreadCount() == 1; }));
+
+	// Block the only worker, so the primary request stays queued and every hedge deadline sees a backed up pool.
+	std::atomic<bool> started(false);
+	std::atomic<bool> release(false);
+	entry->SubmitAttempt([&started, &release]() {
+		started.store(true);
+		while (!release.load()) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	});
+	REQUIRE(wait_until([&started]() { return started.load(); }));
+	std::atomic<bool> file_exists(false);
+	std::thread caller([&]() { file_exists.store(hedged_fs->FileExists(test_file, /*opener=*/nullptr)); });
+	const bool suppressed = wait_until(
+	    [&entry]() { return entry->GetStats()->GetStats(HedgedRequestOperation::FILE_EXISTS).suppressed_hedges >= 2; });
+	// Checked before release, since hedges might be issued once the pool drains.
+	const auto hedged_requests = entry->GetStats()->GetStats(HedgedRequestOperation::FILE_EXISTS).hedged_requests;
+	release.store(true);
+	caller.join();
+	entry->WaitAll();
+
+	REQUIRE(suppressed);
+	REQUIRE(hedged_requests == 0);
+	REQUIRE(file_exists.load());
+}
+
+TEST_CASE("HedgedFileSystem hedges right away on retryable failure in first-success mode", "[hedged_file_system]") {
+	string test_file = TestCreatePath("hedged_first_success.txt");
+	CreateTestFile(test_file, TEST_CONTENT);
+
+	auto mock_fs = make_uniq<MockFileSystem>();
+	auto *mock_fs_ptr = mock_fs.get();
+	auto entry = make_shared_ptr<HedgedRequestFsEntry>();
+	// Hedging delay is far beyond the test timeout, so only hedges on failure are issued.
+	entry->UpdateConfig(HedgedRequestOperation::FILE_EXISTS, std::chrono::milliseconds(100000));
+	entry->UpdateMaxHedgedRequestCount(3);
+	auto hedged_fs = make_uniq<HedgedFileSystem>(std::move(mock_fs), entry);
+
+	// By default, the failed primary attempt decides the outcome.
+	mock_fs_ptr->SetTransientIoFailureCount(1);
+	REQUIRE_THROWS_AS(hedged_fs->FileExists(test_file, /*opener=*/nullptr), IOException);
+	entry->WaitAll();
+
+	entry->UpdateEnableFirstSuccessWins(true);
+	entry->GetStats()->Reset();
+	mock_fs_ptr->SetTransientIoFailureCount(1);
+	const auto start = std::chrono::steady_clock::now();
+	REQUIRE(hedged_fs->FileExists(test_file, /*opener=*/nullptr));
+	REQUIRE(std::chrono::steady_clock::now() - start < std::chrono::seconds(10));
+	entry->WaitAll();
+	auto stats = entry->GetStats()->GetStats(HedgedRequestOperation::FILE_EXISTS);
+	REQUIRE(stats.hedged_requests == 1);
+	REQUIRE(stats.hedge_wins == 1);
+	REQUIRE(stats.failed_attempts == 1);
+
+	// Once all attempts within the max count failed, the latest failure is returned.
+	entry->GetStats()->Reset();
+	mock_fs_ptr->SetTransientIoFailureCount(3);
+	REQUIRE_THROWS_AS(hedged_fs->FileExists(test_file, /*opener=*/nullptr), IOException);
+	entry->WaitAll();
+	stats = entry->GetStats()->GetStats(HedgedRequestOperation::FILE_EXISTS);
+	REQUIRE(stats.hedged_requests == 2);
+	REQUIRE(stats.failed_attempts == 3);
+}
+
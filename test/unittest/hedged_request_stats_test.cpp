@@ -0,0 +1,81 @@
+#include "catch/catch.hpp"
+
+#include "hedged_request_stats.hpp"
+
+#include <thread>
+
+using namespace duckdb; // NOLINT
+
+TEST_CASE("HedgedOperationStats latency buckets", "[hedged_request_stats]") {
+	REQUIRE(HedgedOperationStats::GetLatencyBucket(std::chrono::microseconds(0)) == 0);
+	REQUIRE(HedgedOperationStats::GetLatencyBucket(std::chrono::microseconds(1)) == 1);
+	REQUIRE(HedgedOperationStats::GetLatencyBucket(std::chrono::microseconds(2)) == 2);
+	REQUIRE(HedgedOperationStats::GetLatencyBucket(std::chrono::microseconds(3)) == 2);
+	REQUIRE(HedgedOperationStats::GetLatencyBucket(std::chrono::microseconds(1024)) == 11);
+	REQUIRE(HedgedOperationStats::GetLatencyBucketUpperBound(11) == 2048);
+
+	// Latency beyond the last bucket is accounted into the last bucket.
+	REQUIRE(HedgedOperationStats::GetLatencyBucket(std::chrono::hours(24 * 365)) ==
+	        HedgedOperationStats::LATENCY_BUCKET_COUNT - 1);
+}
+
+TEST_CASE("HedgedRequestStats sums up counters across threads", "[hedged_request_stats]") {
+	HedgedRequestStats stats;
+	constexpr int THREAD_COUNT = 8;
+	constexpr int ITERATIONS = 1000;
+
+	vector<std::thread> threads;
+	for (int idx = 0; idx < THREAD_COUNT; ++idx) {
+		threads.emplace_back([&stats]() {
+			for (int iter = 0; iter < ITERATIONS; ++iter) {
+				stats.RecordPrimaryRequest(HedgedRequestOperation::READ);
+				stats.RecordAttemptStarted(HedgedRequestOperation::READ);
+				stats.RecordLatency(HedgedRequestOperation::READ, std::chrono::microseconds(100));
+			}
+		});
+	}
+	for (auto &cur_thread : threads) {
+		cur_thread.join();
+	}
+	// Attempts finish on a different thread from which they start.
+	for (int iter = 0; iter < THREAD_COUNT * ITERATIONS / 2; ++iter) {
+		stats.RecordAttemptFinished(HedgedRequestOperation::READ);
+	}
+
+	auto read_stats = stats.GetStats(HedgedRequestOperation::READ);
+	REQUIRE(read_stats.primary_requests == THREAD_COUNT * ITERATIONS);
+	REQUIRE(read_stats.pending_attempts == THREAD_COUNT * ITERATIONS / 2);
+	REQUIRE(read_stats.latency_histogram[HedgedOperationStats::GetLatencyBucket(std::chrono::microseconds(100))] ==
+	        THREAD_COUNT * ITERATIONS);
+
+	// Other operations are not affected.
+	REQUIRE(stats.GetStats(HedgedRequestOperation::GLOB).primary_requests == 0);
+
+	// Reset keeps pending attempts, which are still in flight.
+	stats.Reset();
+	read_stats = stats.GetStats(HedgedRequestOperation::READ);
+	REQUIRE(read_stats.primary_requests == 0);
+	REQUIRE(read_stats.latency_histogram[HedgedOperationStats::GetLatencyBucket(std::chrono::microseconds(100))] == 0);
+	REQUIRE(read_stats.pending_attempts == THREAD_COUNT * ITERATIONS / 2);
+}
+
+TEST_CASE("ScopedHedgeCounter counts hedges in innermost scope", "[hedged_request_stats]") {
+	// Recorded without a scope is dropped.
+	ScopedHedgeCounter::Record(1);
+
+	ScopedHedgeCounter outer;
+	ScopedHedgeCounter::Record(2);
+	{
+		ScopedHedgeCounter inner;
+		ScopedHedgeCounter::Record(3);
+		ScopedHedgeCounter::Record(0);
+		REQUIRE(inner.GetHedgedRequestCount() == 3);
+	}
+	ScopedHedgeCounter::Record(1);
+	REQUIRE(outer.GetHedgedRequestCount() == 3);
+
+	// Scopes are per thread.
+	std::thread other([]() { ScopedHedgeCounter::Record(5); });
+	other.join();
+	REQUIRE(outer.GetHedgedRequestCount() == 3);
+}
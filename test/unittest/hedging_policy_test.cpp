@@ -0,0 +1,82 @@
+#include "catch/catch.hpp"
+
+#include "duckdb/common/exception.hpp"
+#include "hedging_policy.hpp"
+
+using namespace duckdb; // NOLINT
+
+namespace {
+std::chrono::milliseconds GetDelay(const HedgedRequestConfig &config, HedgedRequestOperation operation) {
+	return config.delays_ms[static_cast<size_t>(operation)];
+}
+} // namespace
+
+TEST_CASE("HedgedConfigSnapshot resolves layered policies", "[hedging_policy]") {
+	HedgedConfigSnapshot snapshot;
+	snapshot.config.delays_ms[static_cast<size_t>(HedgedRequestOperation::OPEN_FILE)] = std::chrono::milliseconds(1000);
+	snapshot.filesystem_policies["S3FileSystem"].SetOption("open_file_delay_ms", 500);
+	snapshot.filesystem_policies["S3FileSystem"].SetOption("max_hedged_request_count", 2);
+	snapshot.GetOrCreatePrefixPolicy("s3://hot-bucket/").SetOption("open_file_delay_ms", 50);
+
+	// No policy applies.
+	auto config = snapshot.Resolve("HTTPFileSystem", "https://example.com/file");
+	REQUIRE(GetDelay(config, HedgedRequestOperation::OPEN_FILE) == std::chrono::milliseconds(1000));
+	REQUIRE(config.max_hedged_request_count == DEFAULT_MAX_HEDGED_REQUEST_COUNT);
+
+	// Filesystem policy applies.
+	config = snapshot.Resolve("S3FileSystem", "s3://cold-bucket/file");
+	REQUIRE(GetDelay(config, HedgedRequestOperation::OPEN_FILE) == std::chrono::milliseconds(500));
+	REQUIRE(config.max_hedged_request_count == 2);
+
+	// Prefix policy overrides filesystem policy, and unset options are inherited.
+	config = snapshot.Resolve("S3FileSystem", "s3://hot-bucket/file");
+	REQUIRE(GetDelay(config, HedgedRequestOperation::OPEN_FILE) == std::chrono::milliseconds(50));
+	REQUIRE(config.max_hedged_request_count == 2);
+}
+
+TEST_CASE("HedgedConfigSnapshot longest prefix match", "[hedging_policy]") {
+	HedgedConfigSnapshot snapshot;
+	snapshot.GetOrCreatePrefixPolicy("s3://").SetOption("file_exists_delay_ms", 300);
+	snapshot.GetOrCreatePrefixPolicy("s3://bucket/hot/").SetOption("file_exists_delay_ms", 10);
+	snapshot.GetOrCreatePrefixPolicy("s3://bucket/").SetOption("file_exists_delay_ms", 100);
+
+	auto get_delay = [&snapshot](const string &path) {
+		return GetDelay(snapshot.Resolve("S3FileSystem", path), HedgedRequestOperation::FILE_EXISTS);
+	};
+	REQUIRE(get_delay("s3://other/file") == std::chrono::milliseconds(300));
+	REQUIRE(get_delay("s3://bucket/cold/file") == std::chrono::milliseconds(100));
+	REQUIRE(get_delay("s3://bucket/hot/file") == std::chrono::milliseconds(10));
+}
+
+TEST_CASE("HedgedConfigSnapshot resolves replica paths", "[hedging_policy]") {
+	HedgedConfigSnapshot snapshot;
+	snapshot.AddReplica("s3://bucket-us-east/", "s3://bucket-us-west/");
+	snapshot.AddReplica("s3://bucket-us-east/", "s3://bucket-eu/");
+	// Adding a mirror again keeps its rotation order.
+	snapshot.AddReplica("s3://bucket-us-east/", "s3://bucket-us-west/");
+	snapshot.AddReplica("s3://bucket-us-east/hot/", "s3://hot-cache/");
+
+	REQUIRE(snapshot.ResolveReplicaPaths("s3://other/file").empty());
+	auto replica_paths = snapshot.ResolveReplicaPaths("s3://bucket-us-east/data/file");
+	REQUIRE(replica_paths.size() == 2);
+	REQUIRE(replica_paths[0] == "s3://bucket-us-west/data/file");
+	REQUIRE(replica_paths[1] == "s3://bucket-eu/data/file");
+	// Longest matching prefix wins.
+	replica_paths = snapshot.ResolveReplicaPaths("s3://bucket-us-east/hot/file");
+	REQUIRE(replica_paths.size() == 1);
+	REQUIRE(replica_paths[0] == "s3://hot-cache/file");
+}
+
+TEST_CASE("HedgingPolicy options", "[hedging_policy]") {
+	HedgingPolicy policy;
+	policy.SetOption("GLOB_DELAY_MS", 20);
+	policy.SetOption("delete_delay_ms", 30);
+	REQUIRE_THROWS_AS(policy.SetOption("glob_delay", 20), InvalidInputException);
+
+	auto options = policy.ListOptions();
+	REQUIRE(options.size() == 2);
+	REQUIRE(options[0].first == "delete_delay_ms");
+	REQUIRE(options[0].second == 30);
+	REQUIRE(options[1].first == "glob_delay_ms");
+	REQUIRE(options[1].second == 20);
+}
@@ -0,0 +1,93 @@
+#include "catch/catch.hpp"
+
+#include "duckdb/common/exception.hpp"
+#include "latency_distribution.hpp"
+#include "mock_file_system.hpp"
+#include "test_helpers.hpp"
+#include "test_utils.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+using namespace duckdb; // NOLINT
+
+namespace {
+vector<int64_t> SampleSorted(const LatencyDistribution &distribution, uint64_t seed, idx_t count) {
+	std::mt19937_64 rng(seed);
+	vector<int64_t> samples;
+	for (idx_t idx = 0; idx < count; ++idx) {
+		samples.emplace_back(distribution.Sample(rng).count());
+	}
+	std::sort(samples.begin(), samples.end());
+	return samples;
+}
+} // namespace
+
+TEST_CASE("LatencyDistribution fixed latency", "[latency_distribution]") {
+	auto distribution = LatencyDistribution::Fixed(std::chrono::microseconds(1500));
+	std::mt19937_64 rng(1);
+	REQUIRE(distribution.Sample(rng).count() == 1500);
+	REQUIRE(LatencyDistribution().Sample(rng).count() == 0);
+}
+
+TEST_CASE("LatencyDistribution is reproducible from seed", "[latency_distribution]") {
+	auto distribution = LatencyDistribution::LogNormal(std::chrono::milliseconds(10), /*sigma=*/0.5);
+	REQUIRE(SampleSorted(distribution, /*seed=*/7, /*count=*/100) == SampleSorted(distribution, 7, 100));
+	REQUIRE(SampleSorted(distribution, /*seed=*/7, /*count=*/100) != SampleSorted(distribution, 8, 100));
+}
+
+TEST_CASE("LatencyDistribution lognormal median", "[latency_distribution]") {
+	auto distribution = LatencyDistribution::LogNormal(std::chrono::milliseconds(10), /*sigma=*/0.5);
+	const auto samples = SampleSorted(distribution, /*seed=*/1, /*count=*/10000);
+	const auto median = samples[samples.size() / 2];
+	REQUIRE(median > 9000);
+	REQUIRE(median < 11000);
+}
+
+TEST_CASE("LatencyDistribution bimodal slow replica", "[latency_distribution]") {
+	auto distribution = LatencyDistribution::Bimodal(std::chrono::milliseconds(5), std::chrono::milliseconds(200),
+	                                                 /*slow_probability=*/0.1, /*sigma=*/0.1);
+	const auto samples = SampleSorted(distribution, /*seed=*/1, /*count=*/10000);
+	const auto slow_count = std::count_if(samples.begin(), samples.end(), [](int64_t cur) { return cur > 50000; });
+	REQUIRE(slow_count > 800);
+	REQUIRE(slow_count < 1200);
+}
+
+TEST_CASE("LatencyDistribution pareto tail", "[latency_distribution]") {
+	auto distribution =
+	    LatencyDistribution::Pareto(std::chrono::milliseconds(5), /*shape=*/1.5, std::chrono::milliseconds(1000));
+	const auto samples = SampleSorted(distribution, /*seed=*/1, /*count=*/10000);
+	REQUIRE(samples.front() >= 5000);
+	REQUIRE(samples.back() <= 1000000);
+	// Tail is far heavier than the median.
+	REQUIRE(samples[samples.size() * 999 / 1000] > 20 * samples[samples.size() / 2]);
+}
+
+TEST_CASE("LatencyDistribution rejects invalid parameters", "[latency_distribution]") {
+	REQUIRE_THROWS_AS(LatencyDistribution::Fixed(std::chrono::microseconds(-1)), InvalidInputException);
+	REQUIRE_THROWS_AS(LatencyDistribution::LogNormal(std::chrono::microseconds(0), 0.5), InvalidInputException);
+	REQUIRE_THROWS_AS(
+	    LatencyDistribution::Bimodal(std::chrono::milliseconds(1), std::chrono::milliseconds(2), 1.5, 0.5),
+	    InvalidInputException);
+	REQUIRE_THROWS_AS(LatencyDistribution::Pareto(std::chrono::milliseconds(5), 1.5, std::chrono::milliseconds(1)),
+	                  InvalidInputException);
+}
+
+TEST_CASE("MockFileSystem samples per-operation latency", "[latency_distribution]") {
+	string test_file = TestCreatePath("mock_latency_distribution.txt");
+	CreateTestFile(test_file, "content");
+	MockFileSystem mock_fs;
+	mock_fs.SetSeed(1);
+	mock_fs.SetLatencyDistribution(HedgedRequestOperation::FILE_EXISTS,
+	                               LatencyDistribution::Fixed(std::chrono::milliseconds(100)));
+
+	// Operations without a distribution use the fixed delay, which is zero by default.
+	auto start = std::chrono::steady_clock::now();
+	REQUIRE(mock_fs.DirectoryExists(TestDirectoryPath()));
+	REQUIRE(std::chrono::steady_clock::now() - start < std::chrono::milliseconds(100));
+
+	start = std::chrono::steady_clock::now();
+	REQUIRE(mock_fs.FileExists(test_file));
+	REQUIRE(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(100));
+	REQUIRE(mock_fs.GetIoOperationCount() == 2);
+}
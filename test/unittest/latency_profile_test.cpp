@@ -0,0 +1,89 @@
+#include "catch/catch.hpp"
+
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/local_file_system.hpp"
+#include "latency_profile.hpp"
+#include "test_helpers.hpp"
+
+#include <chrono>
+
+using namespace duckdb; // NOLINT
+
+namespace {
+void RecordLatencies(LatencyTracker &tracker, HedgedRequestOperation operation, int64_t max_latency_us) {
+	for (int64_t value = 1; value <= max_latency_us; ++value) {
+		tracker.Record(operation, std::chrono::microseconds(value));
+	}
+}
+} // namespace
+
+TEST_CASE("Latency profile round trip", "[latency_profile]") {
+	LatencyTracker tracker;
+	RecordLatencies(tracker, HedgedRequestOperation::OPEN_FILE, 1000);
+	RecordLatencies(tracker, HedgedRequestOperation::GLOB, 50000);
+	const auto data = SerializeLatencyProfile(tracker);
+	// Sparse buckets keep the profile small.
+	REQUIRE(data.size() < 2048);
+
+	LatencyTracker loaded;
+	RecordLatencies(loaded, HedgedRequestOperation::READ, 10);
+	DeserializeLatencyProfile(data, loaded);
+	for (auto operation : {HedgedRequestOperation::OPEN_FILE, HedgedRequestOperation::GLOB,
+	                       HedgedRequestOperation::READ, HedgedRequestOperation::FILE_EXISTS}) {
+		const auto &expected = tracker.GetSketch(operation);
+		const auto &actual = loaded.GetSketch(operation);
+		REQUIRE(actual.GetSampleCount() == expected.GetSampleCount());
+		REQUIRE(actual.GetQuantile(0.5) == expected.GetQuantile(0.5));
+		REQUIRE(actual.GetQuantile(0.95) == expected.GetQuantile(0.95));
+	}
+}
+
+TEST_CASE("Latency profile rejects malformed data", "[latency_profile]") {
+	LatencyTracker tracker;
+	RecordLatencies(tracker, HedgedRequestOperation::OPEN_FILE, 1000);
+	const auto data = SerializeLatencyProfile(tracker);
+
+	LatencyTracker loaded;
+	RecordLatencies(loaded, HedgedRequestOperation::OPEN_FILE, 10);
+	const auto p95 = loaded.GetSketch(HedgedRequestOperation::OPEN_FILE).GetQuantile(0.95);
+
+	REQUIRE_THROWS_AS(DeserializeLatencyProfile("", loaded), InvalidInputException);
+	REQUIRE_THROWS_AS(DeserializeLatencyProfile("not a profile", loaded), InvalidInputException);
+	REQUIRE_THROWS_AS(DeserializeLatencyProfile(data.substr(0, data.size() - 1), loaded), InvalidInputException);
+	REQUIRE_THROWS_AS(DeserializeLatencyProfile(data + "x", loaded), InvalidInputException);
+
+	// Sketches are untouched by a rejected profile.
+	REQUIRE(loaded.GetSketch(HedgedRequestOperation::OPEN_FILE).GetQuantile(0.95) == p95);
+}
+
+TEST_CASE("Latency profile decays oversized sketches", "[latency_profile]") {
+	array<uint64_t, LatencySketch::BUCKET_COUNT> counts {};
+	counts[LatencySketch::GetBucketIndex(100)] = LatencySketch::DECAY_SAMPLE_COUNT * 4;
+	counts[LatencySketch::GetBucketIndex(5000)] = UINT64_MAX;
+
+	LatencySketch sketch;
+	sketch.SetBucketCounts(counts);
+	REQUIRE(sketch.GetSampleCount() > 0);
+	REQUIRE(sketch.GetSampleCount() < LatencySketch::DECAY_SAMPLE_COUNT);
+	REQUIRE(sketch.GetQuantile(0.5).count() >= 5000);
+}
+
+TEST_CASE("Latency profile save and load through filesystem", "[latency_profile]") {
+	const string profile_path = TestCreatePath("latency_profile.bin");
+	LocalFileSystem local_fs;
+
+	LatencyTracker tracker;
+	RecordLatencies(tracker, HedgedRequestOperation::GET_FILE_SIZE, 2000);
+	SaveLatencyProfile(local_fs, profile_path, tracker);
+	// Saving again overwrites the profile.
+	RecordLatencies(tracker, HedgedRequestOperation::GET_FILE_SIZE, 2000);
+	SaveLatencyProfile(local_fs, profile_path, tracker);
+
+	LatencyTracker loaded;
+	LoadLatencyProfile(local_fs, profile_path, loaded);
+	REQUIRE(loaded.GetSketch(HedgedRequestOperation::GET_FILE_SIZE).GetSampleCount() ==
+	        tracker.GetSketch(HedgedRequestOperation::GET_FILE_SIZE).GetSampleCount());
+	REQUIRE(loaded.GetSketch(HedgedRequestOperation::GET_FILE_SIZE).GetQuantile(0.95) ==
+	        tracker.GetSketch(HedgedRequestOperation::GET_FILE_SIZE).GetQuantile(0.95));
+	local_fs.RemoveFile(profile_path);
+}
@@ -0,0 +1,46 @@
+#include "catch/catch.hpp"
+
+#include "latency_sketch.hpp"
+
+using namespace duckdb; // NOLINT
+
+TEST_CASE("LatencySketch bucket bounds are contiguous", "[latency_sketch]") {
+	for (idx_t idx = 1; idx < 64; ++idx) {
+		REQUIRE(LatencySketch::GetBucketIndex(LatencySketch::GetBucketUpperBound(idx - 1) + 1) == idx);
+	}
+	for (uint64_t value : {0ULL, 1ULL, 7ULL, 8ULL, 1000ULL, 123456ULL, 987654321ULL}) {
+		REQUIRE(LatencySketch::GetBucketUpperBound(LatencySketch::GetBucketIndex(value)) >= value);
+	}
+}
+
+TEST_CASE("LatencySketch quantile", "[latency_sketch]") {
+	LatencySketch sketch;
+	REQUIRE(sketch.GetQuantile(0.95).count() == 0);
+
+	// 1..1000 microseconds.
+	for (int64_t value = 1; value <= 1000; ++value) {
+		sketch.Record(std::chrono::microseconds(value));
+	}
+	REQUIRE(sketch.GetSampleCount() == 1000);
+
+	// Relative error is bounded by sub-bucket width.
+	const auto p50 = sketch.GetQuantile(0.5).count();
+	REQUIRE(p50 >= 500);
+	REQUIRE(p50 <= 570);
+	const auto p95 = sketch.GetQuantile(0.95).count();
+	REQUIRE(p95 >= 950);
+	REQUIRE(p95 <= 1080);
+}
+
+TEST_CASE("LatencySketch decays old samples", "[latency_sketch]") {
+	LatencySketch sketch;
+	for (uint64_t idx = 0; idx < LatencySketch::DECAY_SAMPLE_COUNT - 1; ++idx) {
+		sketch.Record(std::chrono::microseconds(100));
+	}
+	REQUIRE(sketch.GetSampleCount() == LatencySketch::DECAY_SAMPLE_COUNT - 1);
+	sketch.Record(std::chrono::microseconds(100));
+	REQUIRE(sketch.GetSampleCount() == LatencySketch::DECAY_SAMPLE_COUNT / 2);
+
+	sketch.Reset();
+	REQUIRE(sketch.GetSampleCount() == 0);
+}
@@ -0,0 +1,126 @@
+#include "catch/catch.hpp"
+
+#include "listing_cache.hpp"
+
+#include <thread>
+
+using namespace duckdb; // NOLINT
+
+namespace {
+shared_ptr<ListingCache> CreateEnabledCache() {
+	auto cache = make_shared_ptr<ListingCache>();
+	cache->SetEnabled(true);
+	return cache;
+}
+
+bool IsCached(ListingCache &cache, const string &directory) {
+	ListingCache::Listing listing;
+	return cache.TryGetListing(directory, listing);
+}
+} // namespace
+
+TEST_CASE("ListingCache caches listings by directory", "[listing_cache]") {
+	auto cache = CreateEnabledCache();
+	ListingCache::Listing listing;
+	REQUIRE(!cache->TryGetListing("s3://bucket/events", listing));
+
+	const ListingCache::Listing events_listing {{"date=1", true}, {"_SUCCESS", false}};
+	cache->PutListing("s3://bucket/events", events_listing);
+	// Trailing separators are ignored.
+	REQUIRE(cache->TryGetListing("s3://bucket/events/", listing));
+	REQUIRE(listing == events_listing);
+	REQUIRE(!IsCached(*cache, "s3://bucket/event"));
+	REQUIRE(!IsCached(*cache, "s3://bucket"));
+	REQUIRE(cache->GetListingCount() == 1);
+
+	// Listing is replaced by a later one.
+	const ListingCache::Listing updated_listing {{"date=2", true}};
+	cache->PutListing("s3://bucket/events/", updated_listing);
+	REQUIRE(cache->TryGetListing("s3://bucket/events", listing));
+	REQUIRE(listing == updated_listing);
+	REQUIRE(cache->GetListingCount() == 1);
+}
+
+TEST_CASE("ListingCache disabled by default", "[listing_cache]") {
+	ListingCache cache;
+	cache.PutListing("s3://bucket/events", {{"date=1", true}});
+	REQUIRE(!IsCached(cache, "s3://bucket/events"));
+	REQUIRE(cache.GetListingCount() == 0);
+}
+
+TEST_CASE("ListingCache expires listings after TTL", "[listing_cache]") {
+	auto cache = CreateEnabledCache();
+	cache->SetTtl(std::chrono::milliseconds(50));
+	cache->PutListing("s3://bucket/events", {{"date=1", true}});
+	REQUIRE(IsCached(*cache, "s3://bucket/events"));
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(100));
+	REQUIRE(!IsCached(*cache, "s3://bucket/events"));
+	REQUIRE(cache->GetListingCount() == 0);
+	REQUIRE(cache->GetCachedBytes() == 0);
+}
+
+TEST_CASE("ListingCache invalidates ancestors and subtree of a path", "[listing_cache]") {
+	auto cache = CreateEnabledCache();
+	for (const auto *directory : {"s3://bucket", "s3://bucket/events", "s3://bucket/events/date=1",
+	                              "s3://bucket/events/date=1/hour=1", "s3://bucket/events/date=2",
+	                              "s3://bucket/events/date=10", "s3://bucket/logs"}) {
+		cache->PutListing(directory, {{"entry", false}});
+	}
+
+	// Removing a directory drops its own listing, listings under it, and listings of its ancestors.
+	cache->Invalidate("s3://bucket/events/date=1");
+	REQUIRE(!IsCached(*cache, "s3://bucket"));
+	REQUIRE(!IsCached(*cache, "s3://bucket/events"));
+	REQUIRE(!IsCached(*cache, "s3://bucket/events/date=1"));
+	REQUIRE(!IsCached(*cache, "s3://bucket/events/date=1/hour=1"));
+	// Siblings are kept, including one sharing the name prefix.
+	REQUIRE(IsCached(*cache, "s3://bucket/events/date=2"));
+	REQUIRE(IsCached(*cache, "s3://bucket/events/date=10"));
+	REQUIRE(IsCached(*cache, "s3://bucket/logs"));
+
+	// Creating a file under an uncached directory drops cached ancestors.
+	cache->PutListing("s3://bucket/events", {{"entry", false}});
+	cache->Invalidate("s3://bucket/events/date=3/hour=1/file.parquet");
+	REQUIRE(!IsCached(*cache, "s3://bucket/events"));
+	REQUIRE(IsCached(*cache, "s3://bucket/events/date=2"));
+	REQUIRE(cache->GetListingCount() == 3);
+}
+
+TEST_CASE("ListingCache invalidates by prefix", "[listing_cache]") {
+	auto cache = CreateEnabledCache();
+	cache->PutListing("s3://bucket/events", {{"date=1", true}});
+	cache->PutListing("s3://bucket/events/date=1", {{"file.parquet", false}});
+	cache->PutListing("s3://bucket/logs", {{"file.log", false}});
+
+	cache->InvalidatePrefix("s3://bucket/events");
+	REQUIRE(!IsCached(*cache, "s3://bucket/events"));
+	REQUIRE(!IsCached(*cache, "s3://bucket/events/date=1"));
+	REQUIRE(IsCached(*cache, "s3://bucket/logs"));
+
+	cache->InvalidatePrefix("");
+	REQUIRE(cache->GetListingCount() == 0);
+	REQUIRE(cache->GetCachedBytes() == 0);
+}
+
+TEST_CASE("ListingCache evicts least recently used listings beyond memory bound", "[listing_cache]") {
+	auto cache = CreateEnabledCache();
+	const ListingCache::Listing listing(16, {string(64, 'x'), false});
+	cache->PutListing("/data/dir0", listing);
+	const auto listing_bytes = cache->GetCachedBytes();
+	cache->SetMaxBytes(listing_bytes * 2);
+	cache->PutListing("/data/dir1", listing);
+	// Touch the first listing, so the second one is the least recently used.
+	REQUIRE(IsCached(*cache, "/data/dir0"));
+	cache->PutListing("/data/dir2", listing);
+	REQUIRE(cache->GetListingCount() == 2);
+	REQUIRE(cache->GetCachedBytes() <= listing_bytes * 2);
+	REQUIRE(IsCached(*cache, "/data/dir0"));
+	REQUIRE(!IsCached(*cache, "/data/dir1"));
+	REQUIRE(IsCached(*cache, "/data/dir2"));
+
+	// A listing which alone exceeds the bound isn't cached.
+	cache->PutListing("/data/huge", ListingCache::Listing(1024, {string(64, 'x'), false}));
+	REQUIRE(!IsCached(*cache, "/data/huge"));
+	REQUIRE(cache->GetListingCount() == 2);
+}
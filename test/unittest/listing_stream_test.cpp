@@ -0,0 +1,108 @@
+#include "catch/catch.hpp"
+
+#include "cancellation_token.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/helper.hpp"
+#include "listing_stream.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace duckdb; // NOLINT
+
+TEST_CASE("ListingStream first attempt to publish wins", "[listing_stream]") {
+	ListingStream<int> stream(/*page_size_p=*/2, /*max_buffered_pages_p=*/4);
+	auto first_cancellation = make_shared_ptr<CancellationToken>();
+	auto second_cancellation = make_shared_ptr<CancellationToken>();
+	const auto first_attempt = stream.AddAttempt(first_cancellation);
+	const auto second_attempt = stream.AddAttempt(second_cancellation);
+	REQUIRE(!stream.HasWinner());
+
+	ListingPageWriter<int> second_writer(stream, second_attempt);
+	REQUIRE(second_writer.Append(1));
+	REQUIRE(second_writer.Append(2));
+	REQUIRE(stream.HasWinner());
+	REQUIRE(first_cancellation->IsCancelled());
+	REQUIRE(!second_cancellation->IsCancelled());
+
+	// Loser is rejected on publish and finish.
+	ListingPageWriter<int> first_writer(stream, first_attempt);
+	REQUIRE(first_writer.Append(10));
+	REQUIRE(!first_writer.Append(11));
+	REQUIRE(!stream.Finish(first_attempt, /*listed=*/true, nullptr));
+
+	// Attempts registered after the race is decided are cancelled immediately.
+	auto late_cancellation = make_shared_ptr<CancellationToken>();
+	stream.AddAttempt(late_cancellation);
+	REQUIRE(late_cancellation->IsCancelled());
+
+	REQUIRE(second_writer.Append(3));
+	REQUIRE(second_writer.Flush());
+	REQUIRE(stream.Finish(second_attempt, /*listed=*/true, nullptr));
+
+	vector<int> entries;
+	ListingStream<int>::Page page;
+	while (stream.Next(page)) {
+		entries.insert(entries.end(), page.begin(), page.end());
+	}
+	REQUIRE(entries == (vector<int> {1, 2, 3}));
+	REQUIRE(stream.GetResult());
+}
+
+TEST_CASE("ListingStream bounds buffered pages", "[listing_stream]") {
+	constexpr int PAGE_COUNT = 16;
+	auto stream = make_shared_ptr<ListingStream<int>>(/*page_size_p=*/1, /*max_buffered_pages_p=*/2);
+	const auto attempt_id = stream->AddAttempt(make_shared_ptr<CancellationToken>());
+	std::atomic<int> published(0);
+	std::thread producer([&]() {
+		ListingPageWriter<int> writer(*stream, attempt_id);
+		for (int idx = 0; idx < PAGE_COUNT; ++idx) {
+			writer.Append(idx);
+			published.fetch_add(1);
+		}
+		stream->Finish(attempt_id, /*listed=*/true, nullptr);
+	});
+
+	// Producer blocks once the buffer is full.
+	std::this_thread::sleep_for(std::chrono::milliseconds(100));
+	REQUIRE(published.load() <= 3);
+
+	int consumed = 0;
+	ListingStream<int>::Page page;
+	while (stream->Next(page)) {
+		REQUIRE(page.size() == 1);
+		REQUIRE(page[0] == consumed);
+		++consumed;
+	}
+	producer.join();
+	REQUIRE(consumed == PAGE_COUNT);
+}
+
+TEST_CASE("ListingStream close stops attempts", "[listing_stream]") {
+	ListingStream<int> stream(/*page_size_p=*/1, /*max_buffered_pages_p=*/1);
+	auto cancellation = make_shared_ptr<CancellationToken>();
+	const auto attempt_id = stream.AddAttempt(cancellation);
+	ListingPageWriter<int> writer(stream, attempt_id);
+	REQUIRE(writer.Append(1));
+
+	stream.Close();
+	REQUIRE(cancellation->IsCancelled());
+	REQUIRE(!writer.Append(2));
+	REQUIRE(!stream.Finish(attempt_id, /*listed=*/true, nullptr));
+}
+
+TEST_CASE("ListingStream propagates winner failure", "[listing_stream]") {
+	ListingStream<int> stream(/*page_size_p=*/2, /*max_buffered_pages_p=*/4);
+	const auto attempt_id = stream.AddAttempt(make_shared_ptr<CancellationToken>());
+	ListingPageWriter<int> writer(stream, attempt_id);
+	REQUIRE(writer.Append(1));
+	REQUIRE(writer.Append(2));
+	REQUIRE(stream.Finish(attempt_id, /*listed=*/false, std::make_exception_ptr(IOException("listing failed"))));
+
+	// Pages published before the failure are still delivered.
+	ListingStream<int>::Page page;
+	REQUIRE(stream.Next(page));
+	REQUIRE(page.size() == 2);
+	REQUIRE_THROWS_AS(stream.Next(page), IOException);
+}
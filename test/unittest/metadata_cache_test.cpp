@@ -0,0 +1,107 @@
+#include "catch/catch.hpp"
+
+#include "metadata_cache.hpp"
+
+#include <thread>
+
+using namespace duckdb; // NOLINT
+
+namespace {
+shared_ptr<MetadataCache> CreateEnabledCache() {
+	auto cache = make_shared_ptr<MetadataCache>();
+	cache->SetEnabled(true);
+	return cache;
+}
+} // namespace
+
+TEST_CASE("MetadataCache caches fields independently", "[metadata_cache]") {
+	auto cache = CreateEnabledCache();
+	int64_t file_size = 0;
+	bool file_exists = false;
+	REQUIRE(!cache->TryGetFileSize("s3://bucket/a.parquet", file_size));
+
+	cache->PutFileSize("s3://bucket/a.parquet", 100);
+	REQUIRE(cache->TryGetFileSize("s3://bucket/a.parquet", file_size));
+	REQUIRE(file_size == 100);
+	// Other fields of the same path are not filled.
+	REQUIRE(!cache->TryGetFileExists("s3://bucket/a.parquet", file_exists));
+
+	cache->PutFileExists("s3://bucket/a.parquet", true);
+	REQUIRE(cache->TryGetFileExists("s3://bucket/a.parquet", file_exists));
+	REQUIRE(file_exists);
+	REQUIRE(cache->GetEntryCount() == 1);
+}
+
+TEST_CASE("MetadataCache disabled by default", "[metadata_cache]") {
+	MetadataCache cache;
+	int64_t file_size = 0;
+	cache.PutFileSize("s3://bucket/a.parquet", 100);
+	REQUIRE(!cache.TryGetFileSize("s3://bucket/a.parquet", file_size));
+	REQUIRE(cache.GetEntryCount() == 0);
+}
+
+TEST_CASE("MetadataCache expires entries after TTL", "[metadata_cache]") {
+	auto cache = CreateEnabledCache();
+	cache->SetTtl(std::chrono::milliseconds(50));
+	cache->PutFileSize("s3://bucket/a.parquet", 100);
+	int64_t file_size = 0;
+	REQUIRE(cache->TryGetFileSize("s3://bucket/a.parquet", file_size));
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(100));
+	REQUIRE(!cache->TryGetFileSize("s3://bucket/a.parquet", file_size));
+}
+
+TEST_CASE("MetadataCache drops metadata on version change", "[metadata_cache]") {
+	auto cache = CreateEnabledCache();
+	int64_t file_size = 0;
+	cache->PutFileSize("s3://bucket/a.parquet", 100);
+	cache->PutVersionTag("s3://bucket/a.parquet", "etag-1");
+	REQUIRE(cache->TryGetFileSize("s3://bucket/a.parquet", file_size));
+
+	// Same version keeps metadata.
+	cache->PutVersionTag("s3://bucket/a.parquet", "etag-1");
+	REQUIRE(cache->TryGetFileSize("s3://bucket/a.parquet", file_size));
+
+	cache->PutVersionTag("s3://bucket/a.parquet", "etag-2");
+	REQUIRE(!cache->TryGetFileSize("s3://bucket/a.parquet", file_size));
+	// Latest version tag is kept.
+	string version_tag;
+	REQUIRE(cache->TryGetVersionTag("s3://bucket/a.parquet", version_tag));
+	REQUIRE(version_tag == "etag-2");
+	REQUIRE(!cache->TryGetVersionTag("s3://bucket/b.parquet", version_tag));
+}
+
+TEST_CASE("MetadataCache invalidation", "[metadata_cache]") {
+	auto cache = CreateEnabledCache();
+	cache->PutFileSize("s3://bucket/dir/a.parquet", 100);
+	cache->PutFileSize("s3://bucket/dir/b.parquet", 200);
+	cache->PutFileSize("s3://bucket/other/c.parquet", 300);
+	REQUIRE(cache->GetEntryCount() == 3);
+
+	cache->Invalidate("s3://bucket/dir/a.parquet");
+	REQUIRE(cache->GetEntryCount() == 2);
+
+	cache->InvalidatePrefix("s3://bucket/dir/");
+	REQUIRE(cache->GetEntryCount() == 1);
+	int64_t file_size = 0;
+	REQUIRE(cache->TryGetFileSize("s3://bucket/other/c.parquet", file_size));
+
+	cache->InvalidatePrefix("");
+	REQUIRE(cache->GetEntryCount() == 0);
+	REQUIRE(cache->GetCachedBytes() == 0);
+}
+
+TEST_CASE("MetadataCache is bounded by memory", "[metadata_cache]") {
+	auto cache = CreateEnabledCache();
+	for (int idx = 0; idx < 1000; ++idx) {
+		cache->PutFileSize("s3://bucket/file_" + std::to_string(idx), idx);
+	}
+	REQUIRE(cache->GetEntryCount() == 1000);
+
+	// Each shard keeps its share of the bound, least recently used entries are evicted first.
+	constexpr idx_t MAX_BYTES = 64 * 1024;
+	cache->SetMaxBytes(MAX_BYTES);
+	REQUIRE(cache->GetCachedBytes() <= MAX_BYTES);
+	REQUIRE(cache->GetEntryCount() < 1000);
+	REQUIRE(cache->GetEntryCount() > 0);
+}
@@ -0,0 +1,167 @@
+#include "catch/catch.hpp"
+
+#include "duckdb/common/local_file_system.hpp"
+#include "hedge_scheduler.hpp"
+#include "hedged_request_config.hpp"
+#include "open_prefetch_cache.hpp"
+#include "test_helpers.hpp"
+#include "test_utils.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace duckdb; // NOLINT
+
+namespace {
+unique_ptr<FileHandle> OpenTestHandle(FileSystem &fs, const string &path) {
+	return fs.OpenFile(path, FileFlags::FILE_FLAGS_READ);
+}
+} // namespace
+
+TEST_CASE("OpenPrefetchCache hands out prefetched handle once", "[open_prefetch_cache]") {
+	string test_file = TestCreatePath("open_prefetch_take.txt");
+	CreateTestFile(test_file, "content");
+	LocalFileSystem local_fs;
+	HedgeScheduler scheduler;
+	OpenPrefetchCache cache(scheduler);
+
+	REQUIRE(cache.TryTake("local|" + test_file) == nullptr);
+	REQUIRE(cache.TryStartPrefetch("local|" + test_file));
+	// Duplicate prefetch of the same key is rejected.
+	REQUIRE(!cache.TryStartPrefetch("local|" + test_file));
+	cache.FinishPrefetch("local|" + test_file, OpenTestHandle(local_fs, test_file));
+	REQUIRE(cache.GetHandleCount() == 1);
+
+	auto handle = cache.TryTake("local|" + test_file);
+	REQUIRE(handle != nullptr);
+	REQUIRE(cache.TryTake("local|" + test_file) == nullptr);
+	REQUIRE(cache.GetHandleCount() == 0);
+	REQUIRE(cache.GetCachedBytes() == 0);
+}
+
+TEST_CASE("OpenPrefetchCache drops failed prefetch", "[open_prefetch_cache]") {
+	HedgeScheduler scheduler;
+	OpenPrefetchCache cache(scheduler);
+	REQUIRE(cache.TryStartPrefetch("local|missing"));
+	cache.FinishPrefetch("local|missing", /*handle=*/nullptr);
+	REQUIRE(cache.TryTake("local|missing") == nullptr);
+	REQUIRE(cache.GetCachedBytes() == 0);
+}
+
+TEST_CASE("OpenPrefetchCache closes expired handles", "[open_prefetch_cache]") {
+	string test_file = TestCreatePath("open_prefetch_ttl.txt");
+	CreateTestFile(test_file, "content");
+	LocalFileSystem local_fs;
+	HedgeScheduler scheduler;
+	OpenPrefetchCache cache(scheduler);
+	cache.SetTtl(std::chrono::milliseconds(20));
+
+	REQUIRE(cache.TryStartPrefetch("local|" + test_file));
+	cache.FinishPrefetch("local|" + test_file, OpenTestHandle(local_fs, test_file));
+	REQUIRE(cache.GetHandleCount() == 1);
+
+	// Swept by the scheduler, without any further access to the cache.
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+	while (cache.GetHandleCount() != 0 && std::chrono::steady_clock::now() < deadline) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(5));
+	}
+	REQUIRE(cache.GetHandleCount() == 0);
+	REQUIRE(cache.GetCachedBytes() == 0);
+	REQUIRE(scheduler.GetPendingTimerCount() == 0);
+}
+
+TEST_CASE("OpenPrefetchCache outlives the scheduler once sweeping is stopped", "[open_prefetch_cache]") {
+	string test_file1 = TestCreatePath("open_prefetch_stop1.txt");
+	string test_file2 = TestCreatePath("open_prefetch_stop2.txt");
+	CreateTestFile(test_file1, "content");
+	CreateTestFile(test_file2, "content");
+	LocalFileSystem local_fs;
+	auto scheduler = make_uniq<HedgeScheduler>();
+	OpenPrefetchCache cache(*scheduler);
+	cache.SetTtl(std::chrono::milliseconds(20));
+
+	REQUIRE(cache.TryStartPrefetch("local|" + test_file1));
+	cache.FinishPrefetch("local|" + test_file1, OpenTestHandle(local_fs, test_file1));
+	REQUIRE(scheduler->GetPendingTimerCount() == 1);
+	cache.StopSweeping();
+	REQUIRE(scheduler->GetPendingTimerCount() == 0);
+	scheduler.reset();
+
+	// Later prefetches don't arm the sweep timer, and expired handles are evicted by later calls instead.
+	std::this_thread::sleep_for(std::chrono::milliseconds(30));
+	REQUIRE(cache.GetHandleCount() == 1);
+	REQUIRE(cache.TryStartPrefetch("local|" + test_file2));
+	cache.FinishPrefetch("local|" + test_file2, OpenTestHandle(local_fs, test_file2));
+	REQUIRE(cache.GetHandleCount() == 1);
+	REQUIRE(cache.TryTake("local|" + test_file1) == nullptr);
+	REQUIRE(cache.TryTake("local|" + test_file2) != nullptr);
+}
+
+TEST_CASE("OpenPrefetchCache evicts oldest handles beyond memory bound", "[open_prefetch_cache]") {
+	string test_file1 = TestCreatePath("open_prefetch_bound1.txt");
+	string test_file2 = TestCreatePath("open_prefetch_bound2.txt");
+	CreateTestFile(test_file1, "content1");
+	CreateTestFile(test_file2, "content2");
+	LocalFileSystem local_fs;
+	HedgeScheduler scheduler;
+	OpenPrefetchCache cache(scheduler);
+	// Room for a single handle.
+	cache.SetMaxBytes(OPEN_PREFETCH_HANDLE_ESTIMATED_BYTES + test_file1.size() + 16);
+
+	REQUIRE(cache.TryStartPrefetch(test_file1));
+	// No room left while the first prefetch is in flight.
+	REQUIRE(!cache.TryStartPrefetch(test_file2));
+	cache.FinishPrefetch(test_file1, OpenTestHandle(local_fs, test_file1));
+
+	// Cached handles make room for new prefetches.
+	REQUIRE(cache.TryStartPrefetch(test_file2));
+	cache.FinishPrefetch(test_file2, OpenTestHandle(local_fs, test_file2));
+	REQUIRE(cache.GetHandleCount() == 1);
+	REQUIRE(cache.TryTake(test_file1) == nullptr);
+	REQUIRE(cache.TryTake(test_file2) != nullptr);
+
+	// Nothing fits into a zero bound.
+	cache.SetMaxBytes(0);
+	REQUIRE(!cache.TryStartPrefetch(test_file1));
+}
+
+TEST_CASE("OpenPrefetchCache waits for in-flight prefetch", "[open_prefetch_cache]") {
+	string test_file = TestCreatePath("open_prefetch_wait.txt");
+	CreateTestFile(test_file, "content");
+	LocalFileSystem local_fs;
+	HedgeScheduler scheduler;
+	OpenPrefetchCache cache(scheduler);
+
+	REQUIRE(cache.TryStartPrefetch(test_file));
+	std::thread prefetch_thread([&]() {
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		cache.FinishPrefetch(test_file, OpenTestHandle(local_fs, test_file));
+	});
+	REQUIRE(cache.TryTake(test_file) != nullptr);
+	prefetch_thread.join();
+}
+
+TEST_CASE("OpenPrefetchCache discards erased in-flight prefetch", "[open_prefetch_cache]") {
+	string test_file = TestCreatePath("open_prefetch_erase.txt");
+	CreateTestFile(test_file, "content");
+	LocalFileSystem local_fs;
+	HedgeScheduler scheduler;
+	OpenPrefetchCache cache(scheduler);
+
+	REQUIRE(cache.TryStartPrefetch(test_file));
+	cache.Erase(test_file);
+	// Erased prefetch is not waited for.
+	REQUIRE(cache.TryTake(test_file) == nullptr);
+	cache.FinishPrefetch(test_file, OpenTestHandle(local_fs, test_file));
+	REQUIRE(cache.GetHandleCount() == 0);
+	REQUIRE(cache.GetCachedBytes() == 0);
+
+	REQUIRE(cache.TryStartPrefetch("a|" + test_file));
+	cache.FinishPrefetch("a|" + test_file, OpenTestHandle(local_fs, test_file));
+	REQUIRE(cache.TryStartPrefetch("b|" + test_file));
+	cache.FinishPrefetch("b|" + test_file, OpenTestHandle(local_fs, test_file));
+	cache.ErasePrefix("a|");
+	REQUIRE(cache.GetHandleCount() == 1);
+	REQUIRE(cache.TryTake("b|" + test_file) != nullptr);
+}
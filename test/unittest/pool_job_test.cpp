@@ -0,0 +1,68 @@
+#include "catch/catch.hpp"
+
+#include "duckdb/common/helper.hpp"
+#include "duckdb/common/shared_ptr.hpp"
+#include "pool_job.hpp"
+
+#include <array>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+
+using namespace duckdb; // NOLINT
+
+TEST_CASE("PoolJob stores small callables inline", "[pool_job]") {
+	auto counter = make_shared_ptr<int>(0);
+	auto increment = [counter]() { ++*counter; };
+	REQUIRE(PoolJob::IsStoredInline<decltype(increment)>());
+
+	PoolJob job(increment);
+	REQUIRE(static_cast<bool>(job));
+	job();
+	job();
+	REQUIRE(*counter == 2);
+}
+
+TEST_CASE("PoolJob stores large callables on heap", "[pool_job]") {
+	std::array<int, 64> values {};
+	values[63] = 7;
+	int sum = 0;
+	auto add = [values, &sum]() { sum += values[63]; };
+	REQUIRE_FALSE(PoolJob::IsStoredInline<decltype(add)>());
+
+	PoolJob job(add);
+	PoolJob moved(std::move(job));
+	REQUIRE_FALSE(static_cast<bool>(job));
+	moved();
+	REQUIRE(sum == 7);
+}
+
+TEST_CASE("PoolJob move releases the callable once", "[pool_job]") {
+	auto counter = make_shared_ptr<int>(0);
+	{
+		PoolJob job([counter]() { ++*counter; });
+		REQUIRE(counter.use_count() == 2);
+		PoolJob other;
+		other = std::move(job);
+		REQUIRE(counter.use_count() == 2);
+		other();
+	}
+	REQUIRE(counter.use_count() == 1);
+	REQUIRE(*counter == 1);
+}
+
+TEST_CASE("PoolJob empty callables", "[pool_job]") {
+	PoolJob job;
+	REQUIRE_FALSE(static_cast<bool>(job));
+	REQUIRE_THROWS_AS(job(), std::bad_function_call);
+
+	PoolJob from_empty_function {std::function<void()>()};
+	REQUIRE_FALSE(static_cast<bool>(from_empty_function));
+	PoolJob from_nullptr(nullptr);
+	REQUIRE_FALSE(static_cast<bool>(from_nullptr));
+}
+
+TEST_CASE("PoolJob propagates exception", "[pool_job]") {
+	PoolJob job([]() { throw std::runtime_error("test error"); });
+	REQUIRE_THROWS_AS(job(), std::runtime_error);
+}
@@ -0,0 +1,107 @@
+#include "catch/catch.hpp"
+
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/helper.hpp"
+#include "read_ahead_window.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+using namespace duckdb; // NOLINT
+
+namespace {
+const string TEST_CONTENT = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+// Fetch blocks from [TEST_CONTENT] inline, so block count is deterministic, and count fetched blocks.
+ReadAheadWindow::BlockFetcher MakeFetcher(shared_ptr<ReadBufferPool> pool, std::atomic<int> &fetch_count) {
+	return [pool, &fetch_count](idx_t location, idx_t nr_bytes, ReadAheadWindow::BlockCallback on_fetched) {
+		fetch_count.fetch_add(1);
+		auto buffer = pool->Acquire(nr_bytes);
+		std::memcpy(buffer.GetData(), TEST_CONTENT.data() + location, nr_bytes);
+		on_fetched(std::move(buffer), /*eptr=*/nullptr);
+	};
+}
+} // namespace
+
+TEST_CASE("ReadAheadWindow serves sequential reads", "[read_ahead_window]") {
+	auto pool = make_shared_ptr<ReadBufferPool>(/*max_bytes_p=*/1024);
+	std::atomic<int> fetch_count(0);
+	ReadAheadWindow window(MakeFetcher(pool, fetch_count), /*block_size_p=*/4, /*window_blocks_p=*/3);
+
+	string result;
+	idx_t position = 0;
+	char buffer[5];
+	while (true) {
+		const auto bytes_read = window.Read(reinterpret_cast<data_ptr_t>(buffer), sizeof(buffer), position,
+		                                    TEST_CONTENT.size());
+		if (bytes_read == 0) {
+			break;
+		}
+		result.append(buffer, bytes_read);
+		position += bytes_read;
+		REQUIRE(window.GetBlockCount() <= 3);
+	}
+	REQUIRE(result == TEST_CONTENT);
+	// Every block is fetched exactly once.
+	REQUIRE(fetch_count.load() == 9);
+}
+
+TEST_CASE("ReadAheadWindow restarts on non-sequential read", "[read_ahead_window]") {
+	auto pool = make_shared_ptr<ReadBufferPool>(/*max_bytes_p=*/1024);
+	std::atomic<int> fetch_count(0);
+	ReadAheadWindow window(MakeFetcher(pool, fetch_count), /*block_size_p=*/4, /*window_blocks_p=*/2);
+
+	char buffer[4];
+	REQUIRE(window.Read(reinterpret_cast<data_ptr_t>(buffer), sizeof(buffer), 20, TEST_CONTENT.size()) == 4);
+	REQUIRE(string(buffer, 4) == TEST_CONTENT.substr(20, 4));
+
+	// Read before the window start restarts the window.
+	REQUIRE(window.Read(reinterpret_cast<data_ptr_t>(buffer), sizeof(buffer), 2, TEST_CONTENT.size()) == 4);
+	REQUIRE(string(buffer, 4) == TEST_CONTENT.substr(2, 4));
+
+	// Read at end of file.
+	REQUIRE(window.Read(reinterpret_cast<data_ptr_t>(buffer), sizeof(buffer), 34, TEST_CONTENT.size()) == 2);
+	REQUIRE(string(buffer, 2) == TEST_CONTENT.substr(34, 2));
+}
+
+TEST_CASE("ReadAheadWindow rethrows fetch failure", "[read_ahead_window]") {
+	auto pool = make_shared_ptr<ReadBufferPool>(/*max_bytes_p=*/1024);
+	// Fetches complete on detached threads, so states they access are shared.
+	auto fail = make_shared_ptr<std::atomic<bool>>(true);
+	ReadAheadWindow window(
+	    [pool, fail](idx_t location, idx_t nr_bytes, ReadAheadWindow::BlockCallback on_fetched) {
+		    std::thread([pool, fail, location, nr_bytes, on_fetched]() {
+			    if (fail->load()) {
+				    on_fetched(PooledReadBuffer(), std::make_exception_ptr(IOException("fetch failed")));
+				    return;
+			    }
+			    auto buffer = pool->Acquire(nr_bytes);
+			    std::memcpy(buffer.GetData(), TEST_CONTENT.data() + location, nr_bytes);
+			    on_fetched(std::move(buffer), /*eptr=*/nullptr);
+		    }).detach();
+	    },
+	    /*block_size_p=*/4, /*window_blocks_p=*/2);
+
+	char buffer[4];
+	REQUIRE_THROWS_AS(window.Read(reinterpret_cast<data_ptr_t>(buffer), sizeof(buffer), 0, TEST_CONTENT.size()),
+	                  IOException);
+
+	// Failed block is fetched again on the next read.
+	fail->store(false);
+	REQUIRE(window.Read(reinterpret_cast<data_ptr_t>(buffer), sizeof(buffer), 0, TEST_CONTENT.size()) == 4);
+	REQUIRE(string(buffer, 4) == TEST_CONTENT.substr(0, 4));
+}
+
+TEST_CASE("ReadAheadWindow fails blocks whose fetch cannot start", "[read_ahead_window]") {
+	ReadAheadWindow window(
+	    [](idx_t location, idx_t nr_bytes, ReadAheadWindow::BlockCallback on_fetched) {
+		    throw IOException("cannot start fetch");
+	    },
+	    /*block_size_p=*/4, /*window_blocks_p=*/2);
+
+	char buffer[4];
+	REQUIRE_THROWS_AS(window.Read(reinterpret_cast<data_ptr_t>(buffer), sizeof(buffer), 0, TEST_CONTENT.size()),
+	                  IOException);
+	REQUIRE(window.GetBlockCount() == 0);
+}
@@ -0,0 +1,49 @@
+#include "catch/catch.hpp"
+
+#include "read_buffer_pool.hpp"
+
+using namespace duckdb; // NOLINT
+
+TEST_CASE("ReadBufferPool rounds up to size class", "[read_buffer_pool]") {
+	auto pool = make_shared_ptr<ReadBufferPool>(/*max_bytes_p=*/1024 * 1024);
+	auto buffer = pool->Acquire(/*size=*/5000);
+	REQUIRE(buffer.GetData() != nullptr);
+	REQUIRE(buffer.GetCapacity() == 8192);
+}
+
+TEST_CASE("ReadBufferPool reuses released buffers", "[read_buffer_pool]") {
+	auto pool = make_shared_ptr<ReadBufferPool>(/*max_bytes_p=*/1024 * 1024);
+	data_ptr_t first_data = nullptr;
+	{
+		auto buffer = pool->Acquire(/*size=*/4096);
+		first_data = buffer.GetData();
+	}
+	REQUIRE(pool->GetCachedBytes() == 4096);
+
+	auto buffer = pool->Acquire(/*size=*/100);
+	REQUIRE(buffer.GetData() == first_data);
+	REQUIRE(pool->GetCachedBytes() == 0);
+}
+
+TEST_CASE("ReadBufferPool respects memory cap", "[read_buffer_pool]") {
+	auto pool = make_shared_ptr<ReadBufferPool>(/*max_bytes_p=*/8192);
+	{
+		auto buffer1 = pool->Acquire(/*size=*/8192);
+		auto buffer2 = pool->Acquire(/*size=*/8192);
+	}
+	// Only one buffer fits into the cap.
+	REQUIRE(pool->GetCachedBytes() == 8192);
+
+	pool->SetMaxBytes(0);
+	REQUIRE(pool->GetCachedBytes() == 0);
+}
+
+TEST_CASE("ReadBufferPool moved buffer is released once", "[read_buffer_pool]") {
+	auto pool = make_shared_ptr<ReadBufferPool>(/*max_bytes_p=*/1024 * 1024);
+	{
+		auto buffer = pool->Acquire(/*size=*/4096);
+		auto moved_buffer = std::move(buffer);
+		REQUIRE(moved_buffer.GetCapacity() == 4096);
+	}
+	REQUIRE(pool->GetCachedBytes() == 4096);
+}
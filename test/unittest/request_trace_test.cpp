@@ -0,0 +1,191 @@
+#include "catch/catch.hpp"
+
+#include "duckdb/common/exception.hpp"
+#include "request_trace.hpp"
+
+#include <cstring>
+#include <thread>
+
+using namespace duckdb; // NOLINT
+
+namespace {
+std::exception_ptr MakeError(const string &message) {
+	try {
+		throw IOException(message);
+	} catch (...) {
+		return std::current_exception();
+	}
+}
+} // namespace
+
+TEST_CASE("RequestTraceRing keeps the most recent events", "[request_trace]") {
+	RequestTraceRing ring;
+	REQUIRE(ring.GetRecentEvents().empty());
+
+	RequestTraceEvent event;
+	std::memset(&event, 0, sizeof(event));
+	const idx_t publish_count = RequestTraceRing::CAPACITY + 10;
+	for (idx_t idx = 0; idx < publish_count; ++idx) {
+		event.latency_us = static_cast<int64_t>(idx);
+		ring.Publish(event);
+	}
+
+	const auto events = ring.GetRecentEvents();
+	REQUIRE(events.size() == RequestTraceRing::CAPACITY);
+	// The oldest events are overwritten, the rest are ordered by request id.
+	REQUIRE(events.front().request_id == 11);
+	REQUIRE(events.back().request_id == publish_count);
+	for (idx_t idx = 0; idx < events.size(); ++idx) {
+		REQUIRE(static_cast<idx_t>(events[idx].latency_us) + 1 == events[idx].request_id);
+	}
+}
+
+TEST_CASE("RequestTraceRing reads consistent events while written", "[request_trace]") {
+	RequestTraceRing ring;
+	std::atomic<bool> done {false};
+	std::thread writer([&]() {
+		RequestTraceEvent event;
+		std::memset(&event, 0, sizeof(event));
+		for (int64_t idx = 0; idx < 100000; ++idx) {
+			event.latency_us = idx;
+			event.start_time_us = idx;
+			ring.Publish(event);
+		}
+		done.store(true);
+	});
+	while (!done.load()) {
+		for (const auto &cur_event : ring.GetRecentEvents()) {
+			REQUIRE(cur_event.latency_us == cur_event.start_time_us);
+			REQUIRE(static_cast<uint64_t>(cur_event.latency_us) + 1 == cur_event.request_id);
+		}
+	}
+	writer.join();
+}
+
+TEST_CASE("RequestTraceRecorder publishes once caller and winner are done", "[request_trace]") {
+	const string path = "mock://bucket/key.parquet";
+	for (bool winner_first : {true, false}) {
+		RequestTraceRing ring;
+		RequestTraceRecorder recorder;
+		recorder.Begin(ring, HedgedRequestOperation::READ, path);
+		recorder.OnAttemptSubmitted(0);
+		recorder.OnAttemptSubmitted(1);
+		recorder.OnAttemptStarted(0);
+		recorder.OnAttemptStarted(1);
+		recorder.OnAttemptFinished(1);
+		if (winner_first) {
+			recorder.OnAttemptWon(1);
+			REQUIRE(ring.GetRecentEvents().empty());
+			recorder.OnRequestReturned(/*attempt_count=*/2, /*decided_by_caller=*/false);
+		} else {
+			recorder.OnRequestReturned(/*attempt_count=*/2, /*decided_by_caller=*/false);
+			REQUIRE(ring.GetRecentEvents().empty());
+			recorder.OnAttemptWon(1);
+		}
+
+		const auto events = ring.GetRecentEvents();
+		REQUIRE(events.size() == 1);
+		const auto &event = events[0];
+		REQUIRE(event.request_id == 1);
+		REQUIRE(event.operation == HedgedRequestOperation::READ);
+		REQUIRE(event.path_hash == std::hash<string> {}(path));
+		REQUIRE(string(event.path_prefix) == path);
+		REQUIRE(event.attempt_count == 2);
+		REQUIRE(event.winner_attempt == 1);
+		REQUIRE(!event.failed);
+		REQUIRE(string(event.error).empty());
+		REQUIRE(event.attempts[1].submit_us >= 0);
+		REQUIRE(event.attempts[1].start_us >= event.attempts[1].submit_us);
+		REQUIRE(event.attempts[1].finish_us >= event.attempts[1].start_us);
+		// The losing attempt is still running when the event is published.
+		REQUIRE(event.attempts[0].start_us >= 0);
+		REQUIRE(event.attempts[0].finish_us == -1);
+		REQUIRE(event.attempts[2].submit_us == -1);
+	}
+}
+
+TEST_CASE("RequestTraceRecorder traces failures", "[request_trace]") {
+	SECTION("Failed winner") {
+		RequestTraceRing ring;
+		RequestTraceRecorder recorder;
+		recorder.Begin(ring, HedgedRequestOperation::OPEN_FILE, "mock://file");
+		recorder.OnAttemptSubmitted(0);
+		recorder.OnAttemptStarted(0);
+		recorder.OnAttemptFinished(0, MakeError("not found"));
+		recorder.OnAttemptWon(0);
+		recorder.OnRequestReturned(/*attempt_count=*/1, /*decided_by_caller=*/false);
+
+		const auto events = ring.GetRecentEvents();
+		REQUIRE(events.size() == 1);
+		REQUIRE(events[0].failed);
+		REQUIRE(events[0].winner_attempt == 0);
+		REQUIRE(events[0].attempts[0].failed);
+		REQUIRE(string(events[0].error) == "not found");
+	}
+
+	SECTION("Decided by caller") {
+		RequestTraceRing ring;
+		RequestTraceRecorder recorder;
+		recorder.Begin(ring, HedgedRequestOperation::OPEN_FILE, "mock://file");
+		for (size_t idx = 0; idx < 2; ++idx) {
+			recorder.OnAttemptSubmitted(idx);
+			recorder.OnAttemptStarted(idx);
+			recorder.OnAttemptFinished(idx, MakeError("attempt " + std::to_string(idx)));
+		}
+		// No attempt records a win, so the caller's return alone publishes the event.
+		recorder.OnRequestReturned(/*attempt_count=*/2, /*decided_by_caller=*/true);
+
+		const auto events = ring.GetRecentEvents();
+		REQUIRE(events.size() == 1);
+		REQUIRE(events[0].failed);
+		REQUIRE(events[0].winner_attempt == -1);
+		// The first failure is kept.
+		REQUIRE(string(events[0].error) == "attempt 0");
+	}
+
+	SECTION("Cancelled attempt") {
+		RequestTraceRing ring;
+		RequestTraceRecorder recorder;
+		recorder.Begin(ring, HedgedRequestOperation::OPEN_FILE, "mock://file");
+		recorder.OnAttemptSubmitted(0);
+		recorder.OnAttemptSubmitted(1);
+		recorder.OnAttemptFinished(1);
+		recorder.OnAttemptWon(1);
+		// Aborted due to cancellation, which isn't a failure.
+		recorder.OnAttemptFinished(0);
+		recorder.OnRequestReturned(/*attempt_count=*/2, /*decided_by_caller=*/false);
+
+		const auto events = ring.GetRecentEvents();
+		REQUIRE(events.size() == 1);
+		REQUIRE(!events[0].failed);
+		REQUIRE(!events[0].attempts[0].failed);
+		REQUIRE(string(events[0].error).empty());
+	}
+}
+
+TEST_CASE("RequestTraceRecorder truncates path and error", "[request_trace]") {
+	RequestTraceRing ring;
+	const string path(RequestTraceEvent::PATH_PREFIX_BYTES * 2, 'p');
+	const string message(RequestTraceEvent::ERROR_BYTES * 2, 'e');
+
+	RequestTraceRecorder recorder;
+	recorder.Begin(ring, HedgedRequestOperation::GLOB, path);
+	// Attempts beyond the traced ones are only counted.
+	const size_t attempt_count = RequestTraceEvent::MAX_ATTEMPTS + 2;
+	for (size_t idx = 0; idx < attempt_count; ++idx) {
+		recorder.OnAttemptSubmitted(idx);
+		recorder.OnAttemptStarted(idx);
+	}
+	recorder.OnAttemptFinished(attempt_count - 1, MakeError(message));
+	recorder.OnAttemptWon(attempt_count - 1);
+	recorder.OnRequestReturned(attempt_count, /*decided_by_caller=*/false);
+
+	const auto events = ring.GetRecentEvents();
+	REQUIRE(events.size() == 1);
+	REQUIRE(events[0].path_hash == std::hash<string> {}(path));
+	REQUIRE(string(events[0].path_prefix) == path.substr(0, RequestTraceEvent::PATH_PREFIX_BYTES - 1));
+	REQUIRE(string(events[0].error) == message.substr(0, RequestTraceEvent::ERROR_BYTES - 1));
+	REQUIRE(events[0].attempt_count == attempt_count);
+	REQUIRE(events[0].winner_attempt == static_cast<int64_t>(attempt_count - 1));
+	REQUIRE(events[0].failed);
+}
@@ -0,0 +1,112 @@
+#include "catch/catch.hpp"
+
+#include "duckdb/common/vector.hpp"
+#include "single_flight.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+using namespace duckdb; // NOLINT
+
+namespace {
+constexpr int CALLER_COUNT = 8;
+} // namespace
+
+TEST_CASE("SingleFlight shares result among concurrent callers", "[single_flight]") {
+	SingleFlight single_flight;
+	std::atomic<int> invocations(0);
+	std::atomic<int> started(0);
+	std::function<int()> fn = [&]() {
+		invocations.fetch_add(1);
+		// Wait for all callers to join.
+		while (started.load() < CALLER_COUNT) {
+			std::this_thread::yield();
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		return 42;
+	};
+
+	vector<std::thread> threads;
+	std::atomic<int> result_sum(0);
+	for (int idx = 0; idx < CALLER_COUNT; ++idx) {
+		threads.emplace_back([&]() {
+			started.fetch_add(1);
+			result_sum.fetch_add(single_flight.Do<int>("key", fn));
+		});
+	}
+	for (auto &cur_thread : threads) {
+		cur_thread.join();
+	}
+	REQUIRE(result_sum.load() == 42 * CALLER_COUNT);
+	// Callers joining after the leader completes start a new flight, so invocation count is only bounded.
+	REQUIRE(invocations.load() >= 1);
+	REQUIRE(invocations.load() < CALLER_COUNT);
+	REQUIRE(single_flight.GetInFlightCount() == 0);
+}
+
+TEST_CASE("SingleFlight doesn't coalesce different keys", "[single_flight]") {
+	SingleFlight single_flight;
+	REQUIRE(single_flight.Do<int>("a", std::function<int()>([]() { return 1; })) == 1);
+	REQUIRE(single_flight.Do<int>("b", std::function<int()>([]() { return 2; })) == 2);
+	REQUIRE(single_flight.GetInFlightCount() == 0);
+}
+
+TEST_CASE("SingleFlight propagates leader exception to followers", "[single_flight]") {
+	SingleFlight single_flight;
+	std::atomic<bool> follower_joined(false);
+	std::function<int()> fn = [&]() -> int {
+		while (!follower_joined.load()) {
+			std::this_thread::yield();
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		throw std::runtime_error("leader failure");
+	};
+
+	std::atomic<bool> leader_failed(false);
+	std::thread leader([&]() {
+		try {
+			single_flight.Do<int>("key", fn);
+		} catch (const std::runtime_error &) {
+			leader_failed.store(true);
+		}
+	});
+	while (single_flight.GetInFlightCount() == 0) {
+		std::this_thread::yield();
+	}
+	follower_joined.store(true);
+	REQUIRE_THROWS_AS(single_flight.Do<int>("key", fn), std::runtime_error);
+	leader.join();
+	REQUIRE(leader_failed.load());
+	REQUIRE(single_flight.GetInFlightCount() == 0);
+}
+
+TEST_CASE("SingleFlight followers run their own call after leader succeeds", "[single_flight]") {
+	SingleFlight single_flight;
+	std::atomic<bool> follower_joined(false);
+	std::atomic<int> follow_invocations(0);
+	std::function<int()> fn = [&]() {
+		while (!follower_joined.load()) {
+			std::this_thread::yield();
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		return 1;
+	};
+	std::function<int()> follow_fn = [&]() {
+		follow_invocations.fetch_add(1);
+		return 2;
+	};
+
+	int leader_result = 0;
+	std::thread leader([&]() { leader_result = single_flight.DoOrFollow<int>("key", fn, follow_fn); });
+	while (single_flight.GetInFlightCount() == 0) {
+		std::this_thread::yield();
+	}
+	follower_joined.store(true);
+	// The follower might become a leader itself if the first leader has already completed.
+	const auto follower_result = single_flight.DoOrFollow<int>("key", fn, follow_fn);
+	leader.join();
+	REQUIRE(leader_result == 1);
+	REQUIRE(follower_result == (follow_invocations.load() == 1 ? 2 : 1));
+}
@@ -3,6 +3,7 @@
 #include "duckdb/common/multi_file/multi_file_list.hpp"
 #include "duckdb/common/virtual_file_system.hpp"
 #include "hedged_file_system.hpp"
+#include "listing_cache.hpp"
 
 using namespace duckdb;
 
@@ -121,3 +122,25 @@ TEST_CASE("Test Glob uses GlobFilesExtended", "[glob test]") {
 	REQUIRE(results[0].path == "s3://bucket/snapshots/file1.parquet");
 	REQUIRE(results[1].path == "s3://bucket/snapshots/file2.parquet");
 }
+
+// Filesystems not listing directory levels, e.g. object stores without delimiter listing, are globbed as a whole,
+// without any ListFiles call for cached or partitioned expansion.
+TEST_CASE("Test cached and parallel Glob fall back without level listing", "[glob test]") {
+	auto mock_filesystem = make_uniq<MockFileSystemWithExtendedGlob>();
+	auto *mock_ptr = mock_filesystem.get();
+	vector<OpenFileInfo> glob_results;
+	glob_results.emplace_back(OpenFileInfo("s3://bucket/events/2024/file1.parquet"));
+	mock_filesystem->SetExtendedGlobResults(std::move(glob_results));
+
+	auto entry = make_shared_ptr<HedgedRequestFsEntry>();
+	entry->UpdateGlobParallelism(4);
+	auto listing_cache = make_shared_ptr<ListingCache>();
+	listing_cache->SetEnabled(true);
+	auto hedged_request_filesystem = make_uniq<HedgedFileSystem>(std::move(mock_filesystem), entry,
+	                                                             /*metadata_cache_p=*/nullptr, listing_cache);
+	auto results = hedged_request_filesystem->Glob("s3://bucket/events/*/*.parquet");
+	REQUIRE(mock_ptr->GetGlobExtendedInvocation() == 1);
+	REQUIRE(results.size() == 1);
+	REQUIRE(results[0].path == "s3://bucket/events/2024/file1.parquet");
+	entry->WaitAll();
+}
@@ -0,0 +1,217 @@
+#include "catch/catch.hpp"
+
+#include "mutex.hpp"
+#include "thread_pool.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace duckdb; // NOLINT
+
+namespace {
+// Poll until [predicate] holds or timeout.
+template <typename Predicate>
+bool WaitUntil(Predicate predicate, std::chrono::milliseconds timeout = std::chrono::milliseconds(5000)) {
+	const auto deadline = std::chrono::steady_clock::now() + timeout;
+	while (std::chrono::steady_clock::now() < deadline) {
+		if (predicate()) {
+			return true;
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(5));
+	}
+	return predicate();
+}
+} // namespace
+
+TEST_CASE("ThreadPool grows for blocking jobs", "[thread_pool]") {
+	ThreadPool pool(/*min_thread_num=*/1, /*max_thread_num=*/8);
+	REQUIRE(pool.GetThreadCount() == 1);
+
+	// All jobs block concurrently, which requires pool to grow beyond min thread count.
+	std::atomic<int> started(0);
+	std::atomic<bool> release(false);
+	for (int idx = 0; idx < 8; ++idx) {
+		pool.Submit([&started, &release]() {
+			started.fetch_add(1);
+			while (!release.load()) {
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+		});
+	}
+	REQUIRE(WaitUntil([&started]() { return started.load() == 8; }));
+	REQUIRE(pool.GetThreadCount() == 8);
+
+	release.store(true);
+	pool.Wait();
+}
+
+TEST_CASE("ThreadPool respects max thread count", "[thread_pool]") {
+	ThreadPool pool(/*min_thread_num=*/1, /*max_thread_num=*/2);
+	std::atomic<int> finished(0);
+	for (int idx = 0; idx < 16; ++idx) {
+		pool.Submit([&finished]() {
+			std::this_thread::sleep_for(std::chrono::milliseconds(5));
+			finished.fetch_add(1);
+		});
+	}
+	pool.Wait();
+	REQUIRE(finished.load() == 16);
+	REQUIRE(pool.GetThreadCount() <= 2);
+}
+
+TEST_CASE("ThreadPool retires idle threads", "[thread_pool]") {
+	ThreadPool pool(/*min_thread_num=*/1, /*max_thread_num=*/4, /*idle_timeout=*/std::chrono::milliseconds(50));
+	std::atomic<int> started(0);
+	for (int idx = 0; idx < 4; ++idx) {
+		pool.Submit([&started]() {
+			started.fetch_add(1);
+			std::this_thread::sleep_for(std::chrono::milliseconds(100));
+		});
+	}
+	pool.Wait();
+	REQUIRE(started.load() == 4);
+	REQUIRE(WaitUntil([&pool]() { return pool.GetThreadCount() == 1; }));
+
+	// Lowering max thread count after growing up again.
+	pool.SetThreadLimits(/*min_thread_num=*/3, /*max_thread_num=*/3);
+	REQUIRE(pool.GetThreadCount() == 3);
+	pool.SetThreadLimits(/*min_thread_num=*/1, /*max_thread_num=*/1);
+	REQUIRE(WaitUntil([&pool]() { return pool.GetThreadCount() == 1; }));
+}
+
+TEST_CASE("ThreadPool doesn't strand jobs submitted while a worker retires", "[thread_pool]") {
+	ThreadPool pool(/*min_thread_num=*/1, /*max_thread_num=*/2, /*idle_timeout=*/std::chrono::milliseconds(1));
+	// Keeps one worker busy, so only the retiring one could take the jobs below.
+	std::atomic<bool> release(false);
+	pool.Submit([&release]() {
+		while (!release.load()) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	});
+	for (int idx = 0; idx < 200; ++idx) {
+		// Let the second worker hit its idle timeout around the submission.
+		std::this_thread::sleep_for(std::chrono::microseconds(500 + 10 * (idx % 100)));
+		auto fut = pool.Push([]() { return 1; });
+		REQUIRE(fut.wait_for(std::chrono::milliseconds(2000)) == std::future_status::ready);
+	}
+	release.store(true);
+	pool.Wait();
+}
+
+TEST_CASE("ThreadPool runs jobs submitted during destruction", "[thread_pool]") {
+	std::atomic<bool> started(false);
+	std::atomic<int> finished(0);
+	{
+		ThreadPool pool(/*min_thread_num=*/1, /*max_thread_num=*/1);
+		pool.Submit([&pool, &started, &finished]() {
+			started.store(true);
+			// Submitted once the destructor has stopped the pool.
+			std::this_thread::sleep_for(std::chrono::milliseconds(50));
+			for (int idx = 0; idx < 4; ++idx) {
+				pool.Submit([&finished]() { finished.fetch_add(1); });
+			}
+		});
+		REQUIRE(WaitUntil([&started]() { return started.load(); }));
+	}
+	REQUIRE(finished.load() == 4);
+}
+
+TEST_CASE("ThreadPool nested submission", "[thread_pool]") {
+	ThreadPool pool(/*min_thread_num=*/2, /*max_thread_num=*/4);
+	std::atomic<int> finished(0);
+	auto fut = pool.Push([&pool, &finished]() {
+		for (int idx = 0; idx < 10; ++idx) {
+			pool.Submit([&finished]() { finished.fetch_add(1); });
+		}
+		return 5;
+	});
+	REQUIRE(fut.get() == 5);
+	pool.Wait();
+	REQUIRE(finished.load() == 10);
+}
+
+TEST_CASE("ThreadPool skips queued tied jobs", "[thread_pool]") {
+	ThreadPool pool(/*min_thread_num=*/1, /*max_thread_num=*/1);
+	REQUIRE_FALSE(pool.IsSaturated());
+
+	// Block the only worker, so tied jobs queue up behind it.
+	std::atomic<bool> started(false);
+	std::atomic<bool> release(false);
+	pool.Submit([&started, &release]() {
+		started.store(true);
+		while (!release.load()) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	});
+	REQUIRE(WaitUntil([&started]() { return started.load(); }));
+	auto tie = make_shared_ptr<JobTie>();
+	std::atomic<int> run_count(0);
+	std::atomic<int> skip_count(0);
+	for (int idx = 0; idx < 3; ++idx) {
+		pool.Submit([&run_count]() { run_count.fetch_add(1); }, JobPriority::PRIMARY, tie,
+		            [&skip_count]() { skip_count.fetch_add(1); });
+	}
+	REQUIRE(pool.IsSaturated());
+	REQUIRE(tie->GetQueuedCount() == 3);
+
+	// Only the first dequeued sibling runs.
+	release.store(true);
+	pool.Wait();
+	REQUIRE(run_count.load() == 1);
+	REQUIRE(skip_count.load() == 2);
+	REQUIRE(tie->GetSkippedCount() == 2);
+	REQUIRE(tie->GetQueuedCount() == 0);
+
+	// Siblings submitted after one has started still run.
+	pool.Submit([&run_count]() { run_count.fetch_add(1); }, JobPriority::PRIMARY, tie,
+	            [&skip_count]() { skip_count.fetch_add(1); });
+	pool.Wait();
+	REQUIRE(run_count.load() == 2);
+	REQUIRE(skip_count.load() == 2);
+}
+
+TEST_CASE("ThreadPool runs queued jobs by priority", "[thread_pool]") {
+	ThreadPool pool(/*min_thread_num=*/1, /*max_thread_num=*/1);
+
+	// Block the only worker, so jobs of all priority classes queue up behind it.
+	std::atomic<bool> started(false);
+	std::atomic<bool> release(false);
+	pool.Submit([&started, &release]() {
+		started.store(true);
+		while (!release.load()) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	});
+	REQUIRE(WaitUntil([&started]() { return started.load(); }));
+	concurrency::mutex order_mutex;
+	std::vector<JobPriority> order;
+	auto record = [&order_mutex, &order](JobPriority priority) {
+		const concurrency::lock_guard<concurrency::mutex> lock(order_mutex);
+		order.emplace_back(priority);
+	};
+	pool.Submit([&record]() { record(JobPriority::HOUSEKEEPING); }, JobPriority::HOUSEKEEPING);
+	pool.Submit([&record]() { record(JobPriority::HEDGE); }, JobPriority::HEDGE);
+	pool.Submit([&record]() { record(JobPriority::PRIMARY); }, JobPriority::PRIMARY);
+	REQUIRE(pool.GetQueuedJobCount() == 3);
+	REQUIRE(pool.GetQueueStats(JobPriority::HEDGE).queued_jobs == 1);
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	release.store(true);
+	pool.Wait();
+	REQUIRE(order.size() == 3);
+	REQUIRE(order[0] == JobPriority::PRIMARY);
+	REQUIRE(order[1] == JobPriority::HEDGE);
+	REQUIRE(order[2] == JobPriority::HOUSEKEEPING);
+
+	// Queued jobs waited behind the blocking job, which itself didn't queue.
+	REQUIRE(pool.GetQueuedJobCount() == 0);
+	const auto primary_stats = pool.GetQueueStats(JobPriority::PRIMARY);
+	REQUIRE(primary_stats.queued_jobs == 0);
+	REQUIRE(primary_stats.dequeued_jobs == 2);
+	const auto housekeeping_stats = pool.GetQueueStats(JobPriority::HOUSEKEEPING);
+	REQUIRE(housekeeping_stats.dequeued_jobs == 1);
+	REQUIRE(housekeeping_stats.total_wait_us >= 10000);
+	REQUIRE(housekeeping_stats.recent_wait_us > 0);
+}
@@ -0,0 +1,86 @@
+#include "catch/catch.hpp"
+
+#include "timer_wheel.hpp"
+
+using namespace duckdb; // NOLINT
+
+TEST_CASE("TimerWheel expires timers in order", "[timer_wheel]") {
+	TimerWheel wheel;
+	// Cover all levels, including timers cascading down more than one level.
+	wheel.Add(/*timer_id=*/1, /*expire_tick=*/5);
+	wheel.Add(/*timer_id=*/2, /*expire_tick=*/70);
+	wheel.Add(/*timer_id=*/3, /*expire_tick=*/5000);
+	wheel.Add(/*timer_id=*/4, /*expire_tick=*/300000);
+	wheel.Add(/*timer_id=*/5, /*expire_tick=*/64);
+	REQUIRE(wheel.GetTimerCount() == 5);
+
+	vector<uint64_t> expired;
+	wheel.Advance(4, expired);
+	REQUIRE(expired.empty());
+	wheel.Advance(5, expired);
+	REQUIRE(expired == vector<uint64_t> {1});
+
+	expired.clear();
+	wheel.Advance(69, expired);
+	REQUIRE(expired == vector<uint64_t> {5});
+	expired.clear();
+	wheel.Advance(70, expired);
+	REQUIRE(expired == vector<uint64_t> {2});
+
+	expired.clear();
+	wheel.Advance(4999, expired);
+	REQUIRE(expired.empty());
+	wheel.Advance(5000, expired);
+	REQUIRE(expired == vector<uint64_t> {3});
+
+	expired.clear();
+	wheel.Advance(299999, expired);
+	REQUIRE(expired.empty());
+	wheel.Advance(300000, expired);
+	REQUIRE(expired == vector<uint64_t> {4});
+	REQUIRE(wheel.IsEmpty());
+}
+
+TEST_CASE("TimerWheel removes timers", "[timer_wheel]") {
+	TimerWheel wheel;
+	wheel.Add(/*timer_id=*/1, /*expire_tick=*/10);
+	wheel.Add(/*timer_id=*/2, /*expire_tick=*/1000);
+	REQUIRE(wheel.Remove(2));
+	REQUIRE(!wheel.Remove(2));
+
+	vector<uint64_t> expired;
+	wheel.Advance(2000, expired);
+	REQUIRE(expired == vector<uint64_t> {1});
+	REQUIRE(wheel.IsEmpty());
+}
+
+TEST_CASE("TimerWheel handles expired and far timers", "[timer_wheel]") {
+	TimerWheel wheel(/*start_tick=*/100);
+	// Already expired timer fires on the next tick.
+	wheel.Add(/*timer_id=*/1, /*expire_tick=*/50);
+	REQUIRE(wheel.GetNextWakeupTick() == 101);
+
+	// Timer beyond the range of the top level.
+	const uint64_t far_tick = 100 + (uint64_t(1) << (TimerWheel::SLOT_BITS * TimerWheel::LEVEL_COUNT)) + 10;
+	wheel.Add(/*timer_id=*/2, far_tick);
+
+	vector<uint64_t> expired;
+	wheel.Advance(101, expired);
+	REQUIRE(expired == vector<uint64_t> {1});
+	expired.clear();
+	wheel.Advance(far_tick - 1, expired);
+	REQUIRE(expired.empty());
+	wheel.Advance(far_tick, expired);
+	REQUIRE(expired == vector<uint64_t> {2});
+}
+
+TEST_CASE("TimerWheel next wakeup tick", "[timer_wheel]") {
+	TimerWheel wheel;
+	wheel.Add(/*timer_id=*/1, /*expire_tick=*/10);
+	REQUIRE(wheel.GetNextWakeupTick() == 10);
+
+	// Timers on higher levels wake up at the next cascade point.
+	REQUIRE(wheel.Remove(1));
+	wheel.Add(/*timer_id=*/2, /*expire_tick=*/1000);
+	REQUIRE(wheel.GetNextWakeupTick() == TimerWheel::SLOT_COUNT);
+}
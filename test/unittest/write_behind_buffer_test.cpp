@@ -0,0 +1,167 @@
+#include "catch/catch.hpp"
+
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/helper.hpp"
+#include "write_behind_buffer.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+using namespace duckdb; // NOLINT
+
+namespace {
+const string TEST_CONTENT = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+// Write parts into [output] inline, and count written parts.
+WriteBehindBuffer::PartWriter MakeWriter(string &output, std::atomic<int> &write_count) {
+	return [&output, &write_count](shared_ptr<PooledReadBuffer> part, idx_t nr_bytes, idx_t location,
+	                               WriteBehindBuffer::PartCallback on_written) {
+		write_count.fetch_add(1);
+		if (output.size() < location + nr_bytes) {
+			output.resize(location + nr_bytes);
+		}
+		std::memcpy(&output[location], part->GetData(), nr_bytes);
+		on_written(nullptr);
+	};
+}
+} // namespace
+
+TEST_CASE("WriteBehindBuffer writes full parts", "[write_behind_buffer]") {
+	auto pool = make_shared_ptr<ReadBufferPool>(/*max_bytes_p=*/1024);
+	string output;
+	std::atomic<int> write_count(0);
+	WriteBehindBuffer buffer(MakeWriter(output, write_count), pool, /*part_size_p=*/8,
+	                         /*max_outstanding_parts_p=*/2);
+
+	// Small writes are accumulated, and only full parts are written before flush.
+	for (idx_t offset = 0; offset < TEST_CONTENT.size(); offset += 5) {
+		const auto nr_bytes = MinValue<idx_t>(5, TEST_CONTENT.size() - offset);
+		buffer.Write(reinterpret_cast<const_data_ptr_t>(TEST_CONTENT.data()) + offset, nr_bytes, offset);
+	}
+	REQUIRE(write_count.load() == 4);
+	buffer.Flush();
+	REQUIRE(write_count.load() == 5);
+	REQUIRE(output == TEST_CONTENT);
+	REQUIRE(buffer.GetOutstandingPartCount() == 0);
+}
+
+TEST_CASE("WriteBehindBuffer submits non-contiguous writes as separate parts", "[write_behind_buffer]") {
+	auto pool = make_shared_ptr<ReadBufferPool>(/*max_bytes_p=*/1024);
+	string output(TEST_CONTENT.size(), '-');
+	std::atomic<int> write_count(0);
+	WriteBehindBuffer buffer(MakeWriter(output, write_count), pool, /*part_size_p=*/16,
+	                         /*max_outstanding_parts_p=*/2);
+
+	const auto *data = reinterpret_cast<const_data_ptr_t>(TEST_CONTENT.data());
+	buffer.Write(data + 10, 4, 10);
+	buffer.Write(data, 4, 0);
+	REQUIRE(write_count.load() == 1);
+	buffer.Flush();
+	REQUIRE(write_count.load() == 2);
+	REQUIRE(output == "0123------abcd----------------------");
+}
+
+TEST_CASE("WriteBehindBuffer bounds outstanding parts and writes them in order", "[write_behind_buffer]") {
+	auto pool = make_shared_ptr<ReadBufferPool>(/*max_bytes_p=*/1024);
+	string output;
+	std::atomic<int> write_count(0);
+	std::atomic<int> running_count(0);
+	std::atomic<int> max_running_count(0);
+	concurrency::mutex output_mutex;
+	vector<idx_t> locations;
+	// Parts are written on a detached thread each, and complete after a delay.
+	WriteBehindBuffer::PartWriter slow_writer = [&](shared_ptr<PooledReadBuffer> part, idx_t nr_bytes,
+	                                                idx_t location, WriteBehindBuffer::PartCallback on_written) {
+		std::thread([&, part, nr_bytes, location, on_written]() {
+			const auto running = running_count.fetch_add(1) + 1;
+			auto max_running = max_running_count.load();
+			while (running > max_running && !max_running_count.compare_exchange_weak(max_running, running)) {
+			}
+			std::this_thread::sleep_for(std::chrono::milliseconds(20));
+			{
+				const concurrency::lock_guard<concurrency::mutex> lock(output_mutex);
+				locations.emplace_back(location);
+				if (output.size() < location + nr_bytes) {
+					output.resize(location + nr_bytes);
+				}
+				std::memcpy(&output[location], part->GetData(), nr_bytes);
+			}
+			write_count.fetch_add(1);
+			running_count.fetch_sub(1);
+			on_written(nullptr);
+		}).detach();
+	};
+	WriteBehindBuffer buffer(std::move(slow_writer), pool, /*part_size_p=*/4, /*max_outstanding_parts_p=*/2);
+
+	buffer.Write(reinterpret_cast<const_data_ptr_t>(TEST_CONTENT.data()), TEST_CONTENT.size(), /*location=*/0);
+	REQUIRE(buffer.GetOutstandingPartCount() <= 2);
+	buffer.Flush();
+	REQUIRE(output == TEST_CONTENT);
+	REQUIRE(write_count.load() == 9);
+	// Parts are written one at a time, in the order they are submitted.
+	REQUIRE(max_running_count.load() == 1);
+	const concurrency::lock_guard<concurrency::mutex> lock(output_mutex);
+	REQUIRE(locations == vector<idx_t>({0, 4, 8, 12, 16, 20, 24, 28, 32}));
+}
+
+TEST_CASE("WriteBehindBuffer waits for parts held by background attempts", "[write_behind_buffer]") {
+	auto pool = make_shared_ptr<ReadBufferPool>(/*max_bytes_p=*/1024);
+	auto attempt_finished = make_shared_ptr<std::atomic<bool>>(false);
+	// Writer returns before the background attempt holding a part copy finishes, e.g. a losing hedged attempt.
+	WriteBehindBuffer::PartWriter writer = [attempt_finished](shared_ptr<PooledReadBuffer> part, idx_t, idx_t,
+	                                                          WriteBehindBuffer::PartCallback on_written) {
+		std::thread([attempt_finished, part]() {
+			std::this_thread::sleep_for(std::chrono::milliseconds(50));
+			attempt_finished->store(true);
+		}).detach();
+		on_written(nullptr);
+	};
+	WriteBehindBuffer buffer(std::move(writer), pool, /*part_size_p=*/8, /*max_outstanding_parts_p=*/2);
+	buffer.Write(reinterpret_cast<const_data_ptr_t>(TEST_CONTENT.data()), 4, /*location=*/0);
+	buffer.Flush();
+	REQUIRE(attempt_finished->load());
+}
+
+TEST_CASE("WriteBehindBuffer rethrows part failure", "[write_behind_buffer]") {
+	auto pool = make_shared_ptr<ReadBufferPool>(/*max_bytes_p=*/1024);
+	std::atomic<int> write_count(0);
+	WriteBehindBuffer::PartWriter writer = [&write_count](shared_ptr<PooledReadBuffer>, idx_t, idx_t,
+	                                                      WriteBehindBuffer::PartCallback on_written) {
+		write_count.fetch_add(1);
+		on_written(std::make_exception_ptr(IOException("part write failed")));
+	};
+	WriteBehindBuffer buffer(std::move(writer), pool, /*part_size_p=*/4, /*max_outstanding_parts_p=*/2);
+	const auto *data = reinterpret_cast<const_data_ptr_t>(TEST_CONTENT.data());
+	buffer.Write(data, 4, /*location=*/0);
+	// Failure is reported on the next call, and parts after it are never written.
+	REQUIRE_THROWS_AS(buffer.Write(data + 4, 4, /*location=*/4), IOException);
+	REQUIRE_THROWS_AS(buffer.Flush(), IOException);
+	REQUIRE(write_count.load() == 1);
+}
+
+TEST_CASE("WriteBehindBuffer drops pending parts after a failure", "[write_behind_buffer]") {
+	auto pool = make_shared_ptr<ReadBufferPool>(/*max_bytes_p=*/1024);
+	std::atomic<int> write_count(0);
+	shared_ptr<PooledReadBuffer> held_part;
+	WriteBehindBuffer::PartCallback pending_callback;
+	// The first part only completes once the test fails it, so later parts queue up behind it.
+	WriteBehindBuffer::PartWriter writer = [&](shared_ptr<PooledReadBuffer> part, idx_t, idx_t,
+	                                           WriteBehindBuffer::PartCallback on_written) {
+		write_count.fetch_add(1);
+		held_part = std::move(part);
+		pending_callback = std::move(on_written);
+	};
+	WriteBehindBuffer buffer(std::move(writer), pool, /*part_size_p=*/4, /*max_outstanding_parts_p=*/4);
+	const auto *data = reinterpret_cast<const_data_ptr_t>(TEST_CONTENT.data());
+	buffer.Write(data, 12, /*location=*/0);
+	REQUIRE(write_count.load() == 1);
+	REQUIRE(buffer.GetOutstandingPartCount() == 3);
+
+	pending_callback(std::make_exception_ptr(IOException("part write failed")));
+	held_part.reset();
+	REQUIRE(write_count.load() == 1);
+	REQUIRE(buffer.GetOutstandingPartCount() == 0);
+	REQUIRE_THROWS_AS(buffer.Flush(), IOException);
+}